@@ -1,5 +1,7 @@
 #include "Commands/UnrealMCPBlueprintCommands.h"
+#include "MCPLog.h"
 #include "Commands/UnrealMCPCommonUtils.h"
+#include "MCPEditBatch.h"
 #include "Engine/Blueprint.h"
 #include "Engine/BlueprintGeneratedClass.h"
 #include "Factories/BlueprintFactory.h"
@@ -130,11 +132,11 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleCreateBlueprint(const
         if (FoundClass)
         {
             SelectedParentClass = FoundClass;
-            UE_LOG(LogTemp, Log, TEXT("Successfully set parent class to '%s'"), *ClassName);
+            UE_LOG(LogUnrealMCP, Log, TEXT("Successfully set parent class to '%s'"), *ClassName);
         }
         else
         {
-            UE_LOG(LogTemp, Warning, TEXT("Could not find specified parent class '%s' at paths: /Script/Engine.%s or /Script/Game.%s, defaulting to AActor"), 
+            UE_LOG(LogUnrealMCP, Warning, TEXT("Could not find specified parent class '%s' at paths: /Script/Engine.%s or /Script/Game.%s, defaulting to AActor"), 
                 *ClassName, *ClassName, *ClassName);
         }
     }
@@ -246,10 +248,11 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleAddComponentToBluepri
         }
 
         // Add to root if no parent specified
+        Blueprint->SimpleConstructionScript->Modify();
         Blueprint->SimpleConstructionScript->AddNode(NewNode);
 
         // Compile the blueprint
-        FKismetEditorUtilities::CompileBlueprint(Blueprint);
+        FUnrealMCPCommonUtils::CompileBlueprint(Blueprint);
 
         TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
         ResultObj->SetStringField(TEXT("component_name"), ComponentName);
@@ -282,7 +285,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
     }
 
     // Log all input parameters for debugging
-    UE_LOG(LogTemp, Warning, TEXT("SetComponentProperty - Blueprint: %s, Component: %s, Property: %s"), 
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Blueprint: %s, Component: %s, Property: %s"), 
         *BlueprintName, *ComponentName, *PropertyName);
     
     // Log property_value if available
@@ -301,34 +304,34 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
             default: ValueType = TEXT("Unknown"); break;
         }
         
-        UE_LOG(LogTemp, Warning, TEXT("SetComponentProperty - Value Type: %s"), *ValueType);
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Value Type: %s"), *ValueType);
     }
     else
     {
-        UE_LOG(LogTemp, Warning, TEXT("SetComponentProperty - No property_value provided"));
+        UE_LOG(LogUnrealMCP, Warning, TEXT("SetComponentProperty - No property_value provided"));
     }
 
     // Find the blueprint
     UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName);
     if (!Blueprint)
     {
-        UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - Blueprint not found: %s"), *BlueprintName);
+        UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - Blueprint not found: %s"), *BlueprintName);
         return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
     }
     else
     {
-        UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Blueprint found: %s (Class: %s)"), 
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Blueprint found: %s (Class: %s)"), 
             *BlueprintName, 
             Blueprint->GeneratedClass ? *Blueprint->GeneratedClass->GetName() : TEXT("NULL"));
     }
 
     // Find the component
     USCS_Node* ComponentNode = nullptr;
-    UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Searching for component %s in blueprint nodes"), *ComponentName);
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Searching for component %s in blueprint nodes"), *ComponentName);
     
     if (!Blueprint->SimpleConstructionScript)
     {
-        UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - SimpleConstructionScript is NULL for blueprint %s"), *BlueprintName);
+        UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - SimpleConstructionScript is NULL for blueprint %s"), *BlueprintName);
         return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Invalid blueprint construction script"));
     }
     
@@ -336,7 +339,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
     {
         if (Node)
         {
-            UE_LOG(LogTemp, Verbose, TEXT("SetComponentProperty - Found node: %s"), *Node->GetVariableName().ToString());
+            UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Found node: %s"), *Node->GetVariableName().ToString());
             if (Node->GetVariableName().ToString() == ComponentName)
             {
                 ComponentNode = Node;
@@ -345,18 +348,18 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
         }
         else
         {
-            UE_LOG(LogTemp, Warning, TEXT("SetComponentProperty - Found NULL node in blueprint"));
+            UE_LOG(LogUnrealMCP, Warning, TEXT("SetComponentProperty - Found NULL node in blueprint"));
         }
     }
 
     if (!ComponentNode)
     {
-        UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - Component not found: %s"), *ComponentName);
+        UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - Component not found: %s"), *ComponentName);
         return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Component not found: %s"), *ComponentName));
     }
     else
     {
-        UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Component found: %s (Class: %s)"), 
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Component found: %s (Class: %s)"), 
             *ComponentName, 
             ComponentNode->ComponentTemplate ? *ComponentNode->ComponentTemplate->GetClass()->GetName() : TEXT("NULL"));
     }
@@ -365,22 +368,22 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
     UObject* ComponentTemplate = ComponentNode->ComponentTemplate;
     if (!ComponentTemplate)
     {
-        UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - Component template is NULL for %s"), *ComponentName);
+        UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - Component template is NULL for %s"), *ComponentName);
         return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Invalid component template"));
     }
 
     // Check if this is a Spring Arm component and log special debug info
     if (ComponentTemplate->GetClass()->GetName().Contains(TEXT("SpringArm")))
     {
-        UE_LOG(LogTemp, Warning, TEXT("SetComponentProperty - SpringArm component detected! Class: %s"), 
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - SpringArm component detected! Class: %s"), 
             *ComponentTemplate->GetClass()->GetPathName());
             
         // Log all properties of the SpringArm component class
-        UE_LOG(LogTemp, Warning, TEXT("SetComponentProperty - SpringArm properties:"));
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - SpringArm properties:"));
         for (TFieldIterator<FProperty> PropIt(ComponentTemplate->GetClass()); PropIt; ++PropIt)
         {
             FProperty* Prop = *PropIt;
-            UE_LOG(LogTemp, Warning, TEXT("  - %s (%s)"), *Prop->GetName(), *Prop->GetCPPType());
+            UE_LOG(LogUnrealMCP, Verbose, TEXT("  - %s (%s)"), *Prop->GetName(), *Prop->GetCPPType());
         }
 
         // Special handling for Spring Arm properties
@@ -392,7 +395,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
             FProperty* Property = FindFProperty<FProperty>(ComponentTemplate->GetClass(), *PropertyName);
             if (!Property)
             {
-                UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - Property %s not found on SpringArm component"), *PropertyName);
+                UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - Property %s not found on SpringArm component"), *PropertyName);
                 return FUnrealMCPCommonUtils::CreateErrorResponse(
                     FString::Printf(TEXT("Property %s not found on SpringArm component"), *PropertyName));
             }
@@ -426,7 +429,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
                 if (JsonValue->Type == EJson::Number)
                 {
                     const float Value = JsonValue->AsNumber();
-                    UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Setting float property %s to %f"), *PropertyName, Value);
+                    UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Setting float property %s to %f"), *PropertyName, Value);
                     FloatProp->SetPropertyValue_InContainer(ComponentTemplate, Value);
                     bSuccess = true;
                 }
@@ -436,14 +439,14 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
                 if (JsonValue->Type == EJson::Boolean)
                 {
                     const bool Value = JsonValue->AsBool();
-                    UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Setting bool property %s to %d"), *PropertyName, Value);
+                    UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Setting bool property %s to %d"), *PropertyName, Value);
                     BoolProp->SetPropertyValue_InContainer(ComponentTemplate, Value);
                     bSuccess = true;
                 }
             }
             else if (FStructProperty* StructProp = CastField<FStructProperty>(Property))
             {
-                UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Handling struct property %s of type %s"), 
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Handling struct property %s of type %s"), 
                     *PropertyName, *StructProp->Struct->GetName());
                 
                 // Special handling for common Spring Arm struct properties
@@ -488,8 +491,8 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
             if (bSuccess)
             {
                 // Mark the blueprint as modified
-                UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Successfully set SpringArm property %s"), *PropertyName);
-                FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Successfully set SpringArm property %s"), *PropertyName);
+                FUnrealMCPCommonUtils::MarkBlueprintModified(Blueprint);
 
                 TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
                 ResultObj->SetStringField(TEXT("component"), ComponentName);
@@ -499,7 +502,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
             }
             else
             {
-                UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - Failed to set SpringArm property %s"), *PropertyName);
+                UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - Failed to set SpringArm property %s"), *PropertyName);
                 return FUnrealMCPCommonUtils::CreateErrorResponse(
                     FString::Printf(TEXT("Failed to set SpringArm property %s"), *PropertyName));
             }
@@ -517,15 +520,15 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
         FProperty* Property = FindFProperty<FProperty>(ComponentTemplate->GetClass(), *PropertyName);
         if (!Property)
         {
-            UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - Property %s not found on component %s"), 
+            UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - Property %s not found on component %s"), 
                 *PropertyName, *ComponentName);
             
             // List all available properties for this component
-            UE_LOG(LogTemp, Warning, TEXT("SetComponentProperty - Available properties for %s:"), *ComponentName);
+            UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Available properties for %s:"), *ComponentName);
             for (TFieldIterator<FProperty> PropIt(ComponentTemplate->GetClass()); PropIt; ++PropIt)
             {
                 FProperty* Prop = *PropIt;
-                UE_LOG(LogTemp, Warning, TEXT("  - %s (%s)"), *Prop->GetName(), *Prop->GetCPPType());
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("  - %s (%s)"), *Prop->GetName(), *Prop->GetCPPType());
             }
             
             return FUnrealMCPCommonUtils::CreateErrorResponse(
@@ -533,7 +536,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
         }
         else
         {
-            UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Property found: %s (Type: %s)"), 
+            UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Property found: %s (Type: %s)"), 
                 *PropertyName, *Property->GetCPPType());
         }
 
@@ -541,7 +544,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
         FString ErrorMessage;
 
         // Handle different property types
-        UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Attempting to set property %s"), *PropertyName);
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Attempting to set property %s"), *PropertyName);
         
         // Add try-catch block to catch and log any crashes
         try
@@ -549,7 +552,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
             if (FStructProperty* StructProp = CastField<FStructProperty>(Property))
             {
                 // Handle vector properties
-                UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Property is a struct: %s"), 
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Property is a struct: %s"), 
                     StructProp->Struct ? *StructProp->Struct->GetName() : TEXT("NULL"));
                     
                 if (StructProp->Struct == TBaseStructure<FVector>::Get())
@@ -566,7 +569,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
                                 Arr[2]->AsNumber()
                             );
                             void* PropertyAddr = StructProp->ContainerPtrToValuePtr<void>(ComponentTemplate);
-                            UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Setting Vector(%f, %f, %f)"), 
+                            UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Setting Vector(%f, %f, %f)"), 
                                 Vec.X, Vec.Y, Vec.Z);
                             StructProp->CopySingleValue(PropertyAddr, &Vec);
                             bSuccess = true;
@@ -574,7 +577,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
                         else
                         {
                             ErrorMessage = FString::Printf(TEXT("Vector property requires 3 values, got %d"), Arr.Num());
-                            UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - %s"), *ErrorMessage);
+                            UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - %s"), *ErrorMessage);
                         }
                     }
                     else if (JsonValue->Type == EJson::Number)
@@ -583,7 +586,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
                         float Value = JsonValue->AsNumber();
                         FVector Vec(Value, Value, Value);
                         void* PropertyAddr = StructProp->ContainerPtrToValuePtr<void>(ComponentTemplate);
-                        UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Setting Vector(%f, %f, %f) from scalar"), 
+                        UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Setting Vector(%f, %f, %f) from scalar"), 
                             Vec.X, Vec.Y, Vec.Z);
                         StructProp->CopySingleValue(PropertyAddr, &Vec);
                         bSuccess = true;
@@ -591,30 +594,30 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
                     else
                     {
                         ErrorMessage = TEXT("Vector property requires either a single number or array of 3 numbers");
-                        UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - %s"), *ErrorMessage);
+                        UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - %s"), *ErrorMessage);
                     }
                 }
                 else
                 {
                     // Handle other struct properties using default handler
-                    UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Using generic struct handler for %s"), 
+                    UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Using generic struct handler for %s"), 
                         *PropertyName);
                     bSuccess = FUnrealMCPCommonUtils::SetObjectProperty(ComponentTemplate, PropertyName, JsonValue, ErrorMessage);
                     if (!bSuccess)
                     {
-                        UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - Failed to set struct property: %s"), *ErrorMessage);
+                        UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - Failed to set struct property: %s"), *ErrorMessage);
                     }
                 }
             }
             else if (FEnumProperty* EnumProp = CastField<FEnumProperty>(Property))
             {
                 // Handle enum properties
-                UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Property is an enum"));
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Property is an enum"));
                 if (JsonValue->Type == EJson::String)
                 {
                     FString EnumValueName = JsonValue->AsString();
                     UEnum* Enum = EnumProp->GetEnum();
-                    UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Setting enum from string: %s"), *EnumValueName);
+                    UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Setting enum from string: %s"), *EnumValueName);
                     
                     if (Enum)
                     {
@@ -622,7 +625,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
                         
                         if (EnumValue != INDEX_NONE)
                         {
-                            UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Found enum value: %lld"), EnumValue);
+                            UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Found enum value: %lld"), EnumValue);
                             EnumProp->GetUnderlyingProperty()->SetIntPropertyValue(
                                 ComponentTemplate, 
                                 EnumValue
@@ -632,31 +635,31 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
                         else
                         {
                             // List all possible enum values
-                            UE_LOG(LogTemp, Warning, TEXT("SetComponentProperty - Available enum values for %s:"), 
+                            UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Available enum values for %s:"), 
                                 *Enum->GetName());
                             for (int32 i = 0; i < Enum->NumEnums(); i++)
                             {
-                                UE_LOG(LogTemp, Warning, TEXT("  - %s (%lld)"), 
+                                UE_LOG(LogUnrealMCP, Verbose, TEXT("  - %s (%lld)"), 
                                     *Enum->GetNameStringByIndex(i),
                                     Enum->GetValueByIndex(i));
                             }
                             
                             ErrorMessage = FString::Printf(TEXT("Invalid enum value '%s' for property %s"), 
                                 *EnumValueName, *PropertyName);
-                            UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - %s"), *ErrorMessage);
+                            UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - %s"), *ErrorMessage);
                         }
                     }
                     else
                     {
                         ErrorMessage = TEXT("Enum object is NULL");
-                        UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - %s"), *ErrorMessage);
+                        UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - %s"), *ErrorMessage);
                     }
                 }
                 else if (JsonValue->Type == EJson::Number)
                 {
                     // Allow setting enum by integer value
                     int64 EnumValue = JsonValue->AsNumber();
-                    UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Setting enum from number: %lld"), EnumValue);
+                    UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Setting enum from number: %lld"), EnumValue);
                     EnumProp->GetUnderlyingProperty()->SetIntPropertyValue(
                         ComponentTemplate, 
                         EnumValue
@@ -666,60 +669,60 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
                 else
                 {
                     ErrorMessage = TEXT("Enum property requires either a string name or integer value");
-                    UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - %s"), *ErrorMessage);
+                    UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - %s"), *ErrorMessage);
                 }
             }
             else if (FNumericProperty* NumericProp = CastField<FNumericProperty>(Property))
             {
                 // Handle numeric properties
-                UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Property is numeric: IsInteger=%d, IsFloat=%d"), 
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Property is numeric: IsInteger=%d, IsFloat=%d"), 
                     NumericProp->IsInteger(), NumericProp->IsFloatingPoint());
                     
                 if (JsonValue->Type == EJson::Number)
                 {
                     double Value = JsonValue->AsNumber();
-                    UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Setting numeric value: %f"), Value);
+                    UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Setting numeric value: %f"), Value);
                     
                     if (NumericProp->IsInteger())
                     {
                         NumericProp->SetIntPropertyValue(ComponentTemplate, (int64)Value);
-                        UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Set integer value: %lld"), (int64)Value);
+                        UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Set integer value: %lld"), (int64)Value);
                         bSuccess = true;
                     }
                     else if (NumericProp->IsFloatingPoint())
                     {
                         NumericProp->SetFloatingPointPropertyValue(ComponentTemplate, Value);
-                        UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Set float value: %f"), Value);
+                        UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Set float value: %f"), Value);
                         bSuccess = true;
                     }
                 }
                 else
                 {
                     ErrorMessage = TEXT("Numeric property requires a number value");
-                    UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - %s"), *ErrorMessage);
+                    UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - %s"), *ErrorMessage);
                 }
             }
             else
             {
                 // Handle all other property types using default handler
-                UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Using generic property handler for %s (Type: %s)"), 
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Using generic property handler for %s (Type: %s)"), 
                     *PropertyName, *Property->GetCPPType());
                 bSuccess = FUnrealMCPCommonUtils::SetObjectProperty(ComponentTemplate, PropertyName, JsonValue, ErrorMessage);
                 if (!bSuccess)
                 {
-                    UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - Failed to set property: %s"), *ErrorMessage);
+                    UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - Failed to set property: %s"), *ErrorMessage);
                 }
             }
         }
         catch (const std::exception& Ex)
         {
-            UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - EXCEPTION: %s"), ANSI_TO_TCHAR(Ex.what()));
+            UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - EXCEPTION: %s"), ANSI_TO_TCHAR(Ex.what()));
             return FUnrealMCPCommonUtils::CreateErrorResponse(
                 FString::Printf(TEXT("Exception while setting property %s: %s"), *PropertyName, ANSI_TO_TCHAR(Ex.what())));
         }
         catch (...)
         {
-            UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - UNKNOWN EXCEPTION occurred while setting property %s"), *PropertyName);
+            UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - UNKNOWN EXCEPTION occurred while setting property %s"), *PropertyName);
             return FUnrealMCPCommonUtils::CreateErrorResponse(
                 FString::Printf(TEXT("Unknown exception while setting property %s"), *PropertyName));
         }
@@ -727,9 +730,9 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
         if (bSuccess)
         {
             // Mark the blueprint as modified
-            UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Successfully set property %s on component %s"), 
+            UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Successfully set property %s on component %s"), 
                 *PropertyName, *ComponentName);
-            FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+            FUnrealMCPCommonUtils::MarkBlueprintModified(Blueprint);
 
             TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
             ResultObj->SetStringField(TEXT("component"), ComponentName);
@@ -739,13 +742,13 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
         }
         else
         {
-            UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - Failed to set property %s: %s"), 
+            UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - Failed to set property %s: %s"), 
                 *PropertyName, *ErrorMessage);
             return FUnrealMCPCommonUtils::CreateErrorResponse(ErrorMessage);
         }
     }
 
-    UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - Missing 'property_value' parameter"));
+    UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - Missing 'property_value' parameter"));
     return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'property_value' parameter"));
 }
 
@@ -804,7 +807,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetPhysicsProperties(
         float Mass = Params->GetNumberField(TEXT("mass"));
         // In UE5.5, use proper overrideMass instead of just scaling
         PrimComponent->SetMassOverrideInKg(NAME_None, Mass);
-        UE_LOG(LogTemp, Display, TEXT("Set mass for component %s to %f kg"), *ComponentName, Mass);
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("Set mass for component %s to %f kg"), *ComponentName, Mass);
     }
 
     if (Params->HasField(TEXT("linear_damping")))
@@ -818,7 +821,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetPhysicsProperties(
     }
 
     // Mark the blueprint as modified
-    FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+    FUnrealMCPCommonUtils::MarkBlueprintModified(Blueprint);
 
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
     ResultObj->SetStringField(TEXT("component"), ComponentName);
@@ -841,12 +844,14 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleCompileBlueprint(cons
         return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
     }
 
-    // Compile the blueprint
-    FKismetEditorUtilities::CompileBlueprint(Blueprint);
+    // Compile the blueprint (once, at commit, inside an edit batch)
+    const bool bDeferred = FMCPEditBatch::Get() != nullptr;
+    FUnrealMCPCommonUtils::CompileBlueprint(Blueprint);
 
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
     ResultObj->SetStringField(TEXT("name"), BlueprintName);
-    ResultObj->SetBoolField(TEXT("compiled"), true);
+    ResultObj->SetBoolField(TEXT("compiled"), !bDeferred);
+    ResultObj->SetBoolField(TEXT("deferred"), bDeferred);
     return ResultObj;
 }
 
@@ -944,7 +949,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetBlueprintProperty(
         if (FUnrealMCPCommonUtils::SetObjectProperty(DefaultObject, PropertyName, JsonValue, ErrorMessage))
         {
             // Mark the blueprint as modified
-            FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+            FUnrealMCPCommonUtils::MarkBlueprintModified(Blueprint);
 
             TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
             ResultObj->SetStringField(TEXT("property"), PropertyName);
@@ -1026,7 +1031,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetStaticMeshProperti
     }
 
     // Mark the blueprint as modified
-    FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+    FUnrealMCPCommonUtils::MarkBlueprintModified(Blueprint);
 
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
     ResultObj->SetStringField(TEXT("component"), ComponentName);
@@ -1144,7 +1149,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetPawnProperties(con
     // Mark the blueprint as modified if any properties were set
     if (bAnyPropertiesSet)
     {
-        FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+        FUnrealMCPCommonUtils::MarkBlueprintModified(Blueprint);
     }
     else if (ResultsObj->Values.Num() == 0)
     {
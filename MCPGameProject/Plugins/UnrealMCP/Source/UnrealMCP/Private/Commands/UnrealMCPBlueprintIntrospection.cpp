@@ -1,5 +1,10 @@
 #include "Commands/UnrealMCPBlueprintIntrospection.h"
+#include "MCPLog.h"
 #include "Commands/UnrealMCPCommonUtils.h"
+#include "MCPBlueprintChangeTracker.h"
+#include "MCPBlueprintScan.h"
+#include "MCPGraphBinaryExport.h"
+#include "MCPRequestContext.h"
 #include "Engine/Blueprint.h"
 #include "Engine/BlueprintGeneratedClass.h"
 #include "Engine/SimpleConstructionScript.h"
@@ -25,11 +30,41 @@
 #include "K2Node_VariableSet.h"
 #include "K2Node_CustomEvent.h"
 #include "EdGraphSchema_K2.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Crc.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+    // Blueprints whose extracted data is kept in memory
+    const int32 MaxCachedBlueprints = 64;
+    
+    // Sections get_blueprint_data can return
+    const TArray<FString> ValidSections = {
+        TEXT("info"), TEXT("components"), TEXT("variables"), TEXT("functions"), TEXT("event_graphs"),
+        TEXT("custom_events"), TEXT("macros"), TEXT("interfaces")
+    };
+    
+    // Snapshots kept per blueprint for get_blueprint_delta
+    const int32 MaxRevisionLogEntries = 32;
+    
+    // Scans kept at once; finished ones are dropped first to make room
+    const int32 MaxScans = 8;
+    }
 
 FUnrealMCPBlueprintIntrospection::FUnrealMCPBlueprintIntrospection()
 {
 }
 
+FUnrealMCPBlueprintIntrospection::~FUnrealMCPBlueprintIntrospection()
+{
+    for (const TPair<int32, TSharedPtr<FMCPBlueprintScan, ESPMode::ThreadSafe>>& Scan : Scans)
+    {
+        Scan.Value->Cancel();
+    }
+    Scans.Empty();
+}
+
 TSharedPtr<FJsonObject> FUnrealMCPBlueprintIntrospection::HandleCommand(
     const FString& CommandType, 
     const TSharedPtr<FJsonObject>& Params)
@@ -38,6 +73,26 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintIntrospection::HandleCommand(
     {
         return HandleGetBlueprintData(Params);
     }
+    else if (CommandType == TEXT("get_blueprint_delta"))
+    {
+        return HandleGetBlueprintDelta(Params);
+    }
+    else if (CommandType == TEXT("export_graph_binary"))
+    {
+        return HandleExportGraphBinary(Params);
+    }
+    else if (CommandType == TEXT("scan_blueprints"))
+    {
+        return HandleScanBlueprints(Params);
+    }
+    else if (CommandType == TEXT("get_scan_results"))
+    {
+        return HandleGetScanResults(Params);
+    }
+    else if (CommandType == TEXT("cancel_scan"))
+    {
+        return HandleCancelScan(Params);
+    }
     
     return FUnrealMCPCommonUtils::CreateErrorResponse(
         FString::Printf(TEXT("Unknown blueprint introspection command: %s"), *CommandType));
@@ -53,7 +108,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintIntrospection::HandleGetBlueprintData
         return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'blueprint_name' parameter"));
     }
     
-    UE_LOG(LogTemp, Display, TEXT("Getting blueprint data for: %s"), *BlueprintName);
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("Getting blueprint data for: %s"), *BlueprintName);
     
     // Find the blueprint
     UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName);
@@ -63,30 +118,305 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintIntrospection::HandleGetBlueprintData
             FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
     }
     
+    FMCPBlueprintDataRequest Request;
+    FString Error;
+    if (!ParseDataRequest(Params, Request, Error))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+    
+    return BuildBlueprintData(Blueprint, Request);
+}
+
+bool FUnrealMCPBlueprintIntrospection::ParseDataRequest(
+    const TSharedPtr<FJsonObject>& Params, 
+    FMCPBlueprintDataRequest& OutRequest, 
+    FString& OutError)
+{
+    // Sections to return (default: all); "graphs:<name>" selects individual graphs
+    TArray<FString> RequestedSections;
+    FString SectionsString;
+    const TArray<TSharedPtr<FJsonValue>>* SectionsArray = nullptr;
+    if (Params->TryGetArrayField(TEXT("sections"), SectionsArray))
+    {
+        for (const TSharedPtr<FJsonValue>& Value : *SectionsArray)
+        {
+            RequestedSections.Add(Value->AsString());
+        }
+    }
+    else if (Params->TryGetStringField(TEXT("sections"), SectionsString))
+    {
+        SectionsString.ParseIntoArray(RequestedSections, TEXT(","), true);
+    }
+    
+    for (FString Section : RequestedSections)
+    {
+        Section.TrimStartAndEndInline();
+        if (Section.StartsWith(TEXT("graphs:")))
+        {
+            OutRequest.GraphNames.Add(Section.RightChop(7));
+        }
+        else if (ValidSections.Contains(Section))
+        {
+            OutRequest.Sections.Add(Section);
+        }
+        else
+        {
+            OutError = FString::Printf(TEXT("Unknown section '%s'. Valid sections: %s, graphs:<name>"), 
+                *Section, *FString::Join(ValidSections, TEXT(", ")));
+            return false;
+        }
+    }
+    
+    // Graph detail and node paging
+    FString Detail;
+    if (Params->TryGetStringField(TEXT("detail"), Detail))
+    {
+        if (Detail == TEXT("full"))
+        {
+            OutRequest.Query.Detail = EMCPGraphDetail::Full;
+        }
+        else if (Detail == TEXT("pins"))
+        {
+            OutRequest.Query.Detail = EMCPGraphDetail::Pins;
+        }
+        else if (Detail == TEXT("nodes"))
+        {
+            OutRequest.Query.Detail = EMCPGraphDetail::Nodes;
+        }
+        else if (Detail == TEXT("summary"))
+        {
+            OutRequest.Query.Detail = EMCPGraphDetail::Summary;
+        }
+        else
+        {
+            OutError = FString::Printf(TEXT("Unknown detail '%s'. Valid values: full, pins, nodes, summary"), *Detail);
+            return false;
+        }
+    }
+    Params->TryGetNumberField(TEXT("node_offset"), OutRequest.Query.NodeOffset);
+    Params->TryGetNumberField(TEXT("node_limit"), OutRequest.Query.NodeLimit);
+    OutRequest.Query.NodeOffset = FMath::Max(0, OutRequest.Query.NodeOffset);
+    return true;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPBlueprintIntrospection::BuildBlueprintData(
+    UBlueprint* Blueprint, 
+    const FMCPBlueprintDataRequest& Request)
+{
+    // Serve the cached result if nothing in the blueprint changed since it was built
+    FMCPBlueprintChangeTracker& Tracker = GetChangeTracker();
+    Tracker.Track(Blueprint);
+    const uint64 Revision = Tracker.GetBlueprintRevision(Blueprint);
+    
+    const bool bDefaultRequest = Request.IsDefault();
+    FBlueprintDataCache& Cache = FindOrAddCache(Blueprint);
+    if (bDefaultRequest && Cache.Result.IsValid() && Cache.Revision == Revision)
+    {
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("Using cached blueprint data (revision %llu)"), Revision);
+        if (Cache.bDeltaTracked)
+        {
+            RecordSnapshot(Blueprint, Cache);
+        }
+        return Cache.Result;
+    }
+    
     // Create result object
     TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
     Result->SetBoolField(TEXT("success"), true);
+    Result->SetNumberField(TEXT("revision"), (double)Revision);
     
-    // Extract basic Blueprint info
-    TSharedPtr<FJsonObject> InfoObj = ExtractBlueprintInfo(Blueprint);
-    Result->SetObjectField(TEXT("blueprint_info"), InfoObj);
-    
-    // Extract components
-    TArray<TSharedPtr<FJsonValue>> ComponentsArray = ExtractComponents(Blueprint);
-    Result->SetArrayField(TEXT("components"), ComponentsArray);
+    // Info, components and variables only change with the blueprint structure
+    if (Request.WantsSection(TEXT("info")) || Request.WantsSection(TEXT("components")) || Request.WantsSection(TEXT("variables")))
+    {
+        const uint64 StructureRevision = Tracker.GetStructureRevision(Blueprint);
+        if (!Cache.Info.IsValid() || Cache.StructureRevision != StructureRevision)
+        {
+            Cache.Info = ExtractBlueprintInfo(Blueprint);
+            Cache.Components = ExtractComponents(Blueprint);
+            Cache.Variables = ExtractVariables(Blueprint);
+            Cache.StructureRevision = StructureRevision;
+        }
+    }
     
-    // Extract variables
-    TArray<TSharedPtr<FJsonValue>> VariablesArray = ExtractVariables(Blueprint);
-    Result->SetArrayField(TEXT("variables"), VariablesArray);
+    if (Request.WantsSection(TEXT("info")))
+    {
+        Result->SetObjectField(TEXT("blueprint_info"), Cache.Info);
+    }
+    if (Request.WantsSection(TEXT("components")))
+    {
+        Result->SetArrayField(TEXT("components"), Cache.Components);
+    }
+    if (Request.WantsSection(TEXT("variables")))
+    {
+        Result->SetArrayField(TEXT("variables"), Cache.Variables);
+    }
     
     // Extract functions (Phase 4)
-    TArray<TSharedPtr<FJsonValue>> FunctionsArray = ExtractFunctions(Blueprint);
-    Result->SetArrayField(TEXT("functions"), FunctionsArray);
+    if (Request.WantsSection(TEXT("functions")))
+    {
+        Result->SetArrayField(TEXT("functions"), ExtractFunctions(Blueprint, Request.Query));
+    }
     
     // Extract event graphs (Phase 5)
+    if (Request.WantsSection(TEXT("event_graphs")))
+    {
+        Result->SetArrayField(TEXT("event_graphs"), ExtractEventGraphs(Blueprint, Request.Query));
+    }
+    
+    // Extract custom events (Phase 6)
+    if (Request.WantsSection(TEXT("custom_events")))
+    {
+        Result->SetArrayField(TEXT("custom_events"), ExtractCustomEvents(Blueprint));
+    }
+    
+    // Extract macros (Phase 7)
+    if (Request.WantsSection(TEXT("macros")))
+    {
+        Result->SetArrayField(TEXT("macros"), ExtractMacros(Blueprint, Request.Query));
+    }
+    
+    // Extract interfaces (Phase 7)
+    if (Request.WantsSection(TEXT("interfaces")))
+    {
+        Result->SetArrayField(TEXT("interfaces"), ExtractInterfaces(Blueprint));
+    }
+    
+    // Individually requested graphs
+    if (Request.GraphNames.Num() > 0)
+    {
+        FString Error;
+        TArray<TSharedPtr<FJsonValue>> GraphsArray = ExtractNamedGraphs(Blueprint, Request.GraphNames, Request.Query, Error);
+        if (!Error.IsEmpty())
+        {
+            return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+        }
+        Result->SetArrayField(TEXT("graphs"), GraphsArray);
+    }
+    
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("Successfully extracted blueprint data"));
+    
+    if (bDefaultRequest)
+    {
+        Cache.Revision = Revision;
+        Cache.Result = Result;
+    }
+    
+    // Once a client diffs this blueprint, every revision handed out can be a delta base,
+    // whatever sections were asked for. Unchanged graphs reuse the previous snapshot.
+    if (Cache.bDeltaTracked)
+    {
+        RecordSnapshot(Blueprint, Cache);
+    }
+    return Result;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPBlueprintIntrospection::HandleGetBlueprintDelta(
+    const TSharedPtr<FJsonObject>& Params)
+{
+    FString BlueprintName;
+    if (!Params->TryGetStringField(TEXT("blueprint_name"), BlueprintName))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'blueprint_name' parameter"));
+    }
+    
+    double SinceRevisionValue = 0.0;
+    Params->TryGetNumberField(TEXT("since_revision"), SinceRevisionValue);
+    const uint64 SinceRevision = (uint64)FMath::Max(0.0, SinceRevisionValue);
+    
+    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName);
+    if (!Blueprint)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(
+            FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
+    }
+    
+    FMCPBlueprintChangeTracker& Tracker = GetChangeTracker();
+    Tracker.Track(Blueprint);
+    const uint64 Revision = Tracker.GetBlueprintRevision(Blueprint);
+    
+    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetBoolField(TEXT("success"), true);
+    Result->SetNumberField(TEXT("since_revision"), (double)SinceRevision);
+    Result->SetNumberField(TEXT("revision"), (double)Revision);
+    
+    // Find the base before recording, which may drop the oldest log entry.
+    // Revision 0 diffs against an empty blueprint, i.e. returns everything as added.
+    FBlueprintDataCache& Cache = FindOrAddCache(Blueprint);
+    Cache.bDeltaTracked = true;
+    FBlueprintSnapshot Base;
+    if (SinceRevision != 0 && SinceRevision == Revision && (Cache.RevisionLog.Num() == 0 || Cache.RevisionLog.Last().Revision != Revision))
+    {
+        // Nothing changed since the revision the client saw, even if it was handed out
+        // before snapshots were recorded: log the current state as the next base
+        RecordSnapshot(Blueprint, Cache);
+        Result->SetBoolField(TEXT("full_resync_required"), false);
+        Result->SetBoolField(TEXT("structure_changed"), false);
+        Result->SetArrayField(TEXT("graphs"), TArray<TSharedPtr<FJsonValue>>());
+        Result->SetArrayField(TEXT("removed_graphs"), TArray<TSharedPtr<FJsonValue>>());
+        return Result;
+    }
+    if (SinceRevision != 0)
+    {
+        const FBlueprintSnapshot* Logged = Cache.RevisionLog.FindByPredicate([SinceRevision](const FBlueprintSnapshot& Snapshot)
+        {
+            return Snapshot.Revision == SinceRevision;
+        });
+        if (!Logged)
+        {
+            // Too old, evicted, handed out before the first delta query, or never handed out:
+            // the client has to fetch everything again
+            Result->SetBoolField(TEXT("full_resync_required"), true);
+            RecordSnapshot(Blueprint, Cache);
+            return Result;
+        }
+        Base = *Logged;
+    }
+    
+    const FBlueprintSnapshot& Current = RecordSnapshot(Blueprint, Cache);
+    Result->SetBoolField(TEXT("full_resync_required"), false);
+    Result->SetBoolField(TEXT("structure_changed"), SinceRevision == 0 || Base.StructureRevision != Current.StructureRevision);
+    
+    TArray<TSharedPtr<FJsonValue>> GraphsArray;
+    for (const TPair<FObjectKey, TSharedPtr<const FGraphSnapshot>>& Pair : Current.Graphs)
+    {
+        const TSharedPtr<const FGraphSnapshot>* BaseGraph = Base.Graphs.Find(Pair.Key);
+        if (BaseGraph && *BaseGraph == Pair.Value)
+        {
+            // Shared snapshot: the graph did not change
+            continue;
+        }
+        
+        TSharedPtr<FJsonObject> GraphDelta = DiffGraphSnapshots(BaseGraph ? BaseGraph->Get() : nullptr, *Pair.Value);
+        if (GraphDelta.IsValid())
+        {
+            GraphDelta->SetBoolField(TEXT("is_new_graph"), BaseGraph == nullptr);
+            GraphsArray.Add(MakeShared<FJsonValueObject>(GraphDelta));
+        }
+    }
+    Result->SetArrayField(TEXT("graphs"), GraphsArray);
+    
+    TArray<TSharedPtr<FJsonValue>> RemovedGraphsArray;
+    for (const TPair<FObjectKey, TSharedPtr<const FGraphSnapshot>>& Pair : Base.Graphs)
+    {
+        if (!Current.Graphs.Contains(Pair.Key))
+        {
+            RemovedGraphsArray.Add(MakeShared<FJsonValueString>(Pair.Value->Name));
+        }
+    }
+    Result->SetArrayField(TEXT("removed_graphs"), RemovedGraphsArray);
+    
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("Blueprint delta for %s: revision %llu -> %llu, %d graph(s) changed"),
+        *BlueprintName, SinceRevision, Revision, GraphsArray.Num() + RemovedGraphsArray.Num());
+    
+    return Result;
+}
+
+TArray<TSharedPtr<FJsonValue>> FUnrealMCPBlueprintIntrospection::ExtractEventGraphs(UBlueprint* Blueprint, const FMCPGraphQuery& Query)
+{
     TArray<TSharedPtr<FJsonValue>> EventGraphsArray;
     
-    UE_LOG(LogTemp, Warning, TEXT("ExtractEventGraphs: Blueprint=%s, UbergraphPages=%d"), 
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("ExtractEventGraphs: Blueprint=%s, UbergraphPages=%d"), 
         *Blueprint->GetName(), Blueprint->UbergraphPages.Num());
     
     // Main event graph
@@ -94,14 +424,14 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintIntrospection::HandleGetBlueprintData
     {
         if (!Graph) continue;
         
-        UE_LOG(LogTemp, Warning, TEXT("  Event Graph: %s, NumNodes=%d"), 
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("  Event Graph: %s, NumNodes=%d"), 
             *Graph->GetName(), Graph->Nodes.Num());
         
         TSharedPtr<FJsonObject> EventGraphObj = MakeShared<FJsonObject>();
         EventGraphObj->SetStringField(TEXT("name"), Graph->GetName());
         EventGraphObj->SetStringField(TEXT("type"), TEXT("event_graph"));
         
-        TSharedPtr<FJsonObject> GraphData = ExtractGraphData(Graph);
+        TSharedPtr<FJsonObject> GraphData = GetGraphData(Blueprint, Graph, Query);
         if (GraphData.IsValid())
         {
             EventGraphObj->SetObjectField(TEXT("graph"), GraphData);
@@ -122,7 +452,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintIntrospection::HandleGetBlueprintData
                 ConstructionGraphObj->SetStringField(TEXT("name"), TEXT("UserConstructionScript"));
                 ConstructionGraphObj->SetStringField(TEXT("type"), TEXT("construction_script"));
                 
-                TSharedPtr<FJsonObject> GraphData = ExtractGraphData(Graph);
+                TSharedPtr<FJsonObject> GraphData = GetGraphData(Blueprint, Graph, Query);
                 if (GraphData.IsValid())
                 {
                     ConstructionGraphObj->SetObjectField(TEXT("graph"), GraphData);
@@ -134,25 +464,541 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintIntrospection::HandleGetBlueprintData
         }
     }
     
-    Result->SetArrayField(TEXT("event_graphs"), EventGraphsArray);
+    return EventGraphsArray;
+}
+
+TArray<TSharedPtr<FJsonValue>> FUnrealMCPBlueprintIntrospection::ExtractNamedGraphs(
+    UBlueprint* Blueprint, 
+    const TArray<FString>& GraphNames, 
+    const FMCPGraphQuery& Query, 
+    FString& OutError)
+{
+    TArray<TSharedPtr<FJsonValue>> GraphsArray;
     
-    // Extract custom events (Phase 6)
-    TArray<TSharedPtr<FJsonValue>> CustomEventsArray = ExtractCustomEvents(Blueprint);
-    Result->SetArrayField(TEXT("custom_events"), CustomEventsArray);
+    TArray<UEdGraph*> AllGraphs;
+    Blueprint->GetAllGraphs(AllGraphs);
     
-    // Extract macros (Phase 7)
-    TArray<TSharedPtr<FJsonValue>> MacrosArray = ExtractMacros(Blueprint);
-    Result->SetArrayField(TEXT("macros"), MacrosArray);
+    for (const FString& GraphName : GraphNames)
+    {
+        UEdGraph* const* Found = AllGraphs.FindByPredicate([&GraphName](const UEdGraph* Graph)
+        {
+            return Graph && Graph->GetName() == GraphName;
+        });
+        if (!Found)
+        {
+            OutError = FString::Printf(TEXT("Graph not found in blueprint: %s"), *GraphName);
+            return GraphsArray;
+        }
+        
+        UEdGraph* Graph = *Found;
+        TSharedPtr<FJsonObject> GraphObj = MakeShared<FJsonObject>();
+        GraphObj->SetStringField(TEXT("name"), Graph->GetName());
+        GraphObj->SetStringField(TEXT("type"), FUnrealMCPCommonUtils::GetGraphType(Blueprint, Graph));
+        GraphObj->SetObjectField(TEXT("graph"), GetGraphData(Blueprint, Graph, Query));
+        GraphsArray.Add(MakeShared<FJsonValueObject>(GraphObj));
+    }
     
-    // Extract interfaces (Phase 7)
-    TArray<TSharedPtr<FJsonValue>> InterfacesArray = ExtractInterfaces(Blueprint);
-    Result->SetArrayField(TEXT("interfaces"), InterfacesArray);
+    return GraphsArray;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPBlueprintIntrospection::HandleExportGraphBinary(
+    const TSharedPtr<FJsonObject>& Params)
+{
+    FString BlueprintName;
+    if (!Params->TryGetStringField(TEXT("blueprint_name"), BlueprintName))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'blueprint_name' parameter"));
+    }
+    
+    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName);
+    if (!Blueprint)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(
+            FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
+    }
+    
+    // All graphs, or only the named ones
+    TArray<UEdGraph*> AllGraphs;
+    Blueprint->GetAllGraphs(AllGraphs);
+    TArray<UEdGraph*> Graphs;
+    const TArray<TSharedPtr<FJsonValue>>* GraphNames = nullptr;
+    if (Params->TryGetArrayField(TEXT("graphs"), GraphNames) && GraphNames->Num() > 0)
+    {
+        for (const TSharedPtr<FJsonValue>& Value : *GraphNames)
+        {
+            const FString GraphName = Value->AsString();
+            UEdGraph* const* Found = AllGraphs.FindByPredicate([&GraphName](const UEdGraph* Graph)
+            {
+                return Graph && Graph->GetName() == GraphName;
+            });
+            if (!Found)
+            {
+                return FUnrealMCPCommonUtils::CreateErrorResponse(
+                    FString::Printf(TEXT("Graph not found in blueprint: %s"), *GraphName));
+            }
+            Graphs.Add(*Found);
+        }
+    }
+    else
+    {
+        Graphs = AllGraphs;
+    }
+    
+    const double ExportStart = FPlatformTime::Seconds();
+    TArray<uint8> Bytes;
+    const FMCPGraphExportStats Stats = FMCPGraphBinaryExport::Export(Blueprint, Graphs, Bytes);
+    
+    FMCPBlueprintChangeTracker& Tracker = GetChangeTracker();
+    Tracker.Track(Blueprint);
+    
+    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetBoolField(TEXT("success"), true);
+    Result->SetNumberField(TEXT("revision"), (double)Tracker.GetBlueprintRevision(Blueprint));
+    Result->SetStringField(TEXT("format"), TEXT("mcpg"));
+    Result->SetNumberField(TEXT("version"), MCPG_VERSION);
+    Result->SetNumberField(TEXT("graph_count"), Stats.GraphCount);
+    Result->SetNumberField(TEXT("node_count"), Stats.NodeCount);
+    Result->SetNumberField(TEXT("pin_count"), Stats.PinCount);
+    Result->SetNumberField(TEXT("edge_count"), Stats.EdgeCount);
+    Result->SetNumberField(TEXT("string_count"), Stats.StringCount);
+    Result->SetNumberField(TEXT("size_bytes"), Bytes.Num());
+    Result->SetNumberField(TEXT("export_ms"), (FPlatformTime::Seconds() - ExportStart) * 1000.0);
+    Result->SetStringField(TEXT("attachment"), TEXT("graph"));
+    FMCPRequestContext::SetResponseAttachment(MoveTemp(Bytes));
+    return Result;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPBlueprintIntrospection::HandleScanBlueprints(
+    const TSharedPtr<FJsonObject>& Params)
+{
+    FMCPBlueprintScanSettings Settings;
+    
+    // Asset registry filter
+    FString Path;
+    const TArray<TSharedPtr<FJsonValue>>* PathsArray = nullptr;
+    if (Params->TryGetArrayField(TEXT("paths"), PathsArray))
+    {
+        Settings.PackagePaths.Reset();
+        for (const TSharedPtr<FJsonValue>& Value : *PathsArray)
+        {
+            Settings.PackagePaths.Add(FName(*Value->AsString()));
+        }
+    }
+    else if (Params->TryGetStringField(TEXT("path"), Path))
+    {
+        Settings.PackagePaths = { FName(*Path) };
+    }
+    Params->TryGetBoolField(TEXT("recursive"), Settings.bRecursivePaths);
+    Params->TryGetStringField(TEXT("parent_class"), Settings.ParentClass);
+    FString TagName;
+    if (Params->TryGetStringField(TEXT("tag"), TagName))
+    {
+        Settings.TagName = FName(*TagName);
+        Params->TryGetStringField(TEXT("tag_value"), Settings.TagValue);
+    }
+    Params->TryGetNumberField(TEXT("max_blueprints"), Settings.MaxBlueprints);
+    
+    // Pacing
+    double SliceMs = Settings.SliceMs;
+    if (Params->TryGetNumberField(TEXT("slice_ms"), SliceMs))
+    {
+        Settings.SliceMs = FMath::Clamp((float)SliceMs, 1.0f, 100.0f);
+    }
+    
+    // Stream mode pushes results on the requesting connection
+    Params->TryGetBoolField(TEXT("stream"), Settings.bStream);
+    const FMCPRequestContext* Context = FMCPRequestContext::Get();
+    if (Settings.bStream && (!Context || !Context->Connection.IsValid()))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Streaming a scan requires a persistent client connection"));
+    }
+    
+    // Each blueprint is extracted like a get_blueprint_data call with the same sections and detail
+    FMCPBlueprintDataRequest Request;
+    FString Error;
+    if (!ParseDataRequest(Params, Request, Error))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+    
+    // Make room: drop finished scans, oldest first
+    if (Scans.Num() >= MaxScans)
+    {
+        TArray<int32> ScanIds;
+        Scans.GetKeys(ScanIds);
+        ScanIds.Sort();
+        for (int32 ScanId : ScanIds)
+        {
+            if (Scans.Num() < MaxScans)
+            {
+                break;
+            }
+            if (Scans[ScanId]->IsFinished())
+            {
+                Scans.Remove(ScanId);
+            }
+        }
+        if (Scans.Num() >= MaxScans)
+        {
+            return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Too many blueprint scans in progress; cancel one first"));
+        }
+    }
+    
+    const int32 ScanId = NextScanId++;
+    TSharedPtr<FMCPBlueprintScan, ESPMode::ThreadSafe> Scan = MakeShared<FMCPBlueprintScan, ESPMode::ThreadSafe>(
+        ScanId, 
+        Settings, 
+        [this, Request](UBlueprint* Blueprint)
+        {
+            return BuildBlueprintData(Blueprint, Request);
+        },
+        Context ? Context->Connection : nullptr);
+    Scans.Add(ScanId, Scan);
+    Scan->Start();
+    
+    TSharedPtr<FJsonObject> Result = Scan->GetStatus();
+    Result->SetBoolField(TEXT("success"), true);
+    return Result;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPBlueprintIntrospection::HandleGetScanResults(
+    const TSharedPtr<FJsonObject>& Params)
+{
+    FString Error;
+    TSharedPtr<FMCPBlueprintScan, ESPMode::ThreadSafe> Scan = FindScan(Params, Error);
+    if (!Scan.IsValid())
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+    
+    int32 MaxResults = 50;
+    Params->TryGetNumberField(TEXT("max_results"), MaxResults);
+    
+    // Results were serialized on worker threads; they go out as-is in the attachment
+    TArray<uint8> Lines;
+    const int32 Count = Scan->TakeResults(MaxResults, Lines);
+    
+    TSharedPtr<FJsonObject> Result = Scan->GetStatus();
+    Result->SetBoolField(TEXT("success"), true);
+    Result->SetNumberField(TEXT("returned"), Count);
+    Result->SetStringField(TEXT("attachment"), TEXT("ndjson"));
+    Result->SetBoolField(TEXT("has_more"), !Scan->IsDrained());
+    FMCPRequestContext::SetResponseAttachment(MoveTemp(Lines));
     
-    UE_LOG(LogTemp, Display, TEXT("Successfully extracted blueprint data"));
+    if (Scan->IsDrained())
+    {
+        Scans.Remove(Scan->GetScanId());
+    }
+    return Result;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPBlueprintIntrospection::HandleCancelScan(
+    const TSharedPtr<FJsonObject>& Params)
+{
+    FString Error;
+    TSharedPtr<FMCPBlueprintScan, ESPMode::ThreadSafe> Scan = FindScan(Params, Error);
+    if (!Scan.IsValid())
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+    
+    Scan->Cancel();
+    Scans.Remove(Scan->GetScanId());
     
+    TSharedPtr<FJsonObject> Result = Scan->GetStatus();
+    Result->SetBoolField(TEXT("success"), true);
     return Result;
 }
 
+TSharedPtr<FMCPBlueprintScan, ESPMode::ThreadSafe> FUnrealMCPBlueprintIntrospection::FindScan(
+    const TSharedPtr<FJsonObject>& Params, 
+    FString& OutError)
+{
+    int32 ScanId = 0;
+    if (!Params->TryGetNumberField(TEXT("scan_id"), ScanId))
+    {
+        OutError = TEXT("Missing 'scan_id' parameter");
+        return nullptr;
+    }
+    
+    const TSharedPtr<FMCPBlueprintScan, ESPMode::ThreadSafe>* Scan = Scans.Find(ScanId);
+    if (!Scan)
+    {
+        OutError = FString::Printf(TEXT("Blueprint scan not found: %d"), ScanId);
+        return nullptr;
+    }
+    return *Scan;
+}
+
+const FUnrealMCPBlueprintIntrospection::FBlueprintSnapshot& FUnrealMCPBlueprintIntrospection::RecordSnapshot(
+    UBlueprint* Blueprint, 
+    FBlueprintDataCache& Cache)
+{
+    FMCPBlueprintChangeTracker& Tracker = GetChangeTracker();
+    const uint64 Revision = Tracker.GetBlueprintRevision(Blueprint);
+    if (Cache.RevisionLog.Num() > 0 && Cache.RevisionLog.Last().Revision == Revision)
+    {
+        return Cache.RevisionLog.Last();
+    }
+    
+    FBlueprintSnapshot Snapshot;
+    Snapshot.Revision = Revision;
+    Snapshot.StructureRevision = Tracker.GetStructureRevision(Blueprint);
+    
+    // Reuse the previous snapshot of every graph whose revision did not move
+    const FBlueprintSnapshot* Previous = Cache.RevisionLog.Num() > 0 ? &Cache.RevisionLog.Last() : nullptr;
+    TArray<UEdGraph*> Graphs;
+    Blueprint->GetAllGraphs(Graphs);
+    for (UEdGraph* Graph : Graphs)
+    {
+        if (!Graph) continue;
+        
+        const FObjectKey Key(Graph);
+        const uint64 GraphRevision = Tracker.GetGraphRevision(Graph);
+        const TSharedPtr<const FGraphSnapshot>* Existing = Previous ? Previous->Graphs.Find(Key) : nullptr;
+        if (Existing && GraphRevision != 0 && (*Existing)->Revision == GraphRevision)
+        {
+            Snapshot.Graphs.Add(Key, *Existing);
+        }
+        else
+        {
+            Snapshot.Graphs.Add(Key, SnapshotGraph(Blueprint, Graph));
+        }
+    }
+    
+    if (Cache.RevisionLog.Num() >= MaxRevisionLogEntries)
+    {
+        Cache.RevisionLog.RemoveAt(0);
+    }
+    return Cache.RevisionLog.Add_GetRef(MoveTemp(Snapshot));
+}
+
+TSharedPtr<const FUnrealMCPBlueprintIntrospection::FGraphSnapshot> FUnrealMCPBlueprintIntrospection::SnapshotGraph(
+    UBlueprint* Blueprint, 
+    UEdGraph* Graph)
+{
+    TSharedPtr<FGraphSnapshot> Snapshot = MakeShared<FGraphSnapshot>();
+    Snapshot->Name = Graph->GetName();
+    Snapshot->Type = FUnrealMCPCommonUtils::GetGraphType(Blueprint, Graph);
+    Snapshot->Revision = GetChangeTracker().GetGraphRevision(Graph);
+    
+    const TSharedPtr<FJsonObject> GraphData = GetGraphData(Blueprint, Graph, FMCPGraphQuery());
+    
+    const TArray<TSharedPtr<FJsonValue>>* Nodes = nullptr;
+    if (GraphData.IsValid() && GraphData->TryGetArrayField(TEXT("nodes"), Nodes))
+    {
+        for (const TSharedPtr<FJsonValue>& Node : *Nodes)
+        {
+            const TSharedPtr<FJsonObject>& NodeObj = Node->AsObject();
+            const FString NodeId = NodeObj->GetStringField(TEXT("id"));
+            
+            // Fingerprint of everything returned for the node: title, position, pins, defaults
+            FString Serialized;
+            TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Serialized);
+            FJsonSerializer::Serialize(NodeObj.ToSharedRef(), Writer);
+            
+            Snapshot->Nodes.Add(NodeId, Node);
+            Snapshot->NodeHashes.Add(NodeId, FCrc::StrCrc32(*Serialized));
+        }
+    }
+    
+    const TArray<TSharedPtr<FJsonValue>>* Connections = nullptr;
+    if (GraphData.IsValid() && GraphData->TryGetArrayField(TEXT("connections"), Connections))
+    {
+        for (const TSharedPtr<FJsonValue>& Connection : *Connections)
+        {
+            const TSharedPtr<FJsonObject>& ConnObj = Connection->AsObject();
+            Snapshot->Connections.Add(
+                ConnObj->GetStringField(TEXT("from_pin")) + TEXT(">") + ConnObj->GetStringField(TEXT("to_pin")),
+                Connection);
+        }
+    }
+    
+    return Snapshot;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPBlueprintIntrospection::DiffGraphSnapshots(const FGraphSnapshot* Base, const FGraphSnapshot& Current)
+{
+    TArray<TSharedPtr<FJsonValue>> AddedNodes;
+    TArray<TSharedPtr<FJsonValue>> ModifiedNodes;
+    TArray<TSharedPtr<FJsonValue>> RemovedNodes;
+    TArray<TSharedPtr<FJsonValue>> AddedConnections;
+    TArray<TSharedPtr<FJsonValue>> RemovedConnections;
+    
+    for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Current.Nodes)
+    {
+        const uint32* BaseHash = Base ? Base->NodeHashes.Find(Pair.Key) : nullptr;
+        if (!BaseHash)
+        {
+            AddedNodes.Add(Pair.Value);
+        }
+        else if (*BaseHash != Current.NodeHashes.FindChecked(Pair.Key))
+        {
+            ModifiedNodes.Add(Pair.Value);
+        }
+    }
+    
+    for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Current.Connections)
+    {
+        if (!Base || !Base->Connections.Contains(Pair.Key))
+        {
+            AddedConnections.Add(Pair.Value);
+        }
+    }
+    
+    if (Base)
+    {
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Base->Nodes)
+        {
+            if (!Current.Nodes.Contains(Pair.Key))
+            {
+                RemovedNodes.Add(MakeShared<FJsonValueString>(Pair.Key));
+            }
+        }
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Base->Connections)
+        {
+            if (!Current.Connections.Contains(Pair.Key))
+            {
+                RemovedConnections.Add(Pair.Value);
+            }
+        }
+    }
+    
+    // Revision bumps without a visible change (e.g. Modify() with no edit) produce no delta
+    if (Base && AddedNodes.Num() == 0 && ModifiedNodes.Num() == 0 && RemovedNodes.Num() == 0 
+        && AddedConnections.Num() == 0 && RemovedConnections.Num() == 0)
+    {
+        return nullptr;
+    }
+    
+    TSharedPtr<FJsonObject> DeltaObj = MakeShared<FJsonObject>();
+    DeltaObj->SetStringField(TEXT("name"), Current.Name);
+    DeltaObj->SetStringField(TEXT("type"), Current.Type);
+    DeltaObj->SetArrayField(TEXT("added_nodes"), AddedNodes);
+    DeltaObj->SetArrayField(TEXT("modified_nodes"), ModifiedNodes);
+    DeltaObj->SetArrayField(TEXT("removed_nodes"), RemovedNodes);
+    DeltaObj->SetArrayField(TEXT("added_connections"), AddedConnections);
+    DeltaObj->SetArrayField(TEXT("removed_connections"), RemovedConnections);
+    return DeltaObj;
+}
+
+FMCPBlueprintChangeTracker& FUnrealMCPBlueprintIntrospection::GetChangeTracker()
+{
+    if (!ChangeTracker.IsValid())
+    {
+        ChangeTracker = MakeUnique<FMCPBlueprintChangeTracker>();
+    }
+    return *ChangeTracker;
+}
+
+FUnrealMCPBlueprintIntrospection::FBlueprintDataCache& FUnrealMCPBlueprintIntrospection::FindOrAddCache(UBlueprint* Blueprint)
+{
+    const FObjectKey Key(Blueprint);
+    if (!BlueprintCache.Contains(Key) && BlueprintCache.Num() >= MaxCachedBlueprints)
+    {
+        // Drop entries for unloaded blueprints, then the least recently used one
+        for (auto It = BlueprintCache.CreateIterator(); It; ++It)
+        {
+            if (!It->Key.ResolveObjectPtr())
+            {
+                It.RemoveCurrent();
+            }
+        }
+        if (BlueprintCache.Num() >= MaxCachedBlueprints)
+        {
+            FObjectKey OldestKey;
+            double OldestTime = TNumericLimits<double>::Max();
+            for (const TPair<FObjectKey, FBlueprintDataCache>& Pair : BlueprintCache)
+            {
+                if (Pair.Value.LastUsedTime < OldestTime)
+                {
+                    OldestTime = Pair.Value.LastUsedTime;
+                    OldestKey = Pair.Key;
+                }
+            }
+            BlueprintCache.Remove(OldestKey);
+        }
+        GetChangeTracker().PruneStale();
+    }
+    
+    FBlueprintDataCache& Cache = BlueprintCache.FindOrAdd(Key);
+    Cache.LastUsedTime = FPlatformTime::Seconds();
+    return Cache;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPBlueprintIntrospection::GetGraphData(UBlueprint* Blueprint, UEdGraph* Graph, const FMCPGraphQuery& Query)
+{
+    FBlueprintDataCache* Cache = BlueprintCache.Find(FObjectKey(Blueprint));
+    const uint64 Revision = GetChangeTracker().GetGraphRevision(Graph);
+    
+    TSharedPtr<FJsonObject> GraphData;
+    if (!Cache || Revision == 0)
+    {
+        // Untracked graph (e.g. added since tracking started): always extract
+        GraphData = ExtractGraphData(Graph, Query.Detail);
+    }
+    else
+    {
+        FGraphDataCache& GraphCache = Cache->Graphs.FindOrAdd(FObjectKey(Graph));
+        const int32 Level = (int32)Query.Detail;
+        if (!GraphCache.Data[Level].IsValid() || GraphCache.Revision[Level] != Revision)
+        {
+            GraphCache.Data[Level] = ExtractGraphData(Graph, Query.Detail);
+            GraphCache.Revision[Level] = Revision;
+        }
+        GraphData = GraphCache.Data[Level];
+    }
+    
+    return Query.IsPaged() ? PageGraphData(GraphData, Query) : GraphData;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPBlueprintIntrospection::PageGraphData(const TSharedPtr<FJsonObject>& GraphData, const FMCPGraphQuery& Query)
+{
+    const TArray<TSharedPtr<FJsonValue>>* Nodes = nullptr;
+    const TArray<TSharedPtr<FJsonValue>>* Connections = nullptr;
+    if (!GraphData.IsValid() || !GraphData->TryGetArrayField(TEXT("nodes"), Nodes))
+    {
+        // Summary detail has no node list to page
+        return GraphData;
+    }
+    
+    const int32 TotalNodes = Nodes->Num();
+    const int32 First = FMath::Min(Query.NodeOffset, TotalNodes);
+    const int32 Last = Query.NodeLimit > 0 ? FMath::Min(First + Query.NodeLimit, TotalNodes) : TotalNodes;
+    
+    TSharedPtr<FJsonObject> PagedObj = MakeShared<FJsonObject>(*GraphData);
+    TArray<TSharedPtr<FJsonValue>> PagedNodes;
+    TSet<FString> PagedNodeIds;
+    for (int32 Index = First; Index < Last; ++Index)
+    {
+        PagedNodes.Add((*Nodes)[Index]);
+        PagedNodeIds.Add((*Nodes)[Index]->AsObject()->GetStringField(TEXT("id")));
+    }
+    PagedObj->SetArrayField(TEXT("nodes"), PagedNodes);
+    
+    // Keep connections with at least one end in this page
+    if (GraphData->TryGetArrayField(TEXT("connections"), Connections))
+    {
+        TArray<TSharedPtr<FJsonValue>> PagedConnections;
+        for (const TSharedPtr<FJsonValue>& Connection : *Connections)
+        {
+            const TSharedPtr<FJsonObject>& ConnObj = Connection->AsObject();
+            if (PagedNodeIds.Contains(ConnObj->GetStringField(TEXT("from_node"))) ||
+                PagedNodeIds.Contains(ConnObj->GetStringField(TEXT("to_node"))))
+            {
+                PagedConnections.Add(Connection);
+            }
+        }
+        PagedObj->SetArrayField(TEXT("connections"), PagedConnections);
+    }
+    
+    PagedObj->SetNumberField(TEXT("total_nodes"), TotalNodes);
+    PagedObj->SetNumberField(TEXT("node_offset"), First);
+    PagedObj->SetNumberField(TEXT("returned_nodes"), Last - First);
+    PagedObj->SetBoolField(TEXT("has_more"), Last < TotalNodes);
+    return PagedObj;
+}
+
 TSharedPtr<FJsonObject> FUnrealMCPBlueprintIntrospection::ExtractBlueprintInfo(UBlueprint* Blueprint)
 {
     TSharedPtr<FJsonObject> InfoObj = MakeShared<FJsonObject>();
@@ -219,13 +1065,13 @@ TArray<TSharedPtr<FJsonValue>> FUnrealMCPBlueprintIntrospection::ExtractComponen
     USimpleConstructionScript* SCS = Blueprint->SimpleConstructionScript;
     if (!SCS)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Blueprint has no SimpleConstructionScript"));
+        UE_LOG(LogUnrealMCP, Warning, TEXT("Blueprint has no SimpleConstructionScript"));
         return ComponentsArray;
     }
     
     // Iterate through all nodes
     const TArray<USCS_Node*>& AllNodes = SCS->GetAllNodes();
-    UE_LOG(LogTemp, Display, TEXT("Found %d components in blueprint"), AllNodes.Num());
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("Found %d components in blueprint"), AllNodes.Num());
     
     for (USCS_Node* Node : AllNodes)
     {
@@ -350,7 +1196,7 @@ TArray<TSharedPtr<FJsonValue>> FUnrealMCPBlueprintIntrospection::ExtractVariable
 {
     TArray<TSharedPtr<FJsonValue>> VariablesArray;
     
-    UE_LOG(LogTemp, Display, TEXT("Found %d variables in blueprint"), Blueprint->NewVariables.Num());
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("Found %d variables in blueprint"), Blueprint->NewVariables.Num());
     
     for (const FBPVariableDescription& VarDesc : Blueprint->NewVariables)
     {
@@ -476,7 +1322,7 @@ TArray<TSharedPtr<FJsonValue>> FUnrealMCPBlueprintIntrospection::ExtractVariable
     return VariablesArray;
 }
 
-TArray<TSharedPtr<FJsonValue>> FUnrealMCPBlueprintIntrospection::ExtractFunctions(UBlueprint* Blueprint)
+TArray<TSharedPtr<FJsonValue>> FUnrealMCPBlueprintIntrospection::ExtractFunctions(UBlueprint* Blueprint, const FMCPGraphQuery& Query)
 {
     TArray<TSharedPtr<FJsonValue>> FunctionsArray;
     
@@ -489,7 +1335,7 @@ TArray<TSharedPtr<FJsonValue>> FUnrealMCPBlueprintIntrospection::ExtractFunction
     TArray<UEdGraph*> AllGraphs;
     Blueprint->GetAllGraphs(AllGraphs);
     
-    UE_LOG(LogTemp, Warning, TEXT("ExtractFunctions: Blueprint=%s, Total Graphs=%d"), 
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("ExtractFunctions: Blueprint=%s, Total Graphs=%d"), 
         *Blueprint->GetName(), AllGraphs.Num());
     
     for (UEdGraph* Graph : AllGraphs)
@@ -499,7 +1345,7 @@ TArray<TSharedPtr<FJsonValue>> FUnrealMCPBlueprintIntrospection::ExtractFunction
             continue;
         }
         
-        UE_LOG(LogTemp, Warning, TEXT("  Processing Graph: %s, Schema=%s, NumNodes=%d, Outer=%s"), 
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("  Processing Graph: %s, Schema=%s, NumNodes=%d, Outer=%s"), 
             *Graph->GetName(), 
             Graph->Schema ? *Graph->Schema->GetName() : TEXT("NULL"),
             Graph->Nodes.Num(),
@@ -511,7 +1357,7 @@ TArray<TSharedPtr<FJsonValue>> FUnrealMCPBlueprintIntrospection::ExtractFunction
         {
             if (Graph == UberGraph)
             {
-                UE_LOG(LogTemp, Warning, TEXT("    -> SKIPPING: This is an Event Graph (UbergraphPage)"));
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("    -> SKIPPING: This is an Event Graph (UbergraphPage)"));
                 bIsEventGraph = true;
                 break;
             }
@@ -536,11 +1382,11 @@ TArray<TSharedPtr<FJsonValue>> FUnrealMCPBlueprintIntrospection::ExtractFunction
         // Skip if not a function graph
         if (!EntryNode)
         {
-            UE_LOG(LogTemp, Warning, TEXT("    -> SKIPPING: No FunctionEntry node found"));
+            UE_LOG(LogUnrealMCP, Verbose, TEXT("    -> SKIPPING: No FunctionEntry node found"));
             continue;
         }
         
-        UE_LOG(LogTemp, Warning, TEXT("    -> EXTRACTING: Function with %d nodes"), Graph->Nodes.Num());
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("    -> EXTRACTING: Function with %d nodes"), Graph->Nodes.Num());
         
         TSharedPtr<FJsonObject> FuncObj = MakeShared<FJsonObject>();
         
@@ -667,7 +1513,7 @@ TArray<TSharedPtr<FJsonValue>> FUnrealMCPBlueprintIntrospection::ExtractFunction
         FuncObj->SetArrayField(TEXT("local_variables"), LocalVarsArray);
         
         // Extract full graph data (nodes and connections)
-        TSharedPtr<FJsonObject> GraphData = ExtractGraphData(Graph);
+        TSharedPtr<FJsonObject> GraphData = GetGraphData(Blueprint, Graph, Query);
         if (GraphData.IsValid())
         {
             FuncObj->SetObjectField(TEXT("graph"), GraphData);
@@ -676,12 +1522,12 @@ TArray<TSharedPtr<FJsonValue>> FUnrealMCPBlueprintIntrospection::ExtractFunction
         FunctionsArray.Add(MakeShared<FJsonValueObject>(FuncObj));
     }
     
-    UE_LOG(LogTemp, Display, TEXT("Extracted %d functions"), FunctionsArray.Num());
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("Extracted %d functions"), FunctionsArray.Num());
     
     return FunctionsArray;
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPBlueprintIntrospection::ExtractGraphData(UEdGraph* Graph)
+TSharedPtr<FJsonObject> FUnrealMCPBlueprintIntrospection::ExtractGraphData(UEdGraph* Graph, EMCPGraphDetail Detail)
 {
     TSharedPtr<FJsonObject> GraphObj = MakeShared<FJsonObject>();
     
@@ -690,6 +1536,27 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintIntrospection::ExtractGraphData(UEdGr
         return GraphObj;
     }
     
+    // Summary: counts only
+    if (Detail == EMCPGraphDetail::Summary)
+    {
+        int32 ConnectionCount = 0;
+        for (UEdGraphNode* Node : Graph->Nodes)
+        {
+            if (!Node) continue;
+            
+            for (UEdGraphPin* Pin : Node->Pins)
+            {
+                if (Pin && Pin->Direction == EGPD_Output)
+                {
+                    ConnectionCount += Pin->LinkedTo.Num();
+                }
+            }
+        }
+        GraphObj->SetNumberField(TEXT("node_count"), Graph->Nodes.Num());
+        GraphObj->SetNumberField(TEXT("connection_count"), ConnectionCount);
+        return GraphObj;
+    }
+    
     // Extract all nodes
     TArray<TSharedPtr<FJsonValue>> NodesArray;
     TMap<FGuid, int32> NodeGuidToIndex;  // For connection references
@@ -754,7 +1621,14 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintIntrospection::ExtractGraphData(UEdGr
             NodeObj->SetStringField(TEXT("node_category"), TEXT("other"));
         }
         
-        // Extract pins
+        // Extract pins (skipped at "nodes" detail)
+        if (Detail == EMCPGraphDetail::Nodes)
+        {
+            NodesArray.Add(MakeShared<FJsonValueObject>(NodeObj));
+            NodeGuidToIndex.Add(Node->NodeGuid, NodeIndex++);
+            continue;
+        }
+        
         TArray<TSharedPtr<FJsonValue>> PinsArray;
         for (UEdGraphPin* Pin : Node->Pins)
         {
@@ -781,8 +1655,8 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintIntrospection::ExtractGraphData(UEdGr
                     Pin->PinType.PinSubCategoryObject->GetName());
             }
             
-            // Default value for input pins
-            if (!Pin->DefaultValue.IsEmpty())
+            // Default value for input pins (full detail only)
+            if (Detail == EMCPGraphDetail::Full && !Pin->DefaultValue.IsEmpty())
             {
                 PinObj->SetStringField(TEXT("default_value"), Pin->DefaultValue);
             }
@@ -855,7 +1729,7 @@ TArray<TSharedPtr<FJsonValue>> FUnrealMCPBlueprintIntrospection::ExtractCustomEv
         return CustomEventsArray;
     }
     
-    UE_LOG(LogTemp, Display, TEXT("Extracting custom events from Blueprint: %s"), *Blueprint->GetName());
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("Extracting custom events from Blueprint: %s"), *Blueprint->GetName());
     
     // Check all event graphs for custom events
     for (UEdGraph* Graph : Blueprint->UbergraphPages)
@@ -953,18 +1827,18 @@ TArray<TSharedPtr<FJsonValue>> FUnrealMCPBlueprintIntrospection::ExtractCustomEv
             
             CustomEventsArray.Add(MakeShared<FJsonValueObject>(EventObj));
             
-            UE_LOG(LogTemp, Display, TEXT("  Found custom event: %s with %d inputs"), 
+            UE_LOG(LogUnrealMCP, Verbose, TEXT("  Found custom event: %s with %d inputs"), 
                 *CustomEvent->CustomFunctionName.ToString(), InputsArray.Num());
         }
     }
     
-    UE_LOG(LogTemp, Display, TEXT("Total custom events found: %d"), CustomEventsArray.Num());
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("Total custom events found: %d"), CustomEventsArray.Num());
     
     return CustomEventsArray;
 }
 
 // Phase 7: Extract macro definitions
-TArray<TSharedPtr<FJsonValue>> FUnrealMCPBlueprintIntrospection::ExtractMacros(UBlueprint* Blueprint)
+TArray<TSharedPtr<FJsonValue>> FUnrealMCPBlueprintIntrospection::ExtractMacros(UBlueprint* Blueprint, const FMCPGraphQuery& Query)
 {
     TArray<TSharedPtr<FJsonValue>> MacrosArray;
     
@@ -973,7 +1847,7 @@ TArray<TSharedPtr<FJsonValue>> FUnrealMCPBlueprintIntrospection::ExtractMacros(U
         return MacrosArray;
     }
     
-    UE_LOG(LogTemp, Display, TEXT("Extracting macros from Blueprint: %s"), *Blueprint->GetName());
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("Extracting macros from Blueprint: %s"), *Blueprint->GetName());
     
     // Macros are stored in MacroGraphs array
     for (UEdGraph* Graph : Blueprint->MacroGraphs)
@@ -1047,7 +1921,7 @@ TArray<TSharedPtr<FJsonValue>> FUnrealMCPBlueprintIntrospection::ExtractMacros(U
         MacroObj->SetStringField(TEXT("description"), TEXT(""));  // TODO: Find where this is stored
         
         // Extract full graph structure
-        TSharedPtr<FJsonObject> GraphData = ExtractGraphData(Graph);
+        TSharedPtr<FJsonObject> GraphData = GetGraphData(Blueprint, Graph, Query);
         if (GraphData.IsValid())
         {
             MacroObj->SetObjectField(TEXT("graph"), GraphData);
@@ -1055,11 +1929,11 @@ TArray<TSharedPtr<FJsonValue>> FUnrealMCPBlueprintIntrospection::ExtractMacros(U
         
         MacrosArray.Add(MakeShared<FJsonValueObject>(MacroObj));
         
-        UE_LOG(LogTemp, Display, TEXT("  Found macro: %s with %d inputs, %d outputs"), 
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("  Found macro: %s with %d inputs, %d outputs"), 
             *Graph->GetName(), InputsArray.Num(), OutputsArray.Num());
     }
     
-    UE_LOG(LogTemp, Display, TEXT("Total macros found: %d"), MacrosArray.Num());
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("Total macros found: %d"), MacrosArray.Num());
     
     return MacrosArray;
 }
@@ -1074,7 +1948,7 @@ TArray<TSharedPtr<FJsonValue>> FUnrealMCPBlueprintIntrospection::ExtractInterfac
         return InterfacesArray;
     }
     
-    UE_LOG(LogTemp, Display, TEXT("Extracting interfaces from Blueprint: %s"), *Blueprint->GetName());
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("Extracting interfaces from Blueprint: %s"), *Blueprint->GetName());
     
     // Extract implemented interfaces
     for (const FBPInterfaceDescription& InterfaceDesc : Blueprint->ImplementedInterfaces)
@@ -1104,11 +1978,11 @@ TArray<TSharedPtr<FJsonValue>> FUnrealMCPBlueprintIntrospection::ExtractInterfac
         
         InterfacesArray.Add(MakeShared<FJsonValueObject>(InterfaceObj));
         
-        UE_LOG(LogTemp, Display, TEXT("  Found interface: %s with %d functions"), 
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("  Found interface: %s with %d functions"), 
             *InterfaceDesc.Interface->GetName(), GraphsArray.Num());
     }
     
-    UE_LOG(LogTemp, Display, TEXT("Total interfaces found: %d"), InterfacesArray.Num());
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("Total interfaces found: %d"), InterfacesArray.Num());
     
     return InterfacesArray;
 }
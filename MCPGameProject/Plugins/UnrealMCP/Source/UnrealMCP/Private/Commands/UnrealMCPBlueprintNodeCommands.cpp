@@ -1,4 +1,5 @@
 #include "Commands/UnrealMCPBlueprintNodeCommands.h"
+#include "MCPLog.h"
 #include "Commands/UnrealMCPCommonUtils.h"
 #include "Engine/Blueprint.h"
 #include "Engine/BlueprintGeneratedClass.h"
@@ -17,9 +18,6 @@
 #include "Kismet/GameplayStatics.h"
 #include "EdGraphSchema_K2.h"
 
-// Declare the log category
-DEFINE_LOG_CATEGORY_STATIC(LogUnrealMCP, Log, All);
-
 FUnrealMCPBlueprintNodeCommands::FUnrealMCPBlueprintNodeCommands()
 {
 }
@@ -133,7 +131,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleConnectBlueprintN
     if (FUnrealMCPCommonUtils::ConnectGraphNodes(EventGraph, SourceNode, SourcePinName, TargetNode, TargetPinName))
     {
         // Mark the blueprint as modified
-        FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+        FUnrealMCPCommonUtils::MarkBlueprintModified(Blueprint);
 
         TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
         ResultObj->SetStringField(TEXT("source_node_id"), SourceNodeId);
@@ -198,6 +196,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintGetSe
     GetComponentNode->NodePosY = NodePosition.Y;
     
     // Add to graph
+    EventGraph->Modify();
     EventGraph->AddNode(GetComponentNode);
     GetComponentNode->CreateNewGuid();
     GetComponentNode->PostPlacedNewNode();
@@ -207,7 +206,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintGetSe
     GetComponentNode->ReconstructNode();
     
     // Mark the blueprint as modified
-    FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+    FUnrealMCPCommonUtils::MarkBlueprintModified(Blueprint);
 
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
     ResultObj->SetStringField(TEXT("node_id"), GetComponentNode->NodeGuid.ToString());
@@ -258,7 +257,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintEvent
     }
 
     // Mark the blueprint as modified
-    FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+    FUnrealMCPCommonUtils::MarkBlueprintModified(Blueprint);
 
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
     ResultObj->SetStringField(TEXT("node_id"), EventNode->NodeGuid.ToString());
@@ -310,7 +309,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
     UK2Node_CallFunction* FunctionNode = nullptr;
     
     // Add extensive logging for debugging
-    UE_LOG(LogTemp, Display, TEXT("Looking for function '%s' in target '%s'"), 
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("Looking for function '%s' in target '%s'"), 
            *FunctionName, Target.IsEmpty() ? TEXT("Blueprint") : *Target);
     
     // Check if we have a target class specified
@@ -321,7 +320,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
         
         // First try without a prefix
         TargetClass = FindObject<UClass>(ANY_PACKAGE, *Target);
-        UE_LOG(LogTemp, Display, TEXT("Tried to find class '%s': %s"), 
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("Tried to find class '%s': %s"), 
                *Target, TargetClass ? TEXT("Found") : TEXT("Not found"));
         
         // If not found, try with U prefix (common convention for UE classes)
@@ -329,7 +328,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
         {
             FString TargetWithPrefix = FString(TEXT("U")) + Target;
             TargetClass = FindObject<UClass>(ANY_PACKAGE, *TargetWithPrefix);
-            UE_LOG(LogTemp, Display, TEXT("Tried to find class '%s': %s"), 
+            UE_LOG(LogUnrealMCP, Verbose, TEXT("Tried to find class '%s': %s"), 
                    *TargetWithPrefix, TargetClass ? TEXT("Found") : TEXT("Not found"));
         }
         
@@ -346,7 +345,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                 TargetClass = FindObject<UClass>(ANY_PACKAGE, *ClassName);
                 if (TargetClass)
                 {
-                    UE_LOG(LogTemp, Display, TEXT("Found class using alternative name '%s'"), *ClassName);
+                    UE_LOG(LogUnrealMCP, Verbose, TEXT("Found class using alternative name '%s'"), *ClassName);
                     break;
                 }
             }
@@ -361,7 +360,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
             {
                 // Try loading it from its known package
                 TargetClass = LoadObject<UClass>(nullptr, TEXT("/Script/Engine.GameplayStatics"));
-                UE_LOG(LogTemp, Display, TEXT("Explicitly loading GameplayStatics: %s"), 
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("Explicitly loading GameplayStatics: %s"), 
                        TargetClass ? TEXT("Success") : TEXT("Failed"));
             }
         }
@@ -369,7 +368,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
         // If we found a target class, look for the function there
         if (TargetClass)
         {
-            UE_LOG(LogTemp, Display, TEXT("Looking for function '%s' in class '%s'"), 
+            UE_LOG(LogUnrealMCP, Verbose, TEXT("Looking for function '%s' in class '%s'"), 
                    *FunctionName, *TargetClass->GetName());
                    
             // First try exact name
@@ -379,7 +378,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
             UClass* CurrentClass = TargetClass;
             while (!Function && CurrentClass)
             {
-                UE_LOG(LogTemp, Display, TEXT("Searching in class: %s"), *CurrentClass->GetName());
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("Searching in class: %s"), *CurrentClass->GetName());
                 
                 // Try exact match
                 Function = CurrentClass->FindFunctionByName(*FunctionName);
@@ -390,11 +389,11 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                     for (TFieldIterator<UFunction> FuncIt(CurrentClass); FuncIt; ++FuncIt)
                     {
                         UFunction* AvailableFunc = *FuncIt;
-                        UE_LOG(LogTemp, Display, TEXT("  - Available function: %s"), *AvailableFunc->GetName());
+                        UE_LOG(LogUnrealMCP, Verbose, TEXT("  - Available function: %s"), *AvailableFunc->GetName());
                         
                         if (AvailableFunc->GetName().Equals(FunctionName, ESearchCase::IgnoreCase))
                         {
-                            UE_LOG(LogTemp, Display, TEXT("  - Found case-insensitive match: %s"), *AvailableFunc->GetName());
+                            UE_LOG(LogUnrealMCP, Verbose, TEXT("  - Found case-insensitive match: %s"), *AvailableFunc->GetName());
                             Function = AvailableFunc;
                             break;
                         }
@@ -411,7 +410,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                 if (TargetClass->GetName() == TEXT("GameplayStatics") && 
                     (FunctionName == TEXT("GetActorOfClass") || FunctionName.Equals(TEXT("GetActorOfClass"), ESearchCase::IgnoreCase)))
                 {
-                    UE_LOG(LogTemp, Display, TEXT("Using special case handling for GameplayStatics::GetActorOfClass"));
+                    UE_LOG(LogUnrealMCP, Verbose, TEXT("Using special case handling for GameplayStatics::GetActorOfClass"));
                     
                     // Create the function node directly
                     FunctionNode = NewObject<UK2Node_CallFunction>(EventGraph);
@@ -425,17 +424,18 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                         
                         FunctionNode->NodePosX = NodePosition.X;
                         FunctionNode->NodePosY = NodePosition.Y;
+                        EventGraph->Modify();
                         EventGraph->AddNode(FunctionNode);
                         FunctionNode->CreateNewGuid();
                         FunctionNode->PostPlacedNewNode();
                         FunctionNode->AllocateDefaultPins();
                         
-                        UE_LOG(LogTemp, Display, TEXT("Created GetActorOfClass node directly"));
+                        UE_LOG(LogUnrealMCP, Verbose, TEXT("Created GetActorOfClass node directly"));
                         
                         // List all pins
                         for (UEdGraphPin* Pin : FunctionNode->Pins)
                         {
-                            UE_LOG(LogTemp, Display, TEXT("  - Pin: %s, Direction: %d, Category: %s"), 
+                            UE_LOG(LogUnrealMCP, Verbose, TEXT("  - Pin: %s, Direction: %d, Category: %s"), 
                                    *Pin->PinName.ToString(), (int32)Pin->Direction, *Pin->PinType.PinCategory.ToString());
                         }
                     }
@@ -447,7 +447,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
     // If we still haven't found the function, try in the blueprint's class
     if (!Function && !FunctionNode)
     {
-        UE_LOG(LogTemp, Display, TEXT("Trying to find function in blueprint class"));
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("Trying to find function in blueprint class"));
         Function = Blueprint->GeneratedClass->FindFunctionByName(*FunctionName);
     }
     
@@ -478,12 +478,12 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                 UEdGraphPin* ParamPin = FUnrealMCPCommonUtils::FindPin(FunctionNode, ParamName, EGPD_Input);
                 if (ParamPin)
                 {
-                    UE_LOG(LogTemp, Display, TEXT("Found parameter pin '%s' of category '%s'"), 
+                    UE_LOG(LogUnrealMCP, Verbose, TEXT("Found parameter pin '%s' of category '%s'"), 
                            *ParamName, *ParamPin->PinType.PinCategory.ToString());
-                    UE_LOG(LogTemp, Display, TEXT("  Current default value: '%s'"), *ParamPin->DefaultValue);
+                    UE_LOG(LogUnrealMCP, Verbose, TEXT("  Current default value: '%s'"), *ParamPin->DefaultValue);
                     if (ParamPin->PinType.PinSubCategoryObject.IsValid())
                     {
-                        UE_LOG(LogTemp, Display, TEXT("  Pin subcategory: '%s'"), 
+                        UE_LOG(LogUnrealMCP, Verbose, TEXT("  Pin subcategory: '%s'"), 
                                *ParamPin->PinType.PinSubCategoryObject->GetName());
                     }
                     
@@ -491,7 +491,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                     if (ParamValue->Type == EJson::String)
                     {
                         FString StringVal = ParamValue->AsString();
-                        UE_LOG(LogTemp, Display, TEXT("  Setting string parameter '%s' to: '%s'"), 
+                        UE_LOG(LogUnrealMCP, Verbose, TEXT("  Setting string parameter '%s' to: '%s'"), 
                                *ParamName, *StringVal);
                         
                         // Handle class reference parameters (e.g., ActorClass in GetActorOfClass)
@@ -508,7 +508,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                             if (!Class)
                             {
                                 Class = LoadObject<UClass>(nullptr, *ClassName);
-                                UE_LOG(LogUnrealMCP, Display, TEXT("FindObject<UClass> failed. Assuming soft path  path: %s"), *ClassName);
+                                UE_LOG(LogUnrealMCP, Verbose, TEXT("FindObject<UClass> failed. Assuming soft path  path: %s"), *ClassName);
                             }
                             
                             // If not found, try with Engine module path
@@ -516,7 +516,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                             {
                                 FString EngineClassName = FString::Printf(TEXT("/Script/Engine.%s"), *ClassName);
                                 Class = LoadObject<UClass>(nullptr, *EngineClassName);
-                                UE_LOG(LogUnrealMCP, Display, TEXT("Trying Engine module path: %s"), *EngineClassName);
+                                UE_LOG(LogUnrealMCP, Verbose, TEXT("Trying Engine module path: %s"), *EngineClassName);
                             }
                             
                             if (!Class)
@@ -547,7 +547,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                             // Ensure we're using an integer value (no decimal)
                             int32 IntValue = FMath::RoundToInt(ParamValue->AsNumber());
                             ParamPin->DefaultValue = FString::FromInt(IntValue);
-                            UE_LOG(LogTemp, Display, TEXT("  Set integer parameter '%s' to: %d (string: '%s')"), 
+                            UE_LOG(LogUnrealMCP, Verbose, TEXT("  Set integer parameter '%s' to: %d (string: '%s')"), 
                                    *ParamName, IntValue, *ParamPin->DefaultValue);
                         }
                         else if (ParamPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Float)
@@ -555,14 +555,14 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                             // For other numeric types
                             float FloatValue = ParamValue->AsNumber();
                             ParamPin->DefaultValue = FString::SanitizeFloat(FloatValue);
-                            UE_LOG(LogTemp, Display, TEXT("  Set float parameter '%s' to: %f (string: '%s')"), 
+                            UE_LOG(LogUnrealMCP, Verbose, TEXT("  Set float parameter '%s' to: %f (string: '%s')"), 
                                    *ParamName, FloatValue, *ParamPin->DefaultValue);
                         }
                         else if (ParamPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Boolean)
                         {
                             bool BoolValue = ParamValue->AsBool();
                             ParamPin->DefaultValue = BoolValue ? TEXT("true") : TEXT("false");
-                            UE_LOG(LogTemp, Display, TEXT("  Set boolean parameter '%s' to: %s"), 
+                            UE_LOG(LogUnrealMCP, Verbose, TEXT("  Set boolean parameter '%s' to: %s"), 
                                    *ParamName, *ParamPin->DefaultValue);
                         }
                         else if (ParamPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Struct && ParamPin->PinType.PinSubCategoryObject == TBaseStructure<FVector>::Get())
@@ -582,14 +582,14 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                                     FString VectorString = FString::Printf(TEXT("(X=%f,Y=%f,Z=%f)"), X, Y, Z);
                                     ParamPin->DefaultValue = VectorString;
                                     
-                                    UE_LOG(LogTemp, Display, TEXT("  Set vector parameter '%s' to: %s"), 
+                                    UE_LOG(LogUnrealMCP, Verbose, TEXT("  Set vector parameter '%s' to: %s"), 
                                            *ParamName, *VectorString);
-                                    UE_LOG(LogTemp, Display, TEXT("  Final pin value: '%s'"), 
+                                    UE_LOG(LogUnrealMCP, Verbose, TEXT("  Final pin value: '%s'"), 
                                            *ParamPin->DefaultValue);
                                 }
                                 else
                                 {
-                                    UE_LOG(LogTemp, Warning, TEXT("Array parameter type not fully supported yet"));
+                                    UE_LOG(LogUnrealMCP, Warning, TEXT("Array parameter type not fully supported yet"));
                                 }
                             }
                         }
@@ -602,7 +602,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                             // Ensure we're using an integer value (no decimal)
                             int32 IntValue = FMath::RoundToInt(ParamValue->AsNumber());
                             ParamPin->DefaultValue = FString::FromInt(IntValue);
-                            UE_LOG(LogTemp, Display, TEXT("  Set integer parameter '%s' to: %d (string: '%s')"), 
+                            UE_LOG(LogUnrealMCP, Verbose, TEXT("  Set integer parameter '%s' to: %d (string: '%s')"), 
                                    *ParamName, IntValue, *ParamPin->DefaultValue);
                         }
                         else
@@ -610,7 +610,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                             // For other numeric types
                             float FloatValue = ParamValue->AsNumber();
                             ParamPin->DefaultValue = FString::SanitizeFloat(FloatValue);
-                            UE_LOG(LogTemp, Display, TEXT("  Set float parameter '%s' to: %f (string: '%s')"), 
+                            UE_LOG(LogUnrealMCP, Verbose, TEXT("  Set float parameter '%s' to: %f (string: '%s')"), 
                                    *ParamName, FloatValue, *ParamPin->DefaultValue);
                         }
                     }
@@ -618,12 +618,12 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                     {
                         bool BoolValue = ParamValue->AsBool();
                         ParamPin->DefaultValue = BoolValue ? TEXT("true") : TEXT("false");
-                        UE_LOG(LogTemp, Display, TEXT("  Set boolean parameter '%s' to: %s"), 
+                        UE_LOG(LogUnrealMCP, Verbose, TEXT("  Set boolean parameter '%s' to: %s"), 
                                *ParamName, *ParamPin->DefaultValue);
                     }
                     else if (ParamValue->Type == EJson::Array)
                     {
-                        UE_LOG(LogTemp, Display, TEXT("  Processing array parameter '%s'"), *ParamName);
+                        UE_LOG(LogUnrealMCP, Verbose, TEXT("  Processing array parameter '%s'"), *ParamName);
                         // Handle array parameters - like Vector parameters
                         const TArray<TSharedPtr<FJsonValue>>* ArrayValue;
                         if (ParamValue->TryGetArray(ArrayValue))
@@ -641,14 +641,14 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                                 FString VectorString = FString::Printf(TEXT("(X=%f,Y=%f,Z=%f)"), X, Y, Z);
                                 ParamPin->DefaultValue = VectorString;
                                 
-                                UE_LOG(LogTemp, Display, TEXT("  Set vector parameter '%s' to: %s"), 
+                                UE_LOG(LogUnrealMCP, Verbose, TEXT("  Set vector parameter '%s' to: %s"), 
                                        *ParamName, *VectorString);
-                                UE_LOG(LogTemp, Display, TEXT("  Final pin value: '%s'"), 
+                                UE_LOG(LogUnrealMCP, Verbose, TEXT("  Final pin value: '%s'"), 
                                        *ParamPin->DefaultValue);
                             }
                             else
                             {
-                                UE_LOG(LogTemp, Warning, TEXT("Array parameter type not fully supported yet"));
+                                UE_LOG(LogUnrealMCP, Warning, TEXT("Array parameter type not fully supported yet"));
                             }
                         }
                     }
@@ -656,14 +656,14 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                 }
                 else
                 {
-                    UE_LOG(LogTemp, Warning, TEXT("Parameter pin '%s' not found"), *ParamName);
+                    UE_LOG(LogUnrealMCP, Warning, TEXT("Parameter pin '%s' not found"), *ParamName);
                 }
             }
         }
     }
 
     // Mark the blueprint as modified
-    FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+    FUnrealMCPCommonUtils::MarkBlueprintModified(Blueprint);
 
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
     ResultObj->SetStringField(TEXT("node_id"), FunctionNode->NodeGuid.ToString());
@@ -759,7 +759,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintVaria
     }
 
     // Mark the blueprint as modified
-    FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+    FUnrealMCPCommonUtils::MarkBlueprintModified(Blueprint);
 
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
     ResultObj->SetStringField(TEXT("variable_name"), VariableName);
@@ -811,7 +811,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintInput
     }
 
     // Mark the blueprint as modified
-    FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+    FUnrealMCPCommonUtils::MarkBlueprintModified(Blueprint);
 
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
     ResultObj->SetStringField(TEXT("node_id"), InputActionNode->NodeGuid.ToString());
@@ -856,7 +856,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintSelfR
     }
 
     // Mark the blueprint as modified
-    FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+    FUnrealMCPCommonUtils::MarkBlueprintModified(Blueprint);
 
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
     ResultObj->SetStringField(TEXT("node_id"), SelfNode->NodeGuid.ToString());
@@ -910,7 +910,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleFindBlueprintNode
             UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node);
             if (EventNode && EventNode->EventReference.GetMemberName() == FName(*EventName))
             {
-                UE_LOG(LogTemp, Display, TEXT("Found event node with name %s: %s"), *EventName, *EventNode->NodeGuid.ToString());
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("Found event node with name %s: %s"), *EventName, *EventNode->NodeGuid.ToString());
                 NodeGuidArray.Add(MakeShared<FJsonValueString>(EventNode->NodeGuid.ToString()));
             }
         }
@@ -1,5 +1,11 @@
 #include "Commands/UnrealMCPCommonUtils.h"
+#include "MCPLog.h"
+#include "MCPEditBatch.h"
+#include "MCPActorHandles.h"
+#include "MCPRequestContext.h"
 #include "GameFramework/Actor.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
 #include "Engine/Blueprint.h"
 #include "EdGraph/EdGraph.h"
 #include "EdGraph/EdGraphNode.h"
@@ -12,6 +18,7 @@
 #include "K2Node_Self.h"
 #include "EdGraphSchema_K2.h"
 #include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/LightComponent.h"
 #include "Components/PrimitiveComponent.h"
@@ -25,6 +32,8 @@
 #include "BlueprintActionDatabase.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
+#include "Misc/Base64.h"
+#include "MCPTrace.h"
 
 // JSON Utilities
 TSharedPtr<FJsonObject> FUnrealMCPCommonUtils::CreateErrorResponse(const FString& Message)
@@ -145,6 +154,83 @@ FRotator FUnrealMCPCommonUtils::GetRotatorFromJson(const TSharedPtr<FJsonObject>
     return Result;
 }
 
+int32 FUnrealMCPCommonUtils::GetPackedTransformStride(const FString& Layout)
+{
+    if (Layout == TEXT("location"))
+    {
+        return 3;
+    }
+    if (Layout == TEXT("location_rotation"))
+    {
+        return 6;
+    }
+    if (Layout == TEXT("full"))
+    {
+        return 9;
+    }
+    return 0;
+}
+
+bool FUnrealMCPCommonUtils::GetPackedFloats(const TSharedPtr<FJsonObject>& Params, const FString& FieldName, TArray<float>& OutValues, FString& OutError)
+{
+    static_assert(PLATFORM_LITTLE_ENDIAN, "Packed buffers are read in native byte order");
+    
+    // The attachment wins over the JSON fields
+    TArray<uint8> Bytes;
+    FString Base64;
+    const TArray<TSharedPtr<FJsonValue>>* JsonValues = nullptr;
+    const FMCPRequestContext* Context = FMCPRequestContext::Get();
+    if (Context && Context->RequestAttachment.Num() > 0)
+    {
+        Bytes = Context->RequestAttachment;
+    }
+    else if (Params->TryGetStringField(FieldName + TEXT("_base64"), Base64))
+    {
+        if (!FBase64::Decode(Base64, Bytes))
+        {
+            OutError = FString::Printf(TEXT("'%s_base64' is not valid base64"), *FieldName);
+            return false;
+        }
+    }
+    else if (Params->TryGetArrayField(FieldName, JsonValues))
+    {
+        OutValues.Reset(JsonValues->Num());
+        for (const TSharedPtr<FJsonValue>& Value : *JsonValues)
+        {
+            OutValues.Add((float)Value->AsNumber());
+        }
+        return true;
+    }
+    else
+    {
+        OutError = FString::Printf(TEXT("Missing '%s': send a float32 attachment, '%s_base64' or a number array"), *FieldName, *FieldName);
+        return false;
+    }
+    
+    if (Bytes.Num() % sizeof(float) != 0)
+    {
+        OutError = FString::Printf(TEXT("Packed '%s' buffer is %d bytes, not a whole number of float32 values"), *FieldName, Bytes.Num());
+        return false;
+    }
+    OutValues.SetNumUninitialized(Bytes.Num() / sizeof(float));
+    FMemory::Memcpy(OutValues.GetData(), Bytes.GetData(), Bytes.Num());
+    return true;
+}
+
+FTransform FUnrealMCPCommonUtils::MakePackedTransform(const float* Values, int32 Stride)
+{
+    FTransform Transform(FVector(Values[0], Values[1], Values[2]));
+    if (Stride >= 6)
+    {
+        Transform.SetRotation(FQuat(FRotator(Values[3], Values[4], Values[5])));
+    }
+    if (Stride >= 9)
+    {
+        Transform.SetScale3D(FVector(Values[6], Values[7], Values[8]));
+    }
+    return Transform;
+}
+
 // Blueprint Utilities
 UBlueprint* FUnrealMCPCommonUtils::FindBlueprint(const FString& BlueprintName)
 {
@@ -153,20 +239,40 @@ UBlueprint* FUnrealMCPCommonUtils::FindBlueprint(const FString& BlueprintName)
 
 UBlueprint* FUnrealMCPCommonUtils::FindBlueprintByName(const FString& BlueprintName)
 {
-    FString AssetPath;
-    
     // If the path starts with /, it's already a full path
     if (BlueprintName.StartsWith(TEXT("/")))
     {
-        AssetPath = BlueprintName;
+        return LoadObject<UBlueprint>(nullptr, *BlueprintName);
     }
-    else
+    
+    // Otherwise, try /Game/Blueprints/ first
+    if (UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *(TEXT("/Game/Blueprints/") + BlueprintName), nullptr, LOAD_NoWarn))
     {
-        // Otherwise, assume it's in /Game/Blueprints/
-        AssetPath = TEXT("/Game/Blueprints/") + BlueprintName;
+        return Blueprint;
     }
     
-    return LoadObject<UBlueprint>(nullptr, *AssetPath);
+    // Then look the name up in the asset registry, so blueprints in other folders are found
+    // without loading anything but the match
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    FARFilter Filter;
+    Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+    Filter.bRecursiveClasses = true;
+    Filter.PackagePaths.Add(FName(TEXT("/Game")));
+    Filter.bRecursivePaths = true;
+    
+    const FName AssetName(*BlueprintName);
+    FAssetData Found;
+    AssetRegistry.EnumerateAssets(Filter, [&Found, AssetName](const FAssetData& Asset)
+    {
+        if (Asset.AssetName == AssetName)
+        {
+            Found = Asset;
+            return false;
+        }
+        return true;
+    });
+    
+    return Found.IsValid() ? Cast<UBlueprint>(Found.GetAsset()) : nullptr;
 }
 
 UEdGraph* FUnrealMCPCommonUtils::FindOrCreateEventGraph(UBlueprint* Blueprint)
@@ -191,7 +297,66 @@ UEdGraph* FUnrealMCPCommonUtils::FindOrCreateEventGraph(UBlueprint* Blueprint)
     return NewGraph;
 }
 
+FString FUnrealMCPCommonUtils::GetGraphType(const UBlueprint* Blueprint, const UEdGraph* Graph)
+{
+    if (Blueprint->UbergraphPages.Contains(Graph))
+    {
+        return TEXT("event_graph");
+    }
+    if (Blueprint->FunctionGraphs.Contains(Graph))
+    {
+        return Graph->GetName() == TEXT("UserConstructionScript") ? TEXT("construction_script") : TEXT("function");
+    }
+    if (Blueprint->MacroGraphs.Contains(Graph))
+    {
+        return TEXT("macro");
+    }
+    return TEXT("graph");
+}
+
 // Blueprint node utilities
+void FUnrealMCPCommonUtils::MarkBlueprintModified(UBlueprint* Blueprint, bool bStructural)
+{
+    if (FMCPEditBatch* Batch = FMCPEditBatch::Get())
+    {
+        Batch->DeferBlueprintModified(Blueprint, bStructural);
+    }
+    else if (bStructural)
+    {
+        FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+    }
+    else
+    {
+        FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+    }
+}
+
+void FUnrealMCPCommonUtils::CompileBlueprint(UBlueprint* Blueprint)
+{
+    if (FMCPEditBatch* Batch = FMCPEditBatch::Get())
+    {
+        Batch->DeferCompile(Blueprint);
+    }
+    else
+    {
+        MCP_TRACE_SCOPE("MCP CompileBlueprint");
+        FKismetEditorUtilities::CompileBlueprint(Blueprint);
+    }
+}
+
+void FUnrealMCPCommonUtils::SaveBlueprint(UBlueprint* Blueprint)
+{
+    // In a batch the compile has not run yet, and a rollback cannot undo a save
+    if (FMCPEditBatch* Batch = FMCPEditBatch::Get())
+    {
+        Batch->DeferSave(Blueprint);
+    }
+    else
+    {
+        UEditorAssetLibrary::SaveLoadedAsset(Blueprint, false);
+    }
+}
+
 UK2Node_Event* FUnrealMCPCommonUtils::CreateEventNode(UEdGraph* Graph, const FString& EventName, const FVector2D& Position)
 {
     if (!Graph)
@@ -211,7 +376,7 @@ UK2Node_Event* FUnrealMCPCommonUtils::CreateEventNode(UEdGraph* Graph, const FSt
         UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node);
         if (EventNode && EventNode->EventReference.GetMemberName() == FName(*EventName))
         {
-            UE_LOG(LogTemp, Display, TEXT("Using existing event node with name %s (ID: %s)"), 
+            UE_LOG(LogUnrealMCP, Verbose, TEXT("Using existing event node with name %s (ID: %s)"), 
                 *EventName, *EventNode->NodeGuid.ToString());
             return EventNode;
         }
@@ -230,15 +395,16 @@ UK2Node_Event* FUnrealMCPCommonUtils::CreateEventNode(UEdGraph* Graph, const FSt
         EventNode->EventReference.SetExternalMember(FName(*EventName), BlueprintClass);
         EventNode->NodePosX = Position.X;
         EventNode->NodePosY = Position.Y;
+        Graph->Modify();
         Graph->AddNode(EventNode, true);
         EventNode->PostPlacedNewNode();
         EventNode->AllocateDefaultPins();
-        UE_LOG(LogTemp, Display, TEXT("Created new event node with name %s (ID: %s)"), 
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("Created new event node with name %s (ID: %s)"), 
             *EventName, *EventNode->NodeGuid.ToString());
     }
     else
     {
-        UE_LOG(LogTemp, Error, TEXT("Failed to find function for event name: %s"), *EventName);
+        UE_LOG(LogUnrealMCP, Error, TEXT("Failed to find function for event name: %s"), *EventName);
     }
     
     return EventNode;
@@ -255,6 +421,7 @@ UK2Node_CallFunction* FUnrealMCPCommonUtils::CreateFunctionCallNode(UEdGraph* Gr
     FunctionNode->SetFromFunction(Function);
     FunctionNode->NodePosX = Position.X;
     FunctionNode->NodePosY = Position.Y;
+    Graph->Modify();
     Graph->AddNode(FunctionNode, true);
     FunctionNode->CreateNewGuid();
     FunctionNode->PostPlacedNewNode();
@@ -280,6 +447,7 @@ UK2Node_VariableGet* FUnrealMCPCommonUtils::CreateVariableGetNode(UEdGraph* Grap
         VariableGetNode->VariableReference.SetFromField<FProperty>(Property, false);
         VariableGetNode->NodePosX = Position.X;
         VariableGetNode->NodePosY = Position.Y;
+        Graph->Modify();
         Graph->AddNode(VariableGetNode, true);
         VariableGetNode->PostPlacedNewNode();
         VariableGetNode->AllocateDefaultPins();
@@ -307,6 +475,7 @@ UK2Node_VariableSet* FUnrealMCPCommonUtils::CreateVariableSetNode(UEdGraph* Grap
         VariableSetNode->VariableReference.SetFromField<FProperty>(Property, false);
         VariableSetNode->NodePosX = Position.X;
         VariableSetNode->NodePosY = Position.Y;
+        Graph->Modify();
         Graph->AddNode(VariableSetNode, true);
         VariableSetNode->PostPlacedNewNode();
         VariableSetNode->AllocateDefaultPins();
@@ -328,6 +497,7 @@ UK2Node_InputAction* FUnrealMCPCommonUtils::CreateInputActionNode(UEdGraph* Grap
     InputActionNode->InputActionName = FName(*ActionName);
     InputActionNode->NodePosX = Position.X;
     InputActionNode->NodePosY = Position.Y;
+    Graph->Modify();
     Graph->AddNode(InputActionNode, true);
     InputActionNode->CreateNewGuid();
     InputActionNode->PostPlacedNewNode();
@@ -346,6 +516,7 @@ UK2Node_Self* FUnrealMCPCommonUtils::CreateSelfReferenceNode(UEdGraph* Graph, co
     UK2Node_Self* SelfNode = NewObject<UK2Node_Self>(Graph);
     SelfNode->NodePosX = Position.X;
     SelfNode->NodePosY = Position.Y;
+    Graph->Modify();
     Graph->AddNode(SelfNode, true);
     SelfNode->CreateNewGuid();
     SelfNode->PostPlacedNewNode();
@@ -367,6 +538,8 @@ bool FUnrealMCPCommonUtils::ConnectGraphNodes(UEdGraph* Graph, UEdGraphNode* Sou
     
     if (SourcePin && TargetPin)
     {
+        SourceNode->Modify();
+        TargetNode->Modify();
         SourcePin->MakeLinkTo(TargetPin);
         return true;
     }
@@ -382,13 +555,16 @@ UEdGraphPin* FUnrealMCPCommonUtils::FindPin(UEdGraphNode* Node, const FString& P
     }
     
     // Log all pins for debugging
-    UE_LOG(LogTemp, Display, TEXT("FindPin: Looking for pin '%s' (Direction: %d) in node '%s'"), 
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("FindPin: Looking for pin '%s' (Direction: %d) in node '%s'"), 
            *PinName, (int32)Direction, *Node->GetName());
     
-    for (UEdGraphPin* Pin : Node->Pins)
+    if (UE_LOG_ACTIVE(LogUnrealMCP, Verbose))
     {
-        UE_LOG(LogTemp, Display, TEXT("  - Available pin: '%s', Direction: %d, Category: %s"), 
-               *Pin->PinName.ToString(), (int32)Pin->Direction, *Pin->PinType.PinCategory.ToString());
+        for (UEdGraphPin* Pin : Node->Pins)
+        {
+            UE_LOG(LogUnrealMCP, Verbose, TEXT("  - Available pin: '%s', Direction: %d, Category: %s"), 
+                   *Pin->PinName.ToString(), (int32)Pin->Direction, *Pin->PinType.PinCategory.ToString());
+        }
     }
     
     // First try exact match
@@ -396,7 +572,7 @@ UEdGraphPin* FUnrealMCPCommonUtils::FindPin(UEdGraphNode* Node, const FString& P
     {
         if (Pin->PinName.ToString() == PinName && (Direction == EGPD_MAX || Pin->Direction == Direction))
         {
-            UE_LOG(LogTemp, Display, TEXT("  - Found exact matching pin: '%s'"), *Pin->PinName.ToString());
+            UE_LOG(LogUnrealMCP, Verbose, TEXT("  - Found exact matching pin: '%s'"), *Pin->PinName.ToString());
             return Pin;
         }
     }
@@ -407,7 +583,7 @@ UEdGraphPin* FUnrealMCPCommonUtils::FindPin(UEdGraphNode* Node, const FString& P
         if (Pin->PinName.ToString().Equals(PinName, ESearchCase::IgnoreCase) && 
             (Direction == EGPD_MAX || Pin->Direction == Direction))
         {
-            UE_LOG(LogTemp, Display, TEXT("  - Found case-insensitive matching pin: '%s'"), *Pin->PinName.ToString());
+            UE_LOG(LogUnrealMCP, Verbose, TEXT("  - Found case-insensitive matching pin: '%s'"), *Pin->PinName.ToString());
             return Pin;
         }
     }
@@ -419,13 +595,13 @@ UEdGraphPin* FUnrealMCPCommonUtils::FindPin(UEdGraphNode* Node, const FString& P
         {
             if (Pin->Direction == EGPD_Output && Pin->PinType.PinCategory != UEdGraphSchema_K2::PC_Exec)
             {
-                UE_LOG(LogTemp, Display, TEXT("  - Found fallback data output pin: '%s'"), *Pin->PinName.ToString());
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("  - Found fallback data output pin: '%s'"), *Pin->PinName.ToString());
                 return Pin;
             }
         }
     }
     
-    UE_LOG(LogTemp, Warning, TEXT("  - No matching pin found for '%s'"), *PinName);
+    UE_LOG(LogUnrealMCP, Warning, TEXT("  - No matching pin found for '%s'"), *PinName);
     return nullptr;
 }
 
@@ -439,6 +615,7 @@ TSharedPtr<FJsonValue> FUnrealMCPCommonUtils::ActorToJson(AActor* Actor)
     
     TSharedPtr<FJsonObject> ActorObject = MakeShared<FJsonObject>();
     ActorObject->SetStringField(TEXT("name"), Actor->GetName());
+    ActorObject->SetNumberField(TEXT("handle"), FMCPActorHandles::GetHandle(Actor));
     ActorObject->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
     
     FVector Location = Actor->GetActorLocation();
@@ -474,6 +651,7 @@ TSharedPtr<FJsonObject> FUnrealMCPCommonUtils::ActorToJsonObject(AActor* Actor,
     
     TSharedPtr<FJsonObject> ActorObject = MakeShared<FJsonObject>();
     ActorObject->SetStringField(TEXT("name"), Actor->GetName());
+    ActorObject->SetNumberField(TEXT("handle"), FMCPActorHandles::GetHandle(Actor));
     ActorObject->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
     
     FVector Location = Actor->GetActorLocation();
@@ -500,6 +678,48 @@ TSharedPtr<FJsonObject> FUnrealMCPCommonUtils::ActorToJsonObject(AActor* Actor,
     return ActorObject;
 }
 
+AActor* FUnrealMCPCommonUtils::FindActorByName(const FString& ActorName)
+{
+    if (!GWorld || ActorName.IsEmpty())
+    {
+        return nullptr;
+    }
+
+    // Actor names are object names within their level, so look them up directly
+    const FName ObjectName(*ActorName);
+    for (ULevel* Level : GWorld->GetLevels())
+    {
+        if (AActor* Actor = Level ? FindObjectFast<AActor>(Level, ObjectName) : nullptr)
+        {
+            return Actor;
+        }
+    }
+    return nullptr;
+}
+
+AActor* FUnrealMCPCommonUtils::FindActorFromParams(const TSharedPtr<FJsonObject>& Params, FString& OutError, const FString& NameField)
+{
+    int64 Handle = 0;
+    if (Params->TryGetNumberField(TEXT("handle"), Handle))
+    {
+        return FMCPActorHandles::Resolve(Handle, OutError);
+    }
+
+    FString ActorName;
+    if (!Params->TryGetStringField(NameField, ActorName))
+    {
+        OutError = FString::Printf(TEXT("Missing '%s' or 'handle' parameter"), *NameField);
+        return nullptr;
+    }
+
+    AActor* Actor = FindActorByName(ActorName);
+    if (!Actor)
+    {
+        OutError = FString::Printf(TEXT("Actor not found: %s"), *ActorName);
+    }
+    return Actor;
+}
+
 UK2Node_Event* FUnrealMCPCommonUtils::FindExistingEventNode(UEdGraph* Graph, const FString& EventName)
 {
     if (!Graph)
@@ -513,7 +733,7 @@ UK2Node_Event* FUnrealMCPCommonUtils::FindExistingEventNode(UEdGraph* Graph, con
         UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node);
         if (EventNode && EventNode->EventReference.GetMemberName() == FName(*EventName))
         {
-            UE_LOG(LogTemp, Display, TEXT("Found existing event node with name: %s"), *EventName);
+            UE_LOG(LogUnrealMCP, Verbose, TEXT("Found existing event node with name: %s"), *EventName);
             return EventNode;
         }
     }
@@ -537,6 +757,7 @@ bool FUnrealMCPCommonUtils::SetObjectProperty(UObject* Object, const FString& Pr
         return false;
     }
 
+    Object->Modify();
     void* PropertyAddr = Property->ContainerPtrToValuePtr<void>(Object);
     
     // Handle different property types
@@ -579,7 +800,7 @@ bool FUnrealMCPCommonUtils::SetObjectProperty(UObject* Object, const FString& Pr
                 uint8 ByteValue = static_cast<uint8>(Value->AsNumber());
                 ByteProp->SetPropertyValue(PropertyAddr, ByteValue);
                 
-                UE_LOG(LogTemp, Display, TEXT("Setting enum property %s to numeric value: %d"), 
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("Setting enum property %s to numeric value: %d"), 
                       *PropertyName, ByteValue);
                 return true;
             }
@@ -594,7 +815,7 @@ bool FUnrealMCPCommonUtils::SetObjectProperty(UObject* Object, const FString& Pr
                     uint8 ByteValue = FCString::Atoi(*EnumValueName);
                     ByteProp->SetPropertyValue(PropertyAddr, ByteValue);
                     
-                    UE_LOG(LogTemp, Display, TEXT("Setting enum property %s to numeric string value: %s -> %d"), 
+                    UE_LOG(LogUnrealMCP, Verbose, TEXT("Setting enum property %s to numeric string value: %s -> %d"), 
                           *PropertyName, *EnumValueName, ByteValue);
                     return true;
                 }
@@ -616,17 +837,17 @@ bool FUnrealMCPCommonUtils::SetObjectProperty(UObject* Object, const FString& Pr
                 {
                     ByteProp->SetPropertyValue(PropertyAddr, static_cast<uint8>(EnumValue));
                     
-                    UE_LOG(LogTemp, Display, TEXT("Setting enum property %s to name value: %s -> %lld"), 
+                    UE_LOG(LogUnrealMCP, Verbose, TEXT("Setting enum property %s to name value: %s -> %lld"), 
                           *PropertyName, *EnumValueName, EnumValue);
                     return true;
                 }
                 else
                 {
                     // Log all possible enum values for debugging
-                    UE_LOG(LogTemp, Warning, TEXT("Could not find enum value for '%s'. Available options:"), *EnumValueName);
+                    UE_LOG(LogUnrealMCP, Warning, TEXT("Could not find enum value for '%s'. Available options:"), *EnumValueName);
                     for (int32 i = 0; i < EnumDef->NumEnums(); i++)
                     {
-                        UE_LOG(LogTemp, Warning, TEXT("  - %s (value: %d)"), 
+                        UE_LOG(LogUnrealMCP, Verbose, TEXT("  - %s (value: %d)"), 
                                *EnumDef->GetNameStringByIndex(i), EnumDef->GetValueByIndex(i));
                     }
                     
@@ -657,7 +878,7 @@ bool FUnrealMCPCommonUtils::SetObjectProperty(UObject* Object, const FString& Pr
                 int64 EnumValue = static_cast<int64>(Value->AsNumber());
                 UnderlyingNumericProp->SetIntPropertyValue(PropertyAddr, EnumValue);
                 
-                UE_LOG(LogTemp, Display, TEXT("Setting enum property %s to numeric value: %lld"), 
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("Setting enum property %s to numeric value: %lld"), 
                       *PropertyName, EnumValue);
                 return true;
             }
@@ -672,7 +893,7 @@ bool FUnrealMCPCommonUtils::SetObjectProperty(UObject* Object, const FString& Pr
                     int64 EnumValue = FCString::Atoi64(*EnumValueName);
                     UnderlyingNumericProp->SetIntPropertyValue(PropertyAddr, EnumValue);
                     
-                    UE_LOG(LogTemp, Display, TEXT("Setting enum property %s to numeric string value: %s -> %lld"), 
+                    UE_LOG(LogUnrealMCP, Verbose, TEXT("Setting enum property %s to numeric string value: %s -> %lld"), 
                           *PropertyName, *EnumValueName, EnumValue);
                     return true;
                 }
@@ -694,17 +915,17 @@ bool FUnrealMCPCommonUtils::SetObjectProperty(UObject* Object, const FString& Pr
                 {
                     UnderlyingNumericProp->SetIntPropertyValue(PropertyAddr, EnumValue);
                     
-                    UE_LOG(LogTemp, Display, TEXT("Setting enum property %s to name value: %s -> %lld"), 
+                    UE_LOG(LogUnrealMCP, Verbose, TEXT("Setting enum property %s to name value: %s -> %lld"), 
                           *PropertyName, *EnumValueName, EnumValue);
                     return true;
                 }
                 else
                 {
                     // Log all possible enum values for debugging
-                    UE_LOG(LogTemp, Warning, TEXT("Could not find enum value for '%s'. Available options:"), *EnumValueName);
+                    UE_LOG(LogUnrealMCP, Warning, TEXT("Could not find enum value for '%s'. Available options:"), *EnumValueName);
                     for (int32 i = 0; i < EnumDef->NumEnums(); i++)
                     {
-                        UE_LOG(LogTemp, Warning, TEXT("  - %s (value: %d)"), 
+                        UE_LOG(LogUnrealMCP, Verbose, TEXT("  - %s (value: %d)"), 
                                *EnumDef->GetNameStringByIndex(i), EnumDef->GetValueByIndex(i));
                     }
                     
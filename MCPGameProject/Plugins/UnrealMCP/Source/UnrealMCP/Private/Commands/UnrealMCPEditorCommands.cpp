@@ -1,14 +1,23 @@
 #include "Commands/UnrealMCPEditorCommands.h"
+#include "MCPLog.h"
 #include "Commands/UnrealMCPCommonUtils.h"
 #include "UnrealMCPModule.h"
 #include "MCPLogCaptureDevice.h"
+#include "MCPScreenshotCapture.h"
+#include "MCPViewportStream.h"
+#include "MCPClientConnection.h"
+#include "MCPRequestContext.h"
+#include "MCPEditBatch.h"
+#include "MCPActorHandles.h"
+#include "MCPSpatialIndex.h"
+#include "MCPLevelSnapshot.h"
 #include "Editor.h"
 #include "EditorViewportClient.h"
 #include "LevelEditorViewport.h"
-#include "ImageUtils.h"
-#include "HighResScreenshot.h"
 #include "Engine/GameViewportClient.h"
-#include "Misc/FileHelper.h"
+#include "Misc/Base64.h"
+#include "Misc/Paths.h"
+#include "RHI.h"
 #include "GameFramework/Actor.h"
 #include "Engine/Selection.h"
 #include "Kismet/GameplayStatics.h"
@@ -18,16 +27,142 @@
 #include "Engine/SpotLight.h"
 #include "Camera/CameraActor.h"
 #include "Components/StaticMeshComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "EditorAssetLibrary.h"
 #include "EditorSubsystem.h"
 #include "Subsystems/EditorActorSubsystem.h"
 #include "Subsystems/AssetEditorSubsystem.h"
 #include "Engine/Blueprint.h"
 #include "Engine/BlueprintGeneratedClass.h"
 
+namespace
+{
+    /** Optional "class" filter for spatial queries: matches the actor's class or any parent class by name */
+    TFunction<bool(const AActor*)> MakeClassFilter(const TSharedPtr<FJsonObject>& Params)
+    {
+        FString ClassName;
+        if (!Params->TryGetStringField(TEXT("class"), ClassName) || ClassName.IsEmpty())
+        {
+            return [](const AActor*) { return true; };
+        }
+
+        const FName ClassFName(*ClassName);
+        return [ClassFName](const AActor* Actor)
+        {
+            for (const UClass* Class = Actor->GetClass(); Class; Class = Class->GetSuperClass())
+            {
+                if (Class->GetFName() == ClassFName)
+                {
+                    return true;
+                }
+            }
+            return false;
+        };
+    }
+
+    /** Compact per-hit rows; full details are one get_actor_properties away via the handle */
+    TSharedPtr<FJsonObject> MakeSpatialQueryResult(const TArray<FMCPSpatialIndex::FHit>& Hits, bool bComplete, bool bRebuilt,
+        const FMCPSpatialIndex& Index, double StartTime)
+    {
+        TArray<TSharedPtr<FJsonValue>> ActorArray;
+        ActorArray.Reserve(Hits.Num());
+        for (const FMCPSpatialIndex::FHit& Hit : Hits)
+        {
+            const FVector Location = Hit.Actor->GetActorLocation();
+            TArray<TSharedPtr<FJsonValue>> LocationArray;
+            LocationArray.Add(MakeShared<FJsonValueNumber>(Location.X));
+            LocationArray.Add(MakeShared<FJsonValueNumber>(Location.Y));
+            LocationArray.Add(MakeShared<FJsonValueNumber>(Location.Z));
+
+            TSharedPtr<FJsonObject> ActorObject = MakeShared<FJsonObject>();
+            ActorObject->SetStringField(TEXT("name"), Hit.Actor->GetName());
+            ActorObject->SetNumberField(TEXT("handle"), FMCPActorHandles::GetHandle(Hit.Actor));
+            ActorObject->SetStringField(TEXT("class"), Hit.Actor->GetClass()->GetName());
+            ActorObject->SetArrayField(TEXT("location"), LocationArray);
+            ActorObject->SetNumberField(TEXT("distance"), FMath::Sqrt(Hit.DistanceSquared));
+            ActorArray.Add(MakeShared<FJsonValueObject>(ActorObject));
+        }
+
+        TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+        ResultObj->SetArrayField(TEXT("actors"), ActorArray);
+        ResultObj->SetNumberField(TEXT("count"), Hits.Num());
+        ResultObj->SetBoolField(TEXT("truncated"), !bComplete);
+        ResultObj->SetNumberField(TEXT("indexed_actors"), Index.Num());
+        ResultObj->SetBoolField(TEXT("index_rebuilt"), bRebuilt);
+        if (bRebuilt)
+        {
+            ResultObj->SetNumberField(TEXT("index_build_ms"), Index.GetLastBuildSeconds() * 1000.0);
+        }
+        ResultObj->SetNumberField(TEXT("query_us"), (FPlatformTime::Seconds() - StartTime) * 1000000.0);
+        return ResultObj;
+    }
+
+    // Snapshot store budget
+    constexpr int32 MaxStoredSnapshots = 16;
+    constexpr SIZE_T MaxStoredSnapshotBytes = 128 * 1024 * 1024;
+
+    TSharedPtr<FJsonObject> ActorSnapshotToJson(const FMCPActorSnapshot& Entry)
+    {
+        TSharedPtr<FJsonObject> ActorObject = MakeShared<FJsonObject>();
+        ActorObject->SetNumberField(TEXT("handle"), Entry.Handle);
+        ActorObject->SetStringField(TEXT("name"), Entry.Name.ToString());
+        ActorObject->SetStringField(TEXT("class"), Entry.Class.ToString());
+        return ActorObject;
+    }
+
+    TArray<TSharedPtr<FJsonValue>> Vector3fToJson(const FVector3f& Vector)
+    {
+        TArray<TSharedPtr<FJsonValue>> Array;
+        Array.Add(MakeShared<FJsonValueNumber>(Vector.X));
+        Array.Add(MakeShared<FJsonValueNumber>(Vector.Y));
+        Array.Add(MakeShared<FJsonValueNumber>(Vector.Z));
+        return Array;
+    }
+
+    /** Actor types spawn_actors_bulk accepts; the same set as spawn_actor */
+    UClass* GetSpawnableActorClass(const FString& ActorType)
+    {
+        if (ActorType == TEXT("StaticMeshActor"))
+        {
+            return AStaticMeshActor::StaticClass();
+        }
+        if (ActorType == TEXT("PointLight"))
+        {
+            return APointLight::StaticClass();
+        }
+        if (ActorType == TEXT("SpotLight"))
+        {
+            return ASpotLight::StaticClass();
+        }
+        if (ActorType == TEXT("DirectionalLight"))
+        {
+            return ADirectionalLight::StaticClass();
+        }
+        if (ActorType == TEXT("CameraActor"))
+        {
+            return ACameraActor::StaticClass();
+        }
+        return nullptr;
+    }
+}
+
 FUnrealMCPEditorCommands::FUnrealMCPEditorCommands()
+    : NextViewportStreamId(1)
+    , NextSnapshotId(1)
 {
 }
 
+FUnrealMCPEditorCommands::~FUnrealMCPEditorCommands()
+{
+    for (const TPair<int32, TSharedPtr<FMCPViewportStream, ESPMode::ThreadSafe>>& Stream : ViewportStreams)
+    {
+        Stream.Value->Stop(TEXT("server shutting down"), true);
+    }
+    ViewportStreams.Empty();
+}
+
 TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
 {
     // Actor manipulation commands
@@ -43,10 +178,14 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleCommand(const FString& C
     {
         if (CommandType == TEXT("create_actor"))
         {
-            UE_LOG(LogTemp, Warning, TEXT("'create_actor' command is deprecated and will be removed in a future version. Please use 'spawn_actor' instead."));
+            UE_LOG(LogUnrealMCP, Warning, TEXT("'create_actor' command is deprecated and will be removed in a future version. Please use 'spawn_actor' instead."));
         }
         return HandleSpawnActor(Params);
     }
+    else if (CommandType == TEXT("spawn_actors_bulk"))
+    {
+        return HandleSpawnActorsBulk(Params);
+    }
     else if (CommandType == TEXT("delete_actor"))
     {
         return HandleDeleteActor(Params);
@@ -55,6 +194,10 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleCommand(const FString& C
     {
         return HandleSetActorTransform(Params);
     }
+    else if (CommandType == TEXT("set_transforms_bulk"))
+    {
+        return HandleSetTransformsBulk(Params);
+    }
     else if (CommandType == TEXT("get_actor_properties"))
     {
         return HandleGetActorProperties(Params);
@@ -63,6 +206,28 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleCommand(const FString& C
     {
         return HandleSetActorProperty(Params);
     }
+    // Spatial queries
+    else if (CommandType == TEXT("find_actors_in_radius"))
+    {
+        return HandleFindActorsInRadius(Params);
+    }
+    else if (CommandType == TEXT("find_actors_in_box"))
+    {
+        return HandleFindActorsInBox(Params);
+    }
+    else if (CommandType == TEXT("find_nearest_actors"))
+    {
+        return HandleFindNearestActors(Params);
+    }
+    // Level snapshots
+    else if (CommandType == TEXT("snapshot_level"))
+    {
+        return HandleSnapshotLevel(Params);
+    }
+    else if (CommandType == TEXT("diff_level"))
+    {
+        return HandleDiffLevel(Params);
+    }
     // Blueprint actor spawning
     else if (CommandType == TEXT("spawn_blueprint_actor"))
     {
@@ -73,9 +238,18 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleCommand(const FString& C
     {
         return HandleFocusViewport(Params);
     }
-    else if (CommandType == TEXT("take_screenshot"))
+    // Viewport streaming commands
+    else if (CommandType == TEXT("start_viewport_stream"))
     {
-        return HandleTakeScreenshot(Params);
+        return HandleStartViewportStream(Params);
+    }
+    else if (CommandType == TEXT("stop_viewport_stream"))
+    {
+        return HandleStopViewportStream(Params);
+    }
+    else if (CommandType == TEXT("ack_viewport_frame"))
+    {
+        return HandleAckViewportFrame(Params);
     }
     // Console/Log commands
     else if (CommandType == TEXT("get_console_output"))
@@ -91,6 +265,22 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleCommand(const FString& C
     return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown editor command: %s"), *CommandType));
 }
 
+bool FUnrealMCPEditorCommands::IsAsyncCommand(const FString& CommandType) const
+{
+    return CommandType == TEXT("take_screenshot");
+}
+
+TFuture<FMCPCommandResult> FUnrealMCPEditorCommands::HandleCommandAsync(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+{
+    if (CommandType == TEXT("take_screenshot"))
+    {
+        return HandleTakeScreenshot(Params);
+    }
+
+    return MakeFulfilledPromise<FMCPCommandResult>(FMCPCommandResult(
+        FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown async editor command: %s"), *CommandType)))).GetFuture();
+}
+
 TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleGetActorsInLevel(const TSharedPtr<FJsonObject>& Params)
 {
     // Get optional max_actors parameter (default to 100 for safety)
@@ -200,14 +390,9 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSpawnActor(const TShared
     }
 
     // Check if an actor with this name already exists
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(World, AActor::StaticClass(), AllActors);
-    for (AActor* Actor : AllActors)
+    if (FUnrealMCPCommonUtils::FindActorByName(ActorName))
     {
-        if (Actor && Actor->GetName() == ActorName)
-        {
-            return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor with name '%s' already exists"), *ActorName));
-        }
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor with name '%s' already exists"), *ActorName));
     }
 
     FActorSpawnParameters SpawnParams;
@@ -252,62 +437,231 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSpawnActor(const TShared
     return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to create actor"));
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleDeleteActor(const TSharedPtr<FJsonObject>& Params)
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSpawnActorsBulk(const TSharedPtr<FJsonObject>& Params)
 {
-    FString ActorName;
-    if (!Params->TryGetStringField(TEXT("name"), ActorName))
+    const double StartTime = FPlatformTime::Seconds();
+
+    FString NamePrefix;
+    if (!Params->TryGetStringField(TEXT("name_prefix"), NamePrefix) || NamePrefix.IsEmpty())
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'name' parameter"));
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'name_prefix' parameter"));
     }
 
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
-    
-    for (AActor* Actor : AllActors)
+    bool bInstanced = false;
+    Params->TryGetBoolField(TEXT("instanced"), bInstanced);
+
+    FString ActorType = TEXT("StaticMeshActor");
+    Params->TryGetStringField(TEXT("type"), ActorType);
+    UClass* ActorClass = GetSpawnableActorClass(ActorType);
+    if (!bInstanced && !ActorClass)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown actor type: %s"), *ActorType));
+    }
+
+    FString Layout = TEXT("full");
+    Params->TryGetStringField(TEXT("layout"), Layout);
+    const int32 Stride = FUnrealMCPCommonUtils::GetPackedTransformStride(Layout);
+    if (Stride == 0)
     {
-        if (Actor && Actor->GetName() == ActorName)
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown layout '%s' (expected location, location_rotation or full)"), *Layout));
+    }
+
+    TArray<float> Values;
+    FString Error;
+    if (!FUnrealMCPCommonUtils::GetPackedFloats(Params, TEXT("transforms"), Values, Error))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+    if (Values.Num() == 0 || Values.Num() % Stride != 0)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(
+            TEXT("'transforms' must hold a non-zero multiple of %d floats for layout '%s', got %d"), Stride, *Layout, Values.Num()));
+    }
+    const int32 Count = Values.Num() / Stride;
+
+    // Load the mesh once for every actor or instance
+    UStaticMesh* Mesh = nullptr;
+    FString MeshPath;
+    if (Params->TryGetStringField(TEXT("static_mesh"), MeshPath))
+    {
+        Mesh = Cast<UStaticMesh>(UEditorAssetLibrary::LoadAsset(MeshPath));
+        if (!Mesh)
         {
-            // Store actor info before deletion for the response
-            TSharedPtr<FJsonObject> ActorInfo = FUnrealMCPCommonUtils::ActorToJsonObject(Actor);
-            
-            // Delete the actor
-            Actor->Destroy();
-            
-            TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-            ResultObj->SetObjectField(TEXT("deleted_actor"), ActorInfo);
-            return ResultObj;
+            return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Failed to load static mesh: %s"), *MeshPath));
         }
     }
-    
-    return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor not found: %s"), *ActorName));
-}
+    if (bInstanced && !Mesh)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("'instanced' requires 'static_mesh'"));
+    }
+    if (Mesh && !bInstanced && ActorClass != AStaticMeshActor::StaticClass())
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("'static_mesh' is only supported for StaticMeshActor"));
+    }
 
-TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorTransform(const TSharedPtr<FJsonObject>& Params)
-{
-    // Get actor name
-    FString ActorName;
-    if (!Params->TryGetStringField(TEXT("name"), ActorName))
+    UWorld* World = GEditor->GetEditorWorldContext().World();
+    if (!World)
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'name' parameter"));
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get editor world"));
     }
 
-    // Find the actor
-    AActor* TargetActor = nullptr;
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
-    
-    for (AActor* Actor : AllActors)
+    TArray<FTransform> Transforms;
+    Transforms.Reserve(Count);
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        Transforms.Add(FUnrealMCPCommonUtils::MakePackedTransform(Values.GetData() + Index * Stride, Stride));
+    }
+
+    // One undo entry and one viewport refresh, unless the caller's batch already provides them
+    TUniquePtr<FMCPEditBatch> OwnBatch;
+    if (!FMCPEditBatch::Get())
+    {
+        OwnBatch = MakeUnique<FMCPEditBatch>(FString::Printf(TEXT("Spawn %d actors"), Count));
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetNumberField(TEXT("count"), Count);
+
+    // Name collisions are resolved by the spawn itself instead of scanning the world
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.NameMode = FActorSpawnParameters::ESpawnActorNameMode::Requested;
+
+    if (bInstanced)
     {
-        if (Actor && Actor->GetName() == ActorName)
+        bool bHierarchical = true;
+        Params->TryGetBoolField(TEXT("hierarchical"), bHierarchical);
+
+        SpawnParams.Name = *NamePrefix;
+        AActor* InstanceActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+        if (!InstanceActor)
         {
-            TargetActor = Actor;
-            break;
+            if (OwnBatch)
+            {
+                OwnBatch->Rollback();
+            }
+            return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to create instance actor"));
         }
+
+        UClass* ComponentClass = bHierarchical
+            ? UHierarchicalInstancedStaticMeshComponent::StaticClass()
+            : UInstancedStaticMeshComponent::StaticClass();
+        UInstancedStaticMeshComponent* Instances = NewObject<UInstancedStaticMeshComponent>(InstanceActor, ComponentClass, TEXT("Instances"), RF_Transactional);
+        Instances->SetStaticMesh(Mesh);
+        InstanceActor->SetRootComponent(Instances);
+        InstanceActor->AddInstanceComponent(Instances);
+        Instances->RegisterComponent();
+        Instances->AddInstances(Transforms, false);
+
+        ResultObj->SetStringField(TEXT("mode"), TEXT("instanced"));
+        ResultObj->SetStringField(TEXT("component_class"), ComponentClass->GetName());
+        ResultObj->SetNumberField(TEXT("instance_count"), Instances->GetInstanceCount());
+        ResultObj->SetObjectField(TEXT("actor"), FUnrealMCPCommonUtils::ActorToJsonObject(InstanceActor, true));
     }
+    else
+    {
+        bool bReturnNames = false;
+        Params->TryGetBoolField(TEXT("return_names"), bReturnNames);
+
+        // Deferred construction lets the mesh be set before construction runs, and the
+        // full transform (including scale) is applied once by FinishSpawning
+        SpawnParams.bDeferConstruction = true;
+
+        TArray<TSharedPtr<FJsonValue>> Names;
+        FString FirstName;
+        FString LastName;
+        int32 FirstHandle = 0;
+        int32 LastHandle = 0;
+        int32 Spawned = 0;
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            SpawnParams.Name = FName(*NamePrefix, NAME_EXTERNAL_TO_INTERNAL(Index));
+            AActor* NewActor = World->SpawnActor(ActorClass, &Transforms[Index], SpawnParams);
+            if (!NewActor)
+            {
+                continue;
+            }
+
+            if (Mesh)
+            {
+                CastChecked<AStaticMeshActor>(NewActor)->GetStaticMeshComponent()->SetStaticMesh(Mesh);
+            }
+            NewActor->FinishSpawning(Transforms[Index]);
+
+            LastName = NewActor->GetName();
+            LastHandle = FMCPActorHandles::GetHandle(NewActor);
+            if (Spawned == 0)
+            {
+                FirstName = LastName;
+                FirstHandle = LastHandle;
+            }
+            if (bReturnNames)
+            {
+                Names.Add(MakeShared<FJsonValueString>(LastName));
+            }
+            ++Spawned;
+        }
+
+        if (Spawned == 0)
+        {
+            if (OwnBatch)
+            {
+                OwnBatch->Rollback();
+            }
+            return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to spawn any actors"));
+        }
+
+        ResultObj->SetStringField(TEXT("mode"), TEXT("actors"));
+        ResultObj->SetNumberField(TEXT("spawned"), Spawned);
+        ResultObj->SetNumberField(TEXT("failed"), Count - Spawned);
+        ResultObj->SetStringField(TEXT("first_name"), FirstName);
+        ResultObj->SetStringField(TEXT("last_name"), LastName);
+
+        // Actors created here are new to the handle table, so their handles are consecutive
+        ResultObj->SetNumberField(TEXT("first_handle"), FirstHandle);
+        ResultObj->SetNumberField(TEXT("last_handle"), LastHandle);
+        if (bReturnNames)
+        {
+            ResultObj->SetArrayField(TEXT("names"), Names);
+        }
+    }
+
+    if (OwnBatch)
+    {
+        OwnBatch->Commit();
+    }
+
+    ResultObj->SetNumberField(TEXT("elapsed_ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+    return ResultObj;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleDeleteActor(const TSharedPtr<FJsonObject>& Params)
+{
+    FString Error;
+    AActor* Actor = FUnrealMCPCommonUtils::FindActorFromParams(Params, Error);
+    if (!Actor)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+
+    // Store actor info before deletion for the response
+    TSharedPtr<FJsonObject> ActorInfo = FUnrealMCPCommonUtils::ActorToJsonObject(Actor);
+
+    // Delete the actor; its handle becomes stale
+    Actor->Destroy();
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetObjectField(TEXT("deleted_actor"), ActorInfo);
+    return ResultObj;
+}
 
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorTransform(const TSharedPtr<FJsonObject>& Params)
+{
+    // Find the actor by handle or name
+    FString Error;
+    AActor* TargetActor = FUnrealMCPCommonUtils::FindActorFromParams(Params, Error);
     if (!TargetActor)
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor not found: %s"), *ActorName));
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
     }
 
     // Get transform parameters
@@ -327,70 +681,430 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorTransform(const
     }
 
     // Set the new transform
+    TargetActor->Modify();
     TargetActor->SetActorTransform(NewTransform);
+    if (SpatialIndex)
+    {
+        SpatialIndex->NotifyActorMoved(TargetActor);
+    }
 
     // Return updated actor info
     return FUnrealMCPCommonUtils::ActorToJsonObject(TargetActor, true);
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleGetActorProperties(const TSharedPtr<FJsonObject>& Params)
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetTransformsBulk(const TSharedPtr<FJsonObject>& Params)
 {
-    // Get actor name
-    FString ActorName;
-    if (!Params->TryGetStringField(TEXT("name"), ActorName))
+    const double StartTime = FPlatformTime::Seconds();
+
+    // Actors are addressed by handle (no lookup) or by name
+    const TArray<TSharedPtr<FJsonValue>>* HandleValues = nullptr;
+    const TArray<TSharedPtr<FJsonValue>>* NameValues = nullptr;
+    if (!Params->TryGetArrayField(TEXT("handles"), HandleValues) && !Params->TryGetArrayField(TEXT("names"), NameValues))
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'name' parameter"));
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'handles' or 'names' parameter"));
     }
 
-    // Find the actor
-    AActor* TargetActor = nullptr;
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
-    
-    for (AActor* Actor : AllActors)
+    FString Layout = TEXT("full");
+    Params->TryGetStringField(TEXT("layout"), Layout);
+    const int32 Stride = FUnrealMCPCommonUtils::GetPackedTransformStride(Layout);
+    if (Stride == 0)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown layout '%s' (expected location, location_rotation or full)"), *Layout));
+    }
+
+    TArray<float> Values;
+    FString Error;
+    if (!FUnrealMCPCommonUtils::GetPackedFloats(Params, TEXT("transforms"), Values, Error))
     {
-        if (Actor && Actor->GetName() == ActorName)
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+    const int32 Count = HandleValues ? HandleValues->Num() : NameValues->Num();
+    if (Values.Num() != Count * Stride)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(
+            TEXT("'transforms' must hold %d floats (%d actors x %d for layout '%s'), got %d"), Count * Stride, Count, Stride, *Layout, Values.Num()));
+    }
+
+    bool bTransactional = true;
+    Params->TryGetBoolField(TEXT("transactional"), bTransactional);
+
+    // One undo entry and one viewport refresh, unless the caller's batch already provides them
+    TUniquePtr<FMCPEditBatch> OwnBatch;
+    if (bTransactional && !FMCPEditBatch::Get())
+    {
+        OwnBatch = MakeUnique<FMCPEditBatch>(FString::Printf(TEXT("Move %d actors"), Count));
+    }
+
+    // Child component transforms, bounds and overlaps of every moved root are updated
+    // once, when these scopes close after the loop
+    TArray<TUniquePtr<FScopedMovementUpdate>> MovementScopes;
+    MovementScopes.Reserve(Count);
+
+    TArray<TSharedPtr<FJsonValue>> Failures;
+    int32 Updated = 0;
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        AActor* Actor = nullptr;
+        FString ActorError;
+        if (HandleValues)
         {
-            TargetActor = Actor;
-            break;
+            Actor = FMCPActorHandles::Resolve((int64)(*HandleValues)[Index]->AsNumber(), ActorError);
         }
+        else
+        {
+            const FString ActorName = (*NameValues)[Index]->AsString();
+            Actor = FUnrealMCPCommonUtils::FindActorByName(ActorName);
+            if (!Actor)
+            {
+                ActorError = FString::Printf(TEXT("Actor not found: %s"), *ActorName);
+            }
+        }
+        USceneComponent* Root = Actor ? Actor->GetRootComponent() : nullptr;
+        if (!Root)
+        {
+            TSharedPtr<FJsonObject> Failure = MakeShared<FJsonObject>();
+            Failure->SetNumberField(TEXT("index"), Index);
+            Failure->SetStringField(TEXT("error"), Actor ? TEXT("Actor has no root component") : *ActorError);
+            Failures.Add(MakeShared<FJsonValueObject>(Failure));
+            continue;
+        }
+
+        // Layouts without rotation or scale leave those parts of the transform untouched
+        const float* Item = Values.GetData() + Index * Stride;
+        FTransform Transform = Actor->GetActorTransform();
+        Transform.SetLocation(FVector(Item[0], Item[1], Item[2]));
+        if (Stride >= 6)
+        {
+            Transform.SetRotation(FQuat(FRotator(Item[3], Item[4], Item[5])));
+        }
+        if (Stride >= 9)
+        {
+            Transform.SetScale3D(FVector(Item[6], Item[7], Item[8]));
+        }
+
+        if (bTransactional)
+        {
+            Actor->Modify();
+        }
+
+        MovementScopes.Add(MakeUnique<FScopedMovementUpdate>(Root, EScopedUpdate::DeferredUpdates));
+        Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::TeleportPhysics);
+        if (SpatialIndex)
+        {
+            SpatialIndex->NotifyActorMoved(Actor);
+        }
+        ++Updated;
     }
 
-    if (!TargetActor)
+    // Scopes on one component nest, so they must close innermost first
+    while (MovementScopes.Num() > 0)
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor not found: %s"), *ActorName));
+        MovementScopes.Pop();
     }
 
-    // Always return detailed properties for this command
-    return FUnrealMCPCommonUtils::ActorToJsonObject(TargetActor, true);
+    if (OwnBatch)
+    {
+        OwnBatch->Commit();
+    }
+    else if (!FMCPEditBatch::Get())
+    {
+        GEditor->RedrawLevelEditingViewports();
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetNumberField(TEXT("count"), Count);
+    ResultObj->SetNumberField(TEXT("updated"), Updated);
+    ResultObj->SetNumberField(TEXT("failed"), Failures.Num());
+    ResultObj->SetArrayField(TEXT("failures"), Failures);
+    ResultObj->SetNumberField(TEXT("elapsed_ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+    return ResultObj;
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorProperty(const TSharedPtr<FJsonObject>& Params)
+FMCPSpatialIndex& FUnrealMCPEditorCommands::GetSpatialIndex(bool& bOutRebuilt)
 {
-    // Get actor name
-    FString ActorName;
-    if (!Params->TryGetStringField(TEXT("name"), ActorName))
+    if (!SpatialIndex)
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'name' parameter"));
+        SpatialIndex = MakeUnique<FMCPSpatialIndex>();
     }
+    bOutRebuilt = SpatialIndex->Refresh(GEditor->GetEditorWorldContext().World());
+    return *SpatialIndex;
+}
 
-    // Find the actor
-    AActor* TargetActor = nullptr;
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
-    
-    for (AActor* Actor : AllActors)
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleFindActorsInRadius(const TSharedPtr<FJsonObject>& Params)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    double Radius = 0.0;
+    if (!Params->HasField(TEXT("center")) || !Params->TryGetNumberField(TEXT("radius"), Radius) || Radius < 0.0)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'center' or non-negative 'radius' parameter"));
+    }
+    const FVector Center = FUnrealMCPCommonUtils::GetVectorFromJson(Params, TEXT("center"));
+
+    int32 MaxResults = 1000;
+    Params->TryGetNumberField(TEXT("max_results"), MaxResults);
+
+    bool bRebuilt = false;
+    FMCPSpatialIndex& Index = GetSpatialIndex(bRebuilt);
+
+    // Collect every hit before cutting, so a truncated result holds the nearest actors
+    TArray<FMCPSpatialIndex::FHit> Hits;
+    Index.QuerySphere(Center, Radius, MakeClassFilter(Params), MAX_int32, Hits);
+    Hits.Sort([](const FMCPSpatialIndex::FHit& A, const FMCPSpatialIndex::FHit& B) { return A.DistanceSquared < B.DistanceSquared; });
+    const bool bComplete = Hits.Num() <= FMath::Max(MaxResults, 0);
+    if (!bComplete)
+    {
+        Hits.SetNum(FMath::Max(MaxResults, 0), EAllowShrinking::No);
+    }
+    return MakeSpatialQueryResult(Hits, bComplete, bRebuilt, Index, StartTime);
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleFindActorsInBox(const TSharedPtr<FJsonObject>& Params)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    if (!Params->HasField(TEXT("min")) || !Params->HasField(TEXT("max")))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'min' or 'max' parameter"));
+    }
+    const FVector Min = FUnrealMCPCommonUtils::GetVectorFromJson(Params, TEXT("min"));
+    const FVector Max = FUnrealMCPCommonUtils::GetVectorFromJson(Params, TEXT("max"));
+    const FBox Box(Min.ComponentMin(Max), Min.ComponentMax(Max));
+
+    int32 MaxResults = 1000;
+    Params->TryGetNumberField(TEXT("max_results"), MaxResults);
+
+    bool bRebuilt = false;
+    FMCPSpatialIndex& Index = GetSpatialIndex(bRebuilt);
+
+    TArray<FMCPSpatialIndex::FHit> Hits;
+    const bool bComplete = Index.QueryBox(Box, MakeClassFilter(Params), FMath::Max(MaxResults, 0), Hits);
+    return MakeSpatialQueryResult(Hits, bComplete, bRebuilt, Index, StartTime);
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleFindNearestActors(const TSharedPtr<FJsonObject>& Params)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    if (!Params->HasField(TEXT("point")))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'point' parameter"));
+    }
+    const FVector Point = FUnrealMCPCommonUtils::GetVectorFromJson(Params, TEXT("point"));
+
+    int32 Count = 10;
+    Params->TryGetNumberField(TEXT("count"), Count);
+    double MaxDistance = 0.0;
+    Params->TryGetNumberField(TEXT("max_distance"), MaxDistance);
+
+    // The actor queried around is usually not an interesting answer
+    FString ExcludeName;
+    Params->TryGetStringField(TEXT("exclude"), ExcludeName);
+    const FName ExcludeFName = ExcludeName.IsEmpty() ? NAME_None : FName(*ExcludeName);
+    const TFunction<bool(const AActor*)> ClassFilter = MakeClassFilter(Params);
+
+    bool bRebuilt = false;
+    FMCPSpatialIndex& Index = GetSpatialIndex(bRebuilt);
+
+    TArray<FMCPSpatialIndex::FHit> Hits;
+    Index.QueryNearest(Point, FMath::Clamp(Count, 0, 10000), MaxDistance,
+        [&ClassFilter, ExcludeFName](const AActor* Actor)
+        {
+            return (ExcludeFName.IsNone() || Actor->GetFName() != ExcludeFName) && ClassFilter(Actor);
+        }, Hits);
+    return MakeSpatialQueryResult(Hits, true, bRebuilt, Index, StartTime);
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSnapshotLevel(const TSharedPtr<FJsonObject>& Params)
+{
+    UWorld* World = GEditor->GetEditorWorldContext().World();
+    if (!World)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get editor world"));
+    }
+
+    TArray<FName> PropertyNames;
+    const TArray<TSharedPtr<FJsonValue>>* PropertyValues = nullptr;
+    if (Params->TryGetArrayField(TEXT("properties"), PropertyValues))
+    {
+        for (const TSharedPtr<FJsonValue>& Value : *PropertyValues)
+        {
+            PropertyNames.Add(FName(*Value->AsString()));
+        }
+    }
+    bool bIncludeComponents = true;
+    Params->TryGetBoolField(TEXT("include_components"), bIncludeComponents);
+
+    TSharedRef<FMCPLevelSnapshot> Snapshot = FMCPLevelSnapshot::Capture(World, PropertyNames, bIncludeComponents);
+    const int32 SnapshotId = NextSnapshotId++;
+    Snapshots.Add(SnapshotId, Snapshot);
+
+    // Evict the oldest snapshots beyond the count or memory budget, never the new one
+    TArray<TSharedPtr<FJsonValue>> Evicted;
+    SIZE_T TotalBytes = 0;
+    for (const TPair<int32, TSharedPtr<FMCPLevelSnapshot>>& Stored : Snapshots)
+    {
+        TotalBytes += Stored.Value->GetAllocatedSize();
+    }
+    while (Snapshots.Num() > 1 && (Snapshots.Num() > MaxStoredSnapshots || TotalBytes > MaxStoredSnapshotBytes))
+    {
+        int32 OldestId = MAX_int32;
+        for (const TPair<int32, TSharedPtr<FMCPLevelSnapshot>>& Stored : Snapshots)
+        {
+            OldestId = FMath::Min(OldestId, Stored.Key);
+        }
+        TotalBytes -= Snapshots.FindChecked(OldestId)->GetAllocatedSize();
+        Snapshots.Remove(OldestId);
+        Evicted.Add(MakeShared<FJsonValueNumber>(OldestId));
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetNumberField(TEXT("snapshot_id"), SnapshotId);
+    ResultObj->SetNumberField(TEXT("actor_count"), Snapshot->GetEntries().Num());
+    ResultObj->SetNumberField(TEXT("bytes"), (double)Snapshot->GetAllocatedSize());
+    ResultObj->SetNumberField(TEXT("capture_ms"), Snapshot->GetCaptureSeconds() * 1000.0);
+    ResultObj->SetNumberField(TEXT("hash_ms"), Snapshot->GetHashSeconds() * 1000.0);
+    ResultObj->SetNumberField(TEXT("stored_snapshots"), Snapshots.Num());
+    ResultObj->SetNumberField(TEXT("stored_bytes"), (double)TotalBytes);
+    ResultObj->SetArrayField(TEXT("evicted"), Evicted);
+    return ResultObj;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleDiffLevel(const TSharedPtr<FJsonObject>& Params)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    int32 FromId = 0;
+    if (!Params->TryGetNumberField(TEXT("from"), FromId))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'from' parameter"));
+    }
+    const TSharedPtr<FMCPLevelSnapshot>* From = Snapshots.Find(FromId);
+    if (!From)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown or evicted snapshot: %d"), FromId));
+    }
+
+    // Without "to", compare against the live world using the same property selection
+    TSharedPtr<FMCPLevelSnapshot> To;
+    int32 ToId = 0;
+    if (Params->TryGetNumberField(TEXT("to"), ToId))
+    {
+        const TSharedPtr<FMCPLevelSnapshot>* Stored = Snapshots.Find(ToId);
+        if (!Stored)
+        {
+            return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown or evicted snapshot: %d"), ToId));
+        }
+        To = *Stored;
+        if (!(*From)->HasSamePropertySelection(*To))
+        {
+            return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Snapshots were captured with different property selections"));
+        }
+    }
+    else
+    {
+        To = FMCPLevelSnapshot::Capture(GEditor->GetEditorWorldContext().World(), (*From)->GetPropertyNames(), (*From)->IncludesComponents());
+    }
+
+    double Tolerance = 0.01;
+    Params->TryGetNumberField(TEXT("transform_tolerance"), Tolerance);
+    int32 MaxResults = 1000;
+    Params->TryGetNumberField(TEXT("max_results"), MaxResults);
+
+    const FMCPLevelSnapshotDiff Diff = FMCPLevelSnapshot::Diff(**From, *To, (float)Tolerance);
+    const TArray<FMCPActorSnapshot>& FromEntries = (*From)->GetEntries();
+    const TArray<FMCPActorSnapshot>& ToEntries = To->GetEntries();
+
+    TArray<TSharedPtr<FJsonValue>> Added;
+    for (int32 Index = 0; Index < FMath::Min(Diff.Added.Num(), MaxResults); ++Index)
+    {
+        Added.Add(MakeShared<FJsonValueObject>(ActorSnapshotToJson(ToEntries[Diff.Added[Index]])));
+    }
+    TArray<TSharedPtr<FJsonValue>> Removed;
+    for (int32 Index = 0; Index < FMath::Min(Diff.Removed.Num(), MaxResults); ++Index)
     {
-        if (Actor && Actor->GetName() == ActorName)
+        Removed.Add(MakeShared<FJsonValueObject>(ActorSnapshotToJson(FromEntries[Diff.Removed[Index]])));
+    }
+    TArray<TSharedPtr<FJsonValue>> Changed;
+    for (int32 Index = 0; Index < FMath::Min(Diff.Changed.Num(), MaxResults); ++Index)
+    {
+        const FMCPLevelSnapshotDiff::FChange& Change = Diff.Changed[Index];
+        const FMCPActorSnapshot& Before = FromEntries[Change.FromIndex];
+        const FMCPActorSnapshot& After = ToEntries[Change.ToIndex];
+
+        TSharedPtr<FJsonObject> ActorObject = ActorSnapshotToJson(After);
+        TArray<TSharedPtr<FJsonValue>> What;
+        if (Change.bTransform)
+        {
+            What.Add(MakeShared<FJsonValueString>(TEXT("transform")));
+            TSharedPtr<FJsonObject> BeforeObject = MakeShared<FJsonObject>();
+            BeforeObject->SetArrayField(TEXT("location"), Vector3fToJson(Before.Location));
+            BeforeObject->SetArrayField(TEXT("rotation"), Vector3fToJson(FVector3f(Before.Rotation.Pitch, Before.Rotation.Yaw, Before.Rotation.Roll)));
+            BeforeObject->SetArrayField(TEXT("scale"), Vector3fToJson(Before.Scale));
+            TSharedPtr<FJsonObject> AfterObject = MakeShared<FJsonObject>();
+            AfterObject->SetArrayField(TEXT("location"), Vector3fToJson(After.Location));
+            AfterObject->SetArrayField(TEXT("rotation"), Vector3fToJson(FVector3f(After.Rotation.Pitch, After.Rotation.Yaw, After.Rotation.Roll)));
+            AfterObject->SetArrayField(TEXT("scale"), Vector3fToJson(After.Scale));
+            ActorObject->SetObjectField(TEXT("before"), BeforeObject);
+            ActorObject->SetObjectField(TEXT("after"), AfterObject);
+        }
+        if (Change.bProperties)
+        {
+            What.Add(MakeShared<FJsonValueString>(TEXT("properties")));
+        }
+        if (Change.bRenamed)
         {
-            TargetActor = Actor;
-            break;
+            What.Add(MakeShared<FJsonValueString>(TEXT("name")));
+            ActorObject->SetStringField(TEXT("previous_name"), Before.Name.ToString());
         }
+        ActorObject->SetArrayField(TEXT("changes"), What);
+        Changed.Add(MakeShared<FJsonValueObject>(ActorObject));
     }
 
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetNumberField(TEXT("from"), FromId);
+    if (ToId != 0)
+    {
+        ResultObj->SetNumberField(TEXT("to"), ToId);
+    }
+    else
+    {
+        ResultObj->SetStringField(TEXT("to"), TEXT("live"));
+        ResultObj->SetNumberField(TEXT("hash_ms"), To->GetHashSeconds() * 1000.0);
+    }
+    ResultObj->SetNumberField(TEXT("added_count"), Diff.Added.Num());
+    ResultObj->SetNumberField(TEXT("removed_count"), Diff.Removed.Num());
+    ResultObj->SetNumberField(TEXT("changed_count"), Diff.Changed.Num());
+    ResultObj->SetArrayField(TEXT("added"), Added);
+    ResultObj->SetArrayField(TEXT("removed"), Removed);
+    ResultObj->SetArrayField(TEXT("changed"), Changed);
+    ResultObj->SetBoolField(TEXT("truncated"), Diff.Added.Num() > MaxResults || Diff.Removed.Num() > MaxResults || Diff.Changed.Num() > MaxResults);
+    ResultObj->SetNumberField(TEXT("elapsed_ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+    return ResultObj;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleGetActorProperties(const TSharedPtr<FJsonObject>& Params)
+{
+    // Find the actor by handle or name
+    FString Error;
+    AActor* TargetActor = FUnrealMCPCommonUtils::FindActorFromParams(Params, Error);
     if (!TargetActor)
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor not found: %s"), *ActorName));
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+
+    // Always return detailed properties for this command
+    return FUnrealMCPCommonUtils::ActorToJsonObject(TargetActor, true);
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorProperty(const TSharedPtr<FJsonObject>& Params)
+{
+    // Find the actor by handle or name
+    FString Error;
+    AActor* TargetActor = FUnrealMCPCommonUtils::FindActorFromParams(Params, Error);
+    if (!TargetActor)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
     }
 
     // Get property name
@@ -412,9 +1126,15 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorProperty(const T
     FString ErrorMessage;
     if (FUnrealMCPCommonUtils::SetObjectProperty(TargetActor, PropertyName, PropertyValue, ErrorMessage))
     {
+        // The property may have changed the actor's bounds
+        if (SpatialIndex)
+        {
+            SpatialIndex->NotifyActorMoved(TargetActor);
+        }
+
         // Property set successfully
         TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-        ResultObj->SetStringField(TEXT("actor"), ActorName);
+        ResultObj->SetStringField(TEXT("actor"), TargetActor->GetName());
         ResultObj->SetStringField(TEXT("property"), PropertyName);
         ResultObj->SetBoolField(TEXT("success"), true);
         
@@ -507,9 +1227,8 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSpawnBlueprintActor(cons
 
 TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleFocusViewport(const TSharedPtr<FJsonObject>& Params)
 {
-    // Get target actor name if provided
-    FString TargetActorName;
-    bool HasTargetActor = Params->TryGetStringField(TEXT("target"), TargetActorName);
+    // Get target actor if provided, by handle or name
+    bool HasTargetActor = Params->HasField(TEXT("target")) || Params->HasField(TEXT("handle"));
 
     // Get location if provided
     FVector Location(0.0f, 0.0f, 0.0f);
@@ -537,7 +1256,8 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleFocusViewport(const TSha
     }
 
     // Get the active viewport
-    FLevelEditorViewportClient* ViewportClient = (FLevelEditorViewportClient*)GEditor->GetActiveViewport()->GetClient();
+    FViewport* ActiveViewport = GEditor->GetActiveViewport();
+    FLevelEditorViewportClient* ViewportClient = ActiveViewport ? (FLevelEditorViewportClient*)ActiveViewport->GetClient() : nullptr;
     if (!ViewportClient)
     {
         return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get active viewport"));
@@ -547,22 +1267,11 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleFocusViewport(const TSha
     if (HasTargetActor)
     {
         // Find the actor
-        AActor* TargetActor = nullptr;
-        TArray<AActor*> AllActors;
-        UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
-        
-        for (AActor* Actor : AllActors)
-        {
-            if (Actor && Actor->GetName() == TargetActorName)
-            {
-                TargetActor = Actor;
-                break;
-            }
-        }
-
+        FString Error;
+        AActor* TargetActor = FUnrealMCPCommonUtils::FindActorFromParams(Params, Error, TEXT("target"));
         if (!TargetActor)
         {
-            return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor not found: %s"), *TargetActorName));
+            return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
         }
 
         // Focus on the actor
@@ -592,45 +1301,275 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleFocusViewport(const TSha
     return ResultObj;
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleTakeScreenshot(const TSharedPtr<FJsonObject>& Params)
+TFuture<FMCPCommandResult> FUnrealMCPEditorCommands::HandleTakeScreenshot(const TSharedPtr<FJsonObject>& Params)
 {
-    // Get file path parameter
+    FMCPScreenshotRequest Request;
+
+    // Output format and quality
+    if (Params->HasField(TEXT("format")))
+    {
+        Request.Format = Params->GetStringField(TEXT("format")).ToLower();
+    }
+    if (Request.Format != TEXT("png") && Request.Format != TEXT("jpeg") && Request.Format != TEXT("jpg"))
+    {
+        return MakeFulfilledPromise<FMCPCommandResult>(FMCPCommandResult(
+            FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unsupported screenshot format: %s"), *Request.Format)))).GetFuture();
+    }
+    if (Params->HasField(TEXT("quality")))
+    {
+        Request.Quality = Params->GetIntegerField(TEXT("quality"));
+    }
+
+    // Downscaling: explicit max size, legacy [width, height] resolution, or a scale factor
+    if (Params->HasField(TEXT("max_width")))
+    {
+        Request.MaxWidth = Params->GetIntegerField(TEXT("max_width"));
+    }
+    if (Params->HasField(TEXT("max_height")))
+    {
+        Request.MaxHeight = Params->GetIntegerField(TEXT("max_height"));
+    }
+    if (Params->HasField(TEXT("resolution")))
+    {
+        const FVector2D Resolution = FUnrealMCPCommonUtils::GetVector2DFromJson(Params, TEXT("resolution"));
+        Request.MaxWidth = (int32)Resolution.X;
+        Request.MaxHeight = (int32)Resolution.Y;
+    }
+    if (Params->HasField(TEXT("scale")))
+    {
+        Request.Scale = (float)Params->GetNumberField(TEXT("scale"));
+    }
+
+    // Offscreen stand-in (always used under -nullrhi)
+    if (Params->HasField(TEXT("offscreen")))
+    {
+        Request.bOffscreen = Params->GetBoolField(TEXT("offscreen"));
+    }
+    if (Params->HasField(TEXT("offscreen_size")))
+    {
+        const FVector2D OffscreenSize = FUnrealMCPCommonUtils::GetVector2DFromJson(Params, TEXT("offscreen_size"));
+        Request.OffscreenSize = FIntPoint((int32)OffscreenSize.X, (int32)OffscreenSize.Y);
+    }
+
+    // Delivery: "file" (legacy), "base64" inline in the JSON result, or "binary" frame payload
     FString FilePath;
-    if (!Params->TryGetStringField(TEXT("filepath"), FilePath))
+    const bool bHasFilePath = Params->TryGetStringField(TEXT("filepath"), FilePath) && !FilePath.IsEmpty();
+    FString Delivery = bHasFilePath ? TEXT("file") : TEXT("base64");
+    if (Params->HasField(TEXT("delivery")))
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'filepath' parameter"));
+        Delivery = Params->GetStringField(TEXT("delivery")).ToLower();
     }
-    
-    // Ensure the file path has a proper extension
-    if (!FilePath.EndsWith(TEXT(".png")))
+    if (Delivery != TEXT("file") && Delivery != TEXT("base64") && Delivery != TEXT("binary"))
+    {
+        return MakeFulfilledPromise<FMCPCommandResult>(FMCPCommandResult(
+            FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown screenshot delivery: %s"), *Delivery)))).GetFuture();
+    }
+    if (Delivery == TEXT("file") && !bHasFilePath)
     {
-        FilePath += TEXT(".png");
+        return MakeFulfilledPromise<FMCPCommandResult>(FMCPCommandResult(
+            FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'filepath' parameter")))).GetFuture();
     }
 
-    // Get the active viewport
-    if (GEditor && GEditor->GetActiveViewport())
+    if (bHasFilePath)
     {
-        FViewport* Viewport = GEditor->GetActiveViewport();
-        TArray<FColor> Bitmap;
-        FIntRect ViewportRect(0, 0, Viewport->GetSizeXY().X, Viewport->GetSizeXY().Y);
-        
-        if (Viewport->ReadPixels(Bitmap, FReadSurfaceDataFlags(), ViewportRect))
+        // Ensure the file path has an extension matching the format
+        const FString Extension = FPaths::GetExtension(FilePath).ToLower();
+        const bool bJpeg = Request.Format != TEXT("png");
+        if (bJpeg ? (Extension != TEXT("jpg") && Extension != TEXT("jpeg")) : Extension != TEXT("png"))
         {
-            TArray<uint8> CompressedBitmap;
-            FImageUtils::CompressImageArray(Viewport->GetSizeXY().X, Viewport->GetSizeXY().Y, Bitmap, CompressedBitmap);
-            
-            if (FFileHelper::SaveArrayToFile(CompressedBitmap, *FilePath))
-            {
-                TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-                ResultObj->SetStringField(TEXT("filepath"), FilePath);
-                return ResultObj;
-            }
+            FilePath += bJpeg ? TEXT(".jpg") : TEXT(".png");
         }
+        Request.FilePath = FilePath;
     }
-    
-    return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to take screenshot"));
+
+    FViewport* Viewport = GEditor ? GEditor->GetActiveViewport() : nullptr;
+    if (!Viewport && !Request.bOffscreen && !GUsingNullRHI)
+    {
+        return MakeFulfilledPromise<FMCPCommandResult>(FMCPCommandResult(
+            FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get active viewport")))).GetFuture();
+    }
+
+    return FMCPScreenshotCapture::CaptureAsync(Viewport, Request).Next([Delivery](FMCPScreenshotResult Screenshot)
+    {
+        if (!Screenshot.bSuccess)
+        {
+            return FMCPCommandResult(FUnrealMCPCommonUtils::CreateErrorResponse(Screenshot.Error));
+        }
+
+        TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+        ResultObj->SetStringField(TEXT("format"), Screenshot.Format);
+        ResultObj->SetStringField(TEXT("source"), Screenshot.Source);
+        ResultObj->SetBoolField(TEXT("placeholder"), Screenshot.bPlaceholder);
+        ResultObj->SetStringField(TEXT("delivery"), Delivery);
+        ResultObj->SetNumberField(TEXT("width"), Screenshot.OutputSize.X);
+        ResultObj->SetNumberField(TEXT("height"), Screenshot.OutputSize.Y);
+        ResultObj->SetNumberField(TEXT("source_width"), Screenshot.SourceSize.X);
+        ResultObj->SetNumberField(TEXT("source_height"), Screenshot.SourceSize.Y);
+        ResultObj->SetNumberField(TEXT("size_bytes"), Screenshot.EncodedImage.Num());
+        ResultObj->SetNumberField(TEXT("readback_ms"), Screenshot.ReadbackMs);
+        ResultObj->SetNumberField(TEXT("encode_ms"), Screenshot.EncodeMs);
+        if (!Screenshot.FilePath.IsEmpty())
+        {
+            ResultObj->SetStringField(TEXT("filepath"), Screenshot.FilePath);
+        }
+
+        FMCPCommandResult CommandResult(ResultObj);
+        if (Delivery == TEXT("base64"))
+        {
+            ResultObj->SetStringField(TEXT("image_base64"), FBase64::Encode(Screenshot.EncodedImage));
+        }
+        else if (Delivery == TEXT("binary"))
+        {
+            // The encoded image becomes the frame payload
+            ResultObj->SetStringField(TEXT("attachment"), TEXT("image"));
+            CommandResult.Attachment = MoveTemp(Screenshot.EncodedImage);
+        }
+        return CommandResult;
+    });
 }
 
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleStartViewportStream(const TSharedPtr<FJsonObject>& Params)
+{
+    // Frames are pushed back on the connection that asked for them
+    const FMCPRequestContext* Context = FMCPRequestContext::Get();
+    if (!Context || !Context->Connection.IsValid())
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Viewport streaming requires a persistent client connection"));
+    }
+
+    PruneViewportStreams();
+
+    FMCPViewportStreamSettings Settings;
+    Settings.Capture.MaxWidth = 1280;
+    Settings.Capture.MaxHeight = 720;
+
+    if (Params->HasField(TEXT("fps")))
+    {
+        Settings.FrameRate = FMath::Clamp((float)Params->GetNumberField(TEXT("fps")), 0.5f, 60.0f);
+    }
+    if (Params->HasField(TEXT("max_width")))
+    {
+        Settings.Capture.MaxWidth = Params->GetIntegerField(TEXT("max_width"));
+    }
+    if (Params->HasField(TEXT("max_height")))
+    {
+        Settings.Capture.MaxHeight = Params->GetIntegerField(TEXT("max_height"));
+    }
+    if (Params->HasField(TEXT("scale")))
+    {
+        Settings.Capture.Scale = (float)Params->GetNumberField(TEXT("scale"));
+    }
+    if (Params->HasField(TEXT("offscreen")))
+    {
+        Settings.Capture.bOffscreen = Params->GetBoolField(TEXT("offscreen"));
+    }
+    if (Params->HasField(TEXT("offscreen_size")))
+    {
+        const FVector2D OffscreenSize = FUnrealMCPCommonUtils::GetVector2DFromJson(Params, TEXT("offscreen_size"));
+        Settings.Capture.OffscreenSize = FIntPoint((int32)OffscreenSize.X, (int32)OffscreenSize.Y);
+    }
+    if (Params->HasField(TEXT("tile_size")))
+    {
+        Settings.TileSize = FMath::Clamp(Params->GetIntegerField(TEXT("tile_size")), 16, 256);
+    }
+    if (Params->HasField(TEXT("max_in_flight")))
+    {
+        Settings.MaxInFlightFrames = FMath::Clamp(Params->GetIntegerField(TEXT("max_in_flight")), 1, 8);
+    }
+
+    FViewport* Viewport = GEditor ? GEditor->GetActiveViewport() : nullptr;
+    if (!Viewport && !Settings.Capture.bOffscreen && !GUsingNullRHI)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get active viewport"));
+    }
+
+    const int32 StreamId = NextViewportStreamId++;
+    TSharedPtr<FMCPViewportStream, ESPMode::ThreadSafe> Stream = MakeShared<FMCPViewportStream, ESPMode::ThreadSafe>(StreamId, Settings, Context->Connection);
+    ViewportStreams.Add(StreamId, Stream);
+    Stream->Start();
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetNumberField(TEXT("stream_id"), StreamId);
+    ResultObj->SetNumberField(TEXT("fps"), Settings.FrameRate);
+    ResultObj->SetNumberField(TEXT("tile_size"), Settings.TileSize);
+    ResultObj->SetNumberField(TEXT("max_in_flight"), Settings.MaxInFlightFrames);
+    ResultObj->SetStringField(TEXT("encoding"), TEXT("zlib_bgra"));
+    return ResultObj;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleStopViewportStream(const TSharedPtr<FJsonObject>& Params)
+{
+    FString Error;
+    TSharedPtr<FMCPViewportStream, ESPMode::ThreadSafe> Stream = FindViewportStream(Params, Error);
+    if (!Stream.IsValid())
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+
+    Stream->Stop(TEXT("stopped by client"), false);
+    ViewportStreams.Remove(Stream->GetStreamId());
+
+    TSharedPtr<FJsonObject> ResultObj = Stream->GetStats();
+    ResultObj->SetBoolField(TEXT("success"), true);
+    return ResultObj;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleAckViewportFrame(const TSharedPtr<FJsonObject>& Params)
+{
+    FString Error;
+    TSharedPtr<FMCPViewportStream, ESPMode::ThreadSafe> Stream = FindViewportStream(Params, Error);
+    if (!Stream.IsValid())
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+
+    int32 Frame = 0;
+    if (!Params->TryGetNumberField(TEXT("frame"), Frame))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'frame' parameter"));
+    }
+
+    bool bKeyframe = false;
+    Params->TryGetBoolField(TEXT("keyframe"), bKeyframe);
+    Stream->Acknowledge(Frame, bKeyframe);
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetNumberField(TEXT("stream_id"), Stream->GetStreamId());
+    ResultObj->SetBoolField(TEXT("active"), Stream->IsActive());
+    return ResultObj;
+}
+
+TSharedPtr<FMCPViewportStream, ESPMode::ThreadSafe> FUnrealMCPEditorCommands::FindViewportStream(const TSharedPtr<FJsonObject>& Params, FString& OutError)
+{
+    int32 StreamId = 0;
+    if (!Params->TryGetNumberField(TEXT("stream_id"), StreamId))
+    {
+        OutError = TEXT("Missing 'stream_id' parameter");
+        return nullptr;
+    }
+
+    const TSharedPtr<FMCPViewportStream, ESPMode::ThreadSafe>* Stream = ViewportStreams.Find(StreamId);
+    const FMCPRequestContext* Context = FMCPRequestContext::Get();
+    if (!Stream || !Context || !(*Stream)->IsOwnedBy(Context->Connection.Get()))
+    {
+        // Streams are only visible to the connection that started them
+        OutError = FString::Printf(TEXT("Viewport stream not found: %d"), StreamId);
+        return nullptr;
+    }
+    return *Stream;
+}
+
+void FUnrealMCPEditorCommands::PruneViewportStreams()
+{
+    for (auto It = ViewportStreams.CreateIterator(); It; ++It)
+    {
+        if (!It->Value->IsActive())
+        {
+            It->Value->Stop(TEXT("inactive"), false);
+            It.RemoveCurrent();
+        }
+    }
+}
 
 TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleGetConsoleOutput(const TSharedPtr<FJsonObject>& Params)
 {
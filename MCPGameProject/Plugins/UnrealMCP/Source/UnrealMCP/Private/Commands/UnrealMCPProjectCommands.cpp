@@ -1,6 +1,56 @@
 #include "Commands/UnrealMCPProjectCommands.h"
 #include "Commands/UnrealMCPCommonUtils.h"
 #include "GameFramework/InputSettings.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/Async.h"
+#include "String/Find.h"
+
+namespace
+{
+    // Page size when 'limit' is not given, and the largest page returned at once
+    const int32 DefaultAssetPageSize = 100;
+    const int32 MaxAssetPageSize = 5000;
+
+    TFuture<FMCPCommandResult> MakeErrorFuture(const FString& Message)
+    {
+        return MakeFulfilledPromise<FMCPCommandResult>(FMCPCommandResult(
+            FUnrealMCPCommonUtils::CreateErrorResponse(Message))).GetFuture();
+    }
+
+    // A field given either as a single string or as an array of strings
+    void GetStringList(const TSharedPtr<FJsonObject>& Params, const FString& FieldName, TArray<FString>& OutValues)
+    {
+        FString Value;
+        const TArray<TSharedPtr<FJsonValue>>* Values = nullptr;
+        if (Params->TryGetArrayField(FieldName, Values))
+        {
+            for (const TSharedPtr<FJsonValue>& Item : *Values)
+            {
+                OutValues.Add(Item->AsString());
+            }
+        }
+        else if (Params->TryGetStringField(FieldName, Value))
+        {
+            OutValues.Add(Value);
+        }
+    }
+
+    // Class path for a short name ("StaticMesh") or a full path ("/Script/Engine.StaticMesh")
+    bool ResolveClassPath(const FString& ClassName, FTopLevelAssetPath& OutPath)
+    {
+        if (ClassName.StartsWith(TEXT("/")))
+        {
+            return OutPath.TrySetPath(ClassName);
+        }
+        if (UClass* Class = UClass::TryFindTypeSlow<UClass>(ClassName, EFindFirstObjectOptions::ExactClass))
+        {
+            OutPath = Class->GetClassPathName();
+            return true;
+        }
+        return false;
+    }
+}
 
 FUnrealMCPProjectCommands::FUnrealMCPProjectCommands()
 {
@@ -16,6 +66,21 @@ TSharedPtr<FJsonObject> FUnrealMCPProjectCommands::HandleCommand(const FString&
     return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown project command: %s"), *CommandType));
 }
 
+bool FUnrealMCPProjectCommands::IsAsyncCommand(const FString& CommandType) const
+{
+    return CommandType == TEXT("find_assets");
+}
+
+TFuture<FMCPCommandResult> FUnrealMCPProjectCommands::HandleCommandAsync(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+{
+    if (CommandType == TEXT("find_assets"))
+    {
+        return HandleFindAssets(Params);
+    }
+
+    return MakeErrorFuture(FString::Printf(TEXT("Unknown async project command: %s"), *CommandType));
+}
+
 TSharedPtr<FJsonObject> FUnrealMCPProjectCommands::HandleCreateInputMapping(const TSharedPtr<FJsonObject>& Params)
 {
     // Get required parameters
@@ -69,4 +134,161 @@ TSharedPtr<FJsonObject> FUnrealMCPProjectCommands::HandleCreateInputMapping(cons
     ResultObj->SetStringField(TEXT("action_name"), ActionName);
     ResultObj->SetStringField(TEXT("key"), Key);
     return ResultObj;
-} 
\ No newline at end of file
+}
+
+TFuture<FMCPCommandResult> FUnrealMCPProjectCommands::HandleFindAssets(const TSharedPtr<FJsonObject>& Params)
+{
+    // Build the registry filter on the game thread, where class names can be resolved
+    FARFilter Filter;
+    Filter.bIncludeOnlyOnDiskAssets = true;
+
+    TArray<FString> ClassNames;
+    GetStringList(Params, TEXT("class"), ClassNames);
+    for (const FString& ClassName : ClassNames)
+    {
+        FTopLevelAssetPath ClassPath;
+        if (!ResolveClassPath(ClassName, ClassPath))
+        {
+            return MakeErrorFuture(FString::Printf(TEXT("Unknown asset class: %s"), *ClassName));
+        }
+        Filter.ClassPaths.Add(ClassPath);
+    }
+    Filter.bRecursiveClasses = true;
+    Params->TryGetBoolField(TEXT("recursive_classes"), Filter.bRecursiveClasses);
+
+    TArray<FString> Paths;
+    GetStringList(Params, TEXT("paths"), Paths);
+    GetStringList(Params, TEXT("path"), Paths);
+    for (const FString& Path : Paths)
+    {
+        Filter.PackagePaths.Add(FName(*Path));
+    }
+    Filter.bRecursivePaths = true;
+    Params->TryGetBoolField(TEXT("recursive"), Filter.bRecursivePaths);
+
+    // Tags: {"TagName": "Value"} matches a value, {"TagName": null} or "" only requires the tag
+    const TSharedPtr<FJsonObject>* Tags = nullptr;
+    if (Params->TryGetObjectField(TEXT("tags"), Tags))
+    {
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Tag : (*Tags)->Values)
+        {
+            FString TagValue;
+            if (Tag.Value.IsValid() && Tag.Value->TryGetString(TagValue) && !TagValue.IsEmpty())
+            {
+                Filter.TagsAndValues.Add(FName(*Tag.Key), TagValue);
+            }
+            else
+            {
+                Filter.TagsAndValues.Add(FName(*Tag.Key));
+            }
+        }
+    }
+
+    FString NameContains;
+    Params->TryGetStringField(TEXT("name_contains"), NameContains);
+
+    // Tag values to return with each asset; "*" returns all of them
+    TArray<FString> IncludeTagNames;
+    GetStringList(Params, TEXT("include_tags"), IncludeTagNames);
+    const bool bAllTags = IncludeTagNames.Contains(TEXT("*"));
+    TArray<FName> IncludeTags;
+    for (const FString& TagName : IncludeTagNames)
+    {
+        IncludeTags.Add(FName(*TagName));
+    }
+
+    int32 Offset = 0;
+    int32 Limit = DefaultAssetPageSize;
+    Params->TryGetNumberField(TEXT("offset"), Offset);
+    Params->TryGetNumberField(TEXT("limit"), Limit);
+    Offset = FMath::Max(0, Offset);
+    Limit = FMath::Clamp(Limit, 1, MaxAssetPageSize);
+
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    IAssetRegistry* Registry = &AssetRegistry;
+    const bool bRegistryLoading = AssetRegistry.IsLoadingAssets();
+
+    // The registry is internally locked and on-disk queries never load packages,
+    // so the search, sort and JSON building run on the thread pool.
+    return Async(EAsyncExecution::ThreadPool, [Registry, Filter = MoveTemp(Filter), NameContains, IncludeTags, bAllTags, Offset, Limit, bRegistryLoading]()
+    {
+        const double StartTime = FPlatformTime::Seconds();
+
+        TArray<FAssetData> Assets;
+        Registry->EnumerateAssets(Filter, [&Assets, &NameContains](const FAssetData& Asset)
+        {
+            if (!NameContains.IsEmpty())
+            {
+                TStringBuilder<128> AssetName;
+                Asset.AssetName.AppendString(AssetName);
+                if (UE::String::FindFirst(AssetName.ToView(), NameContains, ESearchCase::IgnoreCase) == INDEX_NONE)
+                {
+                    return true;
+                }
+            }
+            Assets.Add(Asset);
+            return true;
+        });
+
+        // Stable order so offset/limit pages line up between calls
+        Assets.Sort([](const FAssetData& A, const FAssetData& B)
+        {
+            const int32 PackageOrder = A.PackageName.Compare(B.PackageName);
+            return PackageOrder != 0 ? PackageOrder < 0 : A.AssetName.Compare(B.AssetName) < 0;
+        });
+
+        const int32 Total = Assets.Num();
+        const int32 First = FMath::Min(Offset, Total);
+        const int32 Last = FMath::Min(First + Limit, Total);
+
+        TArray<TSharedPtr<FJsonValue>> AssetArray;
+        AssetArray.Reserve(Last - First);
+        for (int32 Index = First; Index < Last; ++Index)
+        {
+            const FAssetData& Asset = Assets[Index];
+            TSharedPtr<FJsonObject> AssetObj = MakeShared<FJsonObject>();
+            AssetObj->SetStringField(TEXT("name"), Asset.AssetName.ToString());
+            AssetObj->SetStringField(TEXT("path"), Asset.GetObjectPathString());
+            AssetObj->SetStringField(TEXT("package"), Asset.PackageName.ToString());
+            AssetObj->SetStringField(TEXT("class"), Asset.AssetClassPath.GetAssetName().ToString());
+            AssetObj->SetStringField(TEXT("class_path"), Asset.AssetClassPath.ToString());
+
+            if (bAllTags || IncludeTags.Num() > 0)
+            {
+                TSharedPtr<FJsonObject> TagsObj = MakeShared<FJsonObject>();
+                if (bAllTags)
+                {
+                    for (const TPair<FName, FAssetTagValueRef>& Tag : Asset.TagsAndValues)
+                    {
+                        TagsObj->SetStringField(Tag.Key.ToString(), Tag.Value.AsString());
+                    }
+                }
+                else
+                {
+                    for (const FName& TagName : IncludeTags)
+                    {
+                        FString TagValue;
+                        if (Asset.GetTagValue(TagName, TagValue))
+                        {
+                            TagsObj->SetStringField(TagName.ToString(), TagValue);
+                        }
+                    }
+                }
+                AssetObj->SetObjectField(TEXT("tags"), TagsObj);
+            }
+
+            AssetArray.Add(MakeShared<FJsonValueObject>(AssetObj));
+        }
+
+        TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+        ResultObj->SetBoolField(TEXT("success"), true);
+        ResultObj->SetNumberField(TEXT("total"), Total);
+        ResultObj->SetNumberField(TEXT("offset"), First);
+        ResultObj->SetNumberField(TEXT("returned"), AssetArray.Num());
+        ResultObj->SetBoolField(TEXT("has_more"), Last < Total);
+        ResultObj->SetBoolField(TEXT("registry_loading"), bRegistryLoading);
+        ResultObj->SetNumberField(TEXT("query_ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+        ResultObj->SetArrayField(TEXT("assets"), AssetArray);
+        return FMCPCommandResult(ResultObj);
+    });
+}
@@ -117,7 +117,7 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleCreateUMGWidgetBlueprint(co
 	FAssetRegistryModule::AssetCreated(WidgetBlueprint);
 
 	// Compile the blueprint
-	FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
+	FUnrealMCPCommonUtils::CompileBlueprint(WidgetBlueprint);
 
 	// Create success response
 	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
@@ -165,6 +165,7 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleAddTextBlockToWidget(const
 	}
 
 	// Create Text Block widget
+	WidgetBlueprint->WidgetTree->Modify();
 	UTextBlock* TextBlock = WidgetBlueprint->WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass(), *WidgetName);
 	if (!TextBlock)
 	{
@@ -181,12 +182,13 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleAddTextBlockToWidget(const
 		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Root Canvas Panel not found"));
 	}
 
+	RootCanvas->Modify();
 	UCanvasPanelSlot* PanelSlot = RootCanvas->AddChildToCanvas(TextBlock);
 	PanelSlot->SetPosition(Position);
 
 	// Mark the package dirty and compile
 	WidgetBlueprint->MarkPackageDirty();
-	FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
+	FUnrealMCPCommonUtils::CompileBlueprint(WidgetBlueprint);
 
 	// Create success response
 	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
@@ -296,6 +298,7 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleAddButtonToWidget(const TSh
 	}
 
 	// Add to canvas and set position
+	RootCanvas->Modify();
 	UCanvasPanelSlot* ButtonSlot = RootCanvas->AddChildToCanvas(Button);
 	if (ButtonSlot)
 	{
@@ -311,8 +314,8 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleAddButtonToWidget(const TSh
 	}
 
 	// Save the Widget Blueprint
-	FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
-	UEditorAssetLibrary::SaveAsset(BlueprintPath, false);
+	FUnrealMCPCommonUtils::CompileBlueprint(WidgetBlueprint);
+	FUnrealMCPCommonUtils::SaveBlueprint(WidgetBlueprint);
 
 	Response->SetBoolField(TEXT("success"), true);
 	Response->SetStringField(TEXT("widget_name"), WidgetName);
@@ -433,8 +436,8 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleBindWidgetEvent(const TShar
 	}
 
 	// Save the Widget Blueprint
-	FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
-	UEditorAssetLibrary::SaveAsset(BlueprintPath, false);
+	FUnrealMCPCommonUtils::CompileBlueprint(WidgetBlueprint);
+	FUnrealMCPCommonUtils::SaveBlueprint(WidgetBlueprint);
 
 	Response->SetBoolField(TEXT("success"), true);
 	Response->SetStringField(TEXT("event_name"), EventName);
@@ -511,6 +514,7 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleSetTextBlockBinding(const T
 		
 		// Create entry node - use the API that exists in UE 5.5
 		EntryNode = NewObject<UK2Node_FunctionEntry>(FuncGraph);
+		FuncGraph->Modify();
 		FuncGraph->AddNode(EntryNode, false, false);
 		EntryNode->NodePosX = 0;
 		EntryNode->NodePosY = 0;
@@ -535,8 +539,8 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleSetTextBlockBinding(const T
 	}
 
 	// Save the Widget Blueprint
-	FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
-	UEditorAssetLibrary::SaveAsset(BlueprintPath, false);
+	FUnrealMCPCommonUtils::CompileBlueprint(WidgetBlueprint);
+	FUnrealMCPCommonUtils::SaveBlueprint(WidgetBlueprint);
 
 	Response->SetBoolField(TEXT("success"), true);
 	Response->SetStringField(TEXT("binding_name"), BindingName);
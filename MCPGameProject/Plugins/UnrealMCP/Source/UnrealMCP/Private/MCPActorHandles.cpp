@@ -0,0 +1,46 @@
+#include "MCPActorHandles.h"
+#include "GameFramework/Actor.h"
+#include "UObject/ObjectKey.h"
+
+namespace
+{
+    /** Handle N lives at index N - 1 */
+    TArray<TWeakObjectPtr<AActor>> HandleActors;
+    TMap<TObjectKey<AActor>, int32> ActorHandles;
+}
+
+int32 FMCPActorHandles::GetHandle(AActor* Actor)
+{
+    check(IsInGameThread());
+    if (!Actor)
+    {
+        return 0;
+    }
+
+    if (const int32* Existing = ActorHandles.Find(Actor))
+    {
+        return *Existing;
+    }
+
+    const int32 Handle = HandleActors.Add(Actor) + 1;
+    ActorHandles.Add(Actor, Handle);
+    return Handle;
+}
+
+AActor* FMCPActorHandles::Resolve(int64 Handle, FString& OutError)
+{
+    check(IsInGameThread());
+    if (Handle < 1 || Handle > HandleActors.Num())
+    {
+        OutError = FString::Printf(TEXT("Unknown actor handle: %lld"), Handle);
+        return nullptr;
+    }
+
+    AActor* Actor = HandleActors[Handle - 1].Get();
+    if (!Actor)
+    {
+        OutError = FString::Printf(TEXT("Stale actor handle: %lld (the actor no longer exists)"), Handle);
+        return nullptr;
+    }
+    return Actor;
+}
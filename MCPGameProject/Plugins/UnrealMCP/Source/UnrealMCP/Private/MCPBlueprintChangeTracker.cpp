@@ -0,0 +1,274 @@
+#include "MCPBlueprintChangeTracker.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "EdGraph/EdGraph.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "UObject/UObjectGlobals.h"
+#include "Misc/TransactionObjectEvent.h"
+
+namespace
+{
+    /**
+     * Walk the outer chain of an edited object. Collects every graph on the way
+     * (nodes in collapsed graphs live in nested graphs) and returns the blueprint
+     * that owns it. Component templates and SCS nodes are outered to the
+     * generated class, so that is mapped back to its blueprint.
+     */
+    UBlueprint* FindOwningBlueprint(UObject* Object, TArray<UEdGraph*, TInlineAllocator<4>>& OutGraphs)
+    {
+        for (UObject* Current = Object; Current; Current = Current->GetOuter())
+        {
+            if (UEdGraph* Graph = Cast<UEdGraph>(Current))
+            {
+                OutGraphs.Add(Graph);
+            }
+            else if (UBlueprint* Blueprint = Cast<UBlueprint>(Current))
+            {
+                return Blueprint;
+            }
+            else if (UBlueprintGeneratedClass* GeneratedClass = Cast<UBlueprintGeneratedClass>(Current))
+            {
+                return Cast<UBlueprint>(GeneratedClass->ClassGeneratedBy);
+            }
+            else if (Current->IsA<UPackage>())
+            {
+                break;
+            }
+        }
+        return nullptr;
+    }
+}
+
+FMCPBlueprintChangeTracker::FMCPBlueprintChangeTracker()
+    : NextRevision(1)
+{
+    ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FMCPBlueprintChangeTracker::HandleObjectModified);
+    ObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FMCPBlueprintChangeTracker::HandleObjectPropertyChanged);
+    ObjectTransactedHandle = FCoreUObjectDelegates::OnObjectTransacted.AddRaw(this, &FMCPBlueprintChangeTracker::HandleObjectTransacted);
+}
+
+FMCPBlueprintChangeTracker::~FMCPBlueprintChangeTracker()
+{
+    FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+    FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(ObjectPropertyChangedHandle);
+    FCoreUObjectDelegates::OnObjectTransacted.Remove(ObjectTransactedHandle);
+
+    for (TPair<FObjectKey, FTrackedBlueprint>& Pair : Tracked)
+    {
+        Unbind(Pair.Value);
+    }
+}
+
+void FMCPBlueprintChangeTracker::Track(UBlueprint* Blueprint)
+{
+    check(IsInGameThread());
+
+    if (!Blueprint || Tracked.Contains(FObjectKey(Blueprint)))
+    {
+        return;
+    }
+
+    FTrackedBlueprint& Entry = Tracked.Add(FObjectKey(Blueprint));
+    Entry.Blueprint = Blueprint;
+    Entry.Revision = NextRevision++;
+    Entry.StructureRevision = Entry.Revision;
+    Entry.ChangedHandle = Blueprint->OnChanged().AddRaw(this, &FMCPBlueprintChangeTracker::HandleBlueprintChanged);
+    Entry.CompiledHandle = Blueprint->OnCompiled().AddRaw(this, &FMCPBlueprintChangeTracker::HandleBlueprintChanged);
+    BindGraphs(Entry);
+}
+
+uint64 FMCPBlueprintChangeTracker::GetBlueprintRevision(const UBlueprint* Blueprint) const
+{
+    const FTrackedBlueprint* Entry = Tracked.Find(FObjectKey(Blueprint));
+    return Entry ? Entry->Revision : 0;
+}
+
+uint64 FMCPBlueprintChangeTracker::GetStructureRevision(const UBlueprint* Blueprint) const
+{
+    const FTrackedBlueprint* Entry = Tracked.Find(FObjectKey(Blueprint));
+    return Entry ? Entry->StructureRevision : 0;
+}
+
+uint64 FMCPBlueprintChangeTracker::GetGraphRevision(const UEdGraph* Graph) const
+{
+    const uint64* Revision = GraphRevisions.Find(FObjectKey(Graph));
+    return Revision ? *Revision : 0;
+}
+
+void FMCPBlueprintChangeTracker::PruneStale()
+{
+    for (auto It = Tracked.CreateIterator(); It; ++It)
+    {
+        if (!It->Value.Blueprint.IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+    for (auto It = GraphRevisions.CreateIterator(); It; ++It)
+    {
+        if (!It->Key.ResolveObjectPtr())
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+void FMCPBlueprintChangeTracker::BindGraphs(FTrackedBlueprint& Entry)
+{
+    UBlueprint* Blueprint = Entry.Blueprint.Get();
+    if (!Blueprint)
+    {
+        return;
+    }
+
+    for (auto It = Entry.GraphHandles.CreateIterator(); It; ++It)
+    {
+        if (!It->Key.IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    TArray<UEdGraph*> Graphs;
+    Blueprint->GetAllGraphs(Graphs);
+    for (UEdGraph* Graph : Graphs)
+    {
+        if (!Graph || Entry.GraphHandles.Contains(Graph))
+        {
+            continue;
+        }
+
+        Entry.GraphHandles.Add(Graph, Graph->AddOnGraphChangedHandler(
+            FOnGraphChanged::FDelegate::CreateRaw(this, &FMCPBlueprintChangeTracker::HandleGraphChanged)));
+        GraphRevisions.FindOrAdd(FObjectKey(Graph), Entry.Revision);
+    }
+}
+
+void FMCPBlueprintChangeTracker::Unbind(FTrackedBlueprint& Entry)
+{
+    if (UBlueprint* Blueprint = Entry.Blueprint.Get())
+    {
+        Blueprint->OnChanged().Remove(Entry.ChangedHandle);
+        Blueprint->OnCompiled().Remove(Entry.CompiledHandle);
+    }
+
+    for (const TPair<TWeakObjectPtr<UEdGraph>, FDelegateHandle>& GraphHandle : Entry.GraphHandles)
+    {
+        if (UEdGraph* Graph = GraphHandle.Key.Get())
+        {
+            Graph->RemoveOnGraphChangedHandler(GraphHandle.Value);
+        }
+    }
+    Entry.GraphHandles.Empty();
+}
+
+void FMCPBlueprintChangeTracker::MarkGraphChanged(UBlueprint* Blueprint, UEdGraph* Graph)
+{
+    FTrackedBlueprint* Entry = Tracked.Find(FObjectKey(Blueprint));
+    if (!Entry)
+    {
+        return;
+    }
+
+    const uint64 Revision = NextRevision++;
+    Entry->Revision = Revision;
+    GraphRevisions.Add(FObjectKey(Graph), Revision);
+}
+
+void FMCPBlueprintChangeTracker::MarkStructureChanged(UBlueprint* Blueprint)
+{
+    FTrackedBlueprint* Entry = Tracked.Find(FObjectKey(Blueprint));
+    if (!Entry)
+    {
+        return;
+    }
+
+    const uint64 Revision = NextRevision++;
+    Entry->Revision = Revision;
+    Entry->StructureRevision = Revision;
+}
+
+void FMCPBlueprintChangeTracker::MarkAllChanged(UBlueprint* Blueprint)
+{
+    FTrackedBlueprint* Entry = Tracked.Find(FObjectKey(Blueprint));
+    if (!Entry)
+    {
+        return;
+    }
+
+    // Graphs may have been added or removed
+    BindGraphs(*Entry);
+
+    const uint64 Revision = NextRevision++;
+    Entry->Revision = Revision;
+    Entry->StructureRevision = Revision;
+    for (const TPair<TWeakObjectPtr<UEdGraph>, FDelegateHandle>& GraphHandle : Entry->GraphHandles)
+    {
+        if (const UEdGraph* Graph = GraphHandle.Key.Get())
+        {
+            GraphRevisions.Add(FObjectKey(Graph), Revision);
+        }
+    }
+}
+
+void FMCPBlueprintChangeTracker::HandleObjectChanged(UObject* Object)
+{
+    if (!Object || Tracked.Num() == 0)
+    {
+        return;
+    }
+
+    TArray<UEdGraph*, TInlineAllocator<4>> Graphs;
+    UBlueprint* Blueprint = FindOwningBlueprint(Object, Graphs);
+    if (!Blueprint || !Tracked.Contains(FObjectKey(Blueprint)))
+    {
+        return;
+    }
+
+    if (Graphs.Num() == 0)
+    {
+        MarkStructureChanged(Blueprint);
+        return;
+    }
+
+    for (UEdGraph* Graph : Graphs)
+    {
+        MarkGraphChanged(Blueprint, Graph);
+    }
+}
+
+void FMCPBlueprintChangeTracker::HandleBlueprintChanged(UBlueprint* Blueprint)
+{
+    // Structural edits and compiles can rebuild any node, so everything is stale
+    MarkAllChanged(Blueprint);
+}
+
+void FMCPBlueprintChangeTracker::HandleGraphChanged(const FEdGraphEditAction& Action)
+{
+    UEdGraph* Graph = const_cast<UEdGraph*>(Action.Graph);
+    if (!Graph)
+    {
+        return;
+    }
+
+    if (UBlueprint* Blueprint = FBlueprintEditorUtils::FindBlueprintForGraph(Graph))
+    {
+        MarkGraphChanged(Blueprint, Graph);
+    }
+}
+
+void FMCPBlueprintChangeTracker::HandleObjectModified(UObject* Object)
+{
+    HandleObjectChanged(Object);
+}
+
+void FMCPBlueprintChangeTracker::HandleObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+    HandleObjectChanged(Object);
+}
+
+void FMCPBlueprintChangeTracker::HandleObjectTransacted(UObject* Object, const FTransactionObjectEvent& Event)
+{
+    // Undo/redo restores objects without calling Modify
+    HandleObjectChanged(Object);
+}
@@ -0,0 +1,402 @@
+#include "MCPBlueprintScan.h"
+#include "MCPLog.h"
+#include "MCPClientConnection.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/Async.h"
+#include "Engine/Blueprint.h"
+#include "Misc/PackageName.h"
+#include "Modules/ModuleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "MCPTrace.h"
+
+namespace
+{
+    /** Class name from a class path tag value such as "/Script/CoreUObject.Class'/Script/Engine.Actor'" */
+    FString ClassNameFromTag(const FString& TagValue)
+    {
+        FString ClassName = FSoftObjectPath(FPackageName::ExportTextPathToObjectPath(TagValue)).GetAssetName();
+        ClassName.RemoveFromEnd(TEXT("_C"));
+        return ClassName;
+    }
+
+    bool MatchesParentClass(const FAssetData& Asset, const FString& ParentClass)
+    {
+        FString Wanted = ParentClass;
+        Wanted.RemoveFromEnd(TEXT("_C"));
+
+        FString TagValue;
+        if (Asset.GetTagValue(FBlueprintTags::ParentClassPath, TagValue) && ClassNameFromTag(TagValue).Equals(Wanted, ESearchCase::IgnoreCase))
+        {
+            return true;
+        }
+        if (Asset.GetTagValue(FBlueprintTags::NativeParentClassPath, TagValue) && ClassNameFromTag(TagValue).Equals(Wanted, ESearchCase::IgnoreCase))
+        {
+            return true;
+        }
+        return false;
+    }
+
+    TArray<uint8> SerializeToUtf8(const TSharedRef<FJsonObject>& Object)
+    {
+        MCP_TRACE_SCOPE("MCP SerializeScanResult");
+        FString Text;
+        TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Text);
+        FJsonSerializer::Serialize(Object, Writer);
+        FTCHARToUTF8 Utf8Text(*Text);
+        return TArray<uint8>(reinterpret_cast<const uint8*>(Utf8Text.Get()), Utf8Text.Length());
+    }
+}
+
+FMCPBlueprintScan::FMCPBlueprintScan(int32 InScanId, const FMCPBlueprintScanSettings& InSettings, FMCPBlueprintExtractor&& InExtractor,
+    const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe>& InConnection)
+    : ScanId(InScanId)
+    , Settings(InSettings)
+    , Extractor(MoveTemp(InExtractor))
+    , Connection(InConnection)
+    , NextToLoad(0)
+    , LoadsInFlight(0)
+    , bCancelled(false)
+    , bFinished(false)
+    , SerializationsInFlight(0)
+    , Delivered(0)
+    , Extracted(0)
+    , Failed(0)
+    , ExtractSeconds(0.0)
+    , StartTime(0.0)
+    , FinishTime(0.0)
+{
+}
+
+FMCPBlueprintScan::~FMCPBlueprintScan()
+{
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+    }
+}
+
+void FMCPBlueprintScan::Start()
+{
+    check(IsInGameThread());
+
+    StartTime = FPlatformTime::Seconds();
+
+    // Registry query only: no package is loaded here
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    FARFilter Filter;
+    Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+    Filter.bRecursiveClasses = true;
+    Filter.PackagePaths = Settings.PackagePaths;
+    Filter.bRecursivePaths = Settings.bRecursivePaths;
+    if (!Settings.TagName.IsNone())
+    {
+        if (Settings.TagValue.IsEmpty())
+        {
+            Filter.TagsAndValues.Add(Settings.TagName);
+        }
+        else
+        {
+            Filter.TagsAndValues.Add(Settings.TagName, Settings.TagValue);
+        }
+    }
+
+    AssetRegistry.GetAssets(Filter, Assets);
+    if (!Settings.ParentClass.IsEmpty())
+    {
+        Assets.RemoveAll([this](const FAssetData& Asset)
+        {
+            return !MatchesParentClass(Asset, Settings.ParentClass);
+        });
+    }
+
+    // Stable order, so repeated scans report blueprints in the same sequence
+    Assets.Sort([](const FAssetData& A, const FAssetData& B)
+    {
+        return A.PackageName.LexicalLess(B.PackageName);
+    });
+    if (Settings.MaxBlueprints > 0 && Assets.Num() > Settings.MaxBlueprints)
+    {
+        Assets.SetNum(Settings.MaxBlueprints);
+    }
+
+    UE_LOG(LogUnrealMCP, Display, TEXT("MCPBlueprintScan: Scan %d matched %d blueprints"), ScanId, Assets.Num());
+
+    TWeakPtr<FMCPBlueprintScan, ESPMode::ThreadSafe> WeakThis = AsShared();
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([WeakThis](float DeltaTime)
+    {
+        TSharedPtr<FMCPBlueprintScan, ESPMode::ThreadSafe> This = WeakThis.Pin();
+        return This.IsValid() && This->Tick(DeltaTime);
+    }));
+
+    RequestLoads();
+}
+
+void FMCPBlueprintScan::Cancel()
+{
+    check(IsInGameThread());
+
+    if (bFinished)
+    {
+        return;
+    }
+
+    bCancelled = true;
+    Ready.Empty();
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+    Finish();
+}
+
+bool FMCPBlueprintScan::IsFinished() const
+{
+    return bFinished;
+}
+
+bool FMCPBlueprintScan::IsDrained() const
+{
+    FScopeLock Lock(&ResultsLock);
+    return bFinished && SerializationsInFlight == 0 && Results.Num() == 0;
+}
+
+int32 FMCPBlueprintScan::TakeResults(int32 MaxResults, TArray<uint8>& OutLines)
+{
+    FScopeLock Lock(&ResultsLock);
+    const int32 Count = MaxResults > 0 ? FMath::Min(MaxResults, Results.Num()) : Results.Num();
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        OutLines.Append(Results[Index]);
+    }
+    Results.RemoveAt(0, Count);
+    return Count;
+}
+
+TSharedPtr<FJsonObject> FMCPBlueprintScan::GetStatus() const
+{
+    const double EndTime = FinishTime > 0.0 ? FinishTime : FPlatformTime::Seconds();
+    const double Elapsed = StartTime > 0.0 ? EndTime - StartTime : 0.0;
+
+    int32 Buffered = 0;
+    {
+        FScopeLock Lock(&ResultsLock);
+        Buffered = Results.Num();
+    }
+
+    TSharedPtr<FJsonObject> Status = MakeShared<FJsonObject>();
+    Status->SetNumberField(TEXT("scan_id"), ScanId);
+    Status->SetNumberField(TEXT("total"), Assets.Num());
+    Status->SetNumberField(TEXT("extracted"), Extracted);
+    Status->SetNumberField(TEXT("failed"), Failed);
+    Status->SetNumberField(TEXT("delivered"), Delivered.load());
+    Status->SetNumberField(TEXT("buffered"), Buffered);
+    Status->SetNumberField(TEXT("loading"), LoadsInFlight);
+    Status->SetBoolField(TEXT("stream"), Settings.bStream);
+    Status->SetBoolField(TEXT("finished"), bFinished);
+    Status->SetBoolField(TEXT("cancelled"), bCancelled);
+    Status->SetNumberField(TEXT("elapsed_seconds"), Elapsed);
+    Status->SetNumberField(TEXT("extract_ms"), ExtractSeconds * 1000.0);
+    Status->SetNumberField(TEXT("blueprints_per_second"), Elapsed > 0.0 ? (Extracted + Failed) / Elapsed : 0.0);
+    return Status;
+}
+
+bool FMCPBlueprintScan::Tick(float DeltaTime)
+{
+    if (bCancelled || bFinished)
+    {
+        return false;
+    }
+
+    if (Settings.bStream)
+    {
+        TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe> PinnedConnection = Connection.Pin();
+        if (!PinnedConnection.IsValid() || PinnedConnection->IsClosed())
+        {
+            UE_LOG(LogUnrealMCP, Display, TEXT("MCPBlueprintScan: Scan %d cancelled, connection closed"), ScanId);
+            TickerHandle.Reset();
+            Cancel();
+            return false;
+        }
+    }
+
+    // Extract loaded blueprints until the slice is used up or the consumer falls behind
+    const double SliceEnd = FPlatformTime::Seconds() + Settings.SliceMs / 1000.0;
+    while (Ready.Num() > 0 && !IsBackedUp() && FPlatformTime::Seconds() < SliceEnd)
+    {
+        FLoadedBlueprint Entry = MoveTemp(Ready[0]);
+        Ready.RemoveAt(0);
+
+        const FAssetData& Asset = Assets[Entry.AssetIndex];
+        TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+        Result->SetStringField(TEXT("event"), TEXT("blueprint_scan_result"));
+        Result->SetNumberField(TEXT("scan_id"), ScanId);
+        Result->SetNumberField(TEXT("index"), Entry.AssetIndex);
+        Result->SetStringField(TEXT("name"), Asset.AssetName.ToString());
+        Result->SetStringField(TEXT("asset_path"), Asset.GetSoftObjectPath().ToString());
+
+        const double ExtractStart = FPlatformTime::Seconds();
+        TSharedPtr<FJsonObject> Data = Entry.Blueprint.IsValid() ? Extractor(Entry.Blueprint.Get()) : nullptr;
+        ExtractSeconds += FPlatformTime::Seconds() - ExtractStart;
+
+        bool bSuccess = true;
+        if (!Data.IsValid() || (Data->TryGetBoolField(TEXT("success"), bSuccess) && !bSuccess))
+        {
+            FString Error = TEXT("Blueprint was unloaded before extraction");
+            if (Data.IsValid())
+            {
+                Data->TryGetStringField(TEXT("error"), Error);
+            }
+            Result->SetStringField(TEXT("error"), Error);
+            ++Failed;
+        }
+        else
+        {
+            Result->SetObjectField(TEXT("data"), Data);
+            ++Extracted;
+        }
+
+        Deliver(Result);
+    }
+
+    RequestLoads();
+
+    if (NextToLoad == Assets.Num() && LoadsInFlight == 0 && Ready.Num() == 0 && SerializationsInFlight == 0)
+    {
+        TickerHandle.Reset();
+        Finish();
+        return false;
+    }
+    return true;
+}
+
+void FMCPBlueprintScan::RequestLoads()
+{
+    while (!bCancelled && NextToLoad < Assets.Num() && LoadsInFlight + Ready.Num() < Settings.MaxConcurrentLoads)
+    {
+        const int32 AssetIndex = NextToLoad++;
+        const FAssetData& Asset = Assets[AssetIndex];
+
+        if (Asset.IsAssetLoaded())
+        {
+            FLoadedBlueprint& Entry = Ready.AddDefaulted_GetRef();
+            Entry.AssetIndex = AssetIndex;
+            Entry.Blueprint.Reset(Cast<UBlueprint>(Asset.FastGetAsset(false)));
+            continue;
+        }
+
+        ++LoadsInFlight;
+        TWeakPtr<FMCPBlueprintScan, ESPMode::ThreadSafe> WeakThis = AsShared();
+        LoadPackageAsync(Asset.PackageName.ToString(), FLoadPackageAsyncDelegate::CreateLambda(
+            [WeakThis, AssetIndex](const FName& PackageName, UPackage* Package, EAsyncLoadingResult::Type LoadResult)
+            {
+                if (TSharedPtr<FMCPBlueprintScan, ESPMode::ThreadSafe> This = WeakThis.Pin())
+                {
+                    This->HandlePackageLoaded(AssetIndex, LoadResult);
+                }
+            }));
+    }
+}
+
+void FMCPBlueprintScan::HandlePackageLoaded(int32 AssetIndex, EAsyncLoadingResult::Type LoadResult)
+{
+    --LoadsInFlight;
+    if (bCancelled)
+    {
+        return;
+    }
+
+    UBlueprint* Blueprint = LoadResult == EAsyncLoadingResult::Succeeded
+        ? Cast<UBlueprint>(Assets[AssetIndex].FastGetAsset(false))
+        : nullptr;
+    if (Blueprint)
+    {
+        FLoadedBlueprint& Entry = Ready.AddDefaulted_GetRef();
+        Entry.AssetIndex = AssetIndex;
+        Entry.Blueprint.Reset(Blueprint);
+        return;
+    }
+
+    const FAssetData& Asset = Assets[AssetIndex];
+    TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetStringField(TEXT("event"), TEXT("blueprint_scan_result"));
+    Result->SetNumberField(TEXT("scan_id"), ScanId);
+    Result->SetNumberField(TEXT("index"), AssetIndex);
+    Result->SetStringField(TEXT("name"), Asset.AssetName.ToString());
+    Result->SetStringField(TEXT("asset_path"), Asset.GetSoftObjectPath().ToString());
+    Result->SetStringField(TEXT("error"), TEXT("Failed to load package"));
+    ++Failed;
+    Deliver(Result);
+}
+
+void FMCPBlueprintScan::Deliver(const TSharedRef<FJsonObject>& Result)
+{
+    ++SerializationsInFlight;
+
+    // Results are independent, so they are serialized in parallel and may arrive out of index order
+    TWeakPtr<FMCPBlueprintScan, ESPMode::ThreadSafe> WeakThis = AsShared();
+    Async(EAsyncExecution::ThreadPool, [WeakThis, Result]()
+    {
+        TArray<uint8> Bytes = SerializeToUtf8(Result);
+
+        TSharedPtr<FMCPBlueprintScan, ESPMode::ThreadSafe> This = WeakThis.Pin();
+        if (!This.IsValid())
+        {
+            return;
+        }
+
+        if (This->Settings.bStream)
+        {
+            if (TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe> PinnedConnection = This->Connection.Pin())
+            {
+                PinnedConnection->EnqueuePush(MoveTemp(Bytes));
+            }
+        }
+        else
+        {
+            Bytes.Add('\n');
+            FScopeLock Lock(&This->ResultsLock);
+            This->Results.Add(MoveTemp(Bytes));
+        }
+
+        ++This->Delivered;
+        --This->SerializationsInFlight;
+    });
+}
+
+bool FMCPBlueprintScan::IsBackedUp() const
+{
+    if (Settings.bStream)
+    {
+        TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe> PinnedConnection = Connection.Pin();
+        return PinnedConnection.IsValid() && PinnedConnection->GetPendingPushBytes() > Settings.MaxPendingBytes;
+    }
+
+    FScopeLock Lock(&ResultsLock);
+    return Results.Num() + SerializationsInFlight >= Settings.MaxBufferedResults;
+}
+
+void FMCPBlueprintScan::Finish()
+{
+    bFinished = true;
+    FinishTime = FPlatformTime::Seconds();
+
+    UE_LOG(LogUnrealMCP, Display, TEXT("MCPBlueprintScan: Scan %d %s: %d extracted, %d failed in %.2fs"),
+        ScanId, bCancelled ? TEXT("cancelled") : TEXT("finished"), Extracted, Failed, FinishTime - StartTime);
+
+    if (!Settings.bStream)
+    {
+        return;
+    }
+
+    TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe> PinnedConnection = Connection.Pin();
+    if (PinnedConnection.IsValid() && !PinnedConnection->IsClosed())
+    {
+        TSharedRef<FJsonObject> Event = GetStatus().ToSharedRef();
+        Event->SetStringField(TEXT("event"), TEXT("blueprint_scan_complete"));
+        PinnedConnection->EnqueuePush(SerializeToUtf8(Event));
+    }
+}
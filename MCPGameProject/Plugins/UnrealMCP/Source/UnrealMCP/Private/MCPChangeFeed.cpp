@@ -0,0 +1,230 @@
+#include "MCPChangeFeed.h"
+#include "MCPClientConnection.h"
+#include "Editor.h"
+#include "Engine/Engine.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Misc/Guid.h"
+#include "Misc/TransactionObjectEvent.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+FMCPChangeFeed::FMCPChangeFeed()
+    : Epoch(FGuid::NewGuid().ToString(EGuidFormats::Digits))
+    , LevelRevision(1)
+    , AssetRevision(1)
+    , PushedLevelRevision(1)
+    , PushedAssetRevision(1)
+{
+    ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FMCPChangeFeed::HandleObjectModified);
+    ObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FMCPChangeFeed::HandleObjectPropertyChanged);
+    ObjectTransactedHandle = FCoreUObjectDelegates::OnObjectTransacted.AddRaw(this, &FMCPChangeFeed::HandleObjectTransacted);
+
+    if (GEngine)
+    {
+        ActorAddedHandle = GEngine->OnLevelActorAdded().AddRaw(this, &FMCPChangeFeed::HandleActorChanged);
+        ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddRaw(this, &FMCPChangeFeed::HandleActorChanged);
+        ActorMovedHandle = GEngine->OnActorMoved().AddRaw(this, &FMCPChangeFeed::HandleActorChanged);
+        ActorsMovedHandle = GEngine->OnActorsMoved().AddRaw(this, &FMCPChangeFeed::HandleActorsMoved);
+    }
+    if (GEditor)
+    {
+        BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddRaw(this, &FMCPChangeFeed::HandleBlueprintCompiled);
+    }
+    MapChangeHandle = FEditorDelegates::MapChange.AddRaw(this, &FMCPChangeFeed::HandleMapChanged);
+    MapOpenedHandle = FEditorDelegates::OnMapOpened.AddRaw(this, &FMCPChangeFeed::HandleMapOpened);
+    UndoRedoHandle = FEditorDelegates::PostUndoRedo.AddRaw(this, &FMCPChangeFeed::HandleUndoRedo);
+
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FMCPChangeFeed::HandleAssetChanged);
+    AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FMCPChangeFeed::HandleAssetChanged);
+    AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FMCPChangeFeed::HandleAssetRenamed);
+
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMCPChangeFeed::Tick));
+}
+
+FMCPChangeFeed::~FMCPChangeFeed()
+{
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+    FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+    FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(ObjectPropertyChangedHandle);
+    FCoreUObjectDelegates::OnObjectTransacted.Remove(ObjectTransactedHandle);
+
+    if (GEngine)
+    {
+        GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+        GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+        GEngine->OnActorMoved().Remove(ActorMovedHandle);
+        GEngine->OnActorsMoved().Remove(ActorsMovedHandle);
+    }
+    if (GEditor)
+    {
+        GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+    }
+    FEditorDelegates::MapChange.Remove(MapChangeHandle);
+    FEditorDelegates::OnMapOpened.Remove(MapOpenedHandle);
+    FEditorDelegates::PostUndoRedo.Remove(UndoRedoHandle);
+
+    // The registry may already be gone during editor shutdown
+    if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+    {
+        IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+        AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+        AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+        AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+    }
+}
+
+void FMCPChangeFeed::Subscribe(const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe>& Connection)
+{
+    check(IsInGameThread());
+
+    if (!Connection.IsValid())
+    {
+        return;
+    }
+    Unsubscribe(Connection.Get());
+    Subscribers.Add(Connection);
+}
+
+void FMCPChangeFeed::Unsubscribe(const FMCPClientConnection* Connection)
+{
+    check(IsInGameThread());
+
+    Subscribers.RemoveAll([Connection](const TWeakPtr<FMCPClientConnection, ESPMode::ThreadSafe>& Subscriber)
+    {
+        const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe> Pinned = Subscriber.Pin();
+        return !Pinned.IsValid() || Pinned.Get() == Connection;
+    });
+}
+
+void FMCPChangeFeed::MarkLevelChanged()
+{
+    ++LevelRevision;
+}
+
+void FMCPChangeFeed::MarkAssetsChanged()
+{
+    ++AssetRevision;
+}
+
+TSharedPtr<FJsonObject> FMCPChangeFeed::ToJson() const
+{
+    TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+    Json->SetStringField(TEXT("epoch"), Epoch);
+    Json->SetNumberField(TEXT("level"), (double)LevelRevision.load());
+    Json->SetNumberField(TEXT("assets"), (double)AssetRevision.load());
+    return Json;
+}
+
+FString FMCPChangeFeed::ToJsonString() const
+{
+    return FString::Printf(TEXT("{\"epoch\":\"%s\",\"level\":%llu,\"assets\":%llu}"), *Epoch, LevelRevision.load(), AssetRevision.load());
+}
+
+bool FMCPChangeFeed::Tick(float DeltaTime)
+{
+    const uint64 Level = LevelRevision;
+    const uint64 Assets = AssetRevision;
+    if (Level == PushedLevelRevision && Assets == PushedAssetRevision)
+    {
+        return true;
+    }
+    PushedLevelRevision = Level;
+    PushedAssetRevision = Assets;
+    if (Subscribers.Num() == 0)
+    {
+        return true;
+    }
+
+    const FString EventText = FString::Printf(TEXT("{\"event\":\"revisions\",\"epoch\":\"%s\",\"level\":%llu,\"assets\":%llu}"), *Epoch, Level, Assets);
+    const FTCHARToUTF8 Utf8Event(*EventText);
+    for (int32 Index = Subscribers.Num() - 1; Index >= 0; --Index)
+    {
+        const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe> Connection = Subscribers[Index].Pin();
+        if (!Connection.IsValid() || !Connection->EnqueuePush(TArray<uint8>(reinterpret_cast<const uint8*>(Utf8Event.Get()), Utf8Event.Length())))
+        {
+            Subscribers.RemoveAtSwap(Index);
+        }
+    }
+    return true;
+}
+
+void FMCPChangeFeed::HandleObjectChanged(UObject* Object)
+{
+    if (!Object || Object->GetOutermost() == GetTransientPackage())
+    {
+        return;
+    }
+
+    if (Object->IsA<UWorld>() || Object->IsA<ULevel>() || Object->GetTypedOuter<ULevel>())
+    {
+        MarkLevelChanged();
+    }
+    else
+    {
+        MarkAssetsChanged();
+    }
+}
+
+void FMCPChangeFeed::HandleObjectModified(UObject* Object)
+{
+    HandleObjectChanged(Object);
+}
+
+void FMCPChangeFeed::HandleObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+    HandleObjectChanged(Object);
+}
+
+void FMCPChangeFeed::HandleObjectTransacted(UObject* Object, const FTransactionObjectEvent& Event)
+{
+    HandleObjectChanged(Object);
+}
+
+void FMCPChangeFeed::HandleActorChanged(AActor* Actor)
+{
+    MarkLevelChanged();
+}
+
+void FMCPChangeFeed::HandleActorsMoved(TArray<AActor*>& Actors)
+{
+    MarkLevelChanged();
+}
+
+void FMCPChangeFeed::HandleMapChanged(uint32 MapChangeFlags)
+{
+    MarkLevelChanged();
+}
+
+void FMCPChangeFeed::HandleMapOpened(const FString& Filename, bool bAsTemplate)
+{
+    MarkLevelChanged();
+}
+
+void FMCPChangeFeed::HandleUndoRedo()
+{
+    // Undo/redo can restore objects of any kind without calling Modify
+    MarkLevelChanged();
+    MarkAssetsChanged();
+}
+
+void FMCPChangeFeed::HandleBlueprintCompiled()
+{
+    MarkLevelChanged();
+    MarkAssetsChanged();
+}
+
+void FMCPChangeFeed::HandleAssetChanged(const FAssetData& AssetData)
+{
+    MarkAssetsChanged();
+}
+
+void FMCPChangeFeed::HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+    MarkAssetsChanged();
+}
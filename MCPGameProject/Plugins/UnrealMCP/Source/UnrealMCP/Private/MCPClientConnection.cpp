@@ -0,0 +1,366 @@
+#include "MCPClientConnection.h"
+#include "UnrealMCPBridge.h"
+#include "MCPRequestContext.h"
+#include "MCPChangeFeed.h"
+#include "MCPMessagePack.h"
+#include "MCPSharedMemory.h"
+#include "MCPTrace.h"
+#include "MCPLog.h"
+#include "Commands/UnrealMCPCommonUtils.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "HAL/RunnableThread.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonReader.h"
+
+namespace
+{
+    // Size of a single socket read
+    const int32 RecvChunkSize = 65536;
+
+    // How long the thread waits for input before checking the push queue again
+    const FTimespan PollInterval = FTimespan::FromMilliseconds(5);
+}
+
+FMCPClientConnection::FMCPClientConnection(UUnrealMCPBridge* InBridge, TSharedPtr<FSocket> InSocket, uint32 InConnectionId)
+    : Bridge(InBridge)
+    , Socket(InSocket)
+    , ConnectionId(InConnectionId)
+    , Thread(nullptr)
+    , PendingPushBytes(0)
+    , bRunning(true)
+    , bClosed(false)
+{
+}
+
+FMCPClientConnection::~FMCPClientConnection()
+{
+    Shutdown();
+}
+
+bool FMCPClientConnection::Start()
+{
+    // Accepted sockets inherit the listener's blocking mode on some platforms only
+    Socket->SetNonBlocking(true);
+    Socket->SetNoDelay(true);
+    int32 SocketBufferSize = 65536;  // 64KB buffer
+    Socket->SetSendBufferSize(SocketBufferSize, SocketBufferSize);
+    Socket->SetReceiveBufferSize(SocketBufferSize, SocketBufferSize);
+
+    Thread = FRunnableThread::Create(this, *FString::Printf(TEXT("UnrealMCPClient%u"), ConnectionId), 0, TPri_Normal);
+    if (!Thread)
+    {
+        bClosed = true;
+        return false;
+    }
+    return true;
+}
+
+void FMCPClientConnection::Shutdown()
+{
+    if (Thread)
+    {
+        Thread->Kill(true);
+        delete Thread;
+        Thread = nullptr;
+    }
+    bClosed = true;
+}
+
+void FMCPClientConnection::Stop()
+{
+    bRunning = false;
+}
+
+uint32 FMCPClientConnection::Run()
+{
+    UE_LOG(LogUnrealMCP, Log, TEXT("MCPClientConnection: Client %u connected"), ConnectionId);
+
+    TArray<uint8> Chunk;
+    Chunk.SetNumUninitialized(RecvChunkSize);
+
+    while (bRunning)
+    {
+        FlushPushQueue();
+
+        if (!Socket->Wait(ESocketWaitConditions::WaitForRead, PollInterval))
+        {
+            continue;
+        }
+
+        // Recv fails when the peer closed the connection or on a real error, and succeeds
+        // with no bytes when the read would block. The last error code is not consulted:
+        // it is not set on an orderly close and may be left over from an earlier send.
+        int32 BytesRead = 0;
+        if (!Socket->Recv(Chunk.GetData(), Chunk.Num(), BytesRead))
+        {
+            UE_LOG(LogUnrealMCP, Log, TEXT("MCPClientConnection: Client %u disconnected"), ConnectionId);
+            break;
+        }
+        if (BytesRead == 0)
+        {
+            // Nothing to read after all; wait again
+            continue;
+        }
+
+        ReceiveBuffer.Append(Chunk.GetData(), BytesRead);
+
+        // A single read may hold several messages, or only part of one. They are read
+        // in place and the consumed bytes dropped once, not once per message.
+        FMCPIncomingMessage Message;
+        FString Error;
+        EMCPReadResult ReadResult = EMCPReadResult::Incomplete;
+        int32 ReadOffset = 0;
+        while (bRunning && (ReadResult = FMCPWireProtocol::ReadMessage(ReceiveBuffer, ReadOffset, JsonScan, Message, Error)) == EMCPReadResult::Message)
+        {
+            if (Message.Flags & MCP_FRAME_FLAG_SHARED_PAYLOAD)
+            {
+                if (!SharedMemory.IsValid())
+                {
+                    Error = TEXT("Shared payload without an open shared memory channel");
+                    ReadResult = EMCPReadResult::Malformed;
+                    break;
+                }
+                if (!SharedMemory->ReadRequestPayload(Message.Attachment, Error))
+                {
+                    ReadResult = EMCPReadResult::Malformed;
+                    break;
+                }
+            }
+            HandleMessage(Message);
+        }
+        ReceiveBuffer.RemoveAt(0, ReadOffset, EAllowShrinking::No);
+        if (ReadResult == EMCPReadResult::Malformed)
+        {
+            UE_LOG(LogUnrealMCP, Warning, TEXT("MCPClientConnection: Closing client %u: %s"), ConnectionId, *Error);
+            break;
+        }
+    }
+
+    Socket->Close();
+    SharedMemory.Reset();
+    bClosed = true;
+
+    // Drop anything that was queued for a client that is gone
+    TArray<uint8> Discarded;
+    while (PushQueue.Dequeue(Discarded))
+    {
+    }
+    PendingPushBytes = 0;
+
+    UE_LOG(LogUnrealMCP, Log, TEXT("MCPClientConnection: Client %u connection closed"), ConnectionId);
+    return 0;
+}
+
+bool FMCPClientConnection::OpenSharedMemory(const FString& Name, int64 RingSize, int32 MinPayload, FString& OutError)
+{
+    TUniquePtr<FMCPSharedMemoryChannel> Channel = FMCPSharedMemoryChannel::Open(Name, RingSize, MinPayload, OutError);
+    if (!Channel.IsValid())
+    {
+        return false;
+    }
+
+    UE_LOG(LogUnrealMCP, Log, TEXT("MCPClientConnection: Client %u opened shared memory %s (%lld bytes per direction)"),
+        ConnectionId, *Name, RingSize);
+    SharedMemory = MoveTemp(Channel);
+    return true;
+}
+
+bool FMCPClientConnection::EnqueuePush(TArray<uint8>&& Bytes)
+{
+    if (bClosed)
+    {
+        return false;
+    }
+
+    PendingPushBytes += Bytes.Num();
+    PushQueue.Enqueue(MoveTemp(Bytes));
+    return true;
+}
+
+void FMCPClientConnection::FlushPushQueue()
+{
+    TArray<uint8> Bytes;
+    while (bRunning && PushQueue.Dequeue(Bytes))
+    {
+        PendingPushBytes -= Bytes.Num();
+        if (!SendBytes(Bytes))
+        {
+            UE_LOG(LogUnrealMCP, Warning, TEXT("MCPClientConnection: Failed to push %d bytes to client %u"), Bytes.Num(), ConnectionId);
+        }
+    }
+}
+
+void FMCPClientConnection::HandleMessage(const FMCPIncomingMessage& Message)
+{
+    MCP_TRACE_SCOPE("MCP HandleMessage");
+    const uint64 ReceiveCycle = FPlatformTime::Cycles64();
+    const double ReceiveTime = FPlatformTime::Seconds();
+    const uint64 RequestId = FMCPRequestContext::AllocateRequestId();
+    const TSharedPtr<FMCPRequestJournal, ESPMode::ThreadSafe> Journal = Bridge->GetJournal();
+    if (Journal.IsValid())
+    {
+        Journal->Record(EMCPJournalRecordKind::Request, ConnectionId, RequestId, ReceiveTime,
+            Message.Json.GetData(), Message.Json.Num(), Message.Attachment.GetData(), Message.Attachment.Num(), (uint8)Message.Encoding);
+    }
+
+    const bool bPacked = Message.Encoding == EMCPFrameEncoding::MessagePack;
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("MCPClientConnection: #%llu received %d bytes: %s"), RequestId,
+        Message.Json.Num() + Message.Attachment.Num(),
+        bPacked ? *FMCPLog::Preview(FMCPMessagePack::ToJsonString(Message.Json)) : *FMCPLog::Preview(Message.Json));
+
+    // Parse the envelope, JSON or MessagePack
+    TSharedPtr<FJsonObject> JsonObject;
+    FString ParseError;
+    bool bParsed = false;
+    {
+        MCP_TRACE_SCOPE("MCP ParseRequest");
+        bParsed = FMCPWireProtocol::ParseMessage(Message, JsonObject, ParseError);
+    }
+    if (!bParsed)
+    {
+        UE_LOG(LogUnrealMCP, Warning, TEXT("MCPClientConnection: Failed to parse request (%s) from: %s"), *ParseError,
+            bPacked ? *FString::Printf(TEXT("%d bytes of MessagePack"), Message.Json.Num()) : *FMCPLog::Preview(Message.Json));
+        SendErrorResponse(FString::Printf(TEXT("Failed to parse request: %s"), *ParseError), Message.Encoding, nullptr);
+        return;
+    }
+
+    // Commands use "type"; older MCP-style clients send "command" and expect newline-terminated replies
+    FString CommandType;
+    bool bNewlineTerminated = false;
+    if (!JsonObject->TryGetStringField(TEXT("type"), CommandType))
+    {
+        if (!JsonObject->TryGetStringField(TEXT("command"), CommandType))
+        {
+            UE_LOG(LogUnrealMCP, Warning, TEXT("MCPClientConnection: Missing 'type' field in command"));
+            SendErrorResponse(TEXT("Missing 'type' field in command"), Message.Encoding, JsonObject->TryGetField(TEXT("id")));
+            return;
+        }
+        bNewlineTerminated = true;
+    }
+
+    // Parameters are optional
+    TSharedPtr<FJsonObject> Params = MakeShareable(new FJsonObject());
+    const TSharedPtr<FJsonObject>* ParamsObject = nullptr;
+    if (JsonObject->TryGetObjectField(TEXT("params"), ParamsObject))
+    {
+        Params = *ParamsObject;
+    }
+
+    // Revisions are read before the command runs, so a client caching the result
+    // never tags it with a revision newer than the state it was built from
+    FString Revisions;
+    bool bRevisions = false;
+    if (JsonObject->TryGetBoolField(TEXT("revisions"), bRevisions) && bRevisions)
+    {
+        if (const FMCPChangeFeed* ChangeFeed = Bridge->GetChangeFeed())
+        {
+            Revisions = ChangeFeed->ToJsonString();
+        }
+    }
+
+    // Answer in the encoding the request came in
+    FMCPResponse Response = Bridge->ExecuteCommandWithAttachment(CommandType, Params, AsShared(), Message.Attachment, RequestId,
+        bPacked ? EMCPFrameEncoding::MessagePack : EMCPFrameEncoding::Json);
+    Response.Timing.ReceiveCycle = ReceiveCycle;
+    bool bTiming = false;
+    if (JsonObject->TryGetBoolField(TEXT("timing"), bTiming) && bTiming)
+    {
+        FMCPWireProtocol::AppendTiming(Response);
+    }
+    if (!Revisions.IsEmpty())
+    {
+        FMCPWireProtocol::AppendField(Response, TEXT("revisions"), Revisions);
+    }
+    FMCPWireProtocol::AppendClientId(Response, JsonObject->TryGetField(TEXT("id")));
+    if (bNewlineTerminated && !bPacked && Response.Attachment.Num() == 0)
+    {
+        Response.Body += TEXT("\n");
+    }
+
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("MCPClientConnection: #%llu sending response: %s"), RequestId,
+        *FMCPLog::Preview(FMCPWireProtocol::DescribeResponse(Response)));
+
+    // Send response (framed when it carries a binary attachment or is MessagePack);
+    // large attachments go through shared memory when the client opened it
+    TArray<uint8> ResponseBytes;
+    TArray<uint8> SharedDescriptor;
+    {
+        MCP_TRACE_SCOPE("MCP EncodeResponse");
+        const bool bShared = SharedMemory.IsValid() && SharedMemory->WriteResponsePayload(Response.Attachment, SharedDescriptor);
+        FMCPWireProtocol::EncodeResponse(Response, ResponseBytes, bShared ? &SharedDescriptor : nullptr);
+    }
+    Response.Timing.SerializeEndCycle = FPlatformTime::Cycles64();
+    {
+        MCP_TRACE_SCOPE("MCP SendResponse");
+        if (!SendBytes(ResponseBytes))
+        {
+            UE_LOG(LogUnrealMCP, Warning, TEXT("MCPClientConnection: Failed to send response"));
+        }
+    }
+    Response.Timing.SendEndCycle = FPlatformTime::Cycles64();
+    const double TotalSeconds = FMCPRequestTiming::Seconds(ReceiveCycle, Response.Timing.SendEndCycle);
+    FMCPTrace::OutputRequest(RequestId, CommandType, Response.Timing, Response.bError);
+
+    if (Journal.IsValid())
+    {
+        // A framed response is prefix, header, then the attachment or its shared descriptor;
+        // the journal keeps the attachment itself
+        const int32 JsonOffset = FMCPWireProtocol::IsFrame(ResponseBytes.GetData(), ResponseBytes.Num()) ? MCP_FRAME_HEADER_SIZE : 0;
+        const int32 PayloadOnWire = SharedDescriptor.Num() > 0 ? SharedDescriptor.Num() : Response.Attachment.Num();
+        // The journal's clock is FPlatformTime::Seconds()
+        Journal->Record(EMCPJournalRecordKind::Response, ConnectionId, RequestId, ReceiveTime + TotalSeconds,
+            ResponseBytes.GetData() + JsonOffset, ResponseBytes.Num() - JsonOffset - PayloadOnWire,
+            Response.Attachment.GetData(), Response.Attachment.Num(), (uint8)Response.Encoding,
+            (float)(FMCPRequestTiming::Seconds(Response.Timing.DispatchCycle, Response.Timing.StartCycle) * 1000.0),
+            (float)(FMCPRequestTiming::Seconds(Response.Timing.StartCycle, Response.Timing.EndCycle) * 1000.0));
+    }
+
+    // One summary line per request, rate limited per command type
+    int32 Suppressed = 0;
+    if (UE_LOG_ACTIVE(LogUnrealMCP, Log) && FMCPLog::ShouldLogRequest(CommandType, Suppressed))
+    {
+        UE_LOG(LogUnrealMCP, Log, TEXT("MCPClientConnection: #%llu %s %s in %.2f ms (%d bytes in, %d bytes out)%s"),
+            RequestId, *CommandType, Response.bError ? TEXT("failed") : TEXT("succeeded"),
+            TotalSeconds * 1000.0, Message.Json.Num() + Message.Attachment.Num(), ResponseBytes.Num(),
+            Suppressed > 0 ? *FString::Printf(TEXT(", %d earlier %s requests not logged"), Suppressed, *CommandType) : TEXT(""));
+    }
+
+    Bridge->GetStats().RecordRequest(CommandType, Response.Timing, Response.bError,
+        Message.Json.Num() + Message.Attachment.Num(), ResponseBytes.Num());
+}
+
+void FMCPClientConnection::SendErrorResponse(const FString& Error, EMCPFrameEncoding Encoding, const TSharedPtr<FJsonValue>& Id)
+{
+    FMCPResponse Response = UUnrealMCPBridge::BuildResponse(FMCPCommandResult(FUnrealMCPCommonUtils::CreateErrorResponse(Error)), Encoding);
+    FMCPWireProtocol::AppendClientId(Response, Id);
+
+    TArray<uint8> ResponseBytes;
+    FMCPWireProtocol::EncodeResponse(Response, ResponseBytes);
+    if (!SendBytes(ResponseBytes))
+    {
+        UE_LOG(LogUnrealMCP, Warning, TEXT("MCPClientConnection: Failed to send error response to client %u"), ConnectionId);
+    }
+}
+
+bool FMCPClientConnection::SendBytes(const TArray<uint8>& Bytes)
+{
+    int32 TotalSent = 0;
+    while (TotalSent < Bytes.Num())
+    {
+        int32 BytesSent = 0;
+        if (!Socket->Send(Bytes.GetData() + TotalSent, Bytes.Num() - TotalSent, BytesSent))
+        {
+            // Large payloads (screenshots, stream frames) can fill the send buffer
+            if (ISocketSubsystem::Get()->GetLastErrorCode() == SE_EWOULDBLOCK && bRunning)
+            {
+                Socket->Wait(ESocketWaitConditions::WaitForWrite, PollInterval);
+                continue;
+            }
+            return false;
+        }
+        TotalSent += BytesSent;
+    }
+    return true;
+}
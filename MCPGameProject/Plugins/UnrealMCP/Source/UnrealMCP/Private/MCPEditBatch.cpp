@@ -0,0 +1,177 @@
+#include "MCPEditBatch.h"
+#include "MCPLog.h"
+#include "Editor.h"
+#include "Editor/Transactor.h"
+#include "EditorAssetLibrary.h"
+#include "Engine/Blueprint.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "MCPTrace.h"
+
+namespace
+{
+    FMCPEditBatch* ActiveBatch = nullptr;
+}
+
+FMCPEditBatch::FMCPEditBatch(const FString& InDescription)
+    : Description(InDescription)
+    , StartTime(FPlatformTime::Seconds())
+    , bOpen(true)
+{
+    check(IsInGameThread());
+    check(!ActiveBatch);
+    ActiveBatch = this;
+
+    if (GEditor && GEditor->Trans)
+    {
+        GEditor->BeginTransaction(TEXT("UnrealMCP"), FText::FromString(Description), nullptr);
+
+        // Remember which transaction is ours so Rollback never undoes someone else's
+        const int32 QueueLength = GEditor->Trans->GetQueueLength();
+        if (const FTransaction* Transaction = QueueLength > 0 ? GEditor->Trans->GetTransaction(QueueLength - 1) : nullptr)
+        {
+            TransactionId = Transaction->GetId();
+        }
+    }
+
+    UE_LOG(LogUnrealMCP, Log, TEXT("UnrealMCP: Began edit batch '%s'"), *Description);
+}
+
+FMCPEditBatch::~FMCPEditBatch()
+{
+    if (bOpen)
+    {
+        Commit();
+    }
+    if (ActiveBatch == this)
+    {
+        ActiveBatch = nullptr;
+    }
+}
+
+FMCPEditBatch* FMCPEditBatch::Get()
+{
+    check(IsInGameThread());
+    return ActiveBatch;
+}
+
+FMCPEditBatch::FPendingBlueprint& FMCPEditBatch::FindOrAddPending(UBlueprint* Blueprint)
+{
+    for (FPendingBlueprint& Entry : Pending)
+    {
+        if (Entry.Blueprint.Get() == Blueprint)
+        {
+            return Entry;
+        }
+    }
+    FPendingBlueprint& Entry = Pending.AddDefaulted_GetRef();
+    Entry.Blueprint = Blueprint;
+    return Entry;
+}
+
+void FMCPEditBatch::DeferBlueprintModified(UBlueprint* Blueprint, bool bStructural)
+{
+    if (Blueprint)
+    {
+        FPendingBlueprint& Entry = FindOrAddPending(Blueprint);
+        Entry.bStructural |= bStructural;
+    }
+}
+
+void FMCPEditBatch::DeferCompile(UBlueprint* Blueprint)
+{
+    if (Blueprint)
+    {
+        FindOrAddPending(Blueprint).bCompile = true;
+    }
+}
+
+void FMCPEditBatch::DeferSave(UBlueprint* Blueprint)
+{
+    if (Blueprint)
+    {
+        FindOrAddPending(Blueprint).bSave = true;
+    }
+}
+
+void FMCPEditBatch::EndTransaction()
+{
+    if (bOpen && GEditor && GEditor->Trans)
+    {
+        GEditor->EndTransaction();
+    }
+    bOpen = false;
+    if (ActiveBatch == this)
+    {
+        ActiveBatch = nullptr;
+    }
+}
+
+TSharedPtr<FJsonObject> FMCPEditBatch::Commit()
+{
+    EndTransaction();
+
+    // One refresh per blueprint, after the transaction so compiles are not recorded in it
+    int32 Refreshed = 0;
+    int32 Compiled = 0;
+    int32 Saved = 0;
+    for (const FPendingBlueprint& Entry : Pending)
+    {
+        UBlueprint* Blueprint = Entry.Blueprint.Get();
+        if (!Blueprint)
+        {
+            continue;
+        }
+        if (Entry.bStructural)
+        {
+            FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+        }
+        else
+        {
+            FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+        }
+        ++Refreshed;
+        if (Entry.bCompile)
+        {
+            MCP_TRACE_SCOPE("MCP CompileBlueprint");
+            FKismetEditorUtilities::CompileBlueprint(Blueprint);
+            ++Compiled;
+        }
+        if (Entry.bSave && UEditorAssetLibrary::SaveLoadedAsset(Blueprint, false))
+        {
+            ++Saved;
+        }
+    }
+    Pending.Empty();
+
+    if (GEditor)
+    {
+        GEditor->RedrawLevelEditingViewports();
+    }
+
+    UE_LOG(LogUnrealMCP, Log, TEXT("UnrealMCP: Committed edit batch '%s' (%d blueprints refreshed, %d compiled, %d saved, %.1f ms)"),
+        *Description, Refreshed, Compiled, Saved, GetAge() * 1000.0);
+
+    TSharedPtr<FJsonObject> Summary = MakeShared<FJsonObject>();
+    Summary->SetStringField(TEXT("description"), Description);
+    Summary->SetNumberField(TEXT("blueprints_refreshed"), Refreshed);
+    Summary->SetNumberField(TEXT("blueprints_compiled"), Compiled);
+    Summary->SetNumberField(TEXT("blueprints_saved"), Saved);
+    Summary->SetNumberField(TEXT("elapsed_ms"), GetAge() * 1000.0);
+    return Summary;
+}
+
+void FMCPEditBatch::Rollback()
+{
+    EndTransaction();
+    Pending.Empty();
+
+    // An empty transaction is discarded on end; only undo when ours is the next undo
+    if (GEditor && GEditor->Trans && TransactionId.IsValid()
+        && GEditor->Trans->GetUndoContext(false).TransactionId == TransactionId)
+    {
+        GEditor->UndoTransaction(false);
+    }
+
+    UE_LOG(LogUnrealMCP, Log, TEXT("UnrealMCP: Rolled back edit batch '%s'"), *Description);
+}
@@ -0,0 +1,539 @@
+#include "MCPFakeWorld.h"
+#include "Commands/UnrealMCPCommonUtils.h"
+#include "Dom/JsonValue.h"
+
+namespace
+{
+    /** Actor types spawn_actor accepts, as in FUnrealMCPEditorCommands::HandleSpawnActor */
+    bool IsSpawnableType(const FString& Type)
+    {
+        return Type == TEXT("StaticMeshActor") || Type == TEXT("PointLight") || Type == TEXT("SpotLight")
+            || Type == TEXT("DirectionalLight") || Type == TEXT("CameraActor");
+    }
+
+    TArray<TSharedPtr<FJsonValue>> VectorToJson(const FVector& Vector)
+    {
+        TArray<TSharedPtr<FJsonValue>> Array;
+        Array.Add(MakeShared<FJsonValueNumber>(Vector.X));
+        Array.Add(MakeShared<FJsonValueNumber>(Vector.Y));
+        Array.Add(MakeShared<FJsonValueNumber>(Vector.Z));
+        return Array;
+    }
+}
+
+FMCPFakeWorld::FMCPFakeWorld()
+    : NextHandle(1)
+    , bChanged(false)
+{
+}
+
+TSharedPtr<FJsonObject> FMCPFakeWorld::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, bool& bOutChanged)
+{
+    bChanged = false;
+    TSharedPtr<FJsonObject> Result;
+    if (CommandType == TEXT("get_actors_in_level"))
+    {
+        Result = HandleGetActorsInLevel(Params);
+    }
+    else if (CommandType == TEXT("find_actors_by_name"))
+    {
+        Result = HandleFindActorsByName(Params);
+    }
+    else if (CommandType == TEXT("spawn_actor") || CommandType == TEXT("create_actor"))
+    {
+        Result = HandleSpawnActor(Params);
+    }
+    else if (CommandType == TEXT("spawn_actors_bulk"))
+    {
+        Result = HandleSpawnActorsBulk(Params);
+    }
+    else if (CommandType == TEXT("delete_actor"))
+    {
+        Result = HandleDeleteActor(Params);
+    }
+    else if (CommandType == TEXT("set_actor_transform"))
+    {
+        Result = HandleSetActorTransform(Params);
+    }
+    else if (CommandType == TEXT("set_transforms_bulk"))
+    {
+        Result = HandleSetTransformsBulk(Params);
+    }
+    else if (CommandType == TEXT("get_actor_properties"))
+    {
+        Result = HandleGetActorProperties(Params);
+    }
+    else if (CommandType == TEXT("find_actors_in_radius"))
+    {
+        Result = HandleFindActorsInRadius(Params);
+    }
+    else
+    {
+        Result = FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown command: %s (not available in the fake world)"), *CommandType));
+    }
+
+    bOutChanged = bChanged;
+    return Result;
+}
+
+void FMCPFakeWorld::Populate(int32 Count, const FString& Prefix, double Spacing)
+{
+    const int32 Side = FMath::Max(1, FMath::CeilToInt(FMath::Sqrt((double)Count)));
+    Actors.Reserve(Actors.Num() + Count);
+    HandlesByName.Reserve(HandlesByName.Num() + Count);
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        const FVector Location((Index % Side) * Spacing, (Index / Side) * Spacing, 0.0);
+        AddActor(FString::Printf(TEXT("%s_%d"), *Prefix, Index), TEXT("StaticMeshActor"), FTransform(Location));
+    }
+}
+
+FMCPFakeWorld::FFakeActor* FMCPFakeWorld::AddActor(const FString& Name, const FString& Class, const FTransform& Transform)
+{
+    if (HandlesByName.Contains(Name))
+    {
+        return nullptr;
+    }
+
+    const int32 Handle = NextHandle++;
+    FFakeActor& Actor = Actors.Add(Handle);
+    Actor.Handle = Handle;
+    Actor.Name = Name;
+    Actor.Class = Class;
+    Actor.Transform = Transform;
+    HandlesByName.Add(Name, Handle);
+    bChanged = true;
+    return &Actor;
+}
+
+FMCPFakeWorld::FFakeActor* FMCPFakeWorld::FindActorFromParams(const TSharedPtr<FJsonObject>& Params, FString& OutError)
+{
+    // Same lookup order and errors as FUnrealMCPCommonUtils::FindActorFromParams
+    int64 Handle = 0;
+    if (Params->TryGetNumberField(TEXT("handle"), Handle))
+    {
+        FFakeActor* Actor = Actors.Find((int32)Handle);
+        if (!Actor)
+        {
+            OutError = Handle > 0 && Handle < NextHandle
+                ? FString::Printf(TEXT("Stale actor handle: %lld (the actor no longer exists)"), Handle)
+                : FString::Printf(TEXT("Unknown actor handle: %lld"), Handle);
+        }
+        return Actor;
+    }
+
+    FString ActorName;
+    if (!Params->TryGetStringField(TEXT("name"), ActorName))
+    {
+        OutError = TEXT("Missing 'name' or 'handle' parameter");
+        return nullptr;
+    }
+
+    const int32* FoundHandle = HandlesByName.Find(ActorName);
+    if (!FoundHandle)
+    {
+        OutError = FString::Printf(TEXT("Actor not found: %s"), *ActorName);
+        return nullptr;
+    }
+    return Actors.Find(*FoundHandle);
+}
+
+TSharedPtr<FJsonObject> FMCPFakeWorld::ActorToJsonObject(const FFakeActor& Actor)
+{
+    const FRotator Rotation = Actor.Transform.Rotator();
+    TArray<TSharedPtr<FJsonValue>> RotationArray;
+    RotationArray.Add(MakeShared<FJsonValueNumber>(Rotation.Pitch));
+    RotationArray.Add(MakeShared<FJsonValueNumber>(Rotation.Yaw));
+    RotationArray.Add(MakeShared<FJsonValueNumber>(Rotation.Roll));
+
+    TSharedPtr<FJsonObject> ActorObject = MakeShared<FJsonObject>();
+    ActorObject->SetStringField(TEXT("name"), Actor.Name);
+    ActorObject->SetNumberField(TEXT("handle"), Actor.Handle);
+    ActorObject->SetStringField(TEXT("class"), Actor.Class);
+    ActorObject->SetArrayField(TEXT("location"), VectorToJson(Actor.Transform.GetLocation()));
+    ActorObject->SetArrayField(TEXT("rotation"), RotationArray);
+    ActorObject->SetArrayField(TEXT("scale"), VectorToJson(Actor.Transform.GetScale3D()));
+    return ActorObject;
+}
+
+TSharedPtr<FJsonObject> FMCPFakeWorld::HandleGetActorsInLevel(const TSharedPtr<FJsonObject>& Params)
+{
+    int32 MaxActors = 100;
+    Params->TryGetNumberField(TEXT("max_actors"), MaxActors);
+
+    TArray<TSharedPtr<FJsonValue>> ActorArray;
+    for (const TPair<int32, FFakeActor>& Pair : Actors)
+    {
+        if (MaxActors > 0 && ActorArray.Num() >= MaxActors)
+        {
+            break;
+        }
+        ActorArray.Add(MakeShared<FJsonValueObject>(ActorToJsonObject(Pair.Value)));
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetArrayField(TEXT("actors"), ActorArray);
+    ResultObj->SetNumberField(TEXT("total_actors"), Actors.Num());
+    ResultObj->SetNumberField(TEXT("returned_actors"), ActorArray.Num());
+    ResultObj->SetBoolField(TEXT("truncated"), MaxActors > 0 && Actors.Num() > MaxActors);
+    return ResultObj;
+}
+
+TSharedPtr<FJsonObject> FMCPFakeWorld::HandleFindActorsByName(const TSharedPtr<FJsonObject>& Params)
+{
+    FString Pattern;
+    if (!Params->TryGetStringField(TEXT("pattern"), Pattern))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'pattern' parameter"));
+    }
+
+    TArray<TSharedPtr<FJsonValue>> MatchingActors;
+    for (const TPair<int32, FFakeActor>& Pair : Actors)
+    {
+        if (Pair.Value.Name.Contains(Pattern))
+        {
+            MatchingActors.Add(MakeShared<FJsonValueObject>(ActorToJsonObject(Pair.Value)));
+        }
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetArrayField(TEXT("actors"), MatchingActors);
+    return ResultObj;
+}
+
+TSharedPtr<FJsonObject> FMCPFakeWorld::HandleSpawnActor(const TSharedPtr<FJsonObject>& Params)
+{
+    FString ActorType;
+    if (!Params->TryGetStringField(TEXT("type"), ActorType))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'type' parameter"));
+    }
+    FString ActorName;
+    if (!Params->TryGetStringField(TEXT("name"), ActorName))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'name' parameter"));
+    }
+    if (!IsSpawnableType(ActorType))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown actor type: %s"), *ActorType));
+    }
+
+    FTransform Transform;
+    if (Params->HasField(TEXT("location")))
+    {
+        Transform.SetLocation(FUnrealMCPCommonUtils::GetVectorFromJson(Params, TEXT("location")));
+    }
+    if (Params->HasField(TEXT("rotation")))
+    {
+        Transform.SetRotation(FQuat(FUnrealMCPCommonUtils::GetRotatorFromJson(Params, TEXT("rotation"))));
+    }
+    if (Params->HasField(TEXT("scale")))
+    {
+        Transform.SetScale3D(FUnrealMCPCommonUtils::GetVectorFromJson(Params, TEXT("scale")));
+    }
+
+    const FFakeActor* Actor = AddActor(ActorName, ActorType, Transform);
+    if (!Actor)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor with name '%s' already exists"), *ActorName));
+    }
+    return ActorToJsonObject(*Actor);
+}
+
+TSharedPtr<FJsonObject> FMCPFakeWorld::HandleSpawnActorsBulk(const TSharedPtr<FJsonObject>& Params)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    // Same parameters and result as FUnrealMCPEditorCommands::HandleSpawnActorsBulk, without
+    // instancing; 'static_mesh' is accepted and ignored since fake actors have no components
+    FString NamePrefix;
+    if (!Params->TryGetStringField(TEXT("name_prefix"), NamePrefix) || NamePrefix.IsEmpty())
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'name_prefix' parameter"));
+    }
+
+    bool bInstanced = false;
+    Params->TryGetBoolField(TEXT("instanced"), bInstanced);
+    if (bInstanced)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("'instanced' is not available in the fake world"));
+    }
+
+    FString ActorType = TEXT("StaticMeshActor");
+    Params->TryGetStringField(TEXT("type"), ActorType);
+    if (!IsSpawnableType(ActorType))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown actor type: %s"), *ActorType));
+    }
+
+    FString Layout = TEXT("full");
+    Params->TryGetStringField(TEXT("layout"), Layout);
+    const int32 Stride = FUnrealMCPCommonUtils::GetPackedTransformStride(Layout);
+    if (Stride == 0)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown layout '%s' (expected location, location_rotation or full)"), *Layout));
+    }
+
+    TArray<float> Values;
+    FString Error;
+    if (!FUnrealMCPCommonUtils::GetPackedFloats(Params, TEXT("transforms"), Values, Error))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+    if (Values.Num() == 0 || Values.Num() % Stride != 0)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(
+            TEXT("'transforms' must hold a non-zero multiple of %d floats for layout '%s', got %d"), Stride, *Layout, Values.Num()));
+    }
+    const int32 Count = Values.Num() / Stride;
+
+    bool bReturnNames = false;
+    Params->TryGetBoolField(TEXT("return_names"), bReturnNames);
+
+    Actors.Reserve(Actors.Num() + Count);
+    HandlesByName.Reserve(HandlesByName.Num() + Count);
+
+    // Names follow the editor's <prefix>_<index>; a name that is taken counts as failed
+    TArray<TSharedPtr<FJsonValue>> Names;
+    FString FirstName;
+    FString LastName;
+    int32 FirstHandle = 0;
+    int32 LastHandle = 0;
+    int32 Spawned = 0;
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        const FFakeActor* Actor = AddActor(FString::Printf(TEXT("%s_%d"), *NamePrefix, Index), ActorType,
+            FUnrealMCPCommonUtils::MakePackedTransform(Values.GetData() + Index * Stride, Stride));
+        if (!Actor)
+        {
+            continue;
+        }
+
+        // Copied out: later adds may move the record
+        LastName = Actor->Name;
+        LastHandle = Actor->Handle;
+        if (Spawned == 0)
+        {
+            FirstName = LastName;
+            FirstHandle = LastHandle;
+        }
+        if (bReturnNames)
+        {
+            Names.Add(MakeShared<FJsonValueString>(LastName));
+        }
+        ++Spawned;
+    }
+
+    if (Spawned == 0)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to spawn any actors"));
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetNumberField(TEXT("count"), Count);
+    ResultObj->SetStringField(TEXT("mode"), TEXT("actors"));
+    ResultObj->SetNumberField(TEXT("spawned"), Spawned);
+    ResultObj->SetNumberField(TEXT("failed"), Count - Spawned);
+    ResultObj->SetStringField(TEXT("first_name"), FirstName);
+    ResultObj->SetStringField(TEXT("last_name"), LastName);
+    ResultObj->SetNumberField(TEXT("first_handle"), FirstHandle);
+    ResultObj->SetNumberField(TEXT("last_handle"), LastHandle);
+    if (bReturnNames)
+    {
+        ResultObj->SetArrayField(TEXT("names"), Names);
+    }
+    ResultObj->SetNumberField(TEXT("elapsed_ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+    return ResultObj;
+}
+
+TSharedPtr<FJsonObject> FMCPFakeWorld::HandleDeleteActor(const TSharedPtr<FJsonObject>& Params)
+{
+    FString Error;
+    const FFakeActor* Actor = FindActorFromParams(Params, Error);
+    if (!Actor)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetObjectField(TEXT("deleted_actor"), ActorToJsonObject(*Actor));
+    const int32 Handle = Actor->Handle;
+    HandlesByName.Remove(Actor->Name);
+    Actors.Remove(Handle);
+    bChanged = true;
+    return ResultObj;
+}
+
+TSharedPtr<FJsonObject> FMCPFakeWorld::HandleSetActorTransform(const TSharedPtr<FJsonObject>& Params)
+{
+    FString Error;
+    FFakeActor* Actor = FindActorFromParams(Params, Error);
+    if (!Actor)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+
+    if (Params->HasField(TEXT("location")))
+    {
+        Actor->Transform.SetLocation(FUnrealMCPCommonUtils::GetVectorFromJson(Params, TEXT("location")));
+    }
+    if (Params->HasField(TEXT("rotation")))
+    {
+        Actor->Transform.SetRotation(FQuat(FUnrealMCPCommonUtils::GetRotatorFromJson(Params, TEXT("rotation"))));
+    }
+    if (Params->HasField(TEXT("scale")))
+    {
+        Actor->Transform.SetScale3D(FUnrealMCPCommonUtils::GetVectorFromJson(Params, TEXT("scale")));
+    }
+    bChanged = true;
+    return ActorToJsonObject(*Actor);
+}
+
+TSharedPtr<FJsonObject> FMCPFakeWorld::HandleSetTransformsBulk(const TSharedPtr<FJsonObject>& Params)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    // Same parameters and checks as FUnrealMCPEditorCommands::HandleSetTransformsBulk; 'transactional' has no effect here
+    const TArray<TSharedPtr<FJsonValue>>* HandleValues = nullptr;
+    const TArray<TSharedPtr<FJsonValue>>* NameValues = nullptr;
+    if (!Params->TryGetArrayField(TEXT("handles"), HandleValues) && !Params->TryGetArrayField(TEXT("names"), NameValues))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'handles' or 'names' parameter"));
+    }
+
+    FString Layout = TEXT("full");
+    Params->TryGetStringField(TEXT("layout"), Layout);
+    const int32 Stride = FUnrealMCPCommonUtils::GetPackedTransformStride(Layout);
+    if (Stride == 0)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown layout '%s' (expected location, location_rotation or full)"), *Layout));
+    }
+
+    TArray<float> Values;
+    FString Error;
+    if (!FUnrealMCPCommonUtils::GetPackedFloats(Params, TEXT("transforms"), Values, Error))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+    const int32 Count = HandleValues ? HandleValues->Num() : NameValues->Num();
+    if (Values.Num() != Count * Stride)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(
+            TEXT("'transforms' must hold %d floats (%d actors x %d for layout '%s'), got %d"), Count * Stride, Count, Stride, *Layout, Values.Num()));
+    }
+
+    TArray<TSharedPtr<FJsonValue>> Failures;
+    int32 Updated = 0;
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        TSharedPtr<FJsonObject> ActorParams = MakeShared<FJsonObject>();
+        if (HandleValues)
+        {
+            ActorParams->SetField(TEXT("handle"), (*HandleValues)[Index]);
+        }
+        else
+        {
+            ActorParams->SetField(TEXT("name"), (*NameValues)[Index]);
+        }
+
+        FString ActorError;
+        FFakeActor* Actor = FindActorFromParams(ActorParams, ActorError);
+        if (!Actor)
+        {
+            TSharedPtr<FJsonObject> Failure = MakeShared<FJsonObject>();
+            Failure->SetNumberField(TEXT("index"), Index);
+            Failure->SetStringField(TEXT("error"), ActorError);
+            Failures.Add(MakeShared<FJsonValueObject>(Failure));
+            continue;
+        }
+
+        // Layouts without rotation or scale leave those parts of the transform untouched
+        const float* Item = Values.GetData() + Index * Stride;
+        Actor->Transform.SetLocation(FVector(Item[0], Item[1], Item[2]));
+        if (Stride >= 6)
+        {
+            Actor->Transform.SetRotation(FQuat(FRotator(Item[3], Item[4], Item[5])));
+        }
+        if (Stride >= 9)
+        {
+            Actor->Transform.SetScale3D(FVector(Item[6], Item[7], Item[8]));
+        }
+        ++Updated;
+    }
+    bChanged = Updated > 0;
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetNumberField(TEXT("count"), Count);
+    ResultObj->SetNumberField(TEXT("updated"), Updated);
+    ResultObj->SetNumberField(TEXT("failed"), Failures.Num());
+    ResultObj->SetArrayField(TEXT("failures"), Failures);
+    ResultObj->SetNumberField(TEXT("elapsed_ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+    return ResultObj;
+}
+
+TSharedPtr<FJsonObject> FMCPFakeWorld::HandleGetActorProperties(const TSharedPtr<FJsonObject>& Params)
+{
+    FString Error;
+    const FFakeActor* Actor = FindActorFromParams(Params, Error);
+    if (!Actor)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+    return ActorToJsonObject(*Actor);
+}
+
+TSharedPtr<FJsonObject> FMCPFakeWorld::HandleFindActorsInRadius(const TSharedPtr<FJsonObject>& Params)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    double Radius = 0.0;
+    if (!Params->HasField(TEXT("center")) || !Params->TryGetNumberField(TEXT("radius"), Radius) || Radius < 0.0)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'center' or non-negative 'radius' parameter"));
+    }
+    const FVector Center = FUnrealMCPCommonUtils::GetVectorFromJson(Params, TEXT("center"));
+    int32 MaxResults = 1000;
+    Params->TryGetNumberField(TEXT("max_results"), MaxResults);
+    FString ClassName;
+    Params->TryGetStringField(TEXT("class"), ClassName);
+
+    // Fake actors are points, so a linear scan stands in for the spatial index.
+    // Every hit is collected so the nearest ones are kept when the result is cut.
+    TArray<TPair<double, const FFakeActor*>> Hits;
+    for (const TPair<int32, FFakeActor>& Pair : Actors)
+    {
+        const double DistanceSquared = FVector::DistSquared(Center, Pair.Value.Transform.GetLocation());
+        if (DistanceSquared <= Radius * Radius && (ClassName.IsEmpty() || Pair.Value.Class == ClassName))
+        {
+            Hits.Emplace(DistanceSquared, &Pair.Value);
+        }
+    }
+    Hits.Sort([](const TPair<double, const FFakeActor*>& A, const TPair<double, const FFakeActor*>& B) { return A.Key < B.Key; });
+    const bool bComplete = Hits.Num() <= FMath::Max(MaxResults, 0);
+    if (!bComplete)
+    {
+        Hits.SetNum(FMath::Max(MaxResults, 0), EAllowShrinking::No);
+    }
+
+    TArray<TSharedPtr<FJsonValue>> ActorArray;
+    ActorArray.Reserve(Hits.Num());
+    for (const TPair<double, const FFakeActor*>& Hit : Hits)
+    {
+        TSharedPtr<FJsonObject> ActorObject = MakeShared<FJsonObject>();
+        ActorObject->SetStringField(TEXT("name"), Hit.Value->Name);
+        ActorObject->SetNumberField(TEXT("handle"), Hit.Value->Handle);
+        ActorObject->SetStringField(TEXT("class"), Hit.Value->Class);
+        ActorObject->SetArrayField(TEXT("location"), VectorToJson(Hit.Value->Transform.GetLocation()));
+        ActorObject->SetNumberField(TEXT("distance"), FMath::Sqrt(Hit.Key));
+        ActorArray.Add(MakeShared<FJsonValueObject>(ActorObject));
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetArrayField(TEXT("actors"), ActorArray);
+    ResultObj->SetNumberField(TEXT("count"), Hits.Num());
+    ResultObj->SetBoolField(TEXT("truncated"), !bComplete);
+    ResultObj->SetNumberField(TEXT("indexed_actors"), Actors.Num());
+    ResultObj->SetBoolField(TEXT("index_rebuilt"), false);
+    ResultObj->SetNumberField(TEXT("query_us"), (FPlatformTime::Seconds() - StartTime) * 1000000.0);
+    return ResultObj;
+}
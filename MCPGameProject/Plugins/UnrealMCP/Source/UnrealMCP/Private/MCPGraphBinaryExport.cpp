@@ -0,0 +1,286 @@
+#include "MCPGraphBinaryExport.h"
+#include "Commands/UnrealMCPCommonUtils.h"
+#include "Engine/Blueprint.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+#include "K2Node_Event.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_VariableGet.h"
+#include "K2Node_VariableSet.h"
+#include "K2Node_CustomEvent.h"
+
+namespace
+{
+    /** Deduplicated strings, in order of first use */
+    class FStringTable
+    {
+    public:
+        uint32 Add(const FString& Value)
+        {
+            if (const uint32* Existing = Indices.Find(Value))
+            {
+                return *Existing;
+            }
+            const uint32 Index = Strings.Add(Value);
+            Indices.Add(Value, Index);
+            return Index;
+        }
+
+        uint32 AddOptional(const FString& Value)
+        {
+            return Value.IsEmpty() ? MCPG_NO_STRING : Add(Value);
+        }
+
+        uint32 AddName(FName Value)
+        {
+            return Value.IsNone() ? MCPG_NO_STRING : Add(Value.ToString());
+        }
+
+        const TArray<FString>& GetStrings() const { return Strings; }
+
+    private:
+        TArray<FString> Strings;
+        TMap<FString, uint32> Indices;
+    };
+
+    template <typename T>
+    void AppendColumn(TArray<uint8>& Out, const TArray<T>& Column)
+    {
+        static_assert(PLATFORM_LITTLE_ENDIAN, "MCPG columns are written in native byte order");
+        Out.Append(reinterpret_cast<const uint8*>(Column.GetData()), Column.Num() * sizeof(T));
+    }
+
+    void AppendUInt32(TArray<uint8>& Out, uint32 Value)
+    {
+        Out.Append(reinterpret_cast<const uint8*>(&Value), sizeof(Value));
+    }
+
+    void AppendGuid(TArray<uint8>& Out, const FGuid& Guid)
+    {
+        AppendUInt32(Out, Guid.A);
+        AppendUInt32(Out, Guid.B);
+        AppendUInt32(Out, Guid.C);
+        AppendUInt32(Out, Guid.D);
+    }
+
+    /** Same classification as the JSON "node_category" field */
+    EMCPGraphNodeCategory ClassifyNode(const UEdGraphNode* Node, FName& OutMember)
+    {
+        if (const UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node))
+        {
+            OutMember = EventNode->EventReference.GetMemberName();
+            return EMCPGraphNodeCategory::Event;
+        }
+        if (const UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(Node))
+        {
+            OutMember = CallNode->FunctionReference.GetMemberName();
+            return EMCPGraphNodeCategory::FunctionCall;
+        }
+        if (const UK2Node_VariableGet* VarGetNode = Cast<UK2Node_VariableGet>(Node))
+        {
+            OutMember = VarGetNode->VariableReference.GetMemberName();
+            return EMCPGraphNodeCategory::VariableGet;
+        }
+        if (const UK2Node_VariableSet* VarSetNode = Cast<UK2Node_VariableSet>(Node))
+        {
+            OutMember = VarSetNode->VariableReference.GetMemberName();
+            return EMCPGraphNodeCategory::VariableSet;
+        }
+        if (const UK2Node_CustomEvent* CustomEventNode = Cast<UK2Node_CustomEvent>(Node))
+        {
+            OutMember = CustomEventNode->CustomFunctionName;
+            return EMCPGraphNodeCategory::CustomEvent;
+        }
+        OutMember = NAME_None;
+        return EMCPGraphNodeCategory::Other;
+    }
+}
+
+FMCPGraphExportStats FMCPGraphBinaryExport::Export(const UBlueprint* Blueprint, const TArray<UEdGraph*>& Graphs, TArray<uint8>& OutBytes)
+{
+    FStringTable StringTable;
+
+    // Graph table
+    TArray<uint32> GraphRows;
+
+    // Node columns
+    TArray<FGuid> NodeGuids;
+    TArray<uint32> NodeClasses;
+    TArray<uint32> NodeTitles;
+    TArray<uint32> NodeMembers;
+    TArray<int32> NodePosX;
+    TArray<int32> NodePosY;
+    TArray<uint32> NodeFirstPins;
+    TArray<uint32> NodePinCounts;
+    TArray<uint8> NodeCategories;
+
+    // Pin columns
+    TArray<FGuid> PinGuids;
+    TArray<uint32> PinNodes;
+    TArray<uint32> PinNames;
+    TArray<uint32> PinCategories;
+    TArray<uint32> PinSubCategories;
+    TArray<uint32> PinObjects;
+    TArray<uint32> PinDefaults;
+    TArray<uint8> PinFlags;
+
+    // Edge columns
+    TArray<uint32> EdgeFrom;
+    TArray<uint32> EdgeTo;
+
+    for (const UEdGraph* Graph : Graphs)
+    {
+        if (!Graph)
+        {
+            continue;
+        }
+
+        const uint32 FirstNode = NodeGuids.Num();
+        const uint32 FirstEdge = EdgeFrom.Num();
+        TMap<const UEdGraphPin*, uint32> PinIndices;
+
+        for (const UEdGraphNode* Node : Graph->Nodes)
+        {
+            if (!Node)
+            {
+                continue;
+            }
+
+            const uint32 NodeIndex = NodeGuids.Add(Node->NodeGuid);
+            FName Member;
+            NodeCategories.Add((uint8)ClassifyNode(Node, Member));
+            NodeMembers.Add(StringTable.AddName(Member));
+            NodeClasses.Add(StringTable.Add(Node->GetClass()->GetName()));
+            NodeTitles.Add(StringTable.Add(Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString()));
+            NodePosX.Add(Node->NodePosX);
+            NodePosY.Add(Node->NodePosY);
+            NodeFirstPins.Add(PinGuids.Num());
+
+            uint32 PinCount = 0;
+            for (const UEdGraphPin* Pin : Node->Pins)
+            {
+                if (!Pin)
+                {
+                    continue;
+                }
+
+                PinIndices.Add(Pin, PinGuids.Add(Pin->PinId));
+                PinNodes.Add(NodeIndex);
+                PinNames.Add(StringTable.Add(Pin->PinName.ToString()));
+                PinCategories.Add(StringTable.Add(Pin->PinType.PinCategory.ToString()));
+                PinSubCategories.Add(StringTable.AddName(Pin->PinType.PinSubCategory));
+                PinObjects.Add(Pin->PinType.PinSubCategoryObject.IsValid()
+                    ? StringTable.Add(Pin->PinType.PinSubCategoryObject->GetName())
+                    : MCPG_NO_STRING);
+                PinDefaults.Add(StringTable.AddOptional(Pin->DefaultValue));
+
+                EMCPGraphPinFlags Flags = EMCPGraphPinFlags::None;
+                if (Pin->Direction == EGPD_Output)
+                {
+                    Flags |= EMCPGraphPinFlags::Output;
+                }
+                if (Pin->PinType.bIsReference)
+                {
+                    Flags |= EMCPGraphPinFlags::Reference;
+                }
+                if (Pin->PinType.bIsConst)
+                {
+                    Flags |= EMCPGraphPinFlags::Const;
+                }
+                PinFlags.Add((uint8)Flags);
+                ++PinCount;
+            }
+            NodePinCounts.Add(PinCount);
+        }
+
+        // Edges from output pins only, so every link appears once
+        for (const UEdGraphNode* Node : Graph->Nodes)
+        {
+            if (!Node)
+            {
+                continue;
+            }
+            for (const UEdGraphPin* Pin : Node->Pins)
+            {
+                if (!Pin || Pin->Direction != EGPD_Output)
+                {
+                    continue;
+                }
+                for (const UEdGraphPin* LinkedPin : Pin->LinkedTo)
+                {
+                    if (const uint32* LinkedIndex = PinIndices.Find(LinkedPin))
+                    {
+                        EdgeFrom.Add(PinIndices.FindChecked(Pin));
+                        EdgeTo.Add(*LinkedIndex);
+                    }
+                }
+            }
+        }
+
+        GraphRows.Add(StringTable.Add(Graph->GetName()));
+        GraphRows.Add(StringTable.Add(FUnrealMCPCommonUtils::GetGraphType(Blueprint, Graph)));
+        GraphRows.Add(FirstNode);
+        GraphRows.Add(NodeGuids.Num() - FirstNode);
+        GraphRows.Add(FirstEdge);
+        GraphRows.Add(EdgeFrom.Num() - FirstEdge);
+    }
+
+    FMCPGraphExportStats Stats;
+    Stats.StringCount = StringTable.GetStrings().Num();
+    Stats.GraphCount = GraphRows.Num() / 6;
+    Stats.NodeCount = NodeGuids.Num();
+    Stats.PinCount = PinGuids.Num();
+    Stats.EdgeCount = EdgeFrom.Num();
+
+    OutBytes.Reset();
+    OutBytes.Append(reinterpret_cast<const uint8*>("MCPG"), 4);
+    const uint16 Version = MCPG_VERSION;
+    const uint16 Reserved = 0;
+    OutBytes.Append(reinterpret_cast<const uint8*>(&Version), sizeof(Version));
+    OutBytes.Append(reinterpret_cast<const uint8*>(&Reserved), sizeof(Reserved));
+    AppendUInt32(OutBytes, Stats.StringCount);
+    AppendUInt32(OutBytes, Stats.GraphCount);
+    AppendUInt32(OutBytes, Stats.NodeCount);
+    AppendUInt32(OutBytes, Stats.PinCount);
+    AppendUInt32(OutBytes, Stats.EdgeCount);
+
+    for (const FString& Value : StringTable.GetStrings())
+    {
+        FTCHARToUTF8 Utf8Value(*Value);
+        AppendUInt32(OutBytes, Utf8Value.Length());
+        OutBytes.Append(reinterpret_cast<const uint8*>(Utf8Value.Get()), Utf8Value.Length());
+    }
+
+    AppendColumn(OutBytes, GraphRows);
+
+    for (const FGuid& Guid : NodeGuids)
+    {
+        AppendGuid(OutBytes, Guid);
+    }
+    AppendColumn(OutBytes, NodeClasses);
+    AppendColumn(OutBytes, NodeTitles);
+    AppendColumn(OutBytes, NodeMembers);
+    AppendColumn(OutBytes, NodePosX);
+    AppendColumn(OutBytes, NodePosY);
+    AppendColumn(OutBytes, NodeFirstPins);
+    AppendColumn(OutBytes, NodePinCounts);
+    AppendColumn(OutBytes, NodeCategories);
+
+    for (const FGuid& Guid : PinGuids)
+    {
+        AppendGuid(OutBytes, Guid);
+    }
+    AppendColumn(OutBytes, PinNodes);
+    AppendColumn(OutBytes, PinNames);
+    AppendColumn(OutBytes, PinCategories);
+    AppendColumn(OutBytes, PinSubCategories);
+    AppendColumn(OutBytes, PinObjects);
+    AppendColumn(OutBytes, PinDefaults);
+    AppendColumn(OutBytes, PinFlags);
+
+    AppendColumn(OutBytes, EdgeFrom);
+    AppendColumn(OutBytes, EdgeTo);
+
+    return Stats;
+}
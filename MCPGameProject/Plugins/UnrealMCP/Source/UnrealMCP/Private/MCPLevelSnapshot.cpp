@@ -0,0 +1,216 @@
+#include "MCPLevelSnapshot.h"
+#include "MCPActorHandles.h"
+#include "Async/ParallelFor.h"
+#include "Components/ActorComponent.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Hash/CityHash.h"
+#include "UObject/UnrealType.h"
+
+namespace
+{
+    /** One object whose properties contribute to an actor's hash */
+    struct FHashSource
+    {
+        const UObject* Object;
+        const TArray<const FProperty*>* Properties;
+    };
+
+    /** Properties to hash per class, resolved once per capture */
+    class FPropertySelection
+    {
+    public:
+        explicit FPropertySelection(const TArray<FName>& InNames)
+            : Names(InNames)
+        {
+        }
+
+        const TArray<const FProperty*>& Get(const UClass* Class)
+        {
+            if (const TArray<const FProperty*>* Cached = Cache.Find(Class))
+            {
+                return *Cached;
+            }
+
+            TArray<const FProperty*>& Properties = Cache.Add(Class);
+            if (Names.Num() > 0)
+            {
+                for (const FName& Name : Names)
+                {
+                    if (const FProperty* Property = FindFProperty<FProperty>(Class, Name))
+                    {
+                        Properties.Add(Property);
+                    }
+                }
+            }
+            else
+            {
+                for (TFieldIterator<FProperty> It(Class); It; ++It)
+                {
+                    if (It->HasAnyPropertyFlags(CPF_Edit) && !It->HasAnyPropertyFlags(CPF_Transient | CPF_Deprecated))
+                    {
+                        Properties.Add(*It);
+                    }
+                }
+            }
+            return Properties;
+        }
+
+    private:
+        const TArray<FName>& Names;
+        TMap<const UClass*, TArray<const FProperty*>> Cache;
+    };
+
+    uint64 HashProperties(const FHashSource& Source, uint64 Hash)
+    {
+        FString Text;
+        for (const FProperty* Property : *Source.Properties)
+        {
+            const void* Value = Property->ContainerPtrToValuePtr<void>(Source.Object);
+            if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+            {
+                // Bitfield bools share their byte with neighbours; hash only this bit
+                const uint8 Bit = BoolProperty->GetPropertyValue(Value) ? 1 : 0;
+                Hash = CityHash64WithSeed(reinterpret_cast<const char*>(&Bit), sizeof(Bit), Hash);
+            }
+            else if (Property->HasAnyPropertyFlags(CPF_IsPlainOldData))
+            {
+                Hash = CityHash64WithSeed(static_cast<const char*>(Value), Property->GetSize(), Hash);
+            }
+            else
+            {
+                Text.Reset();
+                Property->ExportTextItem_Direct(Text, Value, nullptr, const_cast<UObject*>(Source.Object), PPF_None);
+                Hash = CityHash64WithSeed(reinterpret_cast<const char*>(*Text), Text.Len() * sizeof(TCHAR), Hash);
+            }
+        }
+        return Hash;
+    }
+
+    bool TransformDiffers(const FMCPActorSnapshot& A, const FMCPActorSnapshot& B, float Tolerance)
+    {
+        return !A.Location.Equals(B.Location, Tolerance)
+            || !A.Rotation.Equals(B.Rotation, Tolerance)
+            || !A.Scale.Equals(B.Scale, Tolerance);
+    }
+}
+
+TSharedRef<FMCPLevelSnapshot> FMCPLevelSnapshot::Capture(UWorld* World, const TArray<FName>& PropertyNames, bool bIncludeComponents)
+{
+    check(IsInGameThread());
+    const double StartTime = FPlatformTime::Seconds();
+
+    TSharedRef<FMCPLevelSnapshot> Snapshot = MakeShared<FMCPLevelSnapshot>();
+    Snapshot->PropertyNames = PropertyNames;
+    Snapshot->bIncludeComponents = bIncludeComponents && PropertyNames.Num() == 0;
+    Snapshot->CaptureTime = FDateTime::UtcNow();
+
+    // Game thread: identity, transform and what to hash for each actor
+    TArray<FHashSource> Sources;
+    TArray<int32> FirstSource;
+    FPropertySelection Selection(PropertyNames);
+    if (World)
+    {
+        TInlineComponentArray<UActorComponent*> Components;
+        for (TActorIterator<AActor> It(World); It; ++It)
+        {
+            AActor* Actor = *It;
+            if (!IsValid(Actor))
+            {
+                continue;
+            }
+
+            FMCPActorSnapshot& Entry = Snapshot->Entries.AddDefaulted_GetRef();
+            Entry.Handle = FMCPActorHandles::GetHandle(Actor);
+            Entry.Name = Actor->GetFName();
+            Entry.Class = Actor->GetClass()->GetFName();
+            const FTransform Transform = Actor->GetActorTransform();
+            Entry.Location = FVector3f(Transform.GetLocation());
+            Entry.Rotation = FRotator3f(Transform.Rotator());
+            Entry.Scale = FVector3f(Transform.GetScale3D());
+
+            FirstSource.Add(Sources.Num());
+            Sources.Add({Actor, &Selection.Get(Actor->GetClass())});
+            if (Snapshot->bIncludeComponents)
+            {
+                Actor->GetComponents(Components);
+                for (const UActorComponent* Component : Components)
+                {
+                    if (IsValid(Component))
+                    {
+                        Sources.Add({Component, &Selection.Get(Component->GetClass())});
+                    }
+                }
+            }
+        }
+    }
+    FirstSource.Add(Sources.Num());
+    Snapshot->CaptureSeconds = FPlatformTime::Seconds() - StartTime;
+
+    // Workers: property hashes
+    const double HashStartTime = FPlatformTime::Seconds();
+    TArray<FMCPActorSnapshot>& Entries = Snapshot->Entries;
+    ParallelFor(Entries.Num(), [&Entries, &Sources, &FirstSource](int32 Index)
+    {
+        uint64 Hash = 0;
+        for (int32 SourceIndex = FirstSource[Index]; SourceIndex < FirstSource[Index + 1]; ++SourceIndex)
+        {
+            Hash = HashProperties(Sources[SourceIndex], Hash);
+        }
+        Entries[Index].PropertyHash = Hash;
+    });
+    Snapshot->HashSeconds = FPlatformTime::Seconds() - HashStartTime;
+
+    Entries.Sort([](const FMCPActorSnapshot& A, const FMCPActorSnapshot& B) { return A.Handle < B.Handle; });
+    Entries.Shrink();
+    return Snapshot;
+}
+
+FMCPLevelSnapshotDiff FMCPLevelSnapshot::Diff(const FMCPLevelSnapshot& From, const FMCPLevelSnapshot& To, float TransformTolerance)
+{
+    FMCPLevelSnapshotDiff Result;
+    const TArray<FMCPActorSnapshot>& FromEntries = From.Entries;
+    const TArray<FMCPActorSnapshot>& ToEntries = To.Entries;
+
+    // Both sides are sorted by handle, so one merge pass pairs them up
+    int32 FromIndex = 0;
+    int32 ToIndex = 0;
+    while (FromIndex < FromEntries.Num() || ToIndex < ToEntries.Num())
+    {
+        if (ToIndex >= ToEntries.Num() || (FromIndex < FromEntries.Num() && FromEntries[FromIndex].Handle < ToEntries[ToIndex].Handle))
+        {
+            Result.Removed.Add(FromIndex++);
+            continue;
+        }
+        if (FromIndex >= FromEntries.Num() || ToEntries[ToIndex].Handle < FromEntries[FromIndex].Handle)
+        {
+            Result.Added.Add(ToIndex++);
+            continue;
+        }
+
+        const FMCPActorSnapshot& Before = FromEntries[FromIndex];
+        const FMCPActorSnapshot& After = ToEntries[ToIndex];
+        FMCPLevelSnapshotDiff::FChange Change;
+        Change.FromIndex = FromIndex++;
+        Change.ToIndex = ToIndex++;
+        Change.bTransform = TransformDiffers(Before, After, TransformTolerance);
+        Change.bProperties = Before.PropertyHash != After.PropertyHash;
+        Change.bRenamed = Before.Name != After.Name;
+        if (Change.bTransform || Change.bProperties || Change.bRenamed)
+        {
+            Result.Changed.Add(Change);
+        }
+    }
+    return Result;
+}
+
+bool FMCPLevelSnapshot::HasSamePropertySelection(const FMCPLevelSnapshot& Other) const
+{
+    return PropertyNames == Other.PropertyNames && bIncludeComponents == Other.bIncludeComponents;
+}
+
+SIZE_T FMCPLevelSnapshot::GetAllocatedSize() const
+{
+    return sizeof(*this) + Entries.GetAllocatedSize() + PropertyNames.GetAllocatedSize();
+}
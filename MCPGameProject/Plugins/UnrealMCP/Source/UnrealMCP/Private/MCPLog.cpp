@@ -0,0 +1,87 @@
+#include "MCPLog.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+
+DEFINE_LOG_CATEGORY(LogUnrealMCP);
+
+namespace
+{
+    TAutoConsoleVariable<int32> CVarPreviewChars(
+        TEXT("UnrealMCP.Log.PreviewChars"),
+        256,
+        TEXT("Longest request or response preview written to LogUnrealMCP, in characters."),
+        ECVF_Default);
+
+    TAutoConsoleVariable<int32> CVarMaxRequestsPerSecond(
+        TEXT("UnrealMCP.Log.MaxRequestsPerSecond"),
+        10,
+        TEXT("Per-request log lines written for each command type per second; the rest are counted and summarized. 0 logs every request."),
+        ECVF_Default);
+
+    struct FRequestSampler
+    {
+        double WindowStart = 0.0;
+        int32 Logged = 0;
+        int32 Suppressed = 0;
+    };
+
+    FCriticalSection SamplerLock;
+    TMap<FString, FRequestSampler> Samplers;
+
+    int32 GetPreviewChars()
+    {
+        return UE_LOG_ACTIVE(LogUnrealMCP, VeryVerbose) ? MAX_int32 : FMath::Max(CVarPreviewChars.GetValueOnAnyThread(), 0);
+    }
+
+    FString PreviewSuffix(int32 Remaining, const TCHAR* Unit)
+    {
+        return Remaining > 0 ? FString::Printf(TEXT("... [%d more %s]"), Remaining, Unit) : FString();
+    }
+}
+
+FString FMCPLog::Preview(const FString& Text)
+{
+    const int32 MaxChars = GetPreviewChars();
+    if (Text.Len() <= MaxChars)
+    {
+        return Text;
+    }
+    return Text.Left(MaxChars) + PreviewSuffix(Text.Len() - MaxChars, TEXT("chars"));
+}
+
+FString FMCPLog::Preview(const TArray<uint8>& Utf8)
+{
+    // Only the previewed bytes are converted; a multi-byte character may be cut at the end
+    const int32 MaxChars = GetPreviewChars();
+    const int32 Count = FMath::Min(Utf8.Num(), MaxChars);
+    FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Utf8.GetData()), Count);
+    return FString::ConstructFromPtrSize(Converted.Get(), Converted.Length()) + PreviewSuffix(Utf8.Num() - Count, TEXT("bytes"));
+}
+
+bool FMCPLog::ShouldLogRequest(const FString& CommandType, int32& OutSuppressed)
+{
+    OutSuppressed = 0;
+    const int32 MaxPerSecond = CVarMaxRequestsPerSecond.GetValueOnAnyThread();
+    if (MaxPerSecond <= 0)
+    {
+        return true;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    FScopeLock ScopeLock(&SamplerLock);
+    FRequestSampler& Sampler = Samplers.FindOrAdd(CommandType);
+    if (Now - Sampler.WindowStart >= 1.0)
+    {
+        Sampler.WindowStart = Now;
+        Sampler.Logged = 0;
+    }
+    if (Sampler.Logged >= MaxPerSecond)
+    {
+        ++Sampler.Suppressed;
+        return false;
+    }
+    ++Sampler.Logged;
+    OutSuppressed = Sampler.Suppressed;
+    Sampler.Suppressed = 0;
+    return true;
+}
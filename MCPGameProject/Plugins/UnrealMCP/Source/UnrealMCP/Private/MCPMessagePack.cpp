@@ -0,0 +1,786 @@
+#include "MCPMessagePack.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+    enum EMessagePackExt : int8
+    {
+        ExtFloatArray = 1,
+        ExtGuid = 2,
+        ExtRecords = 3
+    };
+
+    // Nesting limit for untrusted input
+    const int32 MaxReadDepth = 128;
+
+    void WriteBigEndian(TArray<uint8>& Out, uint64 Value, int32 Size)
+    {
+        for (int32 Shift = (Size - 1) * 8; Shift >= 0; Shift -= 8)
+        {
+            Out.Add((uint8)(Value >> Shift));
+        }
+    }
+
+    void WriteInteger(TArray<uint8>& Out, int64 Value)
+    {
+        if (Value >= 0)
+        {
+            if (Value < 128)
+            {
+                Out.Add((uint8)Value);
+            }
+            else if (Value <= MAX_uint8)
+            {
+                Out.Add(0xcc);
+                Out.Add((uint8)Value);
+            }
+            else if (Value <= MAX_uint16)
+            {
+                Out.Add(0xcd);
+                WriteBigEndian(Out, (uint64)Value, 2);
+            }
+            else if (Value <= MAX_uint32)
+            {
+                Out.Add(0xce);
+                WriteBigEndian(Out, (uint64)Value, 4);
+            }
+            else
+            {
+                Out.Add(0xcf);
+                WriteBigEndian(Out, (uint64)Value, 8);
+            }
+        }
+        else if (Value >= -32)
+        {
+            Out.Add((uint8)(int8)Value);
+        }
+        else if (Value >= MIN_int8)
+        {
+            Out.Add(0xd0);
+            Out.Add((uint8)(int8)Value);
+        }
+        else if (Value >= MIN_int16)
+        {
+            Out.Add(0xd1);
+            WriteBigEndian(Out, (uint16)(int16)Value, 2);
+        }
+        else if (Value >= MIN_int32)
+        {
+            Out.Add(0xd2);
+            WriteBigEndian(Out, (uint32)(int32)Value, 4);
+        }
+        else
+        {
+            Out.Add(0xd3);
+            WriteBigEndian(Out, (uint64)Value, 8);
+        }
+    }
+
+    bool IsIntegral(double Value)
+    {
+        // The bounds keep the cast to int64 defined; NaN fails every comparison
+        return Value >= -9223372036854775808.0 && Value < 9223372036854775808.0 && Value == FMath::TruncToDouble(Value);
+    }
+
+    void WriteNumber(TArray<uint8>& Out, double Value)
+    {
+        if (IsIntegral(Value))
+        {
+            WriteInteger(Out, (int64)Value);
+            return;
+        }
+        uint64 Bits;
+        FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+        Out.Add(0xcb);
+        WriteBigEndian(Out, Bits, 8);
+    }
+
+    void WriteString(TArray<uint8>& Out, const FString& Value)
+    {
+        const FTCHARToUTF8 Utf8(*Value);
+        const int32 Length = Utf8.Length();
+        if (Length < 32)
+        {
+            Out.Add((uint8)(0xa0 | Length));
+        }
+        else if (Length <= MAX_uint8)
+        {
+            Out.Add(0xd9);
+            Out.Add((uint8)Length);
+        }
+        else if (Length <= MAX_uint16)
+        {
+            Out.Add(0xda);
+            WriteBigEndian(Out, Length, 2);
+        }
+        else
+        {
+            Out.Add(0xdb);
+            WriteBigEndian(Out, Length, 4);
+        }
+        Out.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Length);
+    }
+
+    void WriteContainerHeader(TArray<uint8>& Out, uint32 Count, uint8 FixBase, uint8 Code16, uint8 Code32)
+    {
+        if (Count < 16)
+        {
+            Out.Add((uint8)(FixBase | Count));
+        }
+        else if (Count <= MAX_uint16)
+        {
+            Out.Add(Code16);
+            WriteBigEndian(Out, Count, 2);
+        }
+        else
+        {
+            Out.Add(Code32);
+            WriteBigEndian(Out, Count, 4);
+        }
+    }
+
+    void WriteExtHeader(TArray<uint8>& Out, int8 Type, uint32 Size)
+    {
+        if (Size <= MAX_uint8)
+        {
+            Out.Add(0xc7);
+            Out.Add((uint8)Size);
+        }
+        else if (Size <= MAX_uint16)
+        {
+            Out.Add(0xc8);
+            WriteBigEndian(Out, Size, 2);
+        }
+        else
+        {
+            Out.Add(0xc9);
+            WriteBigEndian(Out, Size, 4);
+        }
+        Out.Add((uint8)Type);
+    }
+
+    /** FGuid::ToString() in its default format */
+    bool IsGuidString(const FString& Value)
+    {
+        if (Value.Len() != 32)
+        {
+            return false;
+        }
+        for (const TCHAR Char : Value)
+        {
+            if (!FChar::IsDigit(Char) && !(Char >= TEXT('A') && Char <= TEXT('F')))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool IsFloatArray(const TArray<TSharedPtr<FJsonValue>>& Values)
+    {
+        if (Values.Num() < 2)
+        {
+            return false;
+        }
+        bool bHasFraction = false;
+        for (const TSharedPtr<FJsonValue>& Value : Values)
+        {
+            if (!Value.IsValid() || Value->Type != EJson::Number)
+            {
+                return false;
+            }
+            bHasFraction = bHasFraction || !IsIntegral(Value->AsNumber());
+        }
+        // All-integer arrays (indices, counts) stay integers for the reader
+        return bHasFraction;
+    }
+
+    bool IsRecordArray(const TArray<TSharedPtr<FJsonValue>>& Values)
+    {
+        if (Values.Num() < 2)
+        {
+            return false;
+        }
+        for (const TSharedPtr<FJsonValue>& Value : Values)
+        {
+            if (!Value.IsValid() || Value->Type != EJson::Object || !Value->AsObject().IsValid())
+            {
+                return false;
+            }
+        }
+
+        const TMap<FString, TSharedPtr<FJsonValue>>& First = Values[0]->AsObject()->Values;
+        if (First.Num() == 0)
+        {
+            return false;
+        }
+        for (int32 Index = 1; Index < Values.Num(); ++Index)
+        {
+            const TMap<FString, TSharedPtr<FJsonValue>>& Other = Values[Index]->AsObject()->Values;
+            if (Other.Num() != First.Num())
+            {
+                return false;
+            }
+            auto FirstIt = First.CreateConstIterator();
+            for (auto OtherIt = Other.CreateConstIterator(); OtherIt; ++OtherIt, ++FirstIt)
+            {
+                if (!OtherIt.Key().Equals(FirstIt.Key(), ESearchCase::CaseSensitive))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    void WriteValue(TArray<uint8>& Out, const TSharedPtr<FJsonValue>& Value);
+
+    void WriteObject(TArray<uint8>& Out, const TSharedPtr<FJsonObject>& Object, bool bFixedWidth)
+    {
+        if (!Object.IsValid())
+        {
+            Out.Add(0xc0);
+            return;
+        }
+        if (bFixedWidth)
+        {
+            Out.Add(0xdf);
+            WriteBigEndian(Out, Object->Values.Num(), 4);
+        }
+        else
+        {
+            WriteContainerHeader(Out, Object->Values.Num(), 0x80, 0xde, 0xdf);
+        }
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Object->Values)
+        {
+            WriteString(Out, Pair.Key);
+            WriteValue(Out, Pair.Value);
+        }
+    }
+
+    void WriteArray(TArray<uint8>& Out, const TArray<TSharedPtr<FJsonValue>>& Values)
+    {
+        if (IsFloatArray(Values))
+        {
+            WriteExtHeader(Out, ExtFloatArray, (uint32)Values.Num() * 8);
+            for (const TSharedPtr<FJsonValue>& Value : Values)
+            {
+                const double Number = Value->AsNumber();
+                uint64 Bits;
+                FMemory::Memcpy(&Bits, &Number, sizeof(Bits));
+                for (int32 Shift = 0; Shift < 64; Shift += 8)
+                {
+                    Out.Add((uint8)(Bits >> Shift));
+                }
+            }
+            return;
+        }
+
+        if (IsRecordArray(Values))
+        {
+            // Size is patched in once the records are written
+            Out.Add(0xc9);
+            const int32 SizeOffset = Out.AddZeroed(4);
+            Out.Add((uint8)ExtRecords);
+            const int32 DataStart = Out.Num();
+
+            const TMap<FString, TSharedPtr<FJsonValue>>& Keys = Values[0]->AsObject()->Values;
+            WriteContainerHeader(Out, Values.Num() + 1, 0x90, 0xdc, 0xdd);
+            WriteContainerHeader(Out, Keys.Num(), 0x90, 0xdc, 0xdd);
+            for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Keys)
+            {
+                WriteString(Out, Pair.Key);
+            }
+            for (const TSharedPtr<FJsonValue>& Value : Values)
+            {
+                WriteContainerHeader(Out, Keys.Num(), 0x90, 0xdc, 0xdd);
+                for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Value->AsObject()->Values)
+                {
+                    WriteValue(Out, Pair.Value);
+                }
+            }
+
+            const uint32 Size = Out.Num() - DataStart;
+            for (int32 Index = 0; Index < 4; ++Index)
+            {
+                Out[SizeOffset + Index] = (uint8)(Size >> ((3 - Index) * 8));
+            }
+            return;
+        }
+
+        WriteContainerHeader(Out, Values.Num(), 0x90, 0xdc, 0xdd);
+        for (const TSharedPtr<FJsonValue>& Value : Values)
+        {
+            WriteValue(Out, Value);
+        }
+    }
+
+    void WriteValue(TArray<uint8>& Out, const TSharedPtr<FJsonValue>& Value)
+    {
+        if (!Value.IsValid())
+        {
+            Out.Add(0xc0);
+            return;
+        }
+
+        switch (Value->Type)
+        {
+        case EJson::Boolean:
+            Out.Add(Value->AsBool() ? 0xc3 : 0xc2);
+            break;
+        case EJson::Number:
+            WriteNumber(Out, Value->AsNumber());
+            break;
+        case EJson::String:
+        {
+            const FString String = Value->AsString();
+            if (IsGuidString(String))
+            {
+                uint8 Bytes[16];
+                HexToBytes(String, Bytes);
+                Out.Add(0xd8);
+                Out.Add((uint8)ExtGuid);
+                Out.Append(Bytes, 16);
+            }
+            else
+            {
+                WriteString(Out, String);
+            }
+            break;
+        }
+        case EJson::Array:
+            WriteArray(Out, Value->AsArray());
+            break;
+        case EJson::Object:
+            WriteObject(Out, Value->AsObject(), false);
+            break;
+        default:
+            Out.Add(0xc0);
+            break;
+        }
+    }
+
+    class FReader
+    {
+    public:
+        FReader(const uint8* InData, int32 InNum)
+            : Data(InData)
+            , Num(InNum)
+            , Pos(0)
+        {
+        }
+
+        bool ReadValue(TSharedPtr<FJsonValue>& OutValue, int32 Depth)
+        {
+            if (Depth > MaxReadDepth)
+            {
+                return Fail(TEXT("MessagePack data is nested too deeply"));
+            }
+            if (!Need(1))
+            {
+                return false;
+            }
+
+            const uint8 Code = Data[Pos++];
+            if (Code <= 0x7f)
+            {
+                OutValue = MakeShared<FJsonValueNumber>(Code);
+                return true;
+            }
+            if (Code >= 0xe0)
+            {
+                OutValue = MakeShared<FJsonValueNumber>((int8)Code);
+                return true;
+            }
+            if (Code >= 0x80 && Code <= 0x8f)
+            {
+                return ReadMap(Code & 0x0f, OutValue, Depth);
+            }
+            if (Code >= 0x90 && Code <= 0x9f)
+            {
+                return ReadArray(Code & 0x0f, OutValue, Depth);
+            }
+            if (Code >= 0xa0 && Code <= 0xbf)
+            {
+                return ReadString(Code & 0x1f, OutValue);
+            }
+
+            uint64 Length = 0;
+            switch (Code)
+            {
+            case 0xc0:
+                OutValue = MakeShared<FJsonValueNull>();
+                return true;
+            case 0xc2:
+            case 0xc3:
+                OutValue = MakeShared<FJsonValueBoolean>(Code == 0xc3);
+                return true;
+            case 0xc4:
+            case 0xc5:
+            case 0xc6:
+                return Fail(TEXT("MessagePack bin values are not supported; send bytes as the frame payload"));
+            case 0xc7:
+            case 0xc8:
+            case 0xc9:
+                return ReadBigEndian(1 << (Code - 0xc7), Length) && ReadExt((uint32)Length, OutValue, Depth);
+            case 0xca:
+            {
+                uint64 Bits;
+                if (!ReadBigEndian(4, Bits))
+                {
+                    return false;
+                }
+                float Number;
+                const uint32 Bits32 = (uint32)Bits;
+                FMemory::Memcpy(&Number, &Bits32, sizeof(Number));
+                OutValue = MakeShared<FJsonValueNumber>(Number);
+                return true;
+            }
+            case 0xcb:
+            {
+                uint64 Bits;
+                if (!ReadBigEndian(8, Bits))
+                {
+                    return false;
+                }
+                double Number;
+                FMemory::Memcpy(&Number, &Bits, sizeof(Number));
+                OutValue = MakeShared<FJsonValueNumber>(Number);
+                return true;
+            }
+            case 0xcc:
+            case 0xcd:
+            case 0xce:
+            case 0xcf:
+            {
+                uint64 Number;
+                if (!ReadBigEndian(1 << (Code - 0xcc), Number))
+                {
+                    return false;
+                }
+                OutValue = MakeShared<FJsonValueNumber>((double)Number);
+                return true;
+            }
+            case 0xd0:
+            case 0xd1:
+            case 0xd2:
+            case 0xd3:
+            {
+                const int32 Size = 1 << (Code - 0xd0);
+                uint64 Bits;
+                if (!ReadBigEndian(Size, Bits))
+                {
+                    return false;
+                }
+                // Sign-extend from the encoded width
+                const int64 Number = Size == 8 ? (int64)Bits : (int64)(Bits << (64 - Size * 8)) >> (64 - Size * 8);
+                OutValue = MakeShared<FJsonValueNumber>((double)Number);
+                return true;
+            }
+            case 0xd4:
+            case 0xd5:
+            case 0xd6:
+            case 0xd7:
+            case 0xd8:
+                return ReadExt(1u << (Code - 0xd4), OutValue, Depth);
+            case 0xd9:
+            case 0xda:
+            case 0xdb:
+                return ReadBigEndian(1 << (Code - 0xd9), Length) && ReadString(Length, OutValue);
+            case 0xdc:
+            case 0xdd:
+                return ReadBigEndian(Code == 0xdc ? 2 : 4, Length) && ReadArray(Length, OutValue, Depth);
+            case 0xde:
+            case 0xdf:
+                return ReadBigEndian(Code == 0xde ? 2 : 4, Length) && ReadMap(Length, OutValue, Depth);
+            default:
+                return Fail(FString::Printf(TEXT("Invalid MessagePack type byte 0x%02X"), Code));
+            }
+        }
+
+        bool IsAtEnd() const
+        {
+            return Pos == Num;
+        }
+
+        FString Error;
+
+    private:
+        bool Fail(const FString& Message)
+        {
+            Error = Message;
+            return false;
+        }
+
+        bool Need(uint64 Count)
+        {
+            if ((uint64)(Num - Pos) < Count)
+            {
+                return Fail(TEXT("MessagePack data is truncated"));
+            }
+            return true;
+        }
+
+        bool ReadBigEndian(int32 Size, uint64& OutValue)
+        {
+            if (!Need(Size))
+            {
+                return false;
+            }
+            OutValue = 0;
+            for (int32 Index = 0; Index < Size; ++Index)
+            {
+                OutValue = (OutValue << 8) | Data[Pos++];
+            }
+            return true;
+        }
+
+        bool ReadString(uint64 Length, TSharedPtr<FJsonValue>& OutValue)
+        {
+            FString String;
+            if (!ReadRawString(Length, String))
+            {
+                return false;
+            }
+            OutValue = MakeShared<FJsonValueString>(MoveTemp(String));
+            return true;
+        }
+
+        bool ReadRawString(uint64 Length, FString& OutString)
+        {
+            if (!Need(Length))
+            {
+                return false;
+            }
+            OutString = FString(FUTF8ToTCHAR(reinterpret_cast<const ANSICHAR*>(Data + Pos), (int32)Length));
+            Pos += (int32)Length;
+            return true;
+        }
+
+        bool ReadKey(FString& OutKey)
+        {
+            TSharedPtr<FJsonValue> Key;
+            if (!Need(1))
+            {
+                return false;
+            }
+            const uint8 Code = Data[Pos];
+            if (!((Code >= 0xa0 && Code <= 0xbf) || (Code >= 0xd9 && Code <= 0xdb)))
+            {
+                return Fail(TEXT("MessagePack map keys must be strings"));
+            }
+            if (!ReadValue(Key, 0))
+            {
+                return false;
+            }
+            OutKey = Key->AsString();
+            return true;
+        }
+
+        bool ReadArray(uint64 Count, TSharedPtr<FJsonValue>& OutValue, int32 Depth)
+        {
+            // Every element takes at least one byte; do not trust the count further
+            if (!Need(Count))
+            {
+                return false;
+            }
+            TArray<TSharedPtr<FJsonValue>> Values;
+            Values.Reserve((int32)Count);
+            for (uint64 Index = 0; Index < Count; ++Index)
+            {
+                TSharedPtr<FJsonValue> Value;
+                if (!ReadValue(Value, Depth + 1))
+                {
+                    return false;
+                }
+                Values.Add(MoveTemp(Value));
+            }
+            OutValue = MakeShared<FJsonValueArray>(MoveTemp(Values));
+            return true;
+        }
+
+        bool ReadMap(uint64 Count, TSharedPtr<FJsonValue>& OutValue, int32 Depth)
+        {
+            if (!Need(Count * 2))
+            {
+                return false;
+            }
+            TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+            for (uint64 Index = 0; Index < Count; ++Index)
+            {
+                FString Key;
+                TSharedPtr<FJsonValue> Value;
+                if (!ReadKey(Key) || !ReadValue(Value, Depth + 1))
+                {
+                    return false;
+                }
+                Object->SetField(Key, Value);
+            }
+            OutValue = MakeShared<FJsonValueObject>(Object);
+            return true;
+        }
+
+        bool ReadExt(uint32 Size, TSharedPtr<FJsonValue>& OutValue, int32 Depth)
+        {
+            if (!Need((uint64)Size + 1))
+            {
+                return false;
+            }
+            const int8 Type = (int8)Data[Pos++];
+            const int32 End = Pos + (int32)Size;
+
+            if (Type == ExtFloatArray)
+            {
+                if (Size % 8 != 0)
+                {
+                    return Fail(TEXT("MessagePack float array has a partial element"));
+                }
+                TArray<TSharedPtr<FJsonValue>> Values;
+                Values.Reserve((int32)(Size / 8));
+                for (; Pos < End; Pos += 8)
+                {
+                    uint64 Bits = 0;
+                    for (int32 Index = 7; Index >= 0; --Index)
+                    {
+                        Bits = (Bits << 8) | Data[Pos + Index];
+                    }
+                    double Number;
+                    FMemory::Memcpy(&Number, &Bits, sizeof(Number));
+                    Values.Add(MakeShared<FJsonValueNumber>(Number));
+                }
+                OutValue = MakeShared<FJsonValueArray>(MoveTemp(Values));
+                return true;
+            }
+
+            if (Type == ExtGuid)
+            {
+                if (Size != 16)
+                {
+                    return Fail(TEXT("MessagePack guid must be 16 bytes"));
+                }
+                OutValue = MakeShared<FJsonValueString>(BytesToHex(Data + Pos, 16));
+                Pos = End;
+                return true;
+            }
+
+            if (Type == ExtRecords)
+            {
+                if (!ReadRecords(OutValue, Depth))
+                {
+                    return false;
+                }
+                if (Pos != End)
+                {
+                    return Fail(TEXT("MessagePack records do not match their extension size"));
+                }
+                return true;
+            }
+
+            return Fail(FString::Printf(TEXT("Unknown MessagePack extension type %d"), Type));
+        }
+
+        bool ReadRecords(TSharedPtr<FJsonValue>& OutValue, int32 Depth)
+        {
+            TSharedPtr<FJsonValue> Table;
+            if (!ReadValue(Table, Depth + 1))
+            {
+                return false;
+            }
+            const TArray<TSharedPtr<FJsonValue>>* Rows = nullptr;
+            const TArray<TSharedPtr<FJsonValue>>* Keys = nullptr;
+            if (!Table->TryGetArray(Rows) || Rows->Num() == 0 || !(*Rows)[0]->TryGetArray(Keys))
+            {
+                return Fail(TEXT("MessagePack records must start with an array of keys"));
+            }
+
+            TArray<TSharedPtr<FJsonValue>> Records;
+            Records.Reserve(Rows->Num() - 1);
+            for (int32 RowIndex = 1; RowIndex < Rows->Num(); ++RowIndex)
+            {
+                const TArray<TSharedPtr<FJsonValue>>* Row = nullptr;
+                if (!(*Rows)[RowIndex]->TryGetArray(Row) || Row->Num() != Keys->Num())
+                {
+                    return Fail(TEXT("MessagePack record does not match its keys"));
+                }
+                TSharedPtr<FJsonObject> Record = MakeShared<FJsonObject>();
+                for (int32 Index = 0; Index < Keys->Num(); ++Index)
+                {
+                    FString Key;
+                    if (!(*Keys)[Index]->TryGetString(Key))
+                    {
+                        return Fail(TEXT("MessagePack record keys must be strings"));
+                    }
+                    Record->SetField(Key, (*Row)[Index]);
+                }
+                Records.Add(MakeShared<FJsonValueObject>(Record));
+            }
+            OutValue = MakeShared<FJsonValueArray>(MoveTemp(Records));
+            return true;
+        }
+
+        const uint8* Data;
+        int32 Num;
+        int32 Pos;
+    };
+}
+
+void FMCPMessagePack::Write(const TSharedPtr<FJsonObject>& Object, TArray<uint8>& OutBytes)
+{
+    WriteObject(OutBytes, Object.IsValid() ? Object : MakeShared<FJsonObject>(), true);
+}
+
+bool FMCPMessagePack::AppendField(TArray<uint8>& Bytes, const FString& Name, const TSharedPtr<FJsonValue>& Value)
+{
+    if (Bytes.Num() < 5 || Bytes[0] != 0xdf)
+    {
+        return false;
+    }
+
+    const uint32 Count = ((uint32)Bytes[1] << 24 | (uint32)Bytes[2] << 16 | (uint32)Bytes[3] << 8 | (uint32)Bytes[4]) + 1;
+    for (int32 Index = 0; Index < 4; ++Index)
+    {
+        Bytes[1 + Index] = (uint8)(Count >> ((3 - Index) * 8));
+    }
+    WriteString(Bytes, Name);
+    WriteValue(Bytes, Value);
+    return true;
+}
+
+bool FMCPMessagePack::Read(const uint8* Data, int32 Num, TSharedPtr<FJsonObject>& OutObject, FString& OutError)
+{
+    FReader Reader(Data, Num);
+    TSharedPtr<FJsonValue> Value;
+    if (!Reader.ReadValue(Value, 0))
+    {
+        OutError = Reader.Error;
+        return false;
+    }
+    if (!Reader.IsAtEnd())
+    {
+        OutError = TEXT("Unexpected bytes after the MessagePack value");
+        return false;
+    }
+    if (Value->Type != EJson::Object)
+    {
+        OutError = TEXT("MessagePack message is not a map");
+        return false;
+    }
+    OutObject = Value->AsObject();
+    return true;
+}
+
+FString FMCPMessagePack::ToJsonString(const TArray<uint8>& Bytes)
+{
+    TSharedPtr<FJsonObject> Object;
+    FString Error;
+    if (!Read(Bytes.GetData(), Bytes.Num(), Object, Error))
+    {
+        return FString::Printf(TEXT("<%d bytes of invalid MessagePack: %s>"), Bytes.Num(), *Error);
+    }
+
+    FString Json;
+    TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json);
+    FJsonSerializer::Serialize(Object.ToSharedRef(), Writer);
+    return Json;
+}
@@ -0,0 +1,42 @@
+#include "MCPRequestContext.h"
+#include <atomic>
+
+namespace
+{
+    FMCPRequestContext* CurrentRequestContext = nullptr;
+    std::atomic<uint64> NextRequestId{1};
+}
+
+uint64 FMCPRequestContext::AllocateRequestId()
+{
+    return NextRequestId.fetch_add(1, std::memory_order_relaxed);
+}
+
+const FMCPRequestContext* FMCPRequestContext::Get()
+{
+    check(IsInGameThread());
+    return CurrentRequestContext;
+}
+
+bool FMCPRequestContext::SetResponseAttachment(TArray<uint8>&& Attachment)
+{
+    check(IsInGameThread());
+    if (!CurrentRequestContext)
+    {
+        return false;
+    }
+    CurrentRequestContext->ResponseAttachment = MoveTemp(Attachment);
+    return true;
+}
+
+FMCPRequestContext::FScope::FScope(FMCPRequestContext& Context)
+    : Previous(CurrentRequestContext)
+{
+    check(IsInGameThread());
+    CurrentRequestContext = &Context;
+}
+
+FMCPRequestContext::FScope::~FScope()
+{
+    CurrentRequestContext = Previous;
+}
@@ -0,0 +1,197 @@
+#include "MCPRequestJournal.h"
+#include "MCPLog.h"
+#include "Dom/JsonObject.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/Event.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+    TAutoConsoleVariable<int32> CVarJournalMaxPendingMB(
+        TEXT("UnrealMCP.Journal.MaxPendingMB"),
+        64,
+        TEXT("Journal records waiting to be written beyond this many megabytes are dropped."),
+        ECVF_Default);
+
+    void WriteLE(uint8* Dest, const void* Value, int32 Size)
+    {
+        // Every supported platform is little endian
+        FMemory::Memcpy(Dest, Value, Size);
+    }
+}
+
+TSharedPtr<FMCPRequestJournal, ESPMode::ThreadSafe> FMCPRequestJournal::Open(const FString& Path, FString& OutError)
+{
+    const FString FullPath = FPaths::ConvertRelativePathToFull(Path);
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(FullPath), true);
+    IFileHandle* File = FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*FullPath);
+    if (!File)
+    {
+        OutError = FString::Printf(TEXT("Could not open journal file %s"), *FullPath);
+        return nullptr;
+    }
+
+    uint8 Header[MCP_JOURNAL_FILE_HEADER_SIZE] = { 'M', 'C', 'P', 'J' };
+    const uint32 Version = MCP_JOURNAL_VERSION;
+    WriteLE(Header + 4, &Version, 4);
+    if (!File->Write(Header, sizeof(Header)))
+    {
+        delete File;
+        OutError = FString::Printf(TEXT("Could not write to journal file %s"), *FullPath);
+        return nullptr;
+    }
+
+    TSharedPtr<FMCPRequestJournal, ESPMode::ThreadSafe> Journal(new FMCPRequestJournal(FullPath, File));
+    Journal->Thread = FRunnableThread::Create(Journal.Get(), TEXT("MCPRequestJournal"), 0, TPri_BelowNormal);
+    if (!Journal->Thread)
+    {
+        OutError = TEXT("Could not start the journal writer thread");
+        return nullptr;
+    }
+    UE_LOG(LogUnrealMCP, Display, TEXT("MCPRequestJournal: Recording to %s"), *FullPath);
+    return Journal;
+}
+
+FMCPRequestJournal::FMCPRequestJournal(const FString& InPath, IFileHandle* InFile)
+    : Path(InPath)
+    , File(InFile)
+    , Thread(nullptr)
+    , WakeEvent(FPlatformProcess::GetSynchEventFromPool(false))
+    , OpenTime(FPlatformTime::Seconds())
+    , PendingBytes(0)
+    , RecordsWritten(0)
+    , RecordsDropped(0)
+    , BytesWritten(MCP_JOURNAL_FILE_HEADER_SIZE)
+    , bRunning(true)
+    , bAccepting(true)
+{
+}
+
+FMCPRequestJournal::~FMCPRequestJournal()
+{
+    Close();
+    FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+    WakeEvent = nullptr;
+}
+
+void FMCPRequestJournal::Record(EMCPJournalRecordKind Kind, uint32 ConnectionId, uint64 RequestId, double Time,
+    const uint8* Json, int32 JsonSize, const uint8* Attachment, int32 AttachmentSize, uint8 Encoding,
+    float QueueMs, float ExecuteMs)
+{
+    if (!bAccepting)
+    {
+        return;
+    }
+    const int64 RecordSize = MCP_JOURNAL_RECORD_HEADER_SIZE + (int64)JsonSize + AttachmentSize;
+    if (PendingBytes.load(std::memory_order_relaxed) + RecordSize > (int64)CVarJournalMaxPendingMB.GetValueOnAnyThread() * 1024 * 1024)
+    {
+        ++RecordsDropped;
+        return;
+    }
+
+    TArray<uint8> Bytes;
+    Bytes.SetNumUninitialized((int32)RecordSize);
+    uint8* Data = Bytes.GetData();
+    const uint16 Reserved = 0;
+    const double Elapsed = Time - OpenTime;
+    const uint32 JsonLength = (uint32)JsonSize;
+    const uint32 AttachmentLength = (uint32)AttachmentSize;
+    Data[0] = (uint8)Kind;
+    Data[1] = Encoding;
+    WriteLE(Data + 2, &Reserved, 2);
+    WriteLE(Data + 4, &ConnectionId, 4);
+    WriteLE(Data + 8, &RequestId, 8);
+    WriteLE(Data + 16, &Elapsed, 8);
+    WriteLE(Data + 24, &JsonLength, 4);
+    WriteLE(Data + 28, &AttachmentLength, 4);
+    WriteLE(Data + 32, &QueueMs, 4);
+    WriteLE(Data + 36, &ExecuteMs, 4);
+    if (JsonSize > 0)
+    {
+        FMemory::Memcpy(Data + MCP_JOURNAL_RECORD_HEADER_SIZE, Json, JsonSize);
+    }
+    if (AttachmentSize > 0)
+    {
+        FMemory::Memcpy(Data + MCP_JOURNAL_RECORD_HEADER_SIZE + JsonSize, Attachment, AttachmentSize);
+    }
+
+    PendingBytes += RecordSize;
+    Queue.Enqueue(MoveTemp(Bytes));
+    WakeEvent->Trigger();
+}
+
+uint32 FMCPRequestJournal::Run()
+{
+    while (bRunning)
+    {
+        WakeEvent->Wait(FTimespan::FromMilliseconds(100));
+        WriteQueued();
+    }
+    WriteQueued();
+    return 0;
+}
+
+void FMCPRequestJournal::WriteQueued()
+{
+    TArray<uint8> Bytes;
+    bool bWrote = false;
+    while (Queue.Dequeue(Bytes))
+    {
+        PendingBytes -= Bytes.Num();
+        if (File && File->Write(Bytes.GetData(), Bytes.Num()))
+        {
+            ++RecordsWritten;
+            BytesWritten += Bytes.Num();
+            bWrote = true;
+        }
+        else
+        {
+            ++RecordsDropped;
+        }
+    }
+    if (bWrote)
+    {
+        File->Flush();
+    }
+}
+
+void FMCPRequestJournal::Stop()
+{
+    bRunning = false;
+    WakeEvent->Trigger();
+}
+
+void FMCPRequestJournal::Close()
+{
+    if (!bAccepting.exchange(false))
+    {
+        return;
+    }
+    if (Thread)
+    {
+        Stop();
+        Thread->WaitForCompletion();
+        delete Thread;
+        Thread = nullptr;
+    }
+    WriteQueued();
+    delete File;
+    File = nullptr;
+    UE_LOG(LogUnrealMCP, Display, TEXT("MCPRequestJournal: Closed %s (%lld records, %lld dropped)"),
+        *Path, RecordsWritten.load(), RecordsDropped.load());
+}
+
+TSharedPtr<FJsonObject> FMCPRequestJournal::ToJson() const
+{
+    TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+    Json->SetStringField(TEXT("path"), Path);
+    Json->SetNumberField(TEXT("records_written"), (double)RecordsWritten.load());
+    Json->SetNumberField(TEXT("records_dropped"), (double)RecordsDropped.load());
+    Json->SetNumberField(TEXT("bytes_written"), (double)BytesWritten.load());
+    return Json;
+}
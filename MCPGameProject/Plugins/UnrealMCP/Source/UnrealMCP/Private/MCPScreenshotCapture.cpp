@@ -0,0 +1,375 @@
+#include "MCPScreenshotCapture.h"
+#include "UnrealClient.h"
+#include "RHI.h"
+#include "RHIGPUReadback.h"
+#include "RenderingThread.h"
+#include "Containers/Ticker.h"
+#include "Async/Async.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "ImageUtils.h"
+#include "Misc/FileHelper.h"
+#include "Modules/ModuleManager.h"
+#include "HAL/PlatformTime.h"
+#include <atomic>
+
+namespace
+{
+    // Give up on a readback that has not completed after this long
+    const double ReadbackTimeoutSeconds = 5.0;
+
+    enum class EReadbackStage : int32
+    {
+        Pending,
+        Copying,
+        Failed
+    };
+
+    /**
+     * State shared between the game thread ticker, the render thread and the worker
+     * that encodes the image
+     */
+    struct FPendingScreenshot
+    {
+        TUniquePtr<FRHIGPUTextureReadback> Readback;
+        TPromise<FMCPRawCapture> Promise;
+        FMCPScreenshotRequest Request;
+        FIntPoint Size = FIntPoint::ZeroValue;
+        EPixelFormat PixelFormat = PF_Unknown;
+        std::atomic<int32> Stage { (int32)EReadbackStage::Pending };
+        double StartTime = 0.0;
+    };
+
+    IImageWrapperModule& LoadImageWrapperModule()
+    {
+        check(IsInGameThread());
+        return FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+    }
+
+    FMCPScreenshotResult MakeFailedResult(const FString& Error)
+    {
+        FMCPScreenshotResult Result;
+        Result.bSuccess = false;
+        Result.Error = Error;
+        return Result;
+    }
+
+    FMCPRawCapture MakeFailedCapture(const FString& Error)
+    {
+        FMCPRawCapture Capture;
+        Capture.bSuccess = false;
+        Capture.Error = Error;
+        return Capture;
+    }
+
+    /** Downscale captured pixels to the requested size. Runs on a worker thread. */
+    FMCPRawCapture MakeRawCapture(TArray<FColor>&& Pixels, FIntPoint SourceSize, const FMCPScreenshotRequest& Request, const FString& Source, double ReadbackMs)
+    {
+        FMCPRawCapture Capture;
+        Capture.bSuccess = true;
+        Capture.Source = Source;
+        Capture.SourceSize = SourceSize;
+        Capture.ReadbackMs = ReadbackMs;
+        Capture.OutputSize = FMCPScreenshotCapture::ComputeOutputSize(SourceSize, Request);
+
+        if (Capture.OutputSize != SourceSize)
+        {
+            FImageUtils::ImageResize(SourceSize.X, SourceSize.Y, Pixels, Capture.OutputSize.X, Capture.OutputSize.Y, Capture.Pixels, false);
+        }
+        else
+        {
+            Capture.Pixels = MoveTemp(Pixels);
+        }
+        return Capture;
+    }
+
+    /** Copy locked readback rows into BGRA pixels, converting the common back buffer formats */
+    bool ConvertReadbackRows(const uint8* Data, int32 RowPitchInPixels, FIntPoint Size, EPixelFormat Format, TArray<FColor>& OutPixels)
+    {
+        OutPixels.SetNumUninitialized(Size.X * Size.Y);
+
+        for (int32 Y = 0; Y < Size.Y; ++Y)
+        {
+            FColor* DestRow = OutPixels.GetData() + Y * Size.X;
+
+            switch (Format)
+            {
+                case PF_B8G8R8A8:
+                {
+                    const FColor* SrcRow = reinterpret_cast<const FColor*>(Data) + Y * RowPitchInPixels;
+                    FMemory::Memcpy(DestRow, SrcRow, Size.X * sizeof(FColor));
+                    break;
+                }
+                case PF_R8G8B8A8:
+                {
+                    const uint8* SrcRow = Data + (int64)Y * RowPitchInPixels * 4;
+                    for (int32 X = 0; X < Size.X; ++X)
+                    {
+                        DestRow[X] = FColor(SrcRow[X * 4 + 0], SrcRow[X * 4 + 1], SrcRow[X * 4 + 2], SrcRow[X * 4 + 3]);
+                    }
+                    break;
+                }
+                case PF_A2B10G10R10:
+                {
+                    const uint32* SrcRow = reinterpret_cast<const uint32*>(Data) + Y * RowPitchInPixels;
+                    for (int32 X = 0; X < Size.X; ++X)
+                    {
+                        const uint32 Packed = SrcRow[X];
+                        DestRow[X] = FColor((Packed & 0x3FF) >> 2, ((Packed >> 10) & 0x3FF) >> 2, ((Packed >> 20) & 0x3FF) >> 2, 255);
+                    }
+                    break;
+                }
+                case PF_FloatRGBA:
+                {
+                    const FFloat16Color* SrcRow = reinterpret_cast<const FFloat16Color*>(Data) + Y * RowPitchInPixels;
+                    for (int32 X = 0; X < Size.X; ++X)
+                    {
+                        DestRow[X] = FLinearColor(SrcRow[X]).ToFColor(true);
+                    }
+                    break;
+                }
+                default:
+                    return false;
+            }
+
+            // Viewport alpha is not meaningful; keep the encoded image opaque
+            for (int32 X = 0; X < Size.X; ++X)
+            {
+                DestRow[X].A = 255;
+            }
+        }
+
+        return true;
+    }
+
+    /** Encode and optionally save a raw capture. Runs on a worker thread. */
+    FMCPScreenshotResult EncodeScreenshot(IImageWrapperModule& ImageWrapperModule, const FMCPRawCapture& Capture, const FMCPScreenshotRequest& Request)
+    {
+        const double EncodeStart = FPlatformTime::Seconds();
+
+        FMCPScreenshotResult Result;
+        Result.Source = Capture.Source;
+        Result.SourceSize = Capture.SourceSize;
+        Result.OutputSize = Capture.OutputSize;
+        Result.ReadbackMs = Capture.ReadbackMs;
+        Result.bPlaceholder = Capture.bPlaceholder;
+
+        const bool bJpeg = Request.Format == TEXT("jpeg") || Request.Format == TEXT("jpg");
+        Result.Format = bJpeg ? TEXT("jpeg") : TEXT("png");
+
+        TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(bJpeg ? EImageFormat::JPEG : EImageFormat::PNG);
+        if (!ImageWrapper.IsValid() ||
+            !ImageWrapper->SetRaw(Capture.Pixels.GetData(), Capture.Pixels.Num() * sizeof(FColor), Capture.OutputSize.X, Capture.OutputSize.Y, ERGBFormat::BGRA, 8))
+        {
+            return MakeFailedResult(TEXT("Failed to initialize image encoder"));
+        }
+
+        const int32 Quality = bJpeg ? FMath::Clamp(Request.Quality, 1, 100) : (int32)EImageCompressionQuality::Default;
+        const TArray64<uint8> Compressed = ImageWrapper->GetCompressed(Quality);
+        if (Compressed.Num() == 0)
+        {
+            return MakeFailedResult(TEXT("Failed to encode screenshot"));
+        }
+        Result.EncodedImage.Append(Compressed.GetData(), (int32)Compressed.Num());
+
+        if (!Request.FilePath.IsEmpty())
+        {
+            if (!FFileHelper::SaveArrayToFile(Result.EncodedImage, *Request.FilePath))
+            {
+                return MakeFailedResult(FString::Printf(TEXT("Failed to write screenshot to %s"), *Request.FilePath));
+            }
+            Result.FilePath = Request.FilePath;
+        }
+
+        Result.EncodeMs = (FPlatformTime::Seconds() - EncodeStart) * 1000.0;
+        Result.bSuccess = true;
+        return Result;
+    }
+}
+
+bool FMCPScreenshotCapture::CanReadbackViewport(FViewport* Viewport)
+{
+    return Viewport != nullptr
+        && !GUsingNullRHI
+        && Viewport->GetSizeXY().X > 0
+        && Viewport->GetSizeXY().Y > 0;
+}
+
+FIntPoint FMCPScreenshotCapture::ComputeOutputSize(FIntPoint SourceSize, const FMCPScreenshotRequest& Request)
+{
+    // Only downscaling is supported
+    double Factor = FMath::Clamp((double)Request.Scale, 0.01, 1.0);
+    if (Request.MaxWidth > 0 && SourceSize.X > 0)
+    {
+        Factor = FMath::Min(Factor, (double)Request.MaxWidth / SourceSize.X);
+    }
+    if (Request.MaxHeight > 0 && SourceSize.Y > 0)
+    {
+        Factor = FMath::Min(Factor, (double)Request.MaxHeight / SourceSize.Y);
+    }
+
+    return FIntPoint(
+        FMath::Max(1, FMath::RoundToInt(SourceSize.X * Factor)),
+        FMath::Max(1, FMath::RoundToInt(SourceSize.Y * Factor)));
+}
+
+void FMCPScreenshotCapture::RenderOffscreenStandIn(FIntPoint Size, TArray<FColor>& OutPixels)
+{
+    // Deterministic gradient with a 64px grid so tests can check resizing and encoding
+    OutPixels.SetNumUninitialized(Size.X * Size.Y);
+    for (int32 Y = 0; Y < Size.Y; ++Y)
+    {
+        for (int32 X = 0; X < Size.X; ++X)
+        {
+            const bool bGridLine = (X % 64) == 0 || (Y % 64) == 0;
+            OutPixels[Y * Size.X + X] = bGridLine
+                ? FColor::White
+                : FColor((uint8)((X * 255) / FMath::Max(1, Size.X - 1)), (uint8)((Y * 255) / FMath::Max(1, Size.Y - 1)), 96, 255);
+        }
+    }
+}
+
+TFuture<FMCPScreenshotResult> FMCPScreenshotCapture::EncodeAsync(TArray<FColor>&& Pixels, FIntPoint Size, const FMCPScreenshotRequest& Request, const FString& Source, double ReadbackMs)
+{
+    IImageWrapperModule& ImageWrapperModule = LoadImageWrapperModule();
+
+    return Async(EAsyncExecution::ThreadPool,
+        [&ImageWrapperModule, Pixels = MoveTemp(Pixels), Size, Request, Source, ReadbackMs]() mutable
+        {
+            const FMCPRawCapture Capture = MakeRawCapture(MoveTemp(Pixels), Size, Request, Source, ReadbackMs);
+            return EncodeScreenshot(ImageWrapperModule, Capture, Request);
+        });
+}
+
+TFuture<FMCPScreenshotResult> FMCPScreenshotCapture::CaptureAsync(FViewport* Viewport, const FMCPScreenshotRequest& Request)
+{
+    check(IsInGameThread());
+
+    IImageWrapperModule& ImageWrapperModule = LoadImageWrapperModule();
+
+    return CaptureRawAsync(Viewport, Request).Next([&ImageWrapperModule, Request](FMCPRawCapture Capture)
+    {
+        if (!Capture.bSuccess)
+        {
+            return MakeFailedResult(Capture.Error);
+        }
+        return EncodeScreenshot(ImageWrapperModule, Capture, Request);
+    });
+}
+
+TFuture<FMCPRawCapture> FMCPScreenshotCapture::CaptureRawAsync(FViewport* Viewport, const FMCPScreenshotRequest& Request)
+{
+    check(IsInGameThread());
+
+    // Offscreen stand-in: used under -nullrhi and by tests
+    if (Request.bOffscreen || !CanReadbackViewport(Viewport))
+    {
+        if (!Request.bOffscreen && Viewport && !GUsingNullRHI)
+        {
+            return MakeFulfilledPromise<FMCPRawCapture>(MakeFailedCapture(TEXT("Viewport has no size"))).GetFuture();
+        }
+
+        const FIntPoint Size(FMath::Max(1, Request.OffscreenSize.X), FMath::Max(1, Request.OffscreenSize.Y));
+        return Async(EAsyncExecution::ThreadPool, [Size, Request]()
+        {
+            TArray<FColor> Pixels;
+            RenderOffscreenStandIn(Size, Pixels);
+            FMCPRawCapture Capture = MakeRawCapture(MoveTemp(Pixels), Size, Request, TEXT("offscreen"), 0.0);
+            Capture.bPlaceholder = true;
+            return Capture;
+        });
+    }
+
+    TSharedRef<FPendingScreenshot, ESPMode::ThreadSafe> State = MakeShared<FPendingScreenshot, ESPMode::ThreadSafe>();
+    State->Readback = MakeUnique<FRHIGPUTextureReadback>(TEXT("MCPScreenshotReadback"));
+    State->Request = Request;
+    State->Size = Viewport->GetSizeXY();
+    State->StartTime = FPlatformTime::Seconds();
+    TFuture<FMCPRawCapture> Future = State->Promise.GetFuture();
+
+    // The viewport may be closed before the render thread gets to the copy, so the
+    // command only holds references to its RHI resources, which keep them alive
+    FTextureRHIRef RenderTarget = Viewport->GetRenderTargetTexture();
+    FViewportRHIRef ViewportRHI = Viewport->GetViewportRHI();
+
+    // Queue the GPU copy into a staging texture; nothing here waits for the GPU
+    ENQUEUE_RENDER_COMMAND(MCPEnqueueScreenshotReadback)(
+        [State, RenderTarget, ViewportRHI](FRHICommandListImmediate& RHICmdList)
+        {
+            FTextureRHIRef Texture = RenderTarget;
+            if (!Texture.IsValid() && ViewportRHI.IsValid())
+            {
+                Texture = RHIGetViewportBackBuffer(ViewportRHI);
+            }
+            if (!Texture.IsValid())
+            {
+                State->Stage = (int32)EReadbackStage::Failed;
+                return;
+            }
+
+            const FIntVector TextureSize = Texture->GetSizeXYZ();
+            State->Size = FIntPoint(FMath::Min(State->Size.X, TextureSize.X), FMath::Min(State->Size.Y, TextureSize.Y));
+            State->PixelFormat = Texture->GetFormat();
+            State->Readback->EnqueueCopy(RHICmdList, Texture, FIntVector::ZeroValue, 0, FIntVector(State->Size.X, State->Size.Y, 1));
+            State->Stage = (int32)EReadbackStage::Copying;
+        });
+
+    // Poll the readback once per frame instead of flushing
+    FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([State](float DeltaTime) -> bool
+    {
+        const EReadbackStage Stage = (EReadbackStage)State->Stage.load();
+        if (Stage == EReadbackStage::Failed)
+        {
+            State->Promise.SetValue(MakeFailedCapture(TEXT("Viewport has no readable render target")));
+            return false;
+        }
+
+        if (Stage == EReadbackStage::Pending || !State->Readback->IsReady())
+        {
+            if (FPlatformTime::Seconds() - State->StartTime > ReadbackTimeoutSeconds)
+            {
+                // The render command may still touch the readback, so it stays owned by State
+                State->Stage = (int32)EReadbackStage::Failed;
+                State->Promise.SetValue(MakeFailedCapture(TEXT("Timed out waiting for viewport readback")));
+                return false;
+            }
+            return true;
+        }
+
+        // Lock on the render thread, copy out the rows and hand them to a worker for resizing
+        ENQUEUE_RENDER_COMMAND(MCPResolveScreenshotReadback)(
+            [State](FRHICommandListImmediate& RHICmdList)
+            {
+                const double ReadbackMs = (FPlatformTime::Seconds() - State->StartTime) * 1000.0;
+
+                int32 RowPitchInPixels = 0;
+                const uint8* Data = static_cast<const uint8*>(State->Readback->Lock(RowPitchInPixels));
+                if (!Data)
+                {
+                    // Nothing is mapped, so there is nothing to unlock
+                    State->Promise.SetValue(MakeFailedCapture(TEXT("Failed to map viewport readback")));
+                    return;
+                }
+
+                TArray<FColor> Pixels;
+                const bool bConverted = ConvertReadbackRows(Data, RowPitchInPixels, State->Size, State->PixelFormat, Pixels);
+                State->Readback->Unlock();
+
+                if (!bConverted)
+                {
+                    State->Promise.SetValue(MakeFailedCapture(FString::Printf(TEXT("Unsupported viewport pixel format: %s"),
+                        GetPixelFormatString(State->PixelFormat))));
+                    return;
+                }
+
+                Async(EAsyncExecution::ThreadPool, [State, Pixels = MoveTemp(Pixels), ReadbackMs]() mutable
+                {
+                    State->Promise.SetValue(MakeRawCapture(MoveTemp(Pixels), State->Size, State->Request, TEXT("viewport"), ReadbackMs));
+                });
+            });
+
+        return false;
+    }));
+
+    return Future;
+}
@@ -0,0 +1,182 @@
+#include "MCPServerStats.h"
+#include "Dom/JsonValue.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+    const TCHAR* const PhaseNames[] = { TEXT("parse"), TEXT("queue"), TEXT("execute"), TEXT("serialize"), TEXT("send"), TEXT("total") };
+}
+
+FMCPLatencyHistogram::FMCPLatencyHistogram()
+    : Count(0)
+    , SumSeconds(0.0)
+    , MaxSeconds(0.0)
+{
+    FMemory::Memzero(Buckets);
+}
+
+int32 FMCPLatencyHistogram::GetBucket(uint64 Micros)
+{
+    if (Micros < SubBucketCount)
+    {
+        return (int32)Micros;
+    }
+    // Top SubBucketBits bits below the leading one select the sub-bucket
+    const int32 Magnitude = (int32)FMath::FloorLog2_64(Micros);
+    const int32 SubBucket = (int32)(Micros >> (Magnitude - SubBucketBits)) & (SubBucketCount - 1);
+    return FMath::Min(((Magnitude - SubBucketBits + 1) << SubBucketBits) + SubBucket, NumBuckets - 1);
+}
+
+uint64 FMCPLatencyHistogram::GetBucketUpperBound(int32 Bucket)
+{
+    if (Bucket < 2 * SubBucketCount)
+    {
+        return (uint64)Bucket;
+    }
+    const int32 Shift = (Bucket >> SubBucketBits) - 1;
+    const uint64 Lower = (uint64)(SubBucketCount + (Bucket & (SubBucketCount - 1))) << Shift;
+    return Lower + (1ull << Shift) - 1;
+}
+
+void FMCPLatencyHistogram::Record(double Seconds)
+{
+    Seconds = FMath::Max(Seconds, 0.0);
+    ++Buckets[GetBucket((uint64)(Seconds * 1000000.0))];
+    ++Count;
+    SumSeconds += Seconds;
+    MaxSeconds = FMath::Max(MaxSeconds, Seconds);
+}
+
+void FMCPLatencyHistogram::Merge(const FMCPLatencyHistogram& Other)
+{
+    for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+    {
+        Buckets[Bucket] += Other.Buckets[Bucket];
+    }
+    Count += Other.Count;
+    SumSeconds += Other.SumSeconds;
+    MaxSeconds = FMath::Max(MaxSeconds, Other.MaxSeconds);
+}
+
+double FMCPLatencyHistogram::GetPercentile(double Fraction) const
+{
+    if (Count == 0)
+    {
+        return 0.0;
+    }
+    const uint64 Rank = FMath::Max<uint64>(1, (uint64)FMath::CeilToDouble(Fraction * Count));
+    uint64 Seen = 0;
+    for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+    {
+        Seen += Buckets[Bucket];
+        if (Seen >= Rank)
+        {
+            return FMath::Min(GetBucketUpperBound(Bucket) / 1000000.0, MaxSeconds);
+        }
+    }
+    return MaxSeconds;
+}
+
+TSharedPtr<FJsonObject> FMCPLatencyHistogram::ToJson() const
+{
+    TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+    Json->SetNumberField(TEXT("count"), (double)Count);
+    Json->SetNumberField(TEXT("mean_ms"), Count > 0 ? SumSeconds * 1000.0 / Count : 0.0);
+    Json->SetNumberField(TEXT("p50_ms"), GetPercentile(0.50) * 1000.0);
+    Json->SetNumberField(TEXT("p90_ms"), GetPercentile(0.90) * 1000.0);
+    Json->SetNumberField(TEXT("p99_ms"), GetPercentile(0.99) * 1000.0);
+    Json->SetNumberField(TEXT("p999_ms"), GetPercentile(0.999) * 1000.0);
+    Json->SetNumberField(TEXT("max_ms"), MaxSeconds * 1000.0);
+    return Json;
+}
+
+void FMCPServerStats::FCommandStats::Merge(const FCommandStats& Other)
+{
+    Requests += Other.Requests;
+    Errors += Other.Errors;
+    BytesIn += Other.BytesIn;
+    BytesOut += Other.BytesOut;
+    for (int32 Phase = 0; Phase < NumPhases; ++Phase)
+    {
+        Phases[Phase].Merge(Other.Phases[Phase]);
+    }
+}
+
+TSharedPtr<FJsonObject> FMCPServerStats::FCommandStats::ToJson() const
+{
+    TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+    Json->SetNumberField(TEXT("requests"), (double)Requests);
+    Json->SetNumberField(TEXT("errors"), (double)Errors);
+    Json->SetNumberField(TEXT("bytes_in"), (double)BytesIn);
+    Json->SetNumberField(TEXT("bytes_out"), (double)BytesOut);
+    TSharedPtr<FJsonObject> PhasesJson = MakeShared<FJsonObject>();
+    for (int32 Phase = 0; Phase < NumPhases; ++Phase)
+    {
+        PhasesJson->SetObjectField(PhaseNames[Phase], Phases[Phase].ToJson());
+    }
+    Json->SetObjectField(TEXT("latency"), PhasesJson);
+    return Json;
+}
+
+FMCPServerStats::FMCPServerStats()
+    : StartTime(FPlatformTime::Seconds())
+{
+}
+
+void FMCPServerStats::RecordRequest(const FString& CommandType, const FMCPRequestTiming& Timing, bool bError, int64 BytesIn, int64 BytesOut)
+{
+    FScopeLock ScopeLock(&Lock);
+    FCommandStats* Found = Commands.Find(CommandType);
+    if (!Found)
+    {
+        // Each entry holds a few KB of histograms; unknown types must not grow the map forever
+        Found = &Commands.FindOrAdd(Commands.Num() < MaxCommandTypes ? CommandType : FString(TEXT("other")));
+    }
+    FCommandStats& Stats = *Found;
+    ++Stats.Requests;
+    Stats.Errors += bError ? 1 : 0;
+    Stats.BytesIn += BytesIn;
+    Stats.BytesOut += BytesOut;
+    Stats.Phases[Parse].Record(FMCPRequestTiming::Seconds(Timing.ReceiveCycle, Timing.DispatchCycle));
+    Stats.Phases[Queue].Record(FMCPRequestTiming::Seconds(Timing.DispatchCycle, Timing.StartCycle));
+    Stats.Phases[Execute].Record(FMCPRequestTiming::Seconds(Timing.StartCycle, Timing.EndCycle));
+    Stats.Phases[Serialize].Record(FMCPRequestTiming::Seconds(Timing.EndCycle, Timing.SerializeEndCycle));
+    Stats.Phases[Send].Record(FMCPRequestTiming::Seconds(Timing.SerializeEndCycle, Timing.SendEndCycle));
+    Stats.Phases[Total].Record(FMCPRequestTiming::Seconds(Timing.ReceiveCycle, Timing.SendEndCycle));
+}
+
+TSharedPtr<FJsonObject> FMCPServerStats::ToJson(bool bPerCommand) const
+{
+    FCommandStats Totals;
+    TSharedPtr<FJsonObject> CommandsJson = MakeShared<FJsonObject>();
+    double Uptime = 0.0;
+    {
+        FScopeLock ScopeLock(&Lock);
+        Uptime = FPlatformTime::Seconds() - StartTime;
+        for (const TPair<FString, FCommandStats>& Pair : Commands)
+        {
+            Totals.Merge(Pair.Value);
+            if (bPerCommand)
+            {
+                CommandsJson->SetObjectField(Pair.Key, Pair.Value.ToJson());
+            }
+        }
+    }
+
+    TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+    Json->SetNumberField(TEXT("uptime_s"), Uptime);
+    Json->SetNumberField(TEXT("requests_per_s"), Uptime > 0.0 ? Totals.Requests / Uptime : 0.0);
+    Json->SetObjectField(TEXT("totals"), Totals.ToJson());
+    if (bPerCommand)
+    {
+        Json->SetObjectField(TEXT("commands"), CommandsJson);
+    }
+    return Json;
+}
+
+void FMCPServerStats::Reset()
+{
+    FScopeLock ScopeLock(&Lock);
+    Commands.Reset();
+    StartTime = FPlatformTime::Seconds();
+}
@@ -0,0 +1,132 @@
+#include "MCPSharedMemory.h"
+#include "MCPWireProtocol.h"
+#include "MCPLog.h"
+
+namespace
+{
+    uint32 ReadUInt32LE(const uint8* Src)
+    {
+        return (uint32)Src[0] | ((uint32)Src[1] << 8) | ((uint32)Src[2] << 16) | ((uint32)Src[3] << 24);
+    }
+
+    uint64 ReadUInt64LE(const uint8* Src)
+    {
+        return (uint64)ReadUInt32LE(Src) | ((uint64)ReadUInt32LE(Src + 4) << 32);
+    }
+
+    void WriteUInt64LE(uint8* Dest, uint64 Value)
+    {
+        for (int32 Index = 0; Index < 8; ++Index)
+        {
+            Dest[Index] = (uint8)(Value >> (Index * 8));
+        }
+    }
+}
+
+TUniquePtr<FMCPSharedMemoryChannel> FMCPSharedMemoryChannel::Open(const FString& Name, int64 RingSize, int32 MinPayload, FString& OutError)
+{
+    if (Name.IsEmpty() || RingSize <= 0 || RingSize > MCP_SHARED_MEMORY_MAX_RING_SIZE)
+    {
+        OutError = FString::Printf(TEXT("Invalid shared memory name or ring size (at most %lld bytes)"), MCP_SHARED_MEMORY_MAX_RING_SIZE);
+        return nullptr;
+    }
+
+    const SIZE_T RegionSize = MCP_SHARED_MEMORY_HEADER_SIZE + 2 * (SIZE_T)RingSize;
+    FPlatformMemory::FSharedMemoryRegion* Region = FPlatformMemory::MapNamedSharedMemoryRegion(Name, false,
+        FPlatformMemory::ESharedMemoryAccess::Read | FPlatformMemory::ESharedMemoryAccess::Write, RegionSize);
+    if (!Region)
+    {
+        OutError = FString::Printf(TEXT("Could not map shared memory region '%s'; it must be created by a client on this machine"), *Name);
+        return nullptr;
+    }
+
+    // Do not touch a region that was not set up as a channel of this size
+    const uint8* Header = static_cast<const uint8*>(Region->GetAddress());
+    if (ReadUInt32LE(Header) != MCP_SHARED_MEMORY_MAGIC || ReadUInt32LE(Header + 4) != MCP_SHARED_MEMORY_VERSION
+        || ReadUInt64LE(Header + 8) != (uint64)RingSize)
+    {
+        FPlatformMemory::UnmapNamedSharedMemoryRegion(Region);
+        OutError = FString::Printf(TEXT("Shared memory region '%s' has no version %d header for a %lld byte ring"),
+            *Name, MCP_SHARED_MEMORY_VERSION, RingSize);
+        return nullptr;
+    }
+
+    return TUniquePtr<FMCPSharedMemoryChannel>(new FMCPSharedMemoryChannel(Name, Region, RingSize, FMath::Max(MinPayload, 0)));
+}
+
+FMCPSharedMemoryChannel::FMCPSharedMemoryChannel(const FString& InName, FPlatformMemory::FSharedMemoryRegion* InRegion, int64 InRingSize, int32 InMinPayload)
+    : Name(InName)
+    , Region(InRegion)
+    , Base(static_cast<uint8*>(InRegion->GetAddress()))
+    , RingSize(InRingSize)
+    , MinPayload(InMinPayload)
+    , ResponseHead(0)
+{
+    // Positions restart with every channel, whatever a previous user left behind
+    FPlatformAtomics::AtomicStore(RequestTailPtr(), 0);
+    FPlatformAtomics::AtomicStore(ResponseTailPtr(), 0);
+}
+
+FMCPSharedMemoryChannel::~FMCPSharedMemoryChannel()
+{
+    // The client created the region and removes it
+    FPlatformMemory::UnmapNamedSharedMemoryRegion(Region);
+}
+
+bool FMCPSharedMemoryChannel::ReadRequestPayload(TArray<uint8>& InOutPayload, FString& OutError)
+{
+    if (InOutPayload.Num() != MCP_SHARED_PAYLOAD_DESCRIPTOR_SIZE)
+    {
+        OutError = TEXT("Shared payload descriptor has the wrong size");
+        return false;
+    }
+
+    const uint64 Position = ReadUInt64LE(InOutPayload.GetData());
+    const uint64 Length = ReadUInt64LE(InOutPayload.GetData() + 8);
+    const uint64 Offset = Position % (uint64)RingSize;
+    const uint64 Tail = (uint64)FPlatformAtomics::AtomicRead(RequestTailPtr());
+    if (Position < Tail || Length > MCP_MAX_MESSAGE_SIZE || Offset + Length > (uint64)RingSize)
+    {
+        OutError = FString::Printf(TEXT("Shared payload descriptor out of range (position %llu, length %llu)"), Position, Length);
+        return false;
+    }
+
+    const uint8* Source = Base + MCP_SHARED_MEMORY_HEADER_SIZE + Offset;
+    InOutPayload.Reset((int32)Length);
+    InOutPayload.Append(Source, (int32)Length);
+
+    // Copied out; the client may reuse the space
+    FPlatformAtomics::AtomicStore(RequestTailPtr(), (int64)(Position + Length));
+    return true;
+}
+
+bool FMCPSharedMemoryChannel::WriteResponsePayload(const TArray<uint8>& Payload, TArray<uint8>& OutDescriptor)
+{
+    const uint64 Length = Payload.Num();
+    if (Payload.Num() < MinPayload || Length == 0 || Length > (uint64)RingSize)
+    {
+        return false;
+    }
+
+    uint64 Position = ResponseHead;
+    if (Position % (uint64)RingSize + Length > (uint64)RingSize)
+    {
+        // Payloads never wrap; skip the rest of the ring
+        Position += (uint64)RingSize - Position % (uint64)RingSize;
+    }
+    const uint64 Tail = (uint64)FPlatformAtomics::AtomicRead(ResponseTailPtr());
+    if (Position + Length - Tail > (uint64)RingSize)
+    {
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("MCPSharedMemory: %s response ring full, sending %llu bytes inline"), *Name, Length);
+        return false;
+    }
+
+    uint8* Dest = Base + MCP_SHARED_MEMORY_HEADER_SIZE + RingSize + Position % (uint64)RingSize;
+    FMemory::Memcpy(Dest, Payload.GetData(), Length);
+    ResponseHead = Position + Length;
+
+    OutDescriptor.SetNumUninitialized(MCP_SHARED_PAYLOAD_DESCRIPTOR_SIZE);
+    WriteUInt64LE(OutDescriptor.GetData(), Position);
+    WriteUInt64LE(OutDescriptor.GetData() + 8, Length);
+    return true;
+}
@@ -0,0 +1,492 @@
+#include "MCPSpatialIndex.h"
+#include "MCPLog.h"
+#include "Editor.h"
+#include "EngineUtils.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+namespace
+{
+    // Actors covering more cells than this are checked by every query instead
+    constexpr int32 MaxCellsPerActor = 64;
+}
+
+FMCPSpatialIndex::FMCPSpatialIndex(double InCellSize)
+    : CellSize(InCellSize)
+    , OccupiedMin(MAX_int32, MAX_int32)
+    , OccupiedMax(MIN_int32, MIN_int32)
+    , bNeedsRebuild(true)
+    , CurrentStamp(0)
+    , LastBuildSeconds(0.0)
+{
+    check(CellSize > 0.0);
+
+    if (GEngine)
+    {
+        ActorAddedHandle = GEngine->OnLevelActorAdded().AddRaw(this, &FMCPSpatialIndex::OnActorAdded);
+        ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddRaw(this, &FMCPSpatialIndex::OnActorDeleted);
+        ActorMovedHandle = GEngine->OnActorMoved().AddRaw(this, &FMCPSpatialIndex::OnActorMoved);
+        ActorsMovedHandle = GEngine->OnActorsMoved().AddRaw(this, &FMCPSpatialIndex::OnActorsMoved);
+    }
+    UndoRedoHandle = FEditorDelegates::PostUndoRedo.AddRaw(this, &FMCPSpatialIndex::OnUndoRedo);
+}
+
+FMCPSpatialIndex::~FMCPSpatialIndex()
+{
+    if (GEngine)
+    {
+        GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+        GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+        GEngine->OnActorMoved().Remove(ActorMovedHandle);
+        GEngine->OnActorsMoved().Remove(ActorsMovedHandle);
+    }
+    FEditorDelegates::PostUndoRedo.Remove(UndoRedoHandle);
+}
+
+bool FMCPSpatialIndex::Refresh(UWorld* World)
+{
+    check(IsInGameThread());
+
+    if (bNeedsRebuild || IndexedWorld.Get() != World)
+    {
+        Rebuild(World);
+        return true;
+    }
+
+    for (const TWeakObjectPtr<AActor>& Pending : PendingUpdates)
+    {
+        if (AActor* Actor = Pending.Get())
+        {
+            UpdateActor(Actor);
+        }
+    }
+    PendingUpdates.Reset();
+    return false;
+}
+
+void FMCPSpatialIndex::NotifyActorMoved(AActor* Actor)
+{
+    OnActorMoved(Actor);
+}
+
+void FMCPSpatialIndex::Reset()
+{
+    Entries.Reset();
+    FreeEntries.Reset();
+    EntryIndices.Reset();
+    Cells.Reset();
+    Oversized.Reset();
+    PendingUpdates.Reset();
+    OccupiedMin = FIntPoint(MAX_int32, MAX_int32);
+    OccupiedMax = FIntPoint(MIN_int32, MIN_int32);
+}
+
+void FMCPSpatialIndex::Rebuild(UWorld* World)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    Reset();
+    IndexedWorld = World;
+    bNeedsRebuild = false;
+
+    if (World)
+    {
+        for (TActorIterator<AActor> It(World); It; ++It)
+        {
+            InsertActor(*It);
+        }
+    }
+
+    LastBuildSeconds = FPlatformTime::Seconds() - StartTime;
+    UE_LOG(LogUnrealMCP, Log, TEXT("UnrealMCP: Built spatial index of %d actors in %.1f ms"), Num(), LastBuildSeconds * 1000.0);
+}
+
+FIntPoint FMCPSpatialIndex::GetCell(const FVector& Location) const
+{
+    return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+FBox FMCPSpatialIndex::GetActorBounds(const AActor* Actor)
+{
+    const FBox Bounds = Actor->GetComponentsBoundingBox(true);
+    if (Bounds.IsValid)
+    {
+        return Bounds;
+    }
+
+    // Lights, cameras and other actors without primitives are points
+    const FVector Location = Actor->GetActorLocation();
+    return FBox(Location, Location);
+}
+
+void FMCPSpatialIndex::InsertActor(AActor* Actor)
+{
+    if (!IsValid(Actor) || Actor->GetWorld() != IndexedWorld.Get() || EntryIndices.Contains(Actor))
+    {
+        return;
+    }
+
+    const int32 EntryIndex = FreeEntries.Num() > 0 ? FreeEntries.Pop(EAllowShrinking::No) : Entries.AddDefaulted();
+    FEntry& Entry = Entries[EntryIndex];
+    Entry = FEntry();
+    Entry.Actor = Actor;
+    Entry.Key = Actor;
+    Entry.Bounds = GetActorBounds(Actor);
+    EntryIndices.Add(Actor, EntryIndex);
+    LinkEntry(EntryIndex);
+}
+
+void FMCPSpatialIndex::UpdateActor(AActor* Actor)
+{
+    const int32* EntryIndex = EntryIndices.Find(Actor);
+    if (!EntryIndex)
+    {
+        InsertActor(Actor);
+        return;
+    }
+
+    // Only touch the cells if the actor's footprint actually changed cells
+    FEntry& Entry = Entries[*EntryIndex];
+    const FBox NewBounds = GetActorBounds(Actor);
+    const FIntPoint NewMin = GetCell(NewBounds.Min);
+    const FIntPoint NewMax = GetCell(NewBounds.Max);
+    if (!Entry.bOversized && NewMin == Entry.MinCell && NewMax == Entry.MaxCell)
+    {
+        Entry.Bounds = NewBounds;
+        return;
+    }
+
+    UnlinkEntry(*EntryIndex);
+    Entry.Bounds = NewBounds;
+    LinkEntry(*EntryIndex);
+}
+
+void FMCPSpatialIndex::RemoveEntry(int32 EntryIndex)
+{
+    UnlinkEntry(EntryIndex);
+    EntryIndices.Remove(Entries[EntryIndex].Key);
+    Entries[EntryIndex] = FEntry();
+    FreeEntries.Add(EntryIndex);
+}
+
+void FMCPSpatialIndex::LinkEntry(int32 EntryIndex)
+{
+    FEntry& Entry = Entries[EntryIndex];
+    Entry.MinCell = GetCell(Entry.Bounds.Min);
+    Entry.MaxCell = GetCell(Entry.Bounds.Max);
+
+    const int64 CellCount = int64(Entry.MaxCell.X - Entry.MinCell.X + 1) * int64(Entry.MaxCell.Y - Entry.MinCell.Y + 1);
+    Entry.bOversized = CellCount > MaxCellsPerActor;
+    if (Entry.bOversized)
+    {
+        Oversized.Add(EntryIndex);
+        return;
+    }
+
+    for (int32 Y = Entry.MinCell.Y; Y <= Entry.MaxCell.Y; ++Y)
+    {
+        for (int32 X = Entry.MinCell.X; X <= Entry.MaxCell.X; ++X)
+        {
+            Cells.FindOrAdd(FIntPoint(X, Y)).Add(EntryIndex);
+        }
+    }
+    OccupiedMin = OccupiedMin.ComponentMin(Entry.MinCell);
+    OccupiedMax = OccupiedMax.ComponentMax(Entry.MaxCell);
+}
+
+void FMCPSpatialIndex::UnlinkEntry(int32 EntryIndex)
+{
+    const FEntry& Entry = Entries[EntryIndex];
+    if (Entry.bOversized)
+    {
+        Oversized.RemoveSingleSwap(EntryIndex, EAllowShrinking::No);
+        return;
+    }
+
+    for (int32 Y = Entry.MinCell.Y; Y <= Entry.MaxCell.Y; ++Y)
+    {
+        for (int32 X = Entry.MinCell.X; X <= Entry.MaxCell.X; ++X)
+        {
+            const FIntPoint Cell(X, Y);
+            if (TArray<int32>* CellEntries = Cells.Find(Cell))
+            {
+                CellEntries->RemoveSingleSwap(EntryIndex, EAllowShrinking::No);
+                if (CellEntries->Num() == 0)
+                {
+                    Cells.Remove(Cell);
+                }
+            }
+        }
+    }
+}
+
+bool FMCPSpatialIndex::StampEntry(int32 EntryIndex)
+{
+    FEntry& Entry = Entries[EntryIndex];
+    if (Entry.QueryStamp == CurrentStamp)
+    {
+        return false;
+    }
+    Entry.QueryStamp = CurrentStamp;
+    return true;
+}
+
+template <typename FunctorType>
+void FMCPSpatialIndex::ForEachEntryInCells(const FIntPoint& MinCell, const FIntPoint& MaxCell, FunctorType&& Visitor)
+{
+    auto VisitEntry = [this, &Visitor](int32 EntryIndex)
+    {
+        if (!StampEntry(EntryIndex))
+        {
+            return true;
+        }
+        AActor* Actor = Entries[EntryIndex].Actor.Get();
+        return !IsValid(Actor) || Visitor(Entries[EntryIndex], Actor);
+    };
+
+    for (const int32 EntryIndex : Oversized)
+    {
+        if (!VisitEntry(EntryIndex))
+        {
+            return;
+        }
+    }
+
+    // Clamp to occupied space; for huge ranges walking the occupied cells is cheaper
+    const FIntPoint From = MinCell.ComponentMax(OccupiedMin);
+    const FIntPoint To = MaxCell.ComponentMin(OccupiedMax);
+    if (From.X > To.X || From.Y > To.Y)
+    {
+        return;
+    }
+
+    const int64 RangeCells = int64(To.X - From.X + 1) * int64(To.Y - From.Y + 1);
+    if (RangeCells > Cells.Num())
+    {
+        for (const TPair<FIntPoint, TArray<int32>>& Cell : Cells)
+        {
+            if (Cell.Key.X < From.X || Cell.Key.X > To.X || Cell.Key.Y < From.Y || Cell.Key.Y > To.Y)
+            {
+                continue;
+            }
+            for (const int32 EntryIndex : Cell.Value)
+            {
+                if (!VisitEntry(EntryIndex))
+                {
+                    return;
+                }
+            }
+        }
+        return;
+    }
+
+    for (int32 Y = From.Y; Y <= To.Y; ++Y)
+    {
+        for (int32 X = From.X; X <= To.X; ++X)
+        {
+            if (const TArray<int32>* CellEntries = Cells.Find(FIntPoint(X, Y)))
+            {
+                for (const int32 EntryIndex : *CellEntries)
+                {
+                    if (!VisitEntry(EntryIndex))
+                    {
+                        return;
+                    }
+                }
+            }
+        }
+    }
+}
+
+bool FMCPSpatialIndex::QuerySphere(const FVector& Center, double Radius, FFilter Filter, int32 MaxResults, TArray<FHit>& OutHits)
+{
+    ++CurrentStamp;
+    const double RadiusSquared = FMath::Square(Radius);
+    bool bComplete = true;
+
+    ForEachEntryInCells(GetCell(Center - FVector(Radius)), GetCell(Center + FVector(Radius)),
+        [&](const FEntry& Entry, AActor* Actor)
+        {
+            const double DistanceSquared = Entry.Bounds.ComputeSquaredDistanceToPoint(Center);
+            if (DistanceSquared <= RadiusSquared && Filter(Actor))
+            {
+                if (OutHits.Num() >= MaxResults)
+                {
+                    bComplete = false;
+                    return false;
+                }
+                OutHits.Add({Actor, DistanceSquared});
+            }
+            return true;
+        });
+
+    return bComplete;
+}
+
+bool FMCPSpatialIndex::QueryBox(const FBox& Box, FFilter Filter, int32 MaxResults, TArray<FHit>& OutHits)
+{
+    ++CurrentStamp;
+    const FVector Center = Box.GetCenter();
+    bool bComplete = true;
+
+    ForEachEntryInCells(GetCell(Box.Min), GetCell(Box.Max),
+        [&](const FEntry& Entry, AActor* Actor)
+        {
+            if (Entry.Bounds.Intersect(Box) && Filter(Actor))
+            {
+                if (OutHits.Num() >= MaxResults)
+                {
+                    bComplete = false;
+                    return false;
+                }
+                OutHits.Add({Actor, Entry.Bounds.ComputeSquaredDistanceToPoint(Center)});
+            }
+            return true;
+        });
+
+    return bComplete;
+}
+
+void FMCPSpatialIndex::QueryNearest(const FVector& Point, int32 Count, double MaxDistance, FFilter Filter, TArray<FHit>& OutHits)
+{
+    ++CurrentStamp;
+    if (Count <= 0)
+    {
+        return;
+    }
+
+    const double MaxDistanceSquared = MaxDistance > 0.0 ? FMath::Square(MaxDistance) : TNumericLimits<double>::Max();
+
+    // Max-heap on distance holding the best Count candidates so far
+    TArray<FHit> Best;
+    Best.Reserve(Count + 1);
+    auto FartherFirst = [](const FHit& A, const FHit& B) { return A.DistanceSquared > B.DistanceSquared; };
+
+    auto Consider = [&](const FEntry& Entry, AActor* Actor)
+    {
+        const double DistanceSquared = Entry.Bounds.ComputeSquaredDistanceToPoint(Point);
+        if (DistanceSquared > MaxDistanceSquared || (Best.Num() == Count && DistanceSquared >= Best.HeapTop().DistanceSquared))
+        {
+            return true;
+        }
+        if (!Filter(Actor))
+        {
+            return true;
+        }
+        Best.HeapPush({Actor, DistanceSquared}, FartherFirst);
+        if (Best.Num() > Count)
+        {
+            Best.HeapPopDiscard(FartherFirst, EAllowShrinking::No);
+        }
+        return true;
+    };
+
+    for (const int32 EntryIndex : Oversized)
+    {
+        StampEntry(EntryIndex);
+        AActor* Actor = Entries[EntryIndex].Actor.Get();
+        if (IsValid(Actor))
+        {
+            Consider(Entries[EntryIndex], Actor);
+        }
+    }
+
+    // Walk square rings of cells outward from the point's cell. Anything outside ring R
+    // is at least R * CellSize away, so stop once the Count-th best is closer than that.
+    const FIntPoint Origin = GetCell(Point);
+    if (OccupiedMin.X <= OccupiedMax.X)
+    {
+        int32 LastRing = FMath::Max(
+            FMath::Max(FMath::Abs(Origin.X - OccupiedMin.X), FMath::Abs(OccupiedMax.X - Origin.X)),
+            FMath::Max(FMath::Abs(Origin.Y - OccupiedMin.Y), FMath::Abs(OccupiedMax.Y - Origin.Y)));
+        if (MaxDistance > 0.0)
+        {
+            LastRing = FMath::Min(LastRing, FMath::CeilToInt32(MaxDistance / CellSize) + 1);
+        }
+
+        auto VisitCell = [&](int32 X, int32 Y)
+        {
+            if (const TArray<int32>* CellEntries = Cells.Find(FIntPoint(X, Y)))
+            {
+                for (const int32 EntryIndex : *CellEntries)
+                {
+                    AActor* Actor = Entries[EntryIndex].Actor.Get();
+                    if (StampEntry(EntryIndex) && IsValid(Actor))
+                    {
+                        Consider(Entries[EntryIndex], Actor);
+                    }
+                }
+            }
+        };
+
+        for (int32 Ring = 0; Ring <= LastRing; ++Ring)
+        {
+            if (Ring == 0)
+            {
+                VisitCell(Origin.X, Origin.Y);
+            }
+            else
+            {
+                for (int32 X = Origin.X - Ring; X <= Origin.X + Ring; ++X)
+                {
+                    VisitCell(X, Origin.Y - Ring);
+                    VisitCell(X, Origin.Y + Ring);
+                }
+                for (int32 Y = Origin.Y - Ring + 1; Y <= Origin.Y + Ring - 1; ++Y)
+                {
+                    VisitCell(Origin.X - Ring, Y);
+                    VisitCell(Origin.X + Ring, Y);
+                }
+            }
+
+            if (Best.Num() == Count && Best.HeapTop().DistanceSquared <= FMath::Square(Ring * CellSize))
+            {
+                break;
+            }
+        }
+    }
+
+    Best.Sort([](const FHit& A, const FHit& B) { return A.DistanceSquared < B.DistanceSquared; });
+    OutHits.Append(Best);
+}
+
+void FMCPSpatialIndex::OnActorAdded(AActor* Actor)
+{
+    // Bounds may not be final yet (deferred construction); pick it up on the next Refresh
+    if (!bNeedsRebuild && Actor && Actor->GetWorld() == IndexedWorld.Get())
+    {
+        PendingUpdates.Add(Actor);
+    }
+}
+
+void FMCPSpatialIndex::OnActorDeleted(AActor* Actor)
+{
+    PendingUpdates.Remove(Actor);
+    if (const int32* EntryIndex = EntryIndices.Find(Actor))
+    {
+        RemoveEntry(*EntryIndex);
+    }
+}
+
+void FMCPSpatialIndex::OnActorMoved(AActor* Actor)
+{
+    if (!bNeedsRebuild && Actor && Actor->GetWorld() == IndexedWorld.Get())
+    {
+        PendingUpdates.Add(Actor);
+    }
+}
+
+void FMCPSpatialIndex::OnActorsMoved(TArray<AActor*>& Actors)
+{
+    for (AActor* Actor : Actors)
+    {
+        OnActorMoved(Actor);
+    }
+}
+
+void FMCPSpatialIndex::OnUndoRedo()
+{
+    // Undo can move, restore or remove any number of actors without individual events
+    bNeedsRebuild = true;
+}
@@ -0,0 +1,35 @@
+#include "MCPTrace.h"
+#include "MCPWireProtocol.h"
+
+#if UE_TRACE_ENABLED
+
+UE_TRACE_CHANNEL_DEFINE(UnrealMCPChannel);
+
+// Timestamps are FPlatformTime cycles, the same clock as the CPU timers
+UE_TRACE_EVENT_BEGIN(UnrealMCP, Request)
+    UE_TRACE_EVENT_FIELD(uint64, RequestId)
+    UE_TRACE_EVENT_FIELD(uint64, ReceiveCycle)
+    UE_TRACE_EVENT_FIELD(uint64, DispatchCycle)
+    UE_TRACE_EVENT_FIELD(uint64, StartCycle)
+    UE_TRACE_EVENT_FIELD(uint64, EndCycle)
+    UE_TRACE_EVENT_FIELD(uint64, SendEndCycle)
+    UE_TRACE_EVENT_FIELD(bool, Error)
+    UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Command)
+UE_TRACE_EVENT_END()
+
+#endif
+
+void FMCPTrace::OutputRequest(uint64 RequestId, const FString& CommandType, const FMCPRequestTiming& Timing, bool bError)
+{
+#if UE_TRACE_ENABLED
+    UE_TRACE_LOG(UnrealMCP, Request, UnrealMCPChannel)
+        << Request.RequestId(RequestId)
+        << Request.ReceiveCycle(Timing.ReceiveCycle)
+        << Request.DispatchCycle(Timing.DispatchCycle)
+        << Request.StartCycle(Timing.StartCycle)
+        << Request.EndCycle(Timing.EndCycle)
+        << Request.SendEndCycle(Timing.SendEndCycle)
+        << Request.Error(bError)
+        << Request.Command(*CommandType, CommandType.Len());
+#endif
+}
@@ -0,0 +1,342 @@
+#include "MCPUnixSocket.h"
+#include "MCPLog.h"
+
+#if PLATFORM_UNIX || PLATFORM_MAC
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+#ifdef MSG_NOSIGNAL
+    // A client that went away must not raise SIGPIPE in the editor
+    const int SendFlags = MSG_NOSIGNAL;
+#else
+    const int SendFlags = 0;
+#endif
+
+    FString DescribeErrno()
+    {
+        return FString::Printf(TEXT("%s (errno %d)"), UTF8_TO_TCHAR(strerror(errno)), errno);
+    }
+
+    bool MakeAddress(const FString& Path, sockaddr_un& OutAddress)
+    {
+        FMemory::Memzero(OutAddress);
+        OutAddress.sun_family = AF_UNIX;
+        FTCHARToUTF8 Utf8Path(*Path);
+        if (Utf8Path.Length() == 0 || Utf8Path.Length() >= (int32)sizeof(OutAddress.sun_path))
+        {
+            return false;
+        }
+        FMemory::Memcpy(OutAddress.sun_path, Utf8Path.Get(), Utf8Path.Length());
+        return true;
+    }
+
+    /**
+     * True if Address names a socket file of this user that nothing accepts
+     * connections on. Anything else at the path, such as a regular file or
+     * another user's socket, is never considered stale.
+     */
+    bool IsStaleSocketFile(const sockaddr_un& Address)
+    {
+        struct stat Status;
+        if (lstat(Address.sun_path, &Status) != 0 || !S_ISSOCK(Status.st_mode) || Status.st_uid != getuid())
+        {
+            return false;
+        }
+
+        const int Probe = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (Probe < 0)
+        {
+            return false;
+        }
+        const bool bStale = connect(Probe, reinterpret_cast<const sockaddr*>(&Address), sizeof(Address)) != 0 && errno == ECONNREFUSED;
+        close(Probe);
+        return bStale;
+    }
+
+    /**
+     * A stream socket on a Unix domain socket descriptor. Results follow
+     * FSocketBSD, errors are left in errno where the socket subsystem's
+     * GetLastErrorCode finds them, and calls that need an internet address fail.
+     */
+    class FMCPUnixDomainSocket : public FSocket
+    {
+    public:
+        FMCPUnixDomainSocket(int InDescriptor, const FString& InDescription, const FString& InPath = FString())
+            : FSocket(SOCKTYPE_Streaming, InDescription, NAME_None)
+            , Descriptor(InDescriptor)
+            , Path(InPath)
+        {
+#ifdef SO_NOSIGPIPE
+            int NoSigPipe = 1;
+            setsockopt(Descriptor, SOL_SOCKET, SO_NOSIGPIPE, &NoSigPipe, sizeof(NoSigPipe));
+#endif
+        }
+
+        virtual ~FMCPUnixDomainSocket()
+        {
+            Close();
+        }
+
+        virtual bool Shutdown(ESocketShutdownMode Mode) override
+        {
+            const int How = Mode == ESocketShutdownMode::Read ? SHUT_RD : Mode == ESocketShutdownMode::Write ? SHUT_WR : SHUT_RDWR;
+            return shutdown(Descriptor, How) == 0;
+        }
+
+        virtual bool Close() override
+        {
+            if (Descriptor < 0)
+            {
+                return false;
+            }
+            close(Descriptor);
+            Descriptor = -1;
+            // Only the listener has a path; the socket file goes with it
+            if (!Path.IsEmpty())
+            {
+                unlink(TCHAR_TO_UTF8(*Path));
+            }
+            return true;
+        }
+
+        virtual bool Bind(const FInternetAddr& Addr) override { return false; }
+        virtual bool Connect(const FInternetAddr& Addr) override { return false; }
+
+        virtual bool Listen(int32 MaxBacklog) override
+        {
+            return listen(Descriptor, MaxBacklog) == 0;
+        }
+
+        virtual bool WaitForPendingConnection(bool& bHasPendingConnection, const FTimespan& WaitTime) override
+        {
+            bHasPendingConnection = Poll(POLLIN, WaitTime);
+            return true;
+        }
+
+        virtual bool HasPendingConnection(bool& bHasPendingConnection) override
+        {
+            bHasPendingConnection = Poll(POLLIN, FTimespan::Zero());
+            return true;
+        }
+
+        virtual bool HasPendingData(uint32& PendingDataSize) override
+        {
+            int Available = 0;
+            PendingDataSize = 0;
+            if (ioctl(Descriptor, FIONREAD, &Available) != 0)
+            {
+                return false;
+            }
+            PendingDataSize = (uint32)Available;
+            return Available > 0;
+        }
+
+        virtual FSocket* Accept(const FString& InSocketDescription) override
+        {
+            const int Client = accept(Descriptor, nullptr, nullptr);
+            if (Client < 0)
+            {
+                return nullptr;
+            }
+            fcntl(Client, F_SETFD, FD_CLOEXEC);
+            return new FMCPUnixDomainSocket(Client, InSocketDescription);
+        }
+
+        virtual FSocket* Accept(FInternetAddr& OutAddr, const FString& InSocketDescription) override
+        {
+            return Accept(InSocketDescription);
+        }
+
+        virtual bool SendTo(const uint8* Data, int32 Count, int32& BytesSent, const FInternetAddr& Destination) override
+        {
+            return Send(Data, Count, BytesSent);
+        }
+
+        virtual bool Send(const uint8* Data, int32 Count, int32& BytesSent) override
+        {
+            const ssize_t Result = send(Descriptor, Data, Count, SendFlags);
+            BytesSent = Result >= 0 ? (int32)Result : 0;
+            return Result >= 0;
+        }
+
+        virtual bool RecvFrom(uint8* Data, int32 BufferSize, int32& BytesRead, FInternetAddr& Source, ESocketReceiveFlags::Type Flags) override
+        {
+            return Recv(Data, BufferSize, BytesRead, Flags);
+        }
+
+        virtual bool Recv(uint8* Data, int32 BufferSize, int32& BytesRead, ESocketReceiveFlags::Type Flags) override
+        {
+            const int RecvFlags = ((Flags & ESocketReceiveFlags::Peek) ? MSG_PEEK : 0) | ((Flags & ESocketReceiveFlags::WaitAll) ? MSG_WAITALL : 0);
+            const ssize_t Result = recv(Descriptor, Data, BufferSize, RecvFlags);
+            if (Result < 0)
+            {
+                // As with FSocketBSD, a read that would block is not a failure; nor is an interrupted one
+                BytesRead = 0;
+                return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+            }
+            BytesRead = (int32)Result;
+            // Zero bytes is an orderly shutdown by the peer
+            return Result > 0;
+        }
+
+        virtual bool Wait(ESocketWaitConditions::Type Condition, FTimespan WaitTime) override
+        {
+            const short Events = Condition == ESocketWaitConditions::WaitForRead ? POLLIN
+                : Condition == ESocketWaitConditions::WaitForWrite ? POLLOUT : (POLLIN | POLLOUT);
+            return Poll(Events, WaitTime);
+        }
+
+        virtual ESocketConnectionState GetConnectionState() override
+        {
+            return Descriptor >= 0 ? SCS_Connected : SCS_NotConnected;
+        }
+
+        virtual void GetAddress(FInternetAddr& OutAddr) override {}
+        virtual bool GetPeerAddress(FInternetAddr& OutAddr) override { return false; }
+
+        virtual bool SetNonBlocking(bool bIsNonBlocking) override
+        {
+            const int Flags = fcntl(Descriptor, F_GETFL, 0);
+            return Flags >= 0 && fcntl(Descriptor, F_SETFL, bIsNonBlocking ? (Flags | O_NONBLOCK) : (Flags & ~O_NONBLOCK)) == 0;
+        }
+
+        // Unix domain sockets have no Nagle delay to turn off, and no address to reuse
+        virtual bool SetNoDelay(bool bIsNoDelay) override { return true; }
+        virtual bool SetReuseAddr(bool bAllowReuse) override { return true; }
+
+        virtual bool SetBroadcast(bool bAllowBroadcast) override { return false; }
+        virtual bool JoinMulticastGroup(const FInternetAddr& GroupAddress) override { return false; }
+        virtual bool JoinMulticastGroup(const FInternetAddr& GroupAddress, const FInternetAddr& InterfaceAddress) override { return false; }
+        virtual bool LeaveMulticastGroup(const FInternetAddr& GroupAddress) override { return false; }
+        virtual bool LeaveMulticastGroup(const FInternetAddr& GroupAddress, const FInternetAddr& InterfaceAddress) override { return false; }
+        virtual bool SetMulticastLoopback(bool bLoopback) override { return false; }
+        virtual bool SetMulticastTtl(uint8 TimeToLive) override { return false; }
+        virtual bool SetMulticastInterface(const FInternetAddr& InterfaceAddress) override { return false; }
+        virtual bool SetRecvErr(bool bUseErrorQueue) override { return false; }
+
+        virtual bool SetLinger(bool bShouldLinger, int32 Timeout) override
+        {
+            linger Linger;
+            Linger.l_onoff = bShouldLinger ? 1 : 0;
+            Linger.l_linger = Timeout;
+            return setsockopt(Descriptor, SOL_SOCKET, SO_LINGER, &Linger, sizeof(Linger)) == 0;
+        }
+
+        virtual bool SetSendBufferSize(int32 Size, int32& NewSize) override
+        {
+            return SetBufferSize(SO_SNDBUF, Size, NewSize);
+        }
+
+        virtual bool SetReceiveBufferSize(int32 Size, int32& NewSize) override
+        {
+            return SetBufferSize(SO_RCVBUF, Size, NewSize);
+        }
+
+        virtual int32 GetPortNo() override { return 0; }
+
+    private:
+        bool Poll(short Events, const FTimespan& WaitTime)
+        {
+            pollfd Fd;
+            Fd.fd = Descriptor;
+            Fd.events = Events;
+            Fd.revents = 0;
+            // Errors and hangups also wake the caller, whose next call reports them.
+            // Negative times would make poll wait forever.
+            const int TimeoutMs = (int)FMath::Clamp(WaitTime.GetTotalMilliseconds(), 0.0, (double)MAX_int32);
+            return poll(&Fd, 1, TimeoutMs) > 0;
+        }
+
+        bool SetBufferSize(int Option, int32 Size, int32& NewSize)
+        {
+            const bool bSet = setsockopt(Descriptor, SOL_SOCKET, Option, &Size, sizeof(Size)) == 0;
+            socklen_t Length = sizeof(NewSize);
+            getsockopt(Descriptor, SOL_SOCKET, Option, &NewSize, &Length);
+            return bSet;
+        }
+
+        int Descriptor;
+        FString Path;
+    };
+}
+
+bool FMCPUnixSocket::IsSupported()
+{
+    return true;
+}
+
+TSharedPtr<FSocket> FMCPUnixSocket::Listen(const FString& Path, int32 MaxBacklog, FString& OutError)
+{
+    sockaddr_un Address;
+    if (!MakeAddress(Path, Address))
+    {
+        OutError = FString::Printf(TEXT("Unix socket path '%s' is empty or longer than %d bytes"), *Path, (int32)sizeof(Address.sun_path) - 1);
+        return nullptr;
+    }
+
+    const int Descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (Descriptor < 0)
+    {
+        OutError = FString::Printf(TEXT("Failed to create a Unix socket: %s"), *DescribeErrno());
+        return nullptr;
+    }
+    fcntl(Descriptor, F_SETFD, FD_CLOEXEC);
+
+    // Commands can edit the project; only this user may connect. The socket file
+    // is created owner-only by bind itself, so there is no window before a chmod
+    // in which another user could connect.
+    const mode_t PreviousMask = umask(S_IRWXG | S_IRWXO);
+    int BindResult = bind(Descriptor, reinterpret_cast<const sockaddr*>(&Address), sizeof(Address));
+    int BindError = BindResult != 0 ? errno : 0;
+    if (BindError == EADDRINUSE && IsStaleSocketFile(Address))
+    {
+        // Left behind by an editor that did not shut down cleanly
+        UE_LOG(LogUnrealMCP, Log, TEXT("MCPUnixSocket: Replacing stale socket file %s"), *Path);
+        unlink(Address.sun_path);
+        BindResult = bind(Descriptor, reinterpret_cast<const sockaddr*>(&Address), sizeof(Address));
+        BindError = BindResult != 0 ? errno : 0;
+    }
+    umask(PreviousMask);
+    if (BindResult != 0)
+    {
+        errno = BindError;
+        OutError = BindError == EADDRINUSE
+            ? FString::Printf(TEXT("Failed to bind Unix socket %s: the path is in use by a live server, by another user, or by a file that is not a socket"), *Path)
+            : FString::Printf(TEXT("Failed to bind Unix socket %s: %s"), *Path, *DescribeErrno());
+        close(Descriptor);
+        return nullptr;
+    }
+
+    TSharedPtr<FSocket> Listener = MakeShareable(new FMCPUnixDomainSocket(Descriptor, TEXT("UnrealMCPUnixListener"), Path));
+    if (!Listener->Listen(MaxBacklog))
+    {
+        OutError = FString::Printf(TEXT("Failed to listen on Unix socket %s: %s"), *Path, *DescribeErrno());
+        return nullptr;
+    }
+    return Listener;
+}
+
+#else
+
+bool FMCPUnixSocket::IsSupported()
+{
+    return false;
+}
+
+TSharedPtr<FSocket> FMCPUnixSocket::Listen(const FString& Path, int32 MaxBacklog, FString& OutError)
+{
+    OutError = TEXT("Unix domain sockets are only supported on Linux and Mac");
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,359 @@
+#include "MCPViewportStream.h"
+#include "MCPLog.h"
+#include "MCPClientConnection.h"
+#include "MCPWireProtocol.h"
+#include "Editor.h"
+#include "UnrealClient.h"
+#include "RHI.h"
+#include "Async/ParallelFor.h"
+#include "Misc/Compression.h"
+#include "Misc/ScopeExit.h"
+#include "HAL/PlatformTime.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "MCPTrace.h"
+
+namespace
+{
+    /** True if any row of the tile differs between the two frames */
+    bool TileChanged(const TArray<FColor>& Current, const TArray<FColor>& Previous, int32 Width, const FIntRect& Tile)
+    {
+        const int32 RowBytes = Tile.Width() * sizeof(FColor);
+        for (int32 Y = Tile.Min.Y; Y < Tile.Max.Y; ++Y)
+        {
+            const int32 RowStart = Y * Width + Tile.Min.X;
+            if (FMemory::Memcmp(Current.GetData() + RowStart, Previous.GetData() + RowStart, RowBytes) != 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /** Gather the tile's rows into one buffer and zlib-compress it */
+    bool CompressTile(const TArray<FColor>& Pixels, int32 Width, const FIntRect& Tile, TArray<uint8>& OutCompressed)
+    {
+        const int32 RowBytes = Tile.Width() * sizeof(FColor);
+        TArray<uint8> Raw;
+        Raw.SetNumUninitialized(RowBytes * Tile.Height());
+        for (int32 Y = Tile.Min.Y; Y < Tile.Max.Y; ++Y)
+        {
+            FMemory::Memcpy(Raw.GetData() + (Y - Tile.Min.Y) * RowBytes, Pixels.GetData() + Y * Width + Tile.Min.X, RowBytes);
+        }
+
+        int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, Raw.Num());
+        OutCompressed.SetNumUninitialized(CompressedSize);
+        if (!FCompression::CompressMemory(NAME_Zlib, OutCompressed.GetData(), CompressedSize, Raw.GetData(), Raw.Num(), COMPRESS_BiasSpeed))
+        {
+            return false;
+        }
+        OutCompressed.SetNum(CompressedSize, false);
+        return true;
+    }
+}
+
+FMCPViewportStream::FMCPViewportStream(int32 InStreamId, const FMCPViewportStreamSettings& InSettings,
+    const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe>& InConnection)
+    : StreamId(InStreamId)
+    , Settings(InSettings)
+    , Connection(InConnection)
+    , ConnectionKey(InConnection.Get())
+    , bActive(false)
+    , bCaptureInFlight(false)
+    , bKeyframeRequested(true)
+    , LastSentFrame(0)
+    , LastAckedFrame(0)
+    , PreviousSize(FIntPoint::ZeroValue)
+    , FramesSent(0)
+    , KeyframesSent(0)
+    , FramesUnchanged(0)
+    , FramesThrottled(0)
+    , TilesSent(0)
+    , TilesTotal(0)
+    , BytesSent(0)
+    , StartTime(0.0)
+{
+}
+
+FMCPViewportStream::~FMCPViewportStream()
+{
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+    }
+}
+
+void FMCPViewportStream::Start()
+{
+    check(IsInGameThread());
+
+    bActive = true;
+    StartTime = FPlatformTime::Seconds();
+
+    TWeakPtr<FMCPViewportStream, ESPMode::ThreadSafe> WeakThis = AsShared();
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([WeakThis](float DeltaTime)
+    {
+        TSharedPtr<FMCPViewportStream, ESPMode::ThreadSafe> This = WeakThis.Pin();
+        return This.IsValid() && This->Tick(DeltaTime);
+    }), 1.0f / FMath::Max(Settings.FrameRate, 0.1f));
+}
+
+void FMCPViewportStream::Stop(const FString& Reason, bool bNotifyClient)
+{
+    check(IsInGameThread());
+
+    const bool bWasActive = bActive.exchange(false);
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+
+    if (bWasActive && bNotifyClient)
+    {
+        TSharedRef<FJsonObject> Event = MakeShared<FJsonObject>();
+        Event->SetStringField(TEXT("event"), TEXT("viewport_stream_stopped"));
+        Event->SetNumberField(TEXT("stream_id"), StreamId);
+        Event->SetStringField(TEXT("reason"), Reason);
+        PushEvent(Event);
+    }
+
+    UE_LOG(LogUnrealMCP, Display, TEXT("MCPViewportStream: Stream %d stopped (%s) after %lld frames"), StreamId, *Reason, FramesSent.load());
+}
+
+void FMCPViewportStream::Acknowledge(int32 FrameIndex, bool bRequestKeyframe)
+{
+    const int32 Acked = FMath::Min(FrameIndex, LastSentFrame.load());
+    if (Acked > LastAckedFrame)
+    {
+        LastAckedFrame = Acked;
+    }
+    if (bRequestKeyframe)
+    {
+        bKeyframeRequested = true;
+    }
+}
+
+bool FMCPViewportStream::IsOwnedBy(const FMCPClientConnection* InConnection) const
+{
+    return ConnectionKey == InConnection;
+}
+
+bool FMCPViewportStream::Tick(float DeltaTime)
+{
+    if (!bActive)
+    {
+        return false;
+    }
+
+    TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe> PinnedConnection = Connection.Pin();
+    if (!PinnedConnection.IsValid() || PinnedConnection->IsClosed())
+    {
+        Stop(TEXT("connection closed"), false);
+        return false;
+    }
+
+    if (bCaptureInFlight)
+    {
+        return true;
+    }
+
+    // Backpressure: wait for acknowledgements and for the socket to drain
+    if (LastSentFrame - LastAckedFrame >= Settings.MaxInFlightFrames ||
+        PinnedConnection->GetPendingPushBytes() > Settings.MaxPendingBytes)
+    {
+        ++FramesThrottled;
+        return true;
+    }
+
+    FViewport* Viewport = GEditor ? GEditor->GetActiveViewport() : nullptr;
+    if (!Viewport && !Settings.Capture.bOffscreen && !GUsingNullRHI)
+    {
+        return true;
+    }
+
+    bCaptureInFlight = true;
+    TWeakPtr<FMCPViewportStream, ESPMode::ThreadSafe> WeakThis = AsShared();
+    FMCPScreenshotCapture::CaptureRawAsync(Viewport, Settings.Capture).Next([WeakThis](FMCPRawCapture Capture)
+    {
+        if (TSharedPtr<FMCPViewportStream, ESPMode::ThreadSafe> This = WeakThis.Pin())
+        {
+            This->EncodeAndPush(MoveTemp(Capture));
+        }
+    });
+
+    return true;
+}
+
+void FMCPViewportStream::EncodeAndPush(FMCPRawCapture&& Capture)
+{
+    ON_SCOPE_EXIT
+    {
+        bCaptureInFlight = false;
+    };
+
+    if (!bActive)
+    {
+        return;
+    }
+
+    if (!Capture.bSuccess)
+    {
+        // The ticker notices on its next tick and unregisters itself
+        bActive = false;
+        TSharedRef<FJsonObject> Event = MakeShared<FJsonObject>();
+        Event->SetStringField(TEXT("event"), TEXT("viewport_stream_stopped"));
+        Event->SetNumberField(TEXT("stream_id"), StreamId);
+        Event->SetStringField(TEXT("reason"), Capture.Error);
+        PushEvent(Event);
+        return;
+    }
+
+    const double EncodeStart = FPlatformTime::Seconds();
+    const FIntPoint Size = Capture.OutputSize;
+    const int32 TileSize = Settings.TileSize;
+    const bool bKeyframe = bKeyframeRequested.exchange(false) || Size != PreviousSize || PreviousFrame.Num() != Capture.Pixels.Num();
+
+    TArray<FIntRect> ChangedTiles;
+    int32 TileCount = 0;
+    for (int32 TileY = 0; TileY < Size.Y; TileY += TileSize)
+    {
+        for (int32 TileX = 0; TileX < Size.X; TileX += TileSize)
+        {
+            const FIntRect Tile(TileX, TileY, FMath::Min(TileX + TileSize, Size.X), FMath::Min(TileY + TileSize, Size.Y));
+            ++TileCount;
+            if (bKeyframe || TileChanged(Capture.Pixels, PreviousFrame, Size.X, Tile))
+            {
+                ChangedTiles.Add(Tile);
+            }
+        }
+    }
+
+    if (ChangedTiles.Num() == 0)
+    {
+        ++FramesUnchanged;
+        return;
+    }
+
+    TArray<TArray<uint8>> CompressedTiles;
+    CompressedTiles.SetNum(ChangedTiles.Num());
+    std::atomic<bool> bCompressionFailed(false);
+    ParallelFor(ChangedTiles.Num(), [&](int32 Index)
+    {
+        if (!CompressTile(Capture.Pixels, Size.X, ChangedTiles[Index], CompressedTiles[Index]))
+        {
+            bCompressionFailed = true;
+        }
+    });
+    if (bCompressionFailed)
+    {
+        UE_LOG(LogUnrealMCP, Warning, TEXT("MCPViewportStream: Failed to compress tiles for stream %d"), StreamId);
+        bKeyframeRequested = true;
+        return;
+    }
+
+    TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe> PinnedConnection = Connection.Pin();
+    if (!PinnedConnection.IsValid())
+    {
+        return;
+    }
+
+    // Header lists [x, y, width, height, offset, length] per tile; the payload holds the compressed tiles back to back
+    const int32 FrameIndex = LastSentFrame + 1;
+    TArray<uint8> Payload;
+    TArray<TSharedPtr<FJsonValue>> TileArray;
+    for (int32 Index = 0; Index < ChangedTiles.Num(); ++Index)
+    {
+        const FIntRect& Tile = ChangedTiles[Index];
+        TArray<TSharedPtr<FJsonValue>> Entry;
+        Entry.Add(MakeShared<FJsonValueNumber>(Tile.Min.X));
+        Entry.Add(MakeShared<FJsonValueNumber>(Tile.Min.Y));
+        Entry.Add(MakeShared<FJsonValueNumber>(Tile.Width()));
+        Entry.Add(MakeShared<FJsonValueNumber>(Tile.Height()));
+        Entry.Add(MakeShared<FJsonValueNumber>(Payload.Num()));
+        Entry.Add(MakeShared<FJsonValueNumber>(CompressedTiles[Index].Num()));
+        TileArray.Add(MakeShared<FJsonValueArray>(Entry));
+        Payload.Append(CompressedTiles[Index]);
+    }
+
+    TSharedRef<FJsonObject> Header = MakeShared<FJsonObject>();
+    Header->SetStringField(TEXT("event"), TEXT("viewport_frame"));
+    Header->SetNumberField(TEXT("stream_id"), StreamId);
+    Header->SetNumberField(TEXT("frame"), FrameIndex);
+    Header->SetNumberField(TEXT("width"), Size.X);
+    Header->SetNumberField(TEXT("height"), Size.Y);
+    Header->SetNumberField(TEXT("tile_size"), TileSize);
+    Header->SetBoolField(TEXT("keyframe"), bKeyframe);
+    Header->SetStringField(TEXT("encoding"), TEXT("zlib_bgra"));
+    Header->SetStringField(TEXT("source"), Capture.Source);
+    Header->SetBoolField(TEXT("placeholder"), Capture.bPlaceholder);
+    Header->SetNumberField(TEXT("changed_tiles"), ChangedTiles.Num());
+    Header->SetNumberField(TEXT("total_tiles"), TileCount);
+    Header->SetNumberField(TEXT("readback_ms"), Capture.ReadbackMs);
+    Header->SetNumberField(TEXT("encode_ms"), (FPlatformTime::Seconds() - EncodeStart) * 1000.0);
+    Header->SetArrayField(TEXT("tiles"), TileArray);
+
+    FString HeaderText;
+    MCP_TRACE_SCOPE("MCP SerializeStreamFrame");
+    TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&HeaderText);
+    FJsonSerializer::Serialize(Header, Writer);
+    FTCHARToUTF8 Utf8Header(*HeaderText);
+    TArray<uint8> HeaderBytes(reinterpret_cast<const uint8*>(Utf8Header.Get()), Utf8Header.Length());
+
+    TArray<uint8> FrameBytes;
+    FMCPWireProtocol::EncodeFrame(HeaderBytes, Payload.GetData(), Payload.Num(), EMCPFrameEncoding::Json, FrameBytes);
+    const int32 FrameSize = FrameBytes.Num();
+    if (!bActive || !PinnedConnection->EnqueuePush(MoveTemp(FrameBytes)))
+    {
+        return;
+    }
+
+    LastSentFrame = FrameIndex;
+    ++FramesSent;
+    if (bKeyframe)
+    {
+        ++KeyframesSent;
+    }
+    TilesSent += ChangedTiles.Num();
+    TilesTotal += TileCount;
+    BytesSent += FrameSize;
+
+    PreviousFrame = MoveTemp(Capture.Pixels);
+    PreviousSize = Size;
+}
+
+void FMCPViewportStream::PushEvent(const TSharedRef<FJsonObject>& Event)
+{
+    TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe> PinnedConnection = Connection.Pin();
+    if (!PinnedConnection.IsValid())
+    {
+        return;
+    }
+
+    FString EventText;
+    TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&EventText);
+    FJsonSerializer::Serialize(Event, Writer);
+    FTCHARToUTF8 Utf8Event(*EventText);
+    PinnedConnection->EnqueuePush(TArray<uint8>(reinterpret_cast<const uint8*>(Utf8Event.Get()), Utf8Event.Length()));
+}
+
+TSharedPtr<FJsonObject> FMCPViewportStream::GetStats() const
+{
+    const double Elapsed = StartTime > 0.0 ? FPlatformTime::Seconds() - StartTime : 0.0;
+
+    TSharedPtr<FJsonObject> Stats = MakeShared<FJsonObject>();
+    Stats->SetNumberField(TEXT("stream_id"), StreamId);
+    Stats->SetBoolField(TEXT("active"), bActive);
+    Stats->SetNumberField(TEXT("frames_sent"), (double)FramesSent.load());
+    Stats->SetNumberField(TEXT("keyframes_sent"), (double)KeyframesSent.load());
+    Stats->SetNumberField(TEXT("frames_unchanged"), (double)FramesUnchanged.load());
+    Stats->SetNumberField(TEXT("frames_throttled"), (double)FramesThrottled.load());
+    Stats->SetNumberField(TEXT("tiles_sent"), (double)TilesSent.load());
+    Stats->SetNumberField(TEXT("tiles_total"), (double)TilesTotal.load());
+    Stats->SetNumberField(TEXT("bytes_sent"), (double)BytesSent.load());
+    Stats->SetNumberField(TEXT("last_sent_frame"), LastSentFrame.load());
+    Stats->SetNumberField(TEXT("last_acked_frame"), LastAckedFrame.load());
+    Stats->SetNumberField(TEXT("elapsed_seconds"), Elapsed);
+    Stats->SetNumberField(TEXT("fps"), Elapsed > 0.0 ? FramesSent.load() / Elapsed : 0.0);
+    return Stats;
+}
@@ -0,0 +1,278 @@
+#include "MCPWireProtocol.h"
+#include "MCPMessagePack.h"
+
+namespace
+{
+    void WriteUInt32LE(uint8* Dest, uint32 Value)
+    {
+        Dest[0] = (uint8)(Value & 0xFF);
+        Dest[1] = (uint8)((Value >> 8) & 0xFF);
+        Dest[2] = (uint8)((Value >> 16) & 0xFF);
+        Dest[3] = (uint8)((Value >> 24) & 0xFF);
+    }
+
+    uint32 ReadUInt32LE(const uint8* Src)
+    {
+        return (uint32)Src[0] | ((uint32)Src[1] << 8) | ((uint32)Src[2] << 16) | ((uint32)Src[3] << 24);
+    }
+
+    bool IsJsonWhitespace(uint8 Byte)
+    {
+        return Byte == ' ' || Byte == '\t' || Byte == '\r' || Byte == '\n';
+    }
+
+    /**
+     * Length of the JSON object at the start of the buffer, or INDEX_NONE if it is not
+     * complete yet. Scanning resumes from the state left by the previous call.
+     */
+    int32 FindJsonObjectEnd(const uint8* Data, int32 Num, FMCPJsonScanState& Scan)
+    {
+        for (int32 Index = Scan.Scanned; Index < Num; ++Index)
+        {
+            const uint8 Byte = Data[Index];
+            if (Scan.bInString)
+            {
+                if (Scan.bEscaped)
+                {
+                    Scan.bEscaped = false;
+                }
+                else if (Byte == '\\')
+                {
+                    Scan.bEscaped = true;
+                }
+                else if (Byte == '"')
+                {
+                    Scan.bInString = false;
+                }
+            }
+            else if (Byte == '"')
+            {
+                Scan.bInString = true;
+            }
+            else if (Byte == '{')
+            {
+                ++Scan.Depth;
+            }
+            else if (Byte == '}' && --Scan.Depth == 0)
+            {
+                Scan.Reset();
+                return Index + 1;
+            }
+        }
+        Scan.Scanned = Num;
+        return INDEX_NONE;
+    }
+}
+
+bool FMCPWireProtocol::IsFrame(const uint8* Data, int32 Num)
+{
+    return Num >= 4
+        && Data[0] == MCP_FRAME_MAGIC_0
+        && Data[1] == MCP_FRAME_MAGIC_1
+        && Data[2] == MCP_FRAME_MAGIC_2
+        && Data[3] == MCP_FRAME_MAGIC_3;
+}
+
+EMCPReadResult FMCPWireProtocol::ReadMessage(const TArray<uint8>& Buffer, int32& InOutOffset, FMCPJsonScanState& InOutScan, FMCPIncomingMessage& OutMessage,
+    FString& OutError)
+{
+    // Whitespace between messages is consumed even if no message follows yet
+    while (InOutOffset < Buffer.Num() && IsJsonWhitespace(Buffer[InOutOffset]))
+    {
+        ++InOutOffset;
+    }
+    const uint8* Data = Buffer.GetData() + InOutOffset;
+    const int32 Available = Buffer.Num() - InOutOffset;
+    if (Available <= 0)
+    {
+        return EMCPReadResult::Incomplete;
+    }
+
+    if (Data[0] == '{')
+    {
+        const int32 Length = FindJsonObjectEnd(Data, Available, InOutScan);
+        if (Length == INDEX_NONE)
+        {
+            if (Available > MCP_MAX_MESSAGE_SIZE)
+            {
+                OutError = TEXT("JSON message exceeds the maximum message size");
+                return EMCPReadResult::Malformed;
+            }
+            return EMCPReadResult::Incomplete;
+        }
+
+        OutMessage.Json = TArray<uint8>(Data, Length);
+        OutMessage.Attachment.Reset();
+        OutMessage.Encoding = EMCPFrameEncoding::Json;
+        OutMessage.Flags = 0;
+        InOutOffset += Length;
+        return EMCPReadResult::Message;
+    }
+
+    if (Data[0] == MCP_FRAME_MAGIC_0)
+    {
+        if (Available < MCP_FRAME_HEADER_SIZE)
+        {
+            return EMCPReadResult::Incomplete;
+        }
+
+        const uint8* Prefix = Data;
+        if (!IsFrame(Prefix, Available) || Prefix[4] != MCP_FRAME_VERSION)
+        {
+            OutError = TEXT("Invalid frame prefix");
+            return EMCPReadResult::Malformed;
+        }
+
+        const uint64 HeaderSize = ReadUInt32LE(Prefix + 8);
+        const uint64 PayloadSize = ReadUInt32LE(Prefix + 12);
+        const uint64 TotalSize = MCP_FRAME_HEADER_SIZE + HeaderSize + PayloadSize;
+        if (TotalSize > MCP_MAX_MESSAGE_SIZE)
+        {
+            OutError = TEXT("Frame exceeds the maximum message size");
+            return EMCPReadResult::Malformed;
+        }
+        if ((uint64)Available < TotalSize)
+        {
+            return EMCPReadResult::Incomplete;
+        }
+
+        OutMessage.Encoding = (EMCPFrameEncoding)Prefix[5];
+        OutMessage.Flags = (uint16)(Prefix[6] | (Prefix[7] << 8));
+        OutMessage.Json = TArray<uint8>(Prefix + MCP_FRAME_HEADER_SIZE, (int32)HeaderSize);
+        OutMessage.Attachment = TArray<uint8>(Prefix + MCP_FRAME_HEADER_SIZE + HeaderSize, (int32)PayloadSize);
+        InOutOffset += (int32)TotalSize;
+        return EMCPReadResult::Message;
+    }
+
+    OutError = FString::Printf(TEXT("Unexpected byte 0x%02X at start of message"), Data[0]);
+    return EMCPReadResult::Malformed;
+}
+
+void FMCPWireProtocol::AppendField(FMCPResponse& Response, const TCHAR* Name, const FString& RawJson)
+{
+    if (Response.Encoding == EMCPFrameEncoding::MessagePack)
+    {
+        // Fields are small; parsing them again is cheaper than a second envelope path
+        TSharedPtr<FJsonValue> Value;
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(RawJson);
+        if (FJsonSerializer::Deserialize(Reader, Value) && Value.IsValid())
+        {
+            FMCPMessagePack::AppendField(Response.PackedBody, Name, Value);
+        }
+        return;
+    }
+
+    // The envelope is a serialized object; reopen it rather than parse it again
+    int32 CloseIndex = INDEX_NONE;
+    if (!Response.Body.FindLastChar(TEXT('}'), CloseIndex))
+    {
+        return;
+    }
+    Response.Body.LeftInline(CloseIndex);
+    Response.Body += FString::Printf(TEXT(",\"%s\":%s}"), Name, *RawJson);
+}
+
+void FMCPWireProtocol::AppendTiming(FMCPResponse& Response)
+{
+    AppendField(Response, TEXT("timing"), FString::Printf(TEXT("{\"request_id\":%llu,\"queue_ms\":%.3f,\"execute_ms\":%.3f}"),
+        Response.RequestId,
+        FMCPRequestTiming::Seconds(Response.Timing.DispatchCycle, Response.Timing.StartCycle) * 1000.0,
+        FMCPRequestTiming::Seconds(Response.Timing.StartCycle, Response.Timing.EndCycle) * 1000.0));
+}
+
+void FMCPWireProtocol::AppendClientId(FMCPResponse& Response, const TSharedPtr<FJsonValue>& Id)
+{
+    if (!Id.IsValid() || Id->IsNull())
+    {
+        return;
+    }
+    if (Response.Encoding == EMCPFrameEncoding::MessagePack)
+    {
+        FMCPMessagePack::AppendField(Response.PackedBody, TEXT("id"), Id);
+        return;
+    }
+
+    FString RawId;
+    TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&RawId);
+    if (FJsonSerializer::Serialize(Id, FString(), Writer))
+    {
+        AppendField(Response, TEXT("id"), RawId);
+    }
+}
+
+bool FMCPWireProtocol::ParseMessage(const FMCPIncomingMessage& Message, TSharedPtr<FJsonObject>& OutObject, FString& OutError)
+{
+    if (Message.Encoding == EMCPFrameEncoding::MessagePack)
+    {
+        return FMCPMessagePack::Read(Message.Json.GetData(), Message.Json.Num(), OutObject, OutError);
+    }
+    if (Message.Encoding != EMCPFrameEncoding::Json)
+    {
+        OutError = FString::Printf(TEXT("Unknown frame encoding %d"), (int32)Message.Encoding);
+        return false;
+    }
+
+    const FString Text = FString(FUTF8ToTCHAR(reinterpret_cast<const ANSICHAR*>(Message.Json.GetData()), Message.Json.Num()));
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Text);
+    if (!FJsonSerializer::Deserialize(Reader, OutObject) || !OutObject.IsValid())
+    {
+        OutError = Reader->GetErrorMessage();
+        return false;
+    }
+    return true;
+}
+
+FString FMCPWireProtocol::DescribeResponse(const FMCPResponse& Response)
+{
+    return Response.Encoding == EMCPFrameEncoding::MessagePack ? FMCPMessagePack::ToJsonString(Response.PackedBody) : Response.Body;
+}
+
+void FMCPWireProtocol::EncodeResponse(const FMCPResponse& Response, TArray<uint8>& OutBytes, const TArray<uint8>* SharedDescriptor)
+{
+    const TArray<uint8>& Payload = SharedDescriptor ? *SharedDescriptor : Response.Attachment;
+    const uint16 Flags = SharedDescriptor ? MCP_FRAME_FLAG_SHARED_PAYLOAD : 0;
+
+    if (Response.Encoding == EMCPFrameEncoding::MessagePack)
+    {
+        EncodeFrame(Response.PackedBody, Payload.GetData(), Payload.Num(), EMCPFrameEncoding::MessagePack, OutBytes, Flags);
+        return;
+    }
+
+    FTCHARToUTF8 Utf8Body(*Response.Body);
+
+    if (Payload.Num() == 0)
+    {
+        OutBytes.Reset(Utf8Body.Length());
+        OutBytes.Append(reinterpret_cast<const uint8*>(Utf8Body.Get()), Utf8Body.Length());
+        return;
+    }
+
+    TArray<uint8> Header;
+    Header.Append(reinterpret_cast<const uint8*>(Utf8Body.Get()), Utf8Body.Length());
+    EncodeFrame(Header, Payload.GetData(), Payload.Num(), EMCPFrameEncoding::Json, OutBytes, Flags);
+}
+
+void FMCPWireProtocol::EncodeFrame(const TArray<uint8>& Header, const uint8* Payload, int32 PayloadSize, EMCPFrameEncoding Encoding, TArray<uint8>& OutBytes,
+    uint16 Flags)
+{
+    OutBytes.Reset(MCP_FRAME_HEADER_SIZE + Header.Num() + PayloadSize);
+    OutBytes.AddZeroed(MCP_FRAME_HEADER_SIZE);
+
+    uint8* Prefix = OutBytes.GetData();
+    Prefix[0] = MCP_FRAME_MAGIC_0;
+    Prefix[1] = MCP_FRAME_MAGIC_1;
+    Prefix[2] = MCP_FRAME_MAGIC_2;
+    Prefix[3] = MCP_FRAME_MAGIC_3;
+    Prefix[4] = MCP_FRAME_VERSION;
+    Prefix[5] = (uint8)Encoding;
+    Prefix[6] = (uint8)(Flags & 0xFF);
+    Prefix[7] = (uint8)(Flags >> 8);
+    WriteUInt32LE(Prefix + 8, (uint32)Header.Num());
+    WriteUInt32LE(Prefix + 12, (uint32)PayloadSize);
+
+    OutBytes.Append(Header);
+    if (PayloadSize > 0)
+    {
+        OutBytes.Append(Payload, PayloadSize);
+    }
+}
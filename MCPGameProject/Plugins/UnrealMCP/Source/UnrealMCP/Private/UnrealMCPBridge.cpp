@@ -1,5 +1,18 @@
 #include "UnrealMCPBridge.h"
 #include "MCPServerRunnable.h"
+#include "MCPClientConnection.h"
+#include "MCPRequestContext.h"
+#include "MCPEditBatch.h"
+#include "MCPFakeWorld.h"
+#include "MCPMessagePack.h"
+#include "MCPUnixSocket.h"
+#include "MCPTrace.h"
+#include "MCPLog.h"
+#include "Editor.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+#include "Misc/ConfigCacheIni.h"
 #include "Sockets.h"
 #include "SocketSubsystem.h"
 #include "HAL/RunnableThread.h"
@@ -63,6 +76,48 @@
 #define MCP_SERVER_HOST "127.0.0.1"
 #define MCP_SERVER_PORT 55557
 
+namespace
+{
+    UUnrealMCPBridge* GetEditorBridge()
+    {
+        return GEditor ? GEditor->GetEditorSubsystem<UUnrealMCPBridge>() : nullptr;
+    }
+
+    FString GetDefaultJournalPath()
+    {
+        return FPaths::ProjectSavedDir() / TEXT("MCP") / FString::Printf(TEXT("Journal-%s.mcpj"), *FDateTime::Now().ToString());
+    }
+
+    FAutoConsoleCommand JournalStartCommand(
+        TEXT("UnrealMCP.Journal.Start"),
+        TEXT("Record MCP requests and responses to a binary journal. Usage: UnrealMCP.Journal.Start [Path]"),
+        FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+        {
+            UUnrealMCPBridge* Bridge = GetEditorBridge();
+            if (!Bridge)
+            {
+                return;
+            }
+            const FString Path = Args.Num() > 0 ? Args[0] : GetDefaultJournalPath();
+            FString Error;
+            if (!Bridge->StartJournal(Path, Error))
+            {
+                UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPBridge: %s"), *Error);
+            }
+        }));
+
+    FAutoConsoleCommand JournalStopCommand(
+        TEXT("UnrealMCP.Journal.Stop"),
+        TEXT("Stop recording the MCP request journal"),
+        FConsoleCommandDelegate::CreateLambda([]()
+        {
+            if (UUnrealMCPBridge* Bridge = GetEditorBridge())
+            {
+                Bridge->StopJournal();
+            }
+        }));
+}
+
 UUnrealMCPBridge::UUnrealMCPBridge()
 {
     EditorCommands = MakeShared<FUnrealMCPEditorCommands>();
@@ -71,6 +126,7 @@ UUnrealMCPBridge::UUnrealMCPBridge()
     ProjectCommands = MakeShared<FUnrealMCPProjectCommands>();
     UMGCommands = MakeShared<FUnrealMCPUMGCommands>();
     BlueprintIntrospection = MakeShared<FUnrealMCPBlueprintIntrospection>();
+    bTransactionHasOwner = false;
 }
 
 UUnrealMCPBridge::~UUnrealMCPBridge()
@@ -86,7 +142,7 @@ UUnrealMCPBridge::~UUnrealMCPBridge()
 // Initialize subsystem
 void UUnrealMCPBridge::Initialize(FSubsystemCollectionBase& Collection)
 {
-    UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Initializing"));
+    UE_LOG(LogUnrealMCP, Log, TEXT("UnrealMCPBridge: Initializing"));
     
     bIsRunning = false;
     ListenerSocket = nullptr;
@@ -94,6 +150,27 @@ void UUnrealMCPBridge::Initialize(FSubsystemCollectionBase& Collection)
     ServerThread = nullptr;
     Port = MCP_SERVER_PORT;
     FIPv4Address::Parse(MCP_SERVER_HOST, ServerAddress);
+    
+    // Allow several hosts side by side, e.g. a real and a fake world under benchmark
+    FParse::Value(FCommandLine::Get(), TEXT("MCPPort="), Port);
+
+    // Optional Unix domain socket for local clients: [UnrealMCP] UnixSocketPath in the
+    // editor ini, or -MCPUnixSocket= on the command line
+    UnixSocketPath.Reset();
+    GConfig->GetString(TEXT("UnrealMCP"), TEXT("UnixSocketPath"), UnixSocketPath, GEditorIni);
+    FParse::Value(FCommandLine::Get(), TEXT("MCPUnixSocket="), UnixSocketPath);
+
+    FString JournalPath;
+    if (FParse::Value(FCommandLine::Get(), TEXT("MCPJournal="), JournalPath))
+    {
+        FString Error;
+        if (!StartJournal(JournalPath, Error))
+        {
+            UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPBridge: %s"), *Error);
+        }
+    }
+
+    ChangeFeed = MakeUnique<FMCPChangeFeed>();
 
     // Start the server automatically
     StartServer();
@@ -102,8 +179,16 @@ void UUnrealMCPBridge::Initialize(FSubsystemCollectionBase& Collection)
 // Clean up resources when subsystem is destroyed
 void UUnrealMCPBridge::Deinitialize()
 {
-    UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Shutting down"));
+    UE_LOG(LogUnrealMCP, Log, TEXT("UnrealMCPBridge: Shutting down"));
     StopServer();
+    StopJournal();
+    ChangeFeed.Reset();
+    
+    // Keep edits made in a transaction that was never closed
+    if (OpenTransaction.IsValid())
+    {
+        HandleEndTransaction(true);
+    }
 }
 
 // Start the MCP server
@@ -111,7 +196,7 @@ void UUnrealMCPBridge::StartServer()
 {
     if (bIsRunning)
     {
-        UE_LOG(LogTemp, Warning, TEXT("UnrealMCPBridge: Server is already running"));
+        UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPBridge: Server is already running"));
         return;
     }
 
@@ -119,7 +204,7 @@ void UUnrealMCPBridge::StartServer()
     ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
     if (!SocketSubsystem)
     {
-        UE_LOG(LogTemp, Error, TEXT("UnrealMCPBridge: Failed to get socket subsystem"));
+        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPBridge: Failed to get socket subsystem"));
         return;
     }
 
@@ -127,7 +212,7 @@ void UUnrealMCPBridge::StartServer()
     TSharedPtr<FSocket> NewListenerSocket = MakeShareable(SocketSubsystem->CreateSocket(NAME_Stream, TEXT("UnrealMCPListener"), false));
     if (!NewListenerSocket.IsValid())
     {
-        UE_LOG(LogTemp, Error, TEXT("UnrealMCPBridge: Failed to create listener socket"));
+        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPBridge: Failed to create listener socket"));
         return;
     }
 
@@ -139,31 +224,51 @@ void UUnrealMCPBridge::StartServer()
     FIPv4Endpoint Endpoint(ServerAddress, Port);
     if (!NewListenerSocket->Bind(*Endpoint.ToInternetAddr()))
     {
-        UE_LOG(LogTemp, Error, TEXT("UnrealMCPBridge: Failed to bind listener socket to %s:%d"), *ServerAddress.ToString(), Port);
+        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPBridge: Failed to bind listener socket to %s:%d"), *ServerAddress.ToString(), Port);
         return;
     }
 
     // Start listening
     if (!NewListenerSocket->Listen(5))
     {
-        UE_LOG(LogTemp, Error, TEXT("UnrealMCPBridge: Failed to start listening"));
+        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPBridge: Failed to start listening"));
         return;
     }
 
     ListenerSocket = NewListenerSocket;
     bIsRunning = true;
-    UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Server started on %s:%d"), *ServerAddress.ToString(), Port);
+    UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPBridge: Server started on %s:%d"), *ServerAddress.ToString(), Port);
+
+    TArray<TSharedPtr<FSocket>> Listeners;
+    Listeners.Add(ListenerSocket);
+
+    // The Unix domain socket is an extra; TCP keeps working without it
+    if (!UnixSocketPath.IsEmpty())
+    {
+        FString Error;
+        UnixListenerSocket = FMCPUnixSocket::Listen(UnixSocketPath, 5, Error);
+        if (UnixListenerSocket.IsValid())
+        {
+            UnixListenerSocket->SetNonBlocking(true);
+            Listeners.Add(UnixListenerSocket);
+            UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPBridge: Also listening on Unix socket %s"), *UnixSocketPath);
+        }
+        else
+        {
+            UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPBridge: %s"), *Error);
+        }
+    }
 
     // Start server thread
     ServerThread = FRunnableThread::Create(
-        new FMCPServerRunnable(this, ListenerSocket),
+        new FMCPServerRunnable(this, Listeners),
         TEXT("UnrealMCPServerThread"),
         0, TPri_Normal
     );
 
     if (!ServerThread)
     {
-        UE_LOG(LogTemp, Error, TEXT("UnrealMCPBridge: Failed to create server thread"));
+        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPBridge: Failed to create server thread"));
         StopServer();
         return;
     }
@@ -200,142 +305,717 @@ void UUnrealMCPBridge::StopServer()
         ListenerSocket.Reset();
     }
 
-    UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Server stopped"));
+    // Not created by the socket subsystem; closing it also removes the socket file
+    if (UnixListenerSocket.IsValid())
+    {
+        UnixListenerSocket->Close();
+        UnixListenerSocket.Reset();
+    }
+
+    UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPBridge: Server stopped"));
+}
+
+bool UUnrealMCPBridge::StartJournal(const FString& Path, FString& OutError)
+{
+    TSharedPtr<FMCPRequestJournal, ESPMode::ThreadSafe> NewJournal = FMCPRequestJournal::Open(Path, OutError);
+    if (!NewJournal.IsValid())
+    {
+        return false;
+    }
+    TSharedPtr<FMCPRequestJournal, ESPMode::ThreadSafe> OldJournal;
+    {
+        FScopeLock ScopeLock(&JournalLock);
+        OldJournal = MoveTemp(Journal);
+        Journal = NewJournal;
+    }
+    if (OldJournal.IsValid())
+    {
+        OldJournal->Close();
+    }
+    return true;
+}
+
+void UUnrealMCPBridge::StopJournal()
+{
+    TSharedPtr<FMCPRequestJournal, ESPMode::ThreadSafe> OldJournal;
+    {
+        FScopeLock ScopeLock(&JournalLock);
+        OldJournal = MoveTemp(Journal);
+    }
+    // Connection threads may still hold it; they stop writing once it is closed
+    if (OldJournal.IsValid())
+    {
+        OldJournal->Close();
+    }
+}
+
+TSharedPtr<FMCPRequestJournal, ESPMode::ThreadSafe> UUnrealMCPBridge::GetJournal() const
+{
+    FScopeLock ScopeLock(&JournalLock);
+    return Journal;
+}
+
+void UUnrealMCPBridge::SetFakeWorld(const TSharedPtr<FMCPFakeWorld>& InFakeWorld)
+{
+    check(IsInGameThread());
+    FakeWorld = InFakeWorld;
 }
 
 // Execute a command received from a client
 FString UUnrealMCPBridge::ExecuteCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
 {
-    UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Executing command: %s"), *CommandType);
+    return ExecuteCommandWithAttachment(CommandType, Params).Body;
+}
+
+FMCPResponse UUnrealMCPBridge::ExecuteCommandWithAttachment(const FString& CommandType, const TSharedPtr<FJsonObject>& Params,
+    const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe>& Connection, TArray<uint8> RequestAttachment, uint64 RequestId,
+    EMCPFrameEncoding Encoding)
+{
+    if (RequestId == 0)
+    {
+        RequestId = FMCPRequestContext::AllocateRequestId();
+    }
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("UnrealMCPBridge: Executing command #%llu: %s"), RequestId, *CommandType);
     
-    // Create a promise to wait for the result
-    TPromise<FString> Promise;
-    TFuture<FString> Future = Promise.GetFuture();
+    // Stats and revisions are thread safe; answer without waiting for a possibly busy game thread
+    if (CommandType == TEXT("get_server_stats") || CommandType == TEXT("get_revisions"))
+    {
+        const uint64 StatsStartCycle = FPlatformTime::Cycles64();
+        FMCPResponse Response = BuildResponse(FMCPCommandResult(
+            CommandType == TEXT("get_revisions") ? HandleGetRevisions() : HandleGetServerStats(Params)), Encoding);
+        Response.Timing.DispatchCycle = StatsStartCycle;
+        Response.Timing.StartCycle = StatsStartCycle;
+        Response.Timing.EndCycle = FPlatformTime::Cycles64();
+        Response.RequestId = RequestId;
+        return Response;
+    }
+    
+    // The shared memory channel belongs to the connection thread, which is the one calling
+    if (CommandType == TEXT("open_shared_memory"))
+    {
+        const uint64 OpenStartCycle = FPlatformTime::Cycles64();
+        FMCPResponse Response = BuildResponse(FMCPCommandResult(HandleOpenSharedMemory(Params, Connection)), Encoding);
+        Response.Timing.DispatchCycle = OpenStartCycle;
+        Response.Timing.StartCycle = OpenStartCycle;
+        Response.Timing.EndCycle = FPlatformTime::Cycles64();
+        Response.RequestId = RequestId;
+        return Response;
+    }
+    
+    // Create a promise to wait for the result. It is shared so async handlers
+    // can fulfil it from a worker thread after the game thread task returns.
+    TSharedRef<TPromise<FMCPResponse>, ESPMode::ThreadSafe> Promise = MakeShared<TPromise<FMCPResponse>, ESPMode::ThreadSafe>();
+    TFuture<FMCPResponse> Future = Promise->GetFuture();
+    const uint64 QueuedCycle = FPlatformTime::Cycles64();
     
     // Queue execution on Game Thread
-    AsyncTask(ENamedThreads::GameThread, [this, CommandType, Params, Promise = MoveTemp(Promise)]() mutable
+    AsyncTask(ENamedThreads::GameThread, [this, CommandType, Params, Promise, Connection, QueuedCycle, RequestId, Encoding, RequestAttachment = MoveTemp(RequestAttachment)]() mutable
     {
-        TSharedPtr<FJsonObject> ResponseJson = MakeShareable(new FJsonObject);
+        MCP_TRACE_SCOPE("MCP ExecuteCommand");
+        const uint64 StartCycle = FPlatformTime::Cycles64();
+        FMCPRequestContext Context;
+        Context.RequestId = RequestId;
+        Context.Connection = Connection;
+        Context.RequestAttachment = MoveTemp(RequestAttachment);
+        FMCPRequestContext::FScope ContextScope(Context);
         
-        try
+        // Commands that start on the game thread and complete elsewhere
+        TFuture<FMCPCommandResult> AsyncResult;
+        if (FakeWorld.IsValid())
         {
-            TSharedPtr<FJsonObject> ResultJson;
-            
-            if (CommandType == TEXT("ping"))
-            {
-                ResultJson = MakeShareable(new FJsonObject);
-                ResultJson->SetStringField(TEXT("message"), TEXT("pong"));
-            }
-            // Editor Commands (including actor manipulation)
-            else if (CommandType == TEXT("get_actors_in_level") || 
-                     CommandType == TEXT("find_actors_by_name") ||
-                     CommandType == TEXT("spawn_actor") ||
-                     CommandType == TEXT("create_actor") ||
-                     CommandType == TEXT("delete_actor") || 
-                     CommandType == TEXT("set_actor_transform") ||
-                     CommandType == TEXT("get_actor_properties") ||
-                     CommandType == TEXT("set_actor_property") ||
-                     CommandType == TEXT("spawn_blueprint_actor") ||
-                     CommandType == TEXT("focus_viewport") || 
-                     CommandType == TEXT("take_screenshot") ||
-                     CommandType == TEXT("get_console_output"))
-            {
-                ResultJson = EditorCommands->HandleCommand(CommandType, Params);
-            }
-            // Blueprint Commands
-            else if (CommandType == TEXT("create_blueprint") || 
-                     CommandType == TEXT("add_component_to_blueprint") || 
-                     CommandType == TEXT("set_component_property") || 
-                     CommandType == TEXT("set_physics_properties") || 
-                     CommandType == TEXT("compile_blueprint") || 
-                     CommandType == TEXT("set_blueprint_property") || 
-                     CommandType == TEXT("set_static_mesh_properties") ||
-                     CommandType == TEXT("set_pawn_properties"))
-            {
-                ResultJson = BlueprintCommands->HandleCommand(CommandType, Params);
-            }
-            // Blueprint Node Commands
-            else if (CommandType == TEXT("connect_blueprint_nodes") || 
-                     CommandType == TEXT("add_blueprint_get_self_component_reference") ||
-                     CommandType == TEXT("add_blueprint_self_reference") ||
-                     CommandType == TEXT("find_blueprint_nodes") ||
-                     CommandType == TEXT("add_blueprint_event_node") ||
-                     CommandType == TEXT("add_blueprint_input_action_node") ||
-                     CommandType == TEXT("add_blueprint_function_node") ||
-                     CommandType == TEXT("add_blueprint_get_component_node") ||
-                     CommandType == TEXT("add_blueprint_variable"))
-            {
-                ResultJson = BlueprintNodeCommands->HandleCommand(CommandType, Params);
-            }
-            // Project Commands
-            else if (CommandType == TEXT("create_input_mapping"))
-            {
-                ResultJson = ProjectCommands->HandleCommand(CommandType, Params);
-            }
-            // UMG Commands
-            else if (CommandType == TEXT("create_umg_widget_blueprint") ||
-                     CommandType == TEXT("add_text_block_to_widget") ||
-                     CommandType == TEXT("add_button_to_widget") ||
-                     CommandType == TEXT("bind_widget_event") ||
-                     CommandType == TEXT("set_text_block_binding") ||
-                     CommandType == TEXT("add_widget_to_viewport"))
-            {
-                ResultJson = UMGCommands->HandleCommand(CommandType, Params);
-            }
-            // Blueprint Introspection Commands
-            else if (CommandType == TEXT("get_blueprint_data"))
-            {
-                ResultJson = BlueprintIntrospection->HandleCommand(CommandType, Params);
-            }
-            else
+            // The fake world has no asynchronous commands
+        }
+        else if (EditorCommands->IsAsyncCommand(CommandType))
+        {
+            MCP_TRACE_SCOPE_TEXT(*CommandType);
+            AsyncResult = EditorCommands->HandleCommandAsync(CommandType, Params);
+        }
+        else if (ProjectCommands->IsAsyncCommand(CommandType))
+        {
+            MCP_TRACE_SCOPE_TEXT(*CommandType);
+            AsyncResult = ProjectCommands->HandleCommandAsync(CommandType, Params);
+        }
+        if (AsyncResult.IsValid())
+        {
+            AsyncResult.Next([Promise, QueuedCycle, StartCycle, Encoding](FMCPCommandResult Result)
             {
-                ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-                ResponseJson->SetStringField(TEXT("error"), FString::Printf(TEXT("Unknown command: %s"), *CommandType));
-                
-                FString ResultString;
-                TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
-                FJsonSerializer::Serialize(ResponseJson.ToSharedRef(), Writer);
-                Promise.SetValue(ResultString);
-                return;
-            }
-            
-            // Check if the result contains an error
-            bool bSuccess = true;
-            FString ErrorMessage;
-            
-            if (ResultJson->HasField(TEXT("success")))
+                const uint64 EndCycle = FPlatformTime::Cycles64();
+                FMCPResponse Response = BuildResponse(MoveTemp(Result), Encoding);
+                Response.Timing.DispatchCycle = QueuedCycle;
+                Response.Timing.StartCycle = StartCycle;
+                Response.Timing.EndCycle = EndCycle;
+                Promise->SetValue(MoveTemp(Response));
+            });
+            return;
+        }
+        
+        FMCPCommandResult Result;
+        try
+        {
+            Result.Json = DispatchCommand(CommandType, Params);
+            Result.Attachment = MoveTemp(Context.ResponseAttachment);
+        }
+        catch (const std::exception& e)
+        {
+            Result.Json = FUnrealMCPCommonUtils::CreateErrorResponse(UTF8_TO_TCHAR(e.what()));
+        }
+        
+        const uint64 EndCycle = FPlatformTime::Cycles64();
+        FMCPResponse Response = BuildResponse(MoveTemp(Result), Encoding);
+        Response.Timing.DispatchCycle = QueuedCycle;
+        Response.Timing.StartCycle = StartCycle;
+        Response.Timing.EndCycle = EndCycle;
+        Promise->SetValue(MoveTemp(Response));
+    });
+    
+    FMCPResponse Response;
+    {
+        MCP_TRACE_SCOPE("MCP WaitForGameThread");
+        Response = Future.Get();
+    }
+    Response.RequestId = RequestId;
+    return Response;
+}
+
+TSharedPtr<FJsonObject> UUnrealMCPBridge::DispatchCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+{
+    // One timer per command type; batched commands nest under their batch
+    MCP_TRACE_SCOPE_TEXT(*CommandType);
+    
+    if (CommandType == TEXT("ping"))
+    {
+        TSharedPtr<FJsonObject> ResultJson = MakeShareable(new FJsonObject);
+        ResultJson->SetStringField(TEXT("message"), TEXT("pong"));
+        // Header encodings this server accepts (see MCPWireProtocol.h)
+        TArray<TSharedPtr<FJsonValue>> Encodings;
+        Encodings.Add(MakeShared<FJsonValueString>(TEXT("json")));
+        Encodings.Add(MakeShared<FJsonValueString>(TEXT("msgpack")));
+        ResultJson->SetArrayField(TEXT("encodings"), Encodings);
+        // Commands outside the fake world's set fail on the headless host
+        ResultJson->SetBoolField(TEXT("fake_world"), FakeWorld.IsValid());
+        return ResultJson;
+    }
+    // Round trip of params and attachment, for transport tests and benchmarks
+    else if (CommandType == TEXT("echo"))
+    {
+        TSharedPtr<FJsonObject> ResultJson = MakeShared<FJsonObject>();
+        ResultJson->SetObjectField(TEXT("params"), Params);
+        if (const FMCPRequestContext* Context = FMCPRequestContext::Get())
+        {
+            ResultJson->SetNumberField(TEXT("attachment_bytes"), Context->RequestAttachment.Num());
+            FMCPRequestContext::SetResponseAttachment(TArray<uint8>(Context->RequestAttachment));
+        }
+        return ResultJson;
+    }
+    else if (CommandType == TEXT("get_server_stats"))
+    {
+        return HandleGetServerStats(Params);
+    }
+    else if (CommandType == TEXT("get_revisions"))
+    {
+        return HandleGetRevisions();
+    }
+    else if (CommandType == TEXT("subscribe_revisions"))
+    {
+        return HandleSubscribeRevisions(Params);
+    }
+    else if (CommandType == TEXT("start_recording"))
+    {
+        return HandleStartRecording(Params);
+    }
+    else if (CommandType == TEXT("stop_recording"))
+    {
+        return HandleStopRecording();
+    }
+    // Edit batches and transactions
+    else if (CommandType == TEXT("batch"))
+    {
+        return HandleBatch(Params);
+    }
+    else if (CommandType == TEXT("begin_transaction"))
+    {
+        return HandleBeginTransaction(Params);
+    }
+    else if (CommandType == TEXT("commit_transaction"))
+    {
+        return HandleEndTransaction(true);
+    }
+    else if (CommandType == TEXT("rollback_transaction"))
+    {
+        return HandleEndTransaction(false);
+    }
+    else if (FakeWorld.IsValid())
+    {
+        // Fake actors raise no editor events, so the level revision moves only when a command edited them
+        bool bChanged = false;
+        TSharedPtr<FJsonObject> ResultJson = FakeWorld->HandleCommand(CommandType, Params, bChanged);
+        if (bChanged && ChangeFeed.IsValid())
+        {
+            ChangeFeed->MarkLevelChanged();
+        }
+        return ResultJson;
+    }
+    // Editor Commands (including actor manipulation)
+    else if (CommandType == TEXT("get_actors_in_level") || 
+             CommandType == TEXT("find_actors_by_name") ||
+             CommandType == TEXT("spawn_actor") ||
+             CommandType == TEXT("spawn_actors_bulk") ||
+             CommandType == TEXT("create_actor") ||
+             CommandType == TEXT("delete_actor") || 
+             CommandType == TEXT("set_actor_transform") ||
+             CommandType == TEXT("set_transforms_bulk") ||
+             CommandType == TEXT("get_actor_properties") ||
+             CommandType == TEXT("set_actor_property") ||
+             CommandType == TEXT("spawn_blueprint_actor") ||
+             CommandType == TEXT("find_actors_in_radius") ||
+             CommandType == TEXT("find_actors_in_box") ||
+             CommandType == TEXT("find_nearest_actors") ||
+             CommandType == TEXT("snapshot_level") ||
+             CommandType == TEXT("diff_level") ||
+             CommandType == TEXT("focus_viewport") || 
+             CommandType == TEXT("start_viewport_stream") ||
+             CommandType == TEXT("stop_viewport_stream") ||
+             CommandType == TEXT("ack_viewport_frame") ||
+             CommandType == TEXT("get_console_output"))
+    {
+        return EditorCommands->HandleCommand(CommandType, Params);
+    }
+    // Blueprint Commands
+    else if (CommandType == TEXT("create_blueprint") || 
+             CommandType == TEXT("add_component_to_blueprint") || 
+             CommandType == TEXT("set_component_property") || 
+             CommandType == TEXT("set_physics_properties") || 
+             CommandType == TEXT("compile_blueprint") || 
+             CommandType == TEXT("set_blueprint_property") || 
+             CommandType == TEXT("set_static_mesh_properties") ||
+             CommandType == TEXT("set_pawn_properties"))
+    {
+        return BlueprintCommands->HandleCommand(CommandType, Params);
+    }
+    // Blueprint Node Commands
+    else if (CommandType == TEXT("connect_blueprint_nodes") || 
+             CommandType == TEXT("add_blueprint_get_self_component_reference") ||
+             CommandType == TEXT("add_blueprint_self_reference") ||
+             CommandType == TEXT("find_blueprint_nodes") ||
+             CommandType == TEXT("add_blueprint_event_node") ||
+             CommandType == TEXT("add_blueprint_input_action_node") ||
+             CommandType == TEXT("add_blueprint_function_node") ||
+             CommandType == TEXT("add_blueprint_get_component_node") ||
+             CommandType == TEXT("add_blueprint_variable"))
+    {
+        return BlueprintNodeCommands->HandleCommand(CommandType, Params);
+    }
+    // Project Commands
+    else if (CommandType == TEXT("create_input_mapping"))
+    {
+        return ProjectCommands->HandleCommand(CommandType, Params);
+    }
+    // UMG Commands
+    else if (CommandType == TEXT("create_umg_widget_blueprint") ||
+             CommandType == TEXT("add_text_block_to_widget") ||
+             CommandType == TEXT("add_button_to_widget") ||
+             CommandType == TEXT("bind_widget_event") ||
+             CommandType == TEXT("set_text_block_binding") ||
+             CommandType == TEXT("add_widget_to_viewport"))
+    {
+        return UMGCommands->HandleCommand(CommandType, Params);
+    }
+    // Blueprint Introspection Commands
+    else if (CommandType == TEXT("get_blueprint_data") ||
+             CommandType == TEXT("get_blueprint_delta") ||
+             CommandType == TEXT("export_graph_binary") ||
+             CommandType == TEXT("scan_blueprints") ||
+             CommandType == TEXT("get_scan_results") ||
+             CommandType == TEXT("cancel_scan"))
+    {
+        return BlueprintIntrospection->HandleCommand(CommandType, Params);
+    }
+    
+    return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown command: %s"), *CommandType));
+}
+
+bool UUnrealMCPBridge::IsAsyncCommand(const FString& CommandType) const
+{
+    return !FakeWorld.IsValid() && (EditorCommands->IsAsyncCommand(CommandType) || ProjectCommands->IsAsyncCommand(CommandType));
+}
+
+TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleBatch(const TSharedPtr<FJsonObject>& Params)
+{
+    const TArray<TSharedPtr<FJsonValue>>* Commands = nullptr;
+    if (!Params->TryGetArrayField(TEXT("commands"), Commands))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'commands' parameter"));
+    }
+    
+    bool bTransaction = true;
+    bool bStopOnError = true;
+    FString Description = TEXT("MCP batch");
+    Params->TryGetBoolField(TEXT("transaction"), bTransaction);
+    Params->TryGetBoolField(TEXT("stop_on_error"), bStopOnError);
+    Params->TryGetStringField(TEXT("description"), Description);
+    
+    // Inside begin_transaction the batch joins the open transaction
+    TUniquePtr<FMCPEditBatch> Batch;
+    if (bTransaction && !FMCPEditBatch::Get())
+    {
+        Batch = MakeUnique<FMCPEditBatch>(Description);
+    }
+    
+    const double StartTime = FPlatformTime::Seconds();
+    TArray<TSharedPtr<FJsonValue>> Results;
+    int32 FailedIndex = INDEX_NONE;
+    int32 FailedCount = 0;
+    FString FailedType;
+    FString FailedError;
+    
+    for (int32 Index = 0; Index < Commands->Num(); ++Index)
+    {
+        FString Type;
+        TSharedPtr<FJsonObject> CommandParams = MakeShared<FJsonObject>();
+        TSharedPtr<FJsonObject> Result;
+        
+        const TSharedPtr<FJsonObject>* Command = nullptr;
+        if (!(*Commands)[Index]->TryGetObject(Command) || !(*Command)->TryGetStringField(TEXT("type"), Type))
+        {
+            Result = FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Each batch command needs a 'type'"));
+        }
+        else if (Type == TEXT("batch") || Type.EndsWith(TEXT("_transaction")))
+        {
+            Result = FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("'%s' cannot run inside a batch"), *Type));
+        }
+        else if (IsAsyncCommand(Type))
+        {
+            Result = FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Asynchronous command '%s' cannot run inside a batch"), *Type));
+        }
+        else
+        {
+            const TSharedPtr<FJsonObject>* ParamsObj = nullptr;
+            if ((*Command)->TryGetObjectField(TEXT("params"), ParamsObj))
             {
-                bSuccess = ResultJson->GetBoolField(TEXT("success"));
-                if (!bSuccess && ResultJson->HasField(TEXT("error")))
-                {
-                    ErrorMessage = ResultJson->GetStringField(TEXT("error"));
-                }
+                CommandParams = *ParamsObj;
             }
+            Result = DispatchCommand(Type, CommandParams);
             
-            if (bSuccess)
+            // Binary attachments are not collected from batched commands
+            FMCPRequestContext::SetResponseAttachment(TArray<uint8>());
+        }
+        
+        const bool bSuccess = Result.IsValid() && (!Result->HasField(TEXT("success")) || Result->GetBoolField(TEXT("success")));
+        TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+        Entry->SetStringField(TEXT("type"), Type);
+        Entry->SetStringField(TEXT("status"), bSuccess ? TEXT("success") : TEXT("error"));
+        if (bSuccess)
+        {
+            Entry->SetObjectField(TEXT("result"), Result);
+        }
+        else
+        {
+            FString Error = TEXT("Command returned no result");
+            if (Result.IsValid() && !Result->TryGetStringField(TEXT("error"), Error))
             {
-                // Set success status and include the result
-                ResponseJson->SetStringField(TEXT("status"), TEXT("success"));
-                ResponseJson->SetObjectField(TEXT("result"), ResultJson);
+                Error = TEXT("Command failed without an error message");
             }
-            else
+            Entry->SetStringField(TEXT("error"), Error);
+            ++FailedCount;
+            if (FailedIndex == INDEX_NONE)
             {
-                // Set error status and include the error message
-                ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-                ResponseJson->SetStringField(TEXT("error"), ErrorMessage);
+                FailedIndex = Index;
+                FailedType = Type;
+                FailedError = Error;
             }
         }
-        catch (const std::exception& e)
+        Results.Add(MakeShared<FJsonValueObject>(Entry));
+        
+        if (!bSuccess && bStopOnError)
         {
-            ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-            ResponseJson->SetStringField(TEXT("error"), UTF8_TO_TCHAR(e.what()));
+            break;
         }
+    }
+    
+    // All or nothing when the batch owns its transaction
+    if (Batch.IsValid() && FailedIndex != INDEX_NONE && bStopOnError)
+    {
+        Batch->Rollback();
+        TSharedPtr<FJsonObject> ErrorJson = FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(
+            TEXT("Batch command %d (%s) failed: %s. All edits in the batch were rolled back."), FailedIndex, *FailedType, *FailedError));
         
-        FString ResultString;
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
-        FJsonSerializer::Serialize(ResponseJson.ToSharedRef(), Writer);
-        Promise.SetValue(ResultString);
-    });
+        // Results run up to and including the failed command
+        ErrorJson->SetNumberField(TEXT("failed_index"), FailedIndex);
+        ErrorJson->SetArrayField(TEXT("results"), Results);
+        return ErrorJson;
+    }
+    
+    TSharedPtr<FJsonObject> ResultJson = MakeShared<FJsonObject>();
+    if (Batch.IsValid())
+    {
+        ResultJson = Batch->Commit();
+    }
+    ResultJson->SetBoolField(TEXT("success"), true);
+    ResultJson->SetBoolField(TEXT("transaction"), bTransaction);
+    ResultJson->SetNumberField(TEXT("executed"), Results.Num());
+    ResultJson->SetNumberField(TEXT("failed"), FailedCount);
+    if (FailedIndex != INDEX_NONE)
+    {
+        ResultJson->SetNumberField(TEXT("failed_index"), FailedIndex);
+    }
+    ResultJson->SetNumberField(TEXT("elapsed_ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+    ResultJson->SetArrayField(TEXT("results"), Results);
+    return ResultJson;
+}
+
+TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleBeginTransaction(const TSharedPtr<FJsonObject>& Params)
+{
+    if (FMCPEditBatch* Active = FMCPEditBatch::Get())
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(
+            FString::Printf(TEXT("A transaction is already open: %s"), *Active->GetDescription()));
+    }
+    
+    // Clients that keep one connection open can have the transaction rolled back
+    // if they disconnect; per-command clients leave it open until commit or rollback
+    bool bBindToConnection = false;
+    Params->TryGetBoolField(TEXT("bind_to_connection"), bBindToConnection);
+    const FMCPRequestContext* Context = FMCPRequestContext::Get();
+    if (bBindToConnection && (!Context || !Context->Connection.IsValid()))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("bind_to_connection requires a persistent client connection"));
+    }
+    
+    FString Description = TEXT("MCP transaction");
+    Params->TryGetStringField(TEXT("description"), Description);
+    OpenTransaction = MakeUnique<FMCPEditBatch>(Description);
+    TransactionOwner = bBindToConnection ? Context->Connection : nullptr;
+    bTransactionHasOwner = bBindToConnection;
+    if (bTransactionHasOwner)
+    {
+        TransactionTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateUObject(this, &UUnrealMCPBridge::TickOpenTransaction), 1.0f);
+    }
+    
+    TSharedPtr<FJsonObject> ResultJson = MakeShared<FJsonObject>();
+    ResultJson->SetBoolField(TEXT("success"), true);
+    ResultJson->SetStringField(TEXT("description"), Description);
+    return ResultJson;
+}
+
+TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleEndTransaction(bool bCommit)
+{
+    if (!OpenTransaction.IsValid())
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("No transaction is open"));
+    }
+    
+    if (TransactionTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TransactionTickerHandle);
+        TransactionTickerHandle.Reset();
+    }
+    
+    TSharedPtr<FJsonObject> ResultJson;
+    if (bCommit)
+    {
+        ResultJson = OpenTransaction->Commit();
+    }
+    else
+    {
+        const FString Description = OpenTransaction->GetDescription();
+        OpenTransaction->Rollback();
+        ResultJson = MakeShared<FJsonObject>();
+        ResultJson->SetStringField(TEXT("description"), Description);
+    }
+    OpenTransaction.Reset();
+    TransactionOwner.Reset();
+    bTransactionHasOwner = false;
+    
+    ResultJson->SetBoolField(TEXT("success"), true);
+    ResultJson->SetBoolField(TEXT("committed"), bCommit);
+    return ResultJson;
+}
+
+TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleGetServerStats(const TSharedPtr<FJsonObject>& Params)
+{
+    bool bPerCommand = true;
+    bool bReset = false;
+    Params->TryGetBoolField(TEXT("commands"), bPerCommand);
+    Params->TryGetBoolField(TEXT("reset"), bReset);
+    
+    TSharedPtr<FJsonObject> ResultJson = Stats.ToJson(bPerCommand);
+    if (bReset)
+    {
+        Stats.Reset();
+    }
+    ResultJson->SetBoolField(TEXT("reset"), bReset);
+    if (TSharedPtr<FMCPRequestJournal, ESPMode::ThreadSafe> CurrentJournal = GetJournal())
+    {
+        ResultJson->SetObjectField(TEXT("journal"), CurrentJournal->ToJson());
+    }
+    return ResultJson;
+}
+
+TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleGetRevisions()
+{
+    if (!ChangeFeed.IsValid())
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Revisions are not tracked yet"));
+    }
+    return ChangeFeed->ToJson();
+}
+
+TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleSubscribeRevisions(const TSharedPtr<FJsonObject>& Params)
+{
+    const FMCPRequestContext* Context = FMCPRequestContext::Get();
+    if (!ChangeFeed.IsValid() || !Context || !Context->Connection.IsValid())
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("subscribe_revisions requires a persistent client connection"));
+    }
+    
+    bool bEnabled = true;
+    Params->TryGetBoolField(TEXT("enabled"), bEnabled);
+    if (bEnabled)
+    {
+        ChangeFeed->Subscribe(Context->Connection);
+    }
+    else
+    {
+        ChangeFeed->Unsubscribe(Context->Connection.Get());
+    }
+    
+    TSharedPtr<FJsonObject> ResultJson = ChangeFeed->ToJson();
+    ResultJson->SetBoolField(TEXT("subscribed"), bEnabled);
+    return ResultJson;
+}
+
+TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleOpenSharedMemory(const TSharedPtr<FJsonObject>& Params,
+    const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe>& Connection)
+{
+    if (!Connection.IsValid())
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("open_shared_memory requires a persistent client connection"));
+    }
+    
+    FString Name;
+    double RingSize = 0.0;
+    if (!Params->TryGetStringField(TEXT("name"), Name) || !Params->TryGetNumberField(TEXT("ring_size"), RingSize))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'name' or 'ring_size' parameter"));
+    }
+    int32 MinPayload = 64 * 1024;
+    Params->TryGetNumberField(TEXT("min_payload"), MinPayload);
+    
+    FString Error;
+    if (!Connection->OpenSharedMemory(Name, (int64)RingSize, MinPayload, Error))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+    
+    TSharedPtr<FJsonObject> ResultJson = MakeShared<FJsonObject>();
+    ResultJson->SetStringField(TEXT("name"), Name);
+    ResultJson->SetNumberField(TEXT("ring_size"), RingSize);
+    ResultJson->SetNumberField(TEXT("min_payload"), FMath::Max(MinPayload, 0));
+    return ResultJson;
+}
+
+TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleStartRecording(const TSharedPtr<FJsonObject>& Params)
+{
+    FString Path;
+    if (!Params->TryGetStringField(TEXT("path"), Path) || Path.IsEmpty())
+    {
+        Path = GetDefaultJournalPath();
+    }
+    
+    FString Error;
+    if (!StartJournal(Path, Error))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+    
+    TSharedPtr<FJsonObject> ResultJson = GetJournal()->ToJson();
+    ResultJson->SetBoolField(TEXT("success"), true);
+    return ResultJson;
+}
+
+TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleStopRecording()
+{
+    TSharedPtr<FMCPRequestJournal, ESPMode::ThreadSafe> CurrentJournal = GetJournal();
+    if (!CurrentJournal.IsValid())
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("No recording in progress"));
+    }
+    
+    StopJournal();
+    TSharedPtr<FJsonObject> ResultJson = CurrentJournal->ToJson();
+    ResultJson->SetBoolField(TEXT("success"), true);
+    return ResultJson;
+}
+
+bool UUnrealMCPBridge::TickOpenTransaction(float DeltaTime)
+{
+    TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe> Owner = TransactionOwner.Pin();
+    if (OpenTransaction.IsValid() && (!Owner.IsValid() || Owner->IsClosed()))
+    {
+        UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPBridge: Client disconnected with transaction '%s' open, rolling it back"),
+            *OpenTransaction->GetDescription());
+        TransactionTickerHandle.Reset();
+        HandleEndTransaction(false);
+        return false;
+    }
+    return OpenTransaction.IsValid();
+}
+
+FMCPResponse UUnrealMCPBridge::BuildResponse(FMCPCommandResult&& Result, EMCPFrameEncoding Encoding)
+{
+    TSharedPtr<FJsonObject> ResponseJson = MakeShareable(new FJsonObject);
+    TSharedPtr<FJsonObject> ResultJson = Result.Json;
+    
+    if (!ResultJson.IsValid())
+    {
+        ResultJson = FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Command returned no result"));
+    }
+    
+    // Check if the result contains an error
+    bool bSuccess = true;
+    FString ErrorMessage;
+    
+    if (ResultJson->HasField(TEXT("success")))
+    {
+        bSuccess = ResultJson->GetBoolField(TEXT("success"));
+        if (!bSuccess && ResultJson->HasField(TEXT("error")))
+        {
+            ErrorMessage = ResultJson->GetStringField(TEXT("error"));
+        }
+    }
     
-    return Future.Get();
-}
\ No newline at end of file
+    FMCPResponse Response;
+    if (bSuccess)
+    {
+        // Set success status and include the result
+        ResponseJson->SetStringField(TEXT("status"), TEXT("success"));
+        ResponseJson->SetObjectField(TEXT("result"), ResultJson);
+        Response.Attachment = MoveTemp(Result.Attachment);
+    }
+    else
+    {
+        // Set error status and include the error message, plus any details the command added
+        ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
+        ResponseJson->SetStringField(TEXT("error"), ErrorMessage);
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : ResultJson->Values)
+        {
+            if (Field.Key != TEXT("success") && Field.Key != TEXT("error"))
+            {
+                ResponseJson->SetField(Field.Key, Field.Value);
+            }
+        }
+        Response.bError = true;
+    }
+    
+    MCP_TRACE_SCOPE("MCP SerializeResponse");
+    Response.Encoding = Encoding;
+    if (Encoding == EMCPFrameEncoding::MessagePack)
+    {
+        FMCPMessagePack::Write(ResponseJson, Response.PackedBody);
+        return Response;
+    }
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Response.Body);
+    FJsonSerializer::Serialize(ResponseJson.ToSharedRef(), Writer);
+    return Response;
+}
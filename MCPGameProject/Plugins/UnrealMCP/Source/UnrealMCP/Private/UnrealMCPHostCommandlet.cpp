@@ -0,0 +1,93 @@
+#include "UnrealMCPHostCommandlet.h"
+#include "MCPLog.h"
+#include "UnrealMCPBridge.h"
+#include "MCPFakeWorld.h"
+#include "Editor.h"
+#include "FileHelpers.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Ticker.h"
+#include "HAL/PlatformProcess.h"
+
+UUnrealMCPHostCommandlet::UUnrealMCPHostCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+    ShowErrorCount = false;
+}
+
+int32 UUnrealMCPHostCommandlet::Main(const FString& Params)
+{
+    UUnrealMCPBridge* Bridge = GEditor ? GEditor->GetEditorSubsystem<UUnrealMCPBridge>() : nullptr;
+    if (!Bridge)
+    {
+        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPHost: The MCP bridge subsystem is not available"));
+        return 1;
+    }
+
+    if (FParse::Param(*Params, TEXT("FakeWorld")))
+    {
+        TSharedPtr<FMCPFakeWorld> FakeWorld = MakeShared<FMCPFakeWorld>();
+        int32 FakeActors = 0;
+        if (FParse::Value(*Params, TEXT("FakeActors="), FakeActors) && FakeActors > 0)
+        {
+            FakeWorld->Populate(FakeActors);
+        }
+        Bridge->SetFakeWorld(FakeWorld);
+        UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPHost: Serving a fake world with %d actors"), FakeWorld->Num());
+    }
+    else
+    {
+        FString MapPath;
+        if (FParse::Value(*Params, TEXT("Map="), MapPath))
+        {
+            if (!UEditorLoadingAndSavingUtils::LoadMap(MapPath))
+            {
+                UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPHost: Failed to load map %s"), *MapPath);
+                return 1;
+            }
+            UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPHost: Loaded map %s"), *MapPath);
+        }
+    }
+
+    if (!Bridge->IsRunning())
+    {
+        Bridge->StartServer();
+    }
+    if (!Bridge->IsRunning())
+    {
+        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPHost: The MCP server failed to start"));
+        return 1;
+    }
+
+    double Duration = 0.0;
+    FParse::Value(*Params, TEXT("Duration="), Duration);
+    UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPHost: Serving commands%s"),
+        Duration > 0.0 ? *FString::Printf(TEXT(" for %.0f seconds"), Duration) : TEXT(" until exit is requested"));
+
+    // Stand-in for the editor loop: run the game thread tasks commands are queued
+    // as, and the core ticker that drives timeouts and transaction cleanup
+    const double StartTime = FPlatformTime::Seconds();
+    double LastTickTime = StartTime;
+    while (!IsEngineExitRequested())
+    {
+        FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+
+        const double Now = FPlatformTime::Seconds();
+        FTSTicker::GetCoreTicker().Tick(Now - LastTickTime);
+        LastTickTime = Now;
+
+        if (Duration > 0.0 && Now - StartTime >= Duration)
+        {
+            break;
+        }
+
+        // Short sleep: queued commands wait at most this long for the game thread
+        FPlatformProcess::SleepNoStats(0.0002f);
+    }
+
+    Bridge->StopServer();
+    UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPHost: Stopped after %.1f seconds"), FPlatformTime::Seconds() - StartTime);
+    return 0;
+}
@@ -1,4 +1,5 @@
 #include "UnrealMCPModule.h"
+#include "MCPLog.h"
 #include "UnrealMCPBridge.h"
 #include "MCPLogCaptureDevice.h"
 #include "Modules/ModuleManager.h"
@@ -9,7 +10,7 @@
 
 void FUnrealMCPModule::StartupModule()
 {
-	UE_LOG(LogTemp, Display, TEXT("Unreal MCP Module has started"));
+	UE_LOG(LogUnrealMCP, Display, TEXT("Unreal MCP Module has started"));
 
 	// Create and register the log capture device
 	LogCaptureDevice = MakeUnique<FMCPLogCaptureDevice>(1000); // Keep last 1000 log entries
@@ -17,7 +18,7 @@ void FUnrealMCPModule::StartupModule()
 	if (GLog && LogCaptureDevice.IsValid())
 	{
 		GLog->AddOutputDevice(LogCaptureDevice.Get());
-		UE_LOG(LogTemp, Display, TEXT("MCP Log Capture Device registered - capturing console output"));
+		UE_LOG(LogUnrealMCP, Display, TEXT("MCP Log Capture Device registered - capturing console output"));
 	}
 }
 
@@ -27,12 +28,12 @@ void FUnrealMCPModule::ShutdownModule()
 	if (GLog && LogCaptureDevice.IsValid())
 	{
 		GLog->RemoveOutputDevice(LogCaptureDevice.Get());
-		UE_LOG(LogTemp, Display, TEXT("MCP Log Capture Device unregistered"));
+		UE_LOG(LogUnrealMCP, Display, TEXT("MCP Log Capture Device unregistered"));
 	}
 	
 	LogCaptureDevice.Reset();
 	
-	UE_LOG(LogTemp, Display, TEXT("Unreal MCP Module has shut down"));
+	UE_LOG(LogUnrealMCP, Display, TEXT("Unreal MCP Module has shut down"));
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -2,6 +2,62 @@
 
 #include "CoreMinimal.h"
 #include "Json.h"
+#include "UObject/ObjectKey.h"
+
+class FMCPBlueprintChangeTracker;
+class FMCPBlueprintScan;
+
+/**
+ * How much of each graph get_blueprint_data returns
+ */
+enum class EMCPGraphDetail : uint8
+{
+    /** Nodes, pins with default values, connections */
+    Full,
+    /** Nodes and pins, without pin default values */
+    Pins,
+    /** Nodes and connections, without pins */
+    Nodes,
+    /** Node and connection counts only */
+    Summary,
+
+    Count
+};
+
+/**
+ * Graph options for one request
+ */
+struct FMCPGraphQuery
+{
+    EMCPGraphDetail Detail = EMCPGraphDetail::Full;
+
+    /** Node range [NodeOffset, NodeOffset + NodeLimit); NodeLimit <= 0 returns every node */
+    int32 NodeOffset = 0;
+    int32 NodeLimit = 0;
+
+    bool IsPaged() const { return NodeOffset > 0 || NodeLimit > 0; }
+};
+
+/**
+ * Sections and graph options of a get_blueprint_data request
+ */
+struct FMCPBlueprintDataRequest
+{
+    /** Named sections ("info", "functions", ...) */
+    TSet<FString> Sections;
+
+    /** Individual graphs requested as "graphs:<name>" */
+    TArray<FString> GraphNames;
+
+    FMCPGraphQuery Query;
+
+    /** No sections or graphs named: return every section */
+    bool WantsAllSections() const { return Sections.Num() == 0 && GraphNames.Num() == 0; }
+    bool WantsSection(const TCHAR* Section) const { return WantsAllSections() || Sections.Contains(Section); }
+
+    /** All sections at full detail without paging; the only form cached as a whole */
+    bool IsDefault() const { return WantsAllSections() && Query.Detail == EMCPGraphDetail::Full && !Query.IsPaged(); }
+};
 
 /**
  * Command handler for Blueprint introspection operations.
@@ -12,6 +68,7 @@ class UNREALMCP_API FUnrealMCPBlueprintIntrospection
 {
 public:
     FUnrealMCPBlueprintIntrospection();
+    ~FUnrealMCPBlueprintIntrospection();
     
     /**
      * Main command dispatcher
@@ -24,6 +81,46 @@ private:
      */
     TSharedPtr<FJsonObject> HandleGetBlueprintData(const TSharedPtr<FJsonObject>& Params);
     
+    /**
+     * Get the graph changes since a revision returned by an earlier request
+     */
+    TSharedPtr<FJsonObject> HandleGetBlueprintDelta(const TSharedPtr<FJsonObject>& Params);
+    
+    /**
+     * Export graphs in the compact binary format (see MCPGraphBinaryExport.h)
+     */
+    TSharedPtr<FJsonObject> HandleExportGraphBinary(const TSharedPtr<FJsonObject>& Params);
+    
+    /**
+     * Start extracting every blueprint that matches an asset registry filter
+     */
+    TSharedPtr<FJsonObject> HandleScanBlueprints(const TSharedPtr<FJsonObject>& Params);
+    
+    /**
+     * Collect results of a polled scan
+     */
+    TSharedPtr<FJsonObject> HandleGetScanResults(const TSharedPtr<FJsonObject>& Params);
+    
+    /**
+     * Stop a scan
+     */
+    TSharedPtr<FJsonObject> HandleCancelScan(const TSharedPtr<FJsonObject>& Params);
+    
+    /**
+     * Scan referenced by the 'scan_id' parameter
+     */
+    TSharedPtr<FMCPBlueprintScan, ESPMode::ThreadSafe> FindScan(const TSharedPtr<FJsonObject>& Params, FString& OutError);
+    
+    /**
+     * Read sections, detail and paging parameters
+     */
+    bool ParseDataRequest(const TSharedPtr<FJsonObject>& Params, FMCPBlueprintDataRequest& OutRequest, FString& OutError);
+    
+    /**
+     * Build the get_blueprint_data result for a blueprint, using the caches where possible
+     */
+    TSharedPtr<FJsonObject> BuildBlueprintData(class UBlueprint* Blueprint, const FMCPBlueprintDataRequest& Request);
+    
     /**
      * Extract basic Blueprint information
      */
@@ -42,12 +139,22 @@ private:
     /**
      * Extract Blueprint functions (Phase 4)
      */
-    TArray<TSharedPtr<FJsonValue>> ExtractFunctions(class UBlueprint* Blueprint);
+    TArray<TSharedPtr<FJsonValue>> ExtractFunctions(class UBlueprint* Blueprint, const FMCPGraphQuery& Query);
     
     /**
      * Extract graph node and connection data (Phase 5)
      */
-    TSharedPtr<FJsonObject> ExtractGraphData(class UEdGraph* Graph);
+    TSharedPtr<FJsonObject> ExtractGraphData(class UEdGraph* Graph, EMCPGraphDetail Detail);
+    
+    /**
+     * Extract event graphs and the construction script
+     */
+    TArray<TSharedPtr<FJsonValue>> ExtractEventGraphs(class UBlueprint* Blueprint, const FMCPGraphQuery& Query);
+    
+    /**
+     * Extract specific graphs by name (any graph type)
+     */
+    TArray<TSharedPtr<FJsonValue>> ExtractNamedGraphs(class UBlueprint* Blueprint, const TArray<FString>& GraphNames, const FMCPGraphQuery& Query, FString& OutError);
     
     /**
      * Extract custom events from event graphs (Phase 6)
@@ -57,10 +164,118 @@ private:
     /**
      * Extract macro definitions (Phase 7)
      */
-    TArray<TSharedPtr<FJsonValue>> ExtractMacros(class UBlueprint* Blueprint);
+    TArray<TSharedPtr<FJsonValue>> ExtractMacros(class UBlueprint* Blueprint, const FMCPGraphQuery& Query);
     
     /**
      * Extract implemented interfaces (Phase 7)
      */
     TArray<TSharedPtr<FJsonValue>> ExtractInterfaces(class UBlueprint* Blueprint);
+    
+    /**
+     * Graph data from the cache, re-extracted only when the graph's revision changed
+     */
+    TSharedPtr<FJsonObject> GetGraphData(class UBlueprint* Blueprint, class UEdGraph* Graph, const FMCPGraphQuery& Query);
+    
+    /**
+     * Copy of graph data limited to a node range, with connections touching those nodes
+     */
+    static TSharedPtr<FJsonObject> PageGraphData(const TSharedPtr<FJsonObject>& GraphData, const FMCPGraphQuery& Query);
+    
+    /**
+     * Change tracker, created on first use
+     */
+    FMCPBlueprintChangeTracker& GetChangeTracker();
+    
+    struct FGraphDataCache
+    {
+        uint64 Revision[(int32)EMCPGraphDetail::Count] = {};
+        TSharedPtr<FJsonObject> Data[(int32)EMCPGraphDetail::Count];
+    };
+    
+    /**
+     * Nodes and connections of one graph at a revision, keyed for diffing.
+     * The JSON values are shared with the graph data cache.
+     */
+    struct FGraphSnapshot
+    {
+        FString Name;
+        FString Type;
+        uint64 Revision = 0;
+        
+        /** Node id -> node data, and a hash of the serialized node */
+        TMap<FString, TSharedPtr<FJsonValue>> Nodes;
+        TMap<FString, uint32> NodeHashes;
+        
+        /** "from_pin>to_pin" -> connection data */
+        TMap<FString, TSharedPtr<FJsonValue>> Connections;
+    };
+    
+    /**
+     * State of all graphs at a blueprint revision; graphs that did not change
+     * between revisions share one snapshot
+     */
+    struct FBlueprintSnapshot
+    {
+        uint64 Revision = 0;
+        uint64 StructureRevision = 0;
+        TMap<FObjectKey, TSharedPtr<const FGraphSnapshot>> Graphs;
+    };
+    
+    /**
+     * Cached introspection results for one blueprint
+     */
+    struct FBlueprintDataCache
+    {
+        /** Full get_blueprint_data result and the blueprint revision it was built at */
+        uint64 Revision = 0;
+        TSharedPtr<FJsonObject> Result;
+        
+        /** Sections that do not depend on graph contents, keyed by structure revision */
+        uint64 StructureRevision = 0;
+        TSharedPtr<FJsonObject> Info;
+        TArray<TSharedPtr<FJsonValue>> Components;
+        TArray<TSharedPtr<FJsonValue>> Variables;
+        
+        /** Per-graph extraction results */
+        TMap<FObjectKey, FGraphDataCache> Graphs;
+        
+        /** Recent snapshots, oldest first, that get_blueprint_delta can diff against */
+        TArray<FBlueprintSnapshot> RevisionLog;
+        
+        /**
+         * Set once a client asks for a delta of this blueprint; until then no snapshots
+         * are recorded, so plain reads and scans do not pay for them
+         */
+        bool bDeltaTracked = false;
+        
+        double LastUsedTime = 0.0;
+    };
+    
+    /**
+     * Record the current state of a blueprint in its revision log (no-op if the
+     * current revision is already logged) and return it
+     */
+    const FBlueprintSnapshot& RecordSnapshot(class UBlueprint* Blueprint, FBlueprintDataCache& Cache);
+    
+    /**
+     * Build the snapshot of one graph from its full-detail data
+     */
+    TSharedPtr<const FGraphSnapshot> SnapshotGraph(class UBlueprint* Blueprint, class UEdGraph* Graph);
+    
+    /**
+     * Added, removed and modified nodes and connections between two snapshots of a graph;
+     * null if nothing changed
+     */
+    static TSharedPtr<FJsonObject> DiffGraphSnapshots(const FGraphSnapshot* Base, const FGraphSnapshot& Current);
+    
+    /**
+     * Cache entry for a blueprint, evicting the least recently used entry when full
+     */
+    FBlueprintDataCache& FindOrAddCache(class UBlueprint* Blueprint);
+    
+    TMap<FObjectKey, FBlueprintDataCache> BlueprintCache;
+    TUniquePtr<FMCPBlueprintChangeTracker> ChangeTracker;
+    
+    TMap<int32, TSharedPtr<FMCPBlueprintScan, ESPMode::ThreadSafe>> Scans;
+    int32 NextScanId = 1;
 };
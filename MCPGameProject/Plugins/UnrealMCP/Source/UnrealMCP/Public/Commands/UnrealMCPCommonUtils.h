@@ -32,14 +32,31 @@ public:
     static FVector GetVectorFromJson(const TSharedPtr<FJsonObject>& JsonObject, const FString& FieldName);
     static FRotator GetRotatorFromJson(const TSharedPtr<FJsonObject>& JsonObject, const FString& FieldName);
     
+    // Packed transform buffers, as sent to spawn_actors_bulk and set_transforms_bulk
+    // Floats per transform for a "location", "location_rotation" or "full" layout, or 0 if unknown
+    static int32 GetPackedTransformStride(const FString& Layout);
+    // Float32 values from the request attachment, a base64 "<FieldName>_base64" string or a "<FieldName>" number array
+    static bool GetPackedFloats(const TSharedPtr<FJsonObject>& Params, const FString& FieldName, TArray<float>& OutValues, FString& OutError);
+    // Location, then pitch/yaw/roll, then scale, as far as the stride goes
+    static FTransform MakePackedTransform(const float* Values, int32 Stride);
+    
     // Actor utilities
     static TSharedPtr<FJsonValue> ActorToJson(AActor* Actor);
     static TSharedPtr<FJsonObject> ActorToJsonObject(AActor* Actor, bool bDetailed = false);
+    static AActor* FindActorByName(const FString& ActorName);
+    // Actor named by a "handle" param (see MCPActorHandles.h) or, failing that, by NameField
+    static AActor* FindActorFromParams(const TSharedPtr<FJsonObject>& Params, FString& OutError, const FString& NameField = TEXT("name"));
     
     // Blueprint utilities
     static UBlueprint* FindBlueprint(const FString& BlueprintName);
     static UBlueprint* FindBlueprintByName(const FString& BlueprintName);
     static UEdGraph* FindOrCreateEventGraph(UBlueprint* Blueprint);
+    static FString GetGraphType(const UBlueprint* Blueprint, const UEdGraph* Graph);
+    
+    // Blueprint refresh; deferred to commit while an edit batch is active (see MCPEditBatch.h)
+    static void MarkBlueprintModified(UBlueprint* Blueprint, bool bStructural = false);
+    static void CompileBlueprint(UBlueprint* Blueprint);
+    static void SaveBlueprint(UBlueprint* Blueprint);
     
     // Blueprint node utilities
     static UK2Node_Event* CreateEventNode(UEdGraph* Graph, const FString& EventName, const FVector2D& Position);
@@ -2,6 +2,12 @@
 
 #include "CoreMinimal.h"
 #include "Json.h"
+#include "Async/Future.h"
+#include "MCPWireProtocol.h"
+
+class FMCPViewportStream;
+class FMCPSpatialIndex;
+class FMCPLevelSnapshot;
 
 /**
  * Handler class for Editor-related MCP commands
@@ -11,28 +17,67 @@ class UNREALMCP_API FUnrealMCPEditorCommands
 {
 public:
     FUnrealMCPEditorCommands();
+    ~FUnrealMCPEditorCommands();
 
     // Handle editor commands
     TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
+    // Commands that complete asynchronously; the future is fulfilled off the game thread
+    bool IsAsyncCommand(const FString& CommandType) const;
+    TFuture<FMCPCommandResult> HandleCommandAsync(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+
 private:
     // Actor manipulation commands
     TSharedPtr<FJsonObject> HandleGetActorsInLevel(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleFindActorsByName(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleSpawnActor(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleSpawnActorsBulk(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleDeleteActor(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleSetActorTransform(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleSetTransformsBulk(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleGetActorProperties(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleSetActorProperty(const TSharedPtr<FJsonObject>& Params);
 
+    // Spatial queries, served from SpatialIndex
+    TSharedPtr<FJsonObject> HandleFindActorsInRadius(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleFindActorsInBox(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleFindNearestActors(const TSharedPtr<FJsonObject>& Params);
+
+    // Built on the first spatial query, then kept current by editor events
+    FMCPSpatialIndex& GetSpatialIndex(bool& bOutRebuilt);
+
+    // Level snapshots and diffs
+    TSharedPtr<FJsonObject> HandleSnapshotLevel(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleDiffLevel(const TSharedPtr<FJsonObject>& Params);
+
     // Blueprint actor spawning
     TSharedPtr<FJsonObject> HandleSpawnBlueprintActor(const TSharedPtr<FJsonObject>& Params);
 
     // Editor viewport commands
     TSharedPtr<FJsonObject> HandleFocusViewport(const TSharedPtr<FJsonObject>& Params);
-    TSharedPtr<FJsonObject> HandleTakeScreenshot(const TSharedPtr<FJsonObject>& Params);
+    TFuture<FMCPCommandResult> HandleTakeScreenshot(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleGetConsoleOutput(const TSharedPtr<FJsonObject>& Params);
+
+    // Viewport streaming commands
+    TSharedPtr<FJsonObject> HandleStartViewportStream(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleStopViewportStream(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleAckViewportFrame(const TSharedPtr<FJsonObject>& Params);
+
+    // Find a stream started by the connection that sent the current command
+    TSharedPtr<FMCPViewportStream, ESPMode::ThreadSafe> FindViewportStream(const TSharedPtr<FJsonObject>& Params, FString& OutError);
+
+    // Forget streams whose connection has closed
+    void PruneViewportStreams();
     
     // Editor asset commands
     TSharedPtr<FJsonObject> HandleGetOpenedAssets(const TSharedPtr<FJsonObject>& Params);
+
+    TMap<int32, TSharedPtr<FMCPViewportStream, ESPMode::ThreadSafe>> ViewportStreams;
+    int32 NextViewportStreamId;
+
+    TUniquePtr<FMCPSpatialIndex> SpatialIndex;
+
+    // Stored snapshots by id; the oldest are evicted to stay within the memory budget
+    TMap<int32, TSharedPtr<FMCPLevelSnapshot>> Snapshots;
+    int32 NextSnapshotId;
 }; 
\ No newline at end of file
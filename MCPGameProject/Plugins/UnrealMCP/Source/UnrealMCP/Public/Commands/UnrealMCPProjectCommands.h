@@ -2,6 +2,8 @@
 
 #include "CoreMinimal.h"
 #include "Json.h"
+#include "Async/Future.h"
+#include "MCPWireProtocol.h"
 
 /**
  * Handler class for Project-wide MCP commands
@@ -14,7 +16,14 @@ public:
     // Handle project commands
     TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
+    // Commands that complete asynchronously; the future is fulfilled off the game thread
+    bool IsAsyncCommand(const FString& CommandType) const;
+    TFuture<FMCPCommandResult> HandleCommandAsync(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+
 private:
     // Specific project command handlers
     TSharedPtr<FJsonObject> HandleCreateInputMapping(const TSharedPtr<FJsonObject>& Params);
+
+    // Asset registry search; never loads packages
+    TFuture<FMCPCommandResult> HandleFindAssets(const TSharedPtr<FJsonObject>& Params);
 }; 
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+
+/**
+ * Stable integer handles for actors, so a client can address the same actor
+ * over many commands without the server resolving its name every time.
+ *
+ * A handle is an index into a table of weak actor pointers. Handles start at 1
+ * and are never reused, and an actor keeps its handle for the editor session.
+ * A handle whose actor has been destroyed resolves to a "stale handle" error,
+ * never to a different actor.
+ *
+ * Game thread only.
+ */
+class UNREALMCP_API FMCPActorHandles
+{
+public:
+    /** Handle of an actor, assigned on first use; 0 for null */
+    static int32 GetHandle(AActor* Actor);
+
+    /** Actor behind a handle, or null with OutError describing an unknown or stale handle */
+    static AActor* Resolve(int64 Handle, FString& OutError);
+};
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class UBlueprint;
+class UEdGraph;
+struct FEdGraphEditAction;
+struct FPropertyChangedEvent;
+class FTransactionObjectEvent;
+
+/**
+ * Change counters for blueprints, used to decide when cached introspection
+ * results are stale.
+ *
+ * Once a blueprint is tracked, every edit bumps one or more revisions:
+ *   - graph revision: nodes of that graph changed (added, removed, moved,
+ *     relinked, pin defaults edited)
+ *   - structure revision: anything outside the graphs changed (variables,
+ *     components, class settings), or the blueprint was compiled or
+ *     structurally modified, which also bumps every graph
+ *   - blueprint revision: bumped together with any of the above
+ *
+ * Revisions come from one global counter, so they only ever increase and a
+ * value is never reused, even for a blueprint that was unloaded and reloaded.
+ *
+ * Sources: UBlueprint::OnChanged/OnCompiled, UEdGraph graph-changed handlers,
+ * and the global object modified / property changed / transacted (undo/redo)
+ * delegates, mapped back to their owning blueprint. Game thread only.
+ */
+class UNREALMCP_API FMCPBlueprintChangeTracker
+{
+public:
+    FMCPBlueprintChangeTracker();
+    ~FMCPBlueprintChangeTracker();
+
+    /** Start tracking a blueprint; no-op if it is already tracked */
+    void Track(UBlueprint* Blueprint);
+
+    /** Revisions of a tracked blueprint or graph; 0 if untracked */
+    uint64 GetBlueprintRevision(const UBlueprint* Blueprint) const;
+    uint64 GetStructureRevision(const UBlueprint* Blueprint) const;
+    uint64 GetGraphRevision(const UEdGraph* Graph) const;
+
+    /** Forget blueprints that have been garbage collected */
+    void PruneStale();
+
+private:
+    struct FTrackedBlueprint
+    {
+        TWeakObjectPtr<UBlueprint> Blueprint;
+        uint64 Revision = 0;
+        uint64 StructureRevision = 0;
+        FDelegateHandle ChangedHandle;
+        FDelegateHandle CompiledHandle;
+        TMap<TWeakObjectPtr<UEdGraph>, FDelegateHandle> GraphHandles;
+    };
+
+    // Bind graph-changed handlers for graphs that are not bound yet
+    void BindGraphs(FTrackedBlueprint& Tracked);
+    void Unbind(FTrackedBlueprint& Tracked);
+
+    void MarkGraphChanged(UBlueprint* Blueprint, UEdGraph* Graph);
+    void MarkStructureChanged(UBlueprint* Blueprint);
+    void MarkAllChanged(UBlueprint* Blueprint);
+
+    // Map an edited object to its blueprint and graph and bump the matching revisions
+    void HandleObjectChanged(UObject* Object);
+
+    void HandleBlueprintChanged(UBlueprint* Blueprint);
+    void HandleGraphChanged(const FEdGraphEditAction& Action);
+    void HandleObjectModified(UObject* Object);
+    void HandleObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event);
+    void HandleObjectTransacted(UObject* Object, const FTransactionObjectEvent& Event);
+
+    uint64 NextRevision;
+    TMap<FObjectKey, FTrackedBlueprint> Tracked;
+    TMap<FObjectKey, uint64> GraphRevisions;
+
+    FDelegateHandle ObjectModifiedHandle;
+    FDelegateHandle ObjectPropertyChangedHandle;
+    FDelegateHandle ObjectTransactedHandle;
+};
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Json.h"
+#include "AssetRegistry/AssetData.h"
+#include "Containers/Ticker.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UObject/UObjectGlobals.h"
+#include <atomic>
+
+class FMCPClientConnection;
+class UBlueprint;
+
+/**
+ * Options for a project-wide blueprint scan
+ */
+struct FMCPBlueprintScanSettings
+{
+    /** Asset registry paths to search */
+    TArray<FName> PackagePaths = { FName(TEXT("/Game")) };
+    bool bRecursivePaths = true;
+
+    /** Only blueprints whose parent or native parent class has this name (empty = any) */
+    FString ParentClass;
+
+    /** Only assets carrying this asset registry tag, with this value if it is set */
+    FName TagName;
+    FString TagValue;
+
+    /** Stop after this many blueprints (0 = no limit) */
+    int32 MaxBlueprints = 0;
+
+    /** Game thread time spent extracting per tick */
+    float SliceMs = 8.0f;
+
+    /** Packages being loaded or waiting for extraction at once */
+    int32 MaxConcurrentLoads = 16;
+
+    /** Push each result to the requesting connection instead of holding it for get_scan_results */
+    bool bStream = false;
+
+    /** Extraction pauses while this many results wait to be collected (poll mode) */
+    int32 MaxBufferedResults = 256;
+
+    /** Extraction pauses while the connection has more than this many bytes queued (stream mode) */
+    int64 MaxPendingBytes = 8 * 1024 * 1024;
+};
+
+/** Builds the result for one blueprint on the game thread */
+using FMCPBlueprintExtractor = TFunction<TSharedPtr<FJsonObject>(UBlueprint*)>;
+
+/**
+ * Extracts data from every blueprint matching an asset registry filter without
+ * blocking the editor.
+ *
+ * The asset list comes from the asset registry, so nothing is loaded up front.
+ * Packages are loaded with LoadPackageAsync, a few at a time. A core ticker runs
+ * the extractor on loaded blueprints until the per-tick time slice is used up,
+ * and each result is serialized to JSON on the thread pool. Results are either
+ * pushed to the requesting connection as "blueprint_scan_result" messages or
+ * held as newline-delimited JSON until collected with TakeResults; in both
+ * cases extraction pauses while the consumer is behind.
+ */
+class UNREALMCP_API FMCPBlueprintScan : public TSharedFromThis<FMCPBlueprintScan, ESPMode::ThreadSafe>
+{
+public:
+    FMCPBlueprintScan(int32 InScanId, const FMCPBlueprintScanSettings& InSettings, FMCPBlueprintExtractor&& InExtractor,
+        const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe>& InConnection);
+    ~FMCPBlueprintScan();
+
+    /** Query the asset registry and start loading. Game thread only. */
+    void Start();
+
+    /** Stop loading and extracting; results already produced can still be collected. Game thread only. */
+    void Cancel();
+
+    int32 GetScanId() const { return ScanId; }
+    int32 GetTotal() const { return Assets.Num(); }
+
+    /** True once every blueprint has been extracted and serialized (or the scan was cancelled) */
+    bool IsFinished() const;
+
+    /** True when finished and every held result has been collected */
+    bool IsDrained() const;
+
+    /** Move up to MaxResults held results into OutLines as newline-delimited JSON; returns the count */
+    int32 TakeResults(int32 MaxResults, TArray<uint8>& OutLines);
+
+    /** Progress counters */
+    TSharedPtr<FJsonObject> GetStatus() const;
+
+private:
+    bool Tick(float DeltaTime);
+
+    /** Start package loads up to the concurrency limit */
+    void RequestLoads();
+
+    void HandlePackageLoaded(int32 AssetIndex, EAsyncLoadingResult::Type LoadResult);
+
+    /** Serialize a result on the thread pool and deliver it */
+    void Deliver(const TSharedRef<FJsonObject>& Result);
+
+    /** Extraction should wait for the consumer */
+    bool IsBackedUp() const;
+
+    void Finish();
+
+    const int32 ScanId;
+    const FMCPBlueprintScanSettings Settings;
+    const FMCPBlueprintExtractor Extractor;
+    TWeakPtr<FMCPClientConnection, ESPMode::ThreadSafe> Connection;
+    FTSTicker::FDelegateHandle TickerHandle;
+
+    // Game thread state
+    struct FLoadedBlueprint
+    {
+        int32 AssetIndex = INDEX_NONE;
+        TStrongObjectPtr<UBlueprint> Blueprint;
+    };
+    TArray<FAssetData> Assets;
+    TArray<FLoadedBlueprint> Ready;
+    int32 NextToLoad;
+    int32 LoadsInFlight;
+    bool bCancelled;
+    bool bFinished;
+
+    // Serialized results waiting for TakeResults (poll mode)
+    mutable FCriticalSection ResultsLock;
+    TArray<TArray<uint8>> Results;
+
+    // Counters
+    std::atomic<int32> SerializationsInFlight;
+    std::atomic<int32> Delivered;
+    int32 Extracted;
+    int32 Failed;
+    double ExtractSeconds;
+    double StartTime;
+    double FinishTime;
+};
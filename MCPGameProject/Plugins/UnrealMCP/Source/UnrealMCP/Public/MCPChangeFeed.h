@@ -0,0 +1,96 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Containers/Ticker.h"
+#include <atomic>
+
+class AActor;
+class FMCPClientConnection;
+class FTransactionObjectEvent;
+struct FAssetData;
+struct FPropertyChangedEvent;
+
+/**
+ * Revision counters for what clients cache, and a push feed of their changes.
+ *
+ *   level   actors of the editor world were added, deleted, moved or edited,
+ *           an undo/redo ran, or another map was opened
+ *   assets  an object outside any level was edited (blueprints, their graphs
+ *           and component templates), an asset was added, removed or renamed,
+ *           or an undo/redo ran
+ *
+ * A blueprint compile bumps both, since it reinstances the actors placed from
+ * it. Edits are classified by the outer chain of the modified object; objects
+ * in the transient package (editor UI state, previews) are ignored. Both
+ * counters only increase, and the epoch identifies the editor session, so a
+ * client never compares revisions of two sessions.
+ *
+ * Counters are bumped on the game thread and can be read from any thread.
+ * Subscribed connections get a {"event": "revisions", ...} push at most once per
+ * core ticker tick, and only when a counter changed, so dragging an actor costs
+ * at most one small message per frame.
+ */
+class UNREALMCP_API FMCPChangeFeed
+{
+public:
+    FMCPChangeFeed();
+    ~FMCPChangeFeed();
+
+    /** Push revision changes to a connection until it closes or unsubscribes. Game thread only. */
+    void Subscribe(const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe>& Connection);
+    void Unsubscribe(const FMCPClientConnection* Connection);
+
+    /** Bump a counter for edits that raise no editor events (the fake world) */
+    void MarkLevelChanged();
+    void MarkAssetsChanged();
+
+    /** {"epoch", "level", "assets"}. Any thread. */
+    TSharedPtr<FJsonObject> ToJson() const;
+
+    /** The same as condensed JSON, for response envelopes. Any thread. */
+    FString ToJsonString() const;
+
+private:
+    bool Tick(float DeltaTime);
+
+    // Classify an edited object as a level or an asset change
+    void HandleObjectChanged(UObject* Object);
+
+    void HandleObjectModified(UObject* Object);
+    void HandleObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event);
+    void HandleObjectTransacted(UObject* Object, const FTransactionObjectEvent& Event);
+    void HandleActorChanged(AActor* Actor);
+    void HandleActorsMoved(TArray<AActor*>& Actors);
+    void HandleMapChanged(uint32 MapChangeFlags);
+    void HandleMapOpened(const FString& Filename, bool bAsTemplate);
+    void HandleUndoRedo();
+    void HandleBlueprintCompiled();
+    void HandleAssetChanged(const FAssetData& AssetData);
+    void HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+
+    const FString Epoch;
+    std::atomic<uint64> LevelRevision;
+    std::atomic<uint64> AssetRevision;
+
+    // Game thread only
+    TArray<TWeakPtr<FMCPClientConnection, ESPMode::ThreadSafe>> Subscribers;
+    uint64 PushedLevelRevision;
+    uint64 PushedAssetRevision;
+    FTSTicker::FDelegateHandle TickerHandle;
+
+    FDelegateHandle ObjectModifiedHandle;
+    FDelegateHandle ObjectPropertyChangedHandle;
+    FDelegateHandle ObjectTransactedHandle;
+    FDelegateHandle ActorAddedHandle;
+    FDelegateHandle ActorDeletedHandle;
+    FDelegateHandle ActorMovedHandle;
+    FDelegateHandle ActorsMovedHandle;
+    FDelegateHandle MapChangeHandle;
+    FDelegateHandle MapOpenedHandle;
+    FDelegateHandle UndoRedoHandle;
+    FDelegateHandle BlueprintCompiledHandle;
+    FDelegateHandle AssetAddedHandle;
+    FDelegateHandle AssetRemovedHandle;
+    FDelegateHandle AssetRenamedHandle;
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Containers/Queue.h"
+#include "Sockets.h"
+#include "MCPWireProtocol.h"
+#include <atomic>
+
+class UUnrealMCPBridge;
+class FRunnableThread;
+class FMCPSharedMemoryChannel;
+
+/**
+ * One accepted client socket, serviced on its own thread.
+ *
+ * Requests are read with FMCPWireProtocol::ReadMessage, so a client may keep the
+ * connection open and send any number of commands. Other threads can queue
+ * unsolicited messages (stream frames, notifications) with EnqueuePush; they are
+ * written between requests by the connection thread.
+ *
+ * A client on the same machine may add a shared memory channel with
+ * open_shared_memory; large request and response payloads then bypass the socket
+ * (see MCPSharedMemory.h). Pushes always go over the socket.
+ */
+class UNREALMCP_API FMCPClientConnection : public FRunnable, public TSharedFromThis<FMCPClientConnection, ESPMode::ThreadSafe>
+{
+public:
+	FMCPClientConnection(UUnrealMCPBridge* InBridge, TSharedPtr<FSocket> InSocket, uint32 InConnectionId);
+	virtual ~FMCPClientConnection();
+
+	// Spawn the connection thread
+	bool Start();
+
+	// Stop the thread and wait for it to finish
+	void Shutdown();
+
+	// FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+	uint32 GetConnectionId() const { return ConnectionId; }
+	bool IsClosed() const { return bClosed; }
+
+	// Queue bytes to be sent outside of the request/response cycle. Thread safe.
+	bool EnqueuePush(TArray<uint8>&& Bytes);
+
+	// Bytes queued with EnqueuePush that have not been written yet
+	int64 GetPendingPushBytes() const { return PendingPushBytes; }
+
+	// Map a client's shared memory region, replacing any channel opened before. Connection thread only.
+	bool OpenSharedMemory(const FString& Name, int64 RingSize, int32 MinPayload, FString& OutError);
+
+private:
+	void HandleMessage(const FMCPIncomingMessage& Message);
+
+	// Answer a request that cannot be executed with an error envelope, so the client is not left waiting
+	void SendErrorResponse(const FString& Error, EMCPFrameEncoding Encoding, const TSharedPtr<FJsonValue>& Id);
+	void FlushPushQueue();
+
+	// Write all bytes to the socket, retrying partial and would-block sends
+	bool SendBytes(const TArray<uint8>& Bytes);
+
+	UUnrealMCPBridge* Bridge;
+	TSharedPtr<FSocket> Socket;
+	uint32 ConnectionId;
+	FRunnableThread* Thread;
+
+	TArray<uint8> ReceiveBuffer;
+
+	// Brace matching progress through a partly received JSON message
+	FMCPJsonScanState JsonScan;
+	TQueue<TArray<uint8>, EQueueMode::Mpsc> PushQueue;
+	std::atomic<int64> PendingPushBytes;
+	std::atomic<bool> bRunning;
+	std::atomic<bool> bClosed;
+
+	// Only touched by the connection thread
+	TUniquePtr<FMCPSharedMemoryChannel> SharedMemory;
+};
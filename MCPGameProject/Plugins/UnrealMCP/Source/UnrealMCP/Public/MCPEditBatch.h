@@ -0,0 +1,66 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Json.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UBlueprint;
+
+/**
+ * Groups the edits of several commands into one editor transaction (a single
+ * undo entry) and defers the notifications each edit would otherwise fire.
+ *
+ * While a batch is active, FUnrealMCPCommonUtils::MarkBlueprintModified,
+ * CompileBlueprint and SaveBlueprint only record the blueprint. Commit ends the
+ * transaction, then marks each recorded blueprint modified once (structurally
+ * if any edit asked for it), compiles the ones that asked to be compiled, saves
+ * the ones that asked to be saved and redraws the level viewports once.
+ * Rollback ends the transaction, undoes it and drops the pending notifications,
+ * so nothing from a rolled back batch reaches disk.
+ *
+ * At most one batch is active at a time. Game thread only.
+ */
+class UNREALMCP_API FMCPEditBatch
+{
+public:
+    /** Begin the editor transaction and make this the active batch */
+    explicit FMCPEditBatch(const FString& InDescription);
+
+    /** Commits if neither Commit nor Rollback was called */
+    ~FMCPEditBatch();
+
+    /** The active batch, or null */
+    static FMCPEditBatch* Get();
+
+    /** Deferred notifications */
+    void DeferBlueprintModified(UBlueprint* Blueprint, bool bStructural);
+    void DeferCompile(UBlueprint* Blueprint);
+    void DeferSave(UBlueprint* Blueprint);
+
+    /** End the transaction and flush deferred notifications; returns what was flushed */
+    TSharedPtr<FJsonObject> Commit();
+
+    /** End the transaction and undo it */
+    void Rollback();
+
+    const FString& GetDescription() const { return Description; }
+    double GetAge() const { return FPlatformTime::Seconds() - StartTime; }
+
+private:
+    void EndTransaction();
+
+    struct FPendingBlueprint
+    {
+        TWeakObjectPtr<UBlueprint> Blueprint;
+        bool bStructural = false;
+        bool bCompile = false;
+        bool bSave = false;
+    };
+    FPendingBlueprint& FindOrAddPending(UBlueprint* Blueprint);
+
+    const FString Description;
+    const double StartTime;
+    FGuid TransactionId;
+    bool bOpen;
+    TArray<FPendingBlueprint> Pending;
+};
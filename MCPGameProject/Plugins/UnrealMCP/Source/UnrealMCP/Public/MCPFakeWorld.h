@@ -0,0 +1,66 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+/**
+ * Stand-in for the editor world, used by the headless host (see
+ * UnrealMCPHostCommandlet.h) to load-test the transport, framing, game-thread
+ * scheduling and JSON serialization without loading a map or spawning UObjects.
+ *
+ * Actors are plain records (name, class, transform) with handles of their own.
+ * The common actor commands are served with the same parameters and result
+ * shapes as FUnrealMCPEditorCommands, so clients and benchmarks run unchanged;
+ * every other command returns an "Unknown command" error. Edits are not recorded
+ * in the undo buffer, so rolled back transactions keep them.
+ *
+ * Game thread only, like the real handlers.
+ */
+class UNREALMCP_API FMCPFakeWorld
+{
+public:
+    FMCPFakeWorld();
+
+    /**
+     * Route a command to its fake handler. bOutChanged is set if the command
+     * added, removed or moved an actor; failed and read-only commands leave it false.
+     */
+    TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, bool& bOutChanged);
+
+    /** Add Count StaticMeshActors named <Prefix>_<i> on a square grid with Spacing between them */
+    void Populate(int32 Count, const FString& Prefix = TEXT("FakeActor"), double Spacing = 200.0);
+
+    int32 Num() const { return Actors.Num(); }
+
+private:
+    struct FFakeActor
+    {
+        int32 Handle = 0;
+        FString Name;
+        FString Class;
+        FTransform Transform;
+    };
+
+    FFakeActor* AddActor(const FString& Name, const FString& Class, const FTransform& Transform);
+    FFakeActor* FindActorFromParams(const TSharedPtr<FJsonObject>& Params, FString& OutError);
+    static TSharedPtr<FJsonObject> ActorToJsonObject(const FFakeActor& Actor);
+
+    // Command handlers
+    TSharedPtr<FJsonObject> HandleGetActorsInLevel(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleFindActorsByName(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleSpawnActor(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleSpawnActorsBulk(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleDeleteActor(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleSetActorTransform(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleSetTransformsBulk(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleGetActorProperties(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleFindActorsInRadius(const TSharedPtr<FJsonObject>& Params);
+
+    /** Actors by handle */
+    TMap<int32, FFakeActor> Actors;
+    TMap<FString, int32> HandlesByName;
+    int32 NextHandle;
+
+    /** Set by the handlers when the current command edits the world */
+    bool bChanged;
+};
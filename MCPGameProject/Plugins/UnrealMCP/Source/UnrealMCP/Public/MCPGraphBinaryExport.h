@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UBlueprint;
+class UEdGraph;
+
+/**
+ * Compact binary export of blueprint graphs ("MCPG").
+ *
+ * Carries the same nodes, pins and connections as the JSON graph data, but
+ * every name, title and category is stored once in a string table, GUIDs are
+ * 16 raw bytes, and nodes, pins and edges are laid out as struct-of-arrays
+ * columns so a reader can load each column with a single copy.
+ *
+ * All integers are little endian; string references are u32 indices into the
+ * string table, MCPG_NO_STRING when absent.
+ *
+ *   Header (28 bytes)
+ *     char[4]  magic "MCPG"
+ *     u16      version (MCPG_VERSION)
+ *     u16      reserved
+ *     u32      string_count, graph_count, node_count, pin_count, edge_count
+ *   Strings    string_count x { u32 byte_length, UTF-8 bytes }
+ *   Graphs     graph_count x { u32 name, u32 type, u32 first_node, u32 node_count, u32 first_edge, u32 edge_count }
+ *   Nodes      guid[16 x N], class u32[N], title u32[N], member u32[N],
+ *              pos_x i32[N], pos_y i32[N], first_pin u32[N], pin_count u32[N], category u8[N]
+ *   Pins       guid[16 x P], node u32[P], name u32[P], category u32[P], sub_category u32[P],
+ *              object u32[P], default_value u32[P], flags u8[P]
+ *   Edges      from_pin u32[E], to_pin u32[E]
+ *
+ * GUIDs are the four FGuid components A, B, C, D as u32 each. Node categories
+ * follow EMCPGraphNodeCategory and pin flags EMCPGraphPinFlags. Edges run from an
+ * output pin to the input pin it is linked to, as pin indices.
+ */
+#define MCPG_VERSION 1
+#define MCPG_NO_STRING 0xFFFFFFFFu
+
+enum class EMCPGraphNodeCategory : uint8
+{
+    Other = 0,
+    Event = 1,
+    FunctionCall = 2,
+    VariableGet = 3,
+    VariableSet = 4,
+    CustomEvent = 5
+};
+
+enum class EMCPGraphPinFlags : uint8
+{
+    None = 0,
+    Output = 1 << 0,
+    Reference = 1 << 1,
+    Const = 1 << 2
+};
+ENUM_CLASS_FLAGS(EMCPGraphPinFlags);
+
+/**
+ * Counts describing an export
+ */
+struct FMCPGraphExportStats
+{
+    int32 StringCount = 0;
+    int32 GraphCount = 0;
+    int32 NodeCount = 0;
+    int32 PinCount = 0;
+    int32 EdgeCount = 0;
+};
+
+class UNREALMCP_API FMCPGraphBinaryExport
+{
+public:
+    /** Serialize the given graphs of a blueprint into OutBytes */
+    static FMCPGraphExportStats Export(const UBlueprint* Blueprint, const TArray<UEdGraph*>& Graphs, TArray<uint8>& OutBytes);
+};
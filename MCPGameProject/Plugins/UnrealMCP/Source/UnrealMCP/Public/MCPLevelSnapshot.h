@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+
+/**
+ * Compact record of one actor at snapshot time
+ */
+struct FMCPActorSnapshot
+{
+    /** Actor handle (see MCPActorHandles.h); snapshots are sorted by it */
+    int32 Handle = 0;
+    FName Name;
+    FName Class;
+    FVector3f Location = FVector3f::ZeroVector;
+    FRotator3f Rotation = FRotator3f::ZeroRotator;
+    FVector3f Scale = FVector3f::OneVector;
+    /** Hash of the selected properties of the actor (and its components, when included) */
+    uint64 PropertyHash = 0;
+};
+
+/**
+ * Result of comparing two snapshots. Indices refer to the entries of the
+ * snapshot each list came from.
+ */
+struct FMCPLevelSnapshotDiff
+{
+    struct FChange
+    {
+        int32 FromIndex = INDEX_NONE;
+        int32 ToIndex = INDEX_NONE;
+        bool bTransform = false;
+        bool bProperties = false;
+        bool bRenamed = false;
+    };
+
+    TArray<int32> Added;
+    TArray<int32> Removed;
+    TArray<FChange> Changed;
+};
+
+/**
+ * In-memory snapshot of the actors of a world: identity, class, transform and a
+ * hash of selected properties, about 70 bytes per actor.
+ *
+ * Identity, transforms and the property lists to hash are read on the game thread.
+ * The property hashing runs in a ParallelFor; the game thread waits inside it, so
+ * nothing mutates the actors while the workers read them. Plain-old-data properties
+ * are hashed from memory, everything else from its exported text.
+ */
+class UNREALMCP_API FMCPLevelSnapshot
+{
+public:
+    /**
+     * Capture the actors of World. With PropertyNames empty, every editable property
+     * of each actor is hashed, plus those of its components if bIncludeComponents;
+     * otherwise only the named actor properties are. Game thread only.
+     */
+    static TSharedRef<FMCPLevelSnapshot> Capture(UWorld* World, const TArray<FName>& PropertyNames, bool bIncludeComponents);
+
+    /** Actors added, removed or changed from From to To, matched by handle */
+    static FMCPLevelSnapshotDiff Diff(const FMCPLevelSnapshot& From, const FMCPLevelSnapshot& To, float TransformTolerance);
+
+    /** True if both snapshots hashed the same properties, so their hashes can be compared */
+    bool HasSamePropertySelection(const FMCPLevelSnapshot& Other) const;
+
+    const TArray<FMCPActorSnapshot>& GetEntries() const { return Entries; }
+    const TArray<FName>& GetPropertyNames() const { return PropertyNames; }
+    bool IncludesComponents() const { return bIncludeComponents; }
+    FDateTime GetCaptureTime() const { return CaptureTime; }
+    double GetCaptureSeconds() const { return CaptureSeconds; }
+    double GetHashSeconds() const { return HashSeconds; }
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    TArray<FMCPActorSnapshot> Entries;
+    TArray<FName> PropertyNames;
+    bool bIncludeComponents = false;
+    FDateTime CaptureTime;
+    double CaptureSeconds = 0.0;
+    double HashSeconds = 0.0;
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Logging/LogMacros.h"
+
+/**
+ * Log category for everything the plugin writes. Defaults to Log, so per-request
+ * detail stays out of the console; raise it at runtime with
+ *
+ *   Log LogUnrealMCP Verbose       request and response previews
+ *   Log LogUnrealMCP VeryVerbose   full payloads (expensive for large responses)
+ *
+ * or at startup with -LogCmds="LogUnrealMCP Verbose".
+ */
+UNREALMCP_API DECLARE_LOG_CATEGORY_EXTERN(LogUnrealMCP, Log, All);
+
+struct UNREALMCP_API FMCPLog
+{
+    /**
+     * At most UnrealMCP.Log.PreviewChars characters of a payload, noting how much
+     * was cut; the whole payload when LogUnrealMCP is at VeryVerbose
+     */
+    static FString Preview(const FString& Text);
+    static FString Preview(const TArray<uint8>& Utf8);
+
+    /**
+     * Rate limit for per-request log lines: true for the first
+     * UnrealMCP.Log.MaxRequestsPerSecond requests of a command type in each second.
+     * OutSuppressed is the number of requests of that type skipped since the last
+     * line that was logged. Thread safe.
+     */
+    static bool ShouldLogRequest(const FString& CommandType, int32& OutSuppressed);
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+
+/**
+ * MessagePack encoding of the JSON envelopes, for frames with
+ * EMCPFrameEncoding::MessagePack (see MCPWireProtocol.h).
+ *
+ * Values map one to one onto JSON: nil, booleans, integers and float64 become
+ * numbers, str becomes a string, array and map their JSON counterparts (map keys
+ * must be strings). bin is rejected; bulk bytes belong in the frame payload.
+ * Integral numbers are written as integers, everything else as float64, so no
+ * precision is lost either way.
+ *
+ * Three extension types give the structures commands return most often a compact
+ * form. Writers use them wherever a value qualifies, and readers expand them
+ * back to plain values, so handlers never see them:
+ *
+ *   type  name         data                                  expands to
+ *   1     float array  N little-endian float64               [x, y, ...], N >= 2
+ *   2     guid         16 bytes                              32 uppercase hex digits
+ *   3     records      array [[keys], [values], [values]...] [{key: value, ...}, ...]
+ *
+ * A float array is written for arrays of two or more numbers of which at least
+ * one is not integral: vectors, rotators, transforms, pin positions. Records are
+ * written for arrays of two or more objects with the same keys in the same
+ * order, such as actor lists, so each key is sent once instead of once per
+ * element.
+ */
+class UNREALMCP_API FMCPMessagePack
+{
+public:
+    /**
+     * Append an object as a map. The top-level map always has a 32-bit count, so
+     * fields can be added to it later with AppendField.
+     */
+    static void Write(const TSharedPtr<FJsonObject>& Object, TArray<uint8>& OutBytes);
+
+    /** Add Name: Value to a map written by Write that starts at the front of Bytes */
+    static bool AppendField(TArray<uint8>& Bytes, const FString& Name, const TSharedPtr<FJsonValue>& Value);
+
+    /** Decode a map; the whole buffer must be one value */
+    static bool Read(const uint8* Data, int32 Num, TSharedPtr<FJsonObject>& OutObject, FString& OutError);
+
+    /** The same value as condensed JSON, for logs */
+    static FString ToJsonString(const TArray<uint8>& Bytes);
+};
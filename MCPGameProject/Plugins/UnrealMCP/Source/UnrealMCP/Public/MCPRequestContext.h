@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FMCPClientConnection;
+
+/**
+ * Information about the command currently being dispatched on the game thread.
+ * Handlers that need more than their JSON params (for example to push messages
+ * back to the client later) read it through Get().
+ */
+struct UNREALMCP_API FMCPRequestContext
+{
+    /** Server-assigned id of the request */
+    uint64 RequestId = 0;
+
+    /** Connection the command arrived on; null for in-process calls */
+    TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe> Connection;
+
+    /** Binary payload that arrived with the request; empty for plain JSON requests */
+    TArray<uint8> RequestAttachment;
+
+    /** Binary payload sent with the response of a synchronous handler */
+    TArray<uint8> ResponseAttachment;
+
+    /** Next request id; ids start at 1 and are unique for the editor session. Any thread. */
+    static uint64 AllocateRequestId();
+
+    /** Context of the command being dispatched, or null outside of dispatch. Game thread only. */
+    static const FMCPRequestContext* Get();
+
+    /**
+     * Attach a binary payload to the response of the command being dispatched.
+     * Returns false outside of dispatch. Game thread only.
+     */
+    static bool SetResponseAttachment(TArray<uint8>&& Attachment);
+
+    /** Makes a context current for the lifetime of the scope */
+    class UNREALMCP_API FScope
+    {
+    public:
+        explicit FScope(FMCPRequestContext& Context);
+        ~FScope();
+
+    private:
+        FMCPRequestContext* Previous;
+    };
+};
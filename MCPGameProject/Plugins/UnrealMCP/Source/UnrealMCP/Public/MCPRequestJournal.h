@@ -0,0 +1,93 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Containers/Queue.h"
+#include <atomic>
+
+class FRunnableThread;
+class FEvent;
+class IFileHandle;
+
+/**
+ * Binary journal of the requests and responses that pass through the server,
+ * written to disk on its own thread so the connection threads only copy bytes.
+ *
+ * File layout (little endian): the 8-byte file header "MCPJ", uint32 version
+ * (MCP_JOURNAL_VERSION), uint32 reserved; then one record per request or response:
+ *
+ *   offset  size  field
+ *   0       1     kind (EMCPJournalRecordKind)
+ *   1       1     encoding of the envelope (EMCPFrameEncoding: JSON or MessagePack)
+ *   2       2     reserved, 0
+ *   4       4     connection id
+ *   8       8     request id
+ *   16      8     seconds since the journal was opened (double)
+ *   24      4     envelope length in bytes
+ *   28      4     attachment length in bytes
+ *   32      4     responses: milliseconds queued for the game thread (float), else 0
+ *   36      4     responses: milliseconds executing (float), else 0
+ *   40      ...   envelope, then the attachment
+ *
+ * Python/scripts/benchmarks/replay_journal.py reads journals and replays them.
+ *
+ * When the writer falls behind by more than UnrealMCP.Journal.MaxPendingMB, new
+ * records are dropped and counted rather than held in memory.
+ */
+#define MCP_JOURNAL_VERSION 1
+#define MCP_JOURNAL_FILE_HEADER_SIZE 16
+#define MCP_JOURNAL_RECORD_HEADER_SIZE 40
+
+enum class EMCPJournalRecordKind : uint8
+{
+    Request = 1,
+    Response = 2
+};
+
+class UNREALMCP_API FMCPRequestJournal : public FRunnable
+{
+public:
+    /** Create or truncate the file and start the writer thread. Null on failure. */
+    static TSharedPtr<FMCPRequestJournal, ESPMode::ThreadSafe> Open(const FString& Path, FString& OutError);
+
+    virtual ~FMCPRequestJournal();
+
+    /** Queue a record. Thread safe; the data is copied. */
+    void Record(EMCPJournalRecordKind Kind, uint32 ConnectionId, uint64 RequestId, double Time,
+        const uint8* Json, int32 JsonSize, const uint8* Attachment, int32 AttachmentSize, uint8 Encoding = 0,
+        float QueueMs = 0.0f, float ExecuteMs = 0.0f);
+
+    /** Stop accepting records, write everything queued and close the file */
+    void Close();
+
+    const FString& GetPath() const { return Path; }
+    int64 GetRecordsWritten() const { return RecordsWritten; }
+    int64 GetRecordsDropped() const { return RecordsDropped; }
+    int64 GetBytesWritten() const { return BytesWritten; }
+
+    /** {path, records_written, records_dropped, bytes_written} */
+    TSharedPtr<class FJsonObject> ToJson() const;
+
+    // FRunnable interface
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+private:
+    FMCPRequestJournal(const FString& InPath, IFileHandle* InFile);
+
+    void WriteQueued();
+
+    FString Path;
+    IFileHandle* File;
+    FRunnableThread* Thread;
+    FEvent* WakeEvent;
+    double OpenTime;
+
+    TQueue<TArray<uint8>, EQueueMode::Mpsc> Queue;
+    std::atomic<int64> PendingBytes;
+    std::atomic<int64> RecordsWritten;
+    std::atomic<int64> RecordsDropped;
+    std::atomic<int64> BytesWritten;
+    std::atomic<bool> bRunning;
+    std::atomic<bool> bAccepting;
+};
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+
+class FViewport;
+
+/**
+ * Options for a screenshot capture
+ */
+struct FMCPScreenshotRequest
+{
+    /** Output format: "png" or "jpeg" */
+    FString Format = TEXT("png");
+
+    /** JPEG quality (1-100); ignored for PNG */
+    int32 Quality = 85;
+
+    /** Downscale so the image fits in this box (0 = no limit) */
+    int32 MaxWidth = 0;
+    int32 MaxHeight = 0;
+
+    /** Uniform downscale factor applied before the max size clamp (1 = native) */
+    float Scale = 1.0f;
+
+    /** Capture from the offscreen stand-in instead of the viewport */
+    bool bOffscreen = false;
+
+    /** Size of the offscreen stand-in image */
+    FIntPoint OffscreenSize = FIntPoint(1280, 720);
+
+    /** If set, the encoded image is also written to this file from the worker thread */
+    FString FilePath;
+};
+
+/**
+ * Outcome of a screenshot capture
+ */
+struct FMCPScreenshotResult
+{
+    bool bSuccess = false;
+    FString Error;
+
+    /** Encoded image bytes */
+    TArray<uint8> EncodedImage;
+
+    FString Format;
+    FString Source;
+    FString FilePath;
+    FIntPoint SourceSize = FIntPoint::ZeroValue;
+    FIntPoint OutputSize = FIntPoint::ZeroValue;
+
+    /** Time spent waiting for the GPU readback, and encoding on the worker thread */
+    double ReadbackMs = 0.0;
+    double EncodeMs = 0.0;
+
+    /** The image is the offscreen test pattern, not a render of the scene */
+    bool bPlaceholder = false;
+};
+
+/**
+ * Raw pixels from a capture, already downscaled to the requested size
+ */
+struct FMCPRawCapture
+{
+    bool bSuccess = false;
+    FString Error;
+
+    /** BGRA pixels, OutputSize.X * OutputSize.Y entries */
+    TArray<FColor> Pixels;
+
+    FString Source;
+    FIntPoint SourceSize = FIntPoint::ZeroValue;
+    FIntPoint OutputSize = FIntPoint::ZeroValue;
+    double ReadbackMs = 0.0;
+
+    /** The pixels are the offscreen test pattern, not a render of the scene */
+    bool bPlaceholder = false;
+};
+
+/**
+ * Asynchronous screenshot pipeline.
+ *
+ * The viewport is copied into a staging texture with a non-blocking GPU readback
+ * that is polled from the core ticker, so the game thread never waits on a GPU
+ * flush. Resizing, PNG/JPEG encoding and the optional file write run on the
+ * thread pool. When rendering is unavailable (-nullrhi) or explicitly requested,
+ * an offscreen stand-in produces a deterministic test image that goes through the
+ * same resize/encode path. The stand-in is a placeholder: it does not render the
+ * scene, and results from it have bPlaceholder set.
+ *
+ * Must be called from the game thread. The returned future is fulfilled on a
+ * worker thread.
+ */
+class UNREALMCP_API FMCPScreenshotCapture
+{
+public:
+    /** Capture the given viewport (or the offscreen stand-in) and encode it */
+    static TFuture<FMCPScreenshotResult> CaptureAsync(FViewport* Viewport, const FMCPScreenshotRequest& Request);
+
+    /** Capture and downscale without encoding; format, quality and file path are ignored */
+    static TFuture<FMCPRawCapture> CaptureRawAsync(FViewport* Viewport, const FMCPScreenshotRequest& Request);
+
+    /** Resize and encode raw BGRA pixels on the thread pool. Must be called from the game thread. */
+    static TFuture<FMCPScreenshotResult> EncodeAsync(TArray<FColor>&& Pixels, FIntPoint Size, const FMCPScreenshotRequest& Request, const FString& Source, double ReadbackMs);
+
+    /** Fill a buffer with the offscreen stand-in test pattern */
+    static void RenderOffscreenStandIn(FIntPoint Size, TArray<FColor>& OutPixels);
+
+    /** True if a real viewport readback is possible in this process */
+    static bool CanReadbackViewport(FViewport* Viewport);
+
+    /** Compute the output size after applying scale and max size limits */
+    static FIntPoint ComputeOutputSize(FIntPoint SourceSize, const FMCPScreenshotRequest& Request);
+};
@@ -6,14 +6,17 @@
 #include "Interfaces/IPv4/IPv4Address.h"
 
 class UUnrealMCPBridge;
+class FMCPClientConnection;
 
 /**
- * Runnable class for the MCP server thread
+ * Runnable class for the MCP server thread.
+ * Accepts clients on every listener (TCP, and a Unix domain socket when configured)
+ * and hands each one to an FMCPClientConnection with its own thread.
  */
 class FMCPServerRunnable : public FRunnable
 {
 public:
-	FMCPServerRunnable(UUnrealMCPBridge* InBridge, TSharedPtr<FSocket> InListenerSocket);
+	FMCPServerRunnable(UUnrealMCPBridge* InBridge, const TArray<TSharedPtr<FSocket>>& InListenerSockets);
 	virtual ~FMCPServerRunnable();
 
 	// FRunnable interface
@@ -22,13 +25,15 @@ public:
 	virtual void Stop() override;
 	virtual void Exit() override;
 
-protected:
-	void HandleClientConnection(TSharedPtr<FSocket> ClientSocket);
-	void ProcessMessage(TSharedPtr<FSocket> Client, const FString& Message);
-
 private:
+	void AcceptConnection(FSocket& ListenerSocket);
+
+	// Release connections whose client has gone away
+	void PruneClosedConnections();
+
 	UUnrealMCPBridge* Bridge;
-	TSharedPtr<FSocket> ListenerSocket;
-	TSharedPtr<FSocket> ClientSocket;
+	TArray<TSharedPtr<FSocket>> ListenerSockets;
+	TArray<TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe>> Connections;
+	uint32 NextConnectionId;
 	bool bRunning;
-}; 
\ No newline at end of file
+};
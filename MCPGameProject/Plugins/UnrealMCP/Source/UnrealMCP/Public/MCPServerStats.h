@@ -0,0 +1,103 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "HAL/CriticalSection.h"
+#include "MCPWireProtocol.h"
+
+/**
+ * Log-linear latency histogram in the style of HdrHistogram. Values are bucketed
+ * in microseconds: exact below 8 us, then 8 buckets per power of two, so any
+ * reported percentile is within 12.5% of the true value up to about 4.7 hours.
+ * Recording is a few integer operations and the histogram is a fixed 1 KB.
+ */
+class UNREALMCP_API FMCPLatencyHistogram
+{
+public:
+    FMCPLatencyHistogram();
+
+    void Record(double Seconds);
+    void Merge(const FMCPLatencyHistogram& Other);
+
+    uint64 GetCount() const { return Count; }
+
+    /** Upper bound of the bucket holding the given fraction of values, in seconds */
+    double GetPercentile(double Fraction) const;
+
+    /** {count, mean_ms, p50_ms, p90_ms, p99_ms, p999_ms, max_ms} */
+    TSharedPtr<FJsonObject> ToJson() const;
+
+private:
+    static constexpr int32 SubBucketBits = 3;
+    static constexpr int32 SubBucketCount = 1 << SubBucketBits;
+    static constexpr int32 NumBuckets = 32 * SubBucketCount;
+
+    static int32 GetBucket(uint64 Micros);
+    static uint64 GetBucketUpperBound(int32 Bucket);
+
+    uint32 Buckets[NumBuckets];
+    uint64 Count;
+    double SumSeconds;
+    double MaxSeconds;
+};
+
+/**
+ * Request counters and per-phase latency histograms for every command type.
+ *
+ * A request's timestamps (FMCPRequestTiming) split it into phases:
+ *   parse      receive -> dispatch       JSON parsing on the connection thread
+ *   queue      dispatch -> start         waiting for the game thread
+ *   execute    start -> end              the command handler
+ *   serialize  end -> serialize end      envelope, hand-off to the connection thread, encoding
+ *   send       serialize end -> send end writing to the socket
+ *   total      receive -> send end
+ *
+ * Command types are whatever clients send, so at most MaxCommandTypes get their
+ * own entry; requests of any further type are counted under "other".
+ *
+ * Thread safe. Recording takes a short lock, so get_server_stats can read the
+ * stats from a connection thread while the game thread is busy.
+ */
+class UNREALMCP_API FMCPServerStats
+{
+public:
+    FMCPServerStats();
+
+    void RecordRequest(const FString& CommandType, const FMCPRequestTiming& Timing, bool bError, int64 BytesIn, int64 BytesOut);
+
+    /** Totals over all commands, plus one entry per command if bPerCommand */
+    TSharedPtr<FJsonObject> ToJson(bool bPerCommand) const;
+
+    void Reset();
+
+private:
+    enum EPhase
+    {
+        Parse,
+        Queue,
+        Execute,
+        Serialize,
+        Send,
+        Total,
+        NumPhases
+    };
+
+    struct FCommandStats
+    {
+        uint64 Requests = 0;
+        uint64 Errors = 0;
+        int64 BytesIn = 0;
+        int64 BytesOut = 0;
+        FMCPLatencyHistogram Phases[NumPhases];
+
+        void Merge(const FCommandStats& Other);
+        TSharedPtr<FJsonObject> ToJson() const;
+    };
+
+    /** Well above the number of commands the bridge implements */
+    static constexpr int32 MaxCommandTypes = 256;
+
+    mutable FCriticalSection Lock;
+    TMap<FString, FCommandStats> Commands;
+    double StartTime;
+};
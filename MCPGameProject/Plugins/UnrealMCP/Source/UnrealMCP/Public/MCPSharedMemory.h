@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformMemory.h"
+
+/**
+ * Shared memory rings that carry large payloads between the server and a client
+ * on the same machine, so a screenshot or a bulk buffer is one memcpy on each side
+ * instead of many trips through loopback TCP.
+ *
+ * The client creates a named region and sends open_shared_memory on its TCP
+ * connection; the server maps the region for that connection only. TCP stays the
+ * control channel: every request and response is still a message on the socket,
+ * and only the frame payload moves into the region.
+ *
+ * Region layout (little endian):
+ *
+ *   offset        size  field
+ *   0             4     magic "MCPS"
+ *   4             4     version (MCP_SHARED_MEMORY_VERSION)
+ *   8             8     ring size in bytes, per direction
+ *   16            8     request ring tail: bytes consumed by the server (server writes)
+ *   24            8     response ring tail: bytes consumed by the client (client writes)
+ *   64            ring  request ring, client to server
+ *   64 + ring     ring  response ring, server to client
+ *
+ * Positions count bytes since the region was opened. A payload at position P is
+ * stored at offset P % ring size and never wraps; a writer whose payload would
+ * cross the end of the ring skips to its start. A writer may fill the ring up to
+ * the reader's tail. When a payload does not fit, it is sent inline on TCP as
+ * before, so neither side ever waits for the other.
+ *
+ * A frame with MCP_FRAME_FLAG_SHARED_PAYLOAD in its flags carries a descriptor
+ * instead of its payload: uint64 position, uint64 length. The reader copies the
+ * payload out and moves its tail past it. Descriptors are read in the order
+ * their frames arrive, so tails only move forward.
+ */
+#define MCP_SHARED_MEMORY_MAGIC 0x5350434D  // "MCPS"
+#define MCP_SHARED_MEMORY_VERSION 1
+#define MCP_SHARED_MEMORY_HEADER_SIZE 64
+#define MCP_SHARED_PAYLOAD_DESCRIPTOR_SIZE 16
+
+// Largest ring a client may ask for, per direction
+#define MCP_SHARED_MEMORY_MAX_RING_SIZE (1024ll * 1024 * 1024)
+
+class UNREALMCP_API FMCPSharedMemoryChannel
+{
+public:
+    /**
+     * Map a region created by a client. Payloads smaller than MinPayload stay
+     * inline. Null, with OutError set, if the region is missing or is not a channel.
+     */
+    static TUniquePtr<FMCPSharedMemoryChannel> Open(const FString& Name, int64 RingSize, int32 MinPayload, FString& OutError);
+
+    ~FMCPSharedMemoryChannel();
+
+    /** Replace a request descriptor with the payload it points to, and release its ring space */
+    bool ReadRequestPayload(TArray<uint8>& InOutPayload, FString& OutError);
+
+    /**
+     * Copy a response payload into the response ring and describe it. False if
+     * the payload is small or does not fit right now; it is then sent inline.
+     */
+    bool WriteResponsePayload(const TArray<uint8>& Payload, TArray<uint8>& OutDescriptor);
+
+    const FString& GetName() const { return Name; }
+    int64 GetRingSize() const { return RingSize; }
+
+private:
+    FMCPSharedMemoryChannel(const FString& InName, FPlatformMemory::FSharedMemoryRegion* InRegion, int64 InRingSize, int32 InMinPayload);
+
+    volatile int64* RequestTailPtr() const { return reinterpret_cast<volatile int64*>(Base + 16); }
+    volatile int64* ResponseTailPtr() const { return reinterpret_cast<volatile int64*>(Base + 24); }
+
+    FString Name;
+    FPlatformMemory::FSharedMemoryRegion* Region;
+    uint8* Base;
+    int64 RingSize;
+    int32 MinPayload;
+
+    // Next free position of the response ring; only this side writes it
+    uint64 ResponseHead;
+};
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtr.h"
+#include "Templates/Function.h"
+
+class AActor;
+class UWorld;
+
+/**
+ * Uniform grid over the bounds of every actor in the editor world, so spatial
+ * queries only visit the cells they overlap instead of every actor.
+ *
+ * Cells are XY columns; Z is tested per actor. An actor is stored in every cell
+ * its bounds overlap, except actors covering more than MaxCellsPerActor cells
+ * (landscapes, sky spheres, ...), which live in a separate list every query checks.
+ *
+ * The index follows the editor's actor added, deleted and moved events. Added and
+ * moved actors are only queued and re-bounded on the next Refresh, so a drag or a
+ * deferred spawn costs nothing until someone queries. Commands that move actors
+ * without a move event call NotifyActorMoved. Undo/redo and a change of editor
+ * world rebuild the whole index on the next Refresh.
+ *
+ * Game thread only.
+ */
+class UNREALMCP_API FMCPSpatialIndex
+{
+public:
+    explicit FMCPSpatialIndex(double InCellSize = 2000.0);
+    ~FMCPSpatialIndex();
+
+    /** Bring the index up to date for World. Returns true if it had to be rebuilt. */
+    bool Refresh(UWorld* World);
+
+    /** Queue an actor whose bounds changed without an editor move event */
+    void NotifyActorMoved(AActor* Actor);
+
+    struct FHit
+    {
+        AActor* Actor;
+        double DistanceSquared;
+    };
+
+    /** Accepts or rejects a candidate actor */
+    using FFilter = TFunctionRef<bool(const AActor*)>;
+
+    /**
+     * Actors whose bounds intersect the sphere, unordered, with the squared distance
+     * from Center to their bounds. Stops after MaxResults; returns false if it did.
+     */
+    bool QuerySphere(const FVector& Center, double Radius, FFilter Filter, int32 MaxResults, TArray<FHit>& OutHits);
+
+    /** Actors whose bounds intersect Box, unordered. Stops after MaxResults; returns false if it did. */
+    bool QueryBox(const FBox& Box, FFilter Filter, int32 MaxResults, TArray<FHit>& OutHits);
+
+    /** Up to Count actors closest to Point (distance to their bounds), nearest first. MaxDistance <= 0 means unlimited. */
+    void QueryNearest(const FVector& Point, int32 Count, double MaxDistance, FFilter Filter, TArray<FHit>& OutHits);
+
+    /** Actors currently indexed */
+    int32 Num() const { return EntryIndices.Num(); }
+
+    /** Duration of the last full rebuild */
+    double GetLastBuildSeconds() const { return LastBuildSeconds; }
+
+private:
+    struct FEntry
+    {
+        TWeakObjectPtr<AActor> Actor;
+        TObjectKey<AActor> Key;
+        FBox Bounds = FBox(ForceInit);
+        FIntPoint MinCell = FIntPoint::ZeroValue;
+        FIntPoint MaxCell = FIntPoint::ZeroValue;
+        bool bOversized = false;
+        uint32 QueryStamp = 0;
+    };
+
+    void Rebuild(UWorld* World);
+    void Reset();
+    void InsertActor(AActor* Actor);
+    void UpdateActor(AActor* Actor);
+    void RemoveEntry(int32 EntryIndex);
+    void LinkEntry(int32 EntryIndex);
+    void UnlinkEntry(int32 EntryIndex);
+
+    FIntPoint GetCell(const FVector& Location) const;
+    static FBox GetActorBounds(const AActor* Actor);
+
+    /** Visit each live entry in the cells overlapping [MinCell, MaxCell] once, plus oversized entries */
+    template <typename FunctorType>
+    void ForEachEntryInCells(const FIntPoint& MinCell, const FIntPoint& MaxCell, FunctorType&& Visitor);
+
+    /** Mark an entry visited for the current query; false if it already was */
+    bool StampEntry(int32 EntryIndex);
+
+    // Editor event handlers
+    void OnActorAdded(AActor* Actor);
+    void OnActorDeleted(AActor* Actor);
+    void OnActorMoved(AActor* Actor);
+    void OnActorsMoved(TArray<AActor*>& Actors);
+    void OnUndoRedo();
+
+    const double CellSize;
+
+    TArray<FEntry> Entries;
+    TArray<int32> FreeEntries;
+    TMap<TObjectKey<AActor>, int32> EntryIndices;
+    TMap<FIntPoint, TArray<int32>> Cells;
+    TArray<int32> Oversized;
+
+    /** Bounding rectangle of every cell ever occupied; limits nearest-neighbour search */
+    FIntPoint OccupiedMin;
+    FIntPoint OccupiedMax;
+
+    TSet<TWeakObjectPtr<AActor>> PendingUpdates;
+    TWeakObjectPtr<UWorld> IndexedWorld;
+    bool bNeedsRebuild;
+    uint32 CurrentStamp;
+    double LastBuildSeconds;
+
+    FDelegateHandle ActorAddedHandle;
+    FDelegateHandle ActorDeletedHandle;
+    FDelegateHandle ActorMovedHandle;
+    FDelegateHandle ActorsMovedHandle;
+    FDelegateHandle UndoRedoHandle;
+};
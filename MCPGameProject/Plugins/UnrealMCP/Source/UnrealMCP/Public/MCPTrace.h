@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+struct FMCPRequestTiming;
+
+/**
+ * Unreal Insights instrumentation for MCP work. Enable it with
+ *
+ *   -trace=cpu,unrealmcp
+ *
+ * (or "Trace.Enable UnrealMCP" at runtime). The connection threads, the game thread
+ * handlers, blueprint compiles and JSON serialization then appear as "MCP ..." timers
+ * on the Insights timeline next to engine frames, and every request emits an
+ * UnrealMCP.Request event with its id, command name and stage timestamps.
+ *
+ * With the channel off, a scope is a single branch on the channel flag; in builds
+ * without trace support everything here compiles away.
+ */
+UE_TRACE_CHANNEL_EXTERN(UnrealMCPChannel, UNREALMCP_API);
+
+/** Timer with a fixed name, e.g. MCP_TRACE_SCOPE("MCP ParseRequest") */
+#define MCP_TRACE_SCOPE(NameStr) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(NameStr, UnrealMCPChannel)
+
+/** Timer named by a runtime string, such as the command type. Keep the set of names small. */
+#define MCP_TRACE_SCOPE_TEXT(Text) TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(Text, UnrealMCPChannel)
+
+struct UNREALMCP_API FMCPTrace
+{
+    /** Emit the UnrealMCP.Request event for a completed request. Any thread. */
+    static void OutputRequest(uint64 RequestId, const FString& CommandType, const FMCPRequestTiming& Timing, bool bError);
+};
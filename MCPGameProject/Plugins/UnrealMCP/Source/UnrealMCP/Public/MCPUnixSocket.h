@@ -0,0 +1,32 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Sockets.h"
+
+/**
+ * Unix domain socket listener for clients on the same machine.
+ *
+ * Loopback TCP still runs the full TCP stack for every message: checksums,
+ * acknowledgements and Nagle's algorithm. A Unix domain socket skips all of it,
+ * which lowers the latency of small requests. The engine's socket subsystem only
+ * knows internet sockets, so the listener and the sockets it accepts are an
+ * FSocket implementation over the POSIX calls. Accepted sockets are serviced by
+ * FMCPClientConnection exactly like TCP clients, with the same wire protocol.
+ *
+ * The socket file is created with owner-only permissions and removed when the
+ * listener closes. Only Linux and Mac are supported.
+ */
+class UNREALMCP_API FMCPUnixSocket
+{
+public:
+    /** True on platforms with Unix domain sockets */
+    static bool IsSupported();
+
+    /**
+     * Bind and listen on Path. A socket file of this user left behind by a
+     * process that is gone is replaced; anything else at Path (a live server,
+     * another user's socket, a file that is not a socket) is left alone and
+     * fails. Null, with OutError set, on failure.
+     */
+    static TSharedPtr<FSocket> Listen(const FString& Path, int32 MaxBacklog, FString& OutError);
+};
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Json.h"
+#include "Containers/Ticker.h"
+#include "MCPScreenshotCapture.h"
+#include <atomic>
+
+class FMCPClientConnection;
+
+/**
+ * Options for a viewport stream
+ */
+struct FMCPViewportStreamSettings
+{
+    /** Target capture rate in frames per second */
+    float FrameRate = 10.0f;
+
+    /** Capture size and source; format, quality and file path are unused */
+    FMCPScreenshotRequest Capture;
+
+    /** Edge length in pixels of the square tiles compared between frames */
+    int32 TileSize = 64;
+
+    /** Frames that may be pushed before the client has to acknowledge one */
+    int32 MaxInFlightFrames = 2;
+
+    /** Skip captures while more than this many bytes wait in the connection's push queue */
+    int64 MaxPendingBytes = 8 * 1024 * 1024;
+};
+
+/**
+ * Pushes viewport frames to one client connection.
+ *
+ * A core ticker captures at the requested rate using the raw screenshot readback.
+ * On a worker thread each frame is split into tiles and compared with the
+ * previous frame; only tiles that changed are zlib-compressed and pushed as one
+ * "viewport_frame" wire frame. The first frame, and any frame after a resize or
+ * a keyframe request, contains every tile.
+ *
+ * Backpressure: at most one capture is in flight, no capture starts while
+ * MaxInFlightFrames pushed frames are unacknowledged, and none starts while the
+ * connection still has MaxPendingBytes queued. Skipped ticks are counted, not
+ * queued, so a slow client sees a lower frame rate instead of growing latency.
+ */
+class UNREALMCP_API FMCPViewportStream : public TSharedFromThis<FMCPViewportStream, ESPMode::ThreadSafe>
+{
+public:
+    FMCPViewportStream(int32 InStreamId, const FMCPViewportStreamSettings& InSettings,
+        const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe>& InConnection);
+    ~FMCPViewportStream();
+
+    /** Begin capturing. Game thread only. */
+    void Start();
+
+    /** Stop capturing; a frame that is still being encoded is dropped. Game thread only. */
+    void Stop(const FString& Reason, bool bNotifyClient);
+
+    /** Record that the client received a frame, optionally asking for a full frame next */
+    void Acknowledge(int32 FrameIndex, bool bRequestKeyframe);
+
+    bool IsActive() const { return bActive; }
+    int32 GetStreamId() const { return StreamId; }
+    bool IsOwnedBy(const FMCPClientConnection* InConnection) const;
+
+    /** Counters describing the stream so far */
+    TSharedPtr<FJsonObject> GetStats() const;
+
+private:
+    bool Tick(float DeltaTime);
+
+    /** Diff against the previous frame and push the changed tiles. Runs on a worker thread. */
+    void EncodeAndPush(FMCPRawCapture&& Capture);
+
+    void PushEvent(const TSharedRef<FJsonObject>& Event);
+
+    const int32 StreamId;
+    const FMCPViewportStreamSettings Settings;
+    TWeakPtr<FMCPClientConnection, ESPMode::ThreadSafe> Connection;
+    const FMCPClientConnection* ConnectionKey;
+    FTSTicker::FDelegateHandle TickerHandle;
+
+    std::atomic<bool> bActive;
+    std::atomic<bool> bCaptureInFlight;
+    std::atomic<bool> bKeyframeRequested;
+    std::atomic<int32> LastSentFrame;
+    std::atomic<int32> LastAckedFrame;
+
+    // Previous frame; only touched by the single in-flight encode
+    TArray<FColor> PreviousFrame;
+    FIntPoint PreviousSize;
+
+    // Stats
+    std::atomic<int64> FramesSent;
+    std::atomic<int64> KeyframesSent;
+    std::atomic<int64> FramesUnchanged;
+    std::atomic<int64> FramesThrottled;
+    std::atomic<int64> TilesSent;
+    std::atomic<int64> TilesTotal;
+    std::atomic<int64> BytesSent;
+    double StartTime;
+};
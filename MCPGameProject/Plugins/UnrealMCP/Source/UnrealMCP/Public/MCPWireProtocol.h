@@ -0,0 +1,222 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Json.h"
+#include "HAL/PlatformTime.h"
+
+/**
+ * Wire format shared by the MCP server and its clients.
+ *
+ * Plain messages are a bare UTF-8 JSON object, exactly as before. When a message
+ * carries binary data (screenshots, packed buffers) it is sent as a frame:
+ *
+ *   offset  size  field
+ *   0       4     magic "MCPF"
+ *   4       1     version (MCP_FRAME_VERSION)
+ *   5       1     header encoding (EMCPFrameEncoding)
+ *   6       2     flags (little endian, MCP_FRAME_FLAG_*)
+ *   8       4     header length in bytes (little endian)
+ *   12      4     payload length in bytes (little endian)
+ *   16      ...   header (the normal envelope), then raw payload bytes
+ *
+ * A JSON message can never start with 'M', so readers can tell both forms apart
+ * from the first byte.
+ *
+ * The header of a frame is JSON, or MessagePack (see MCPMessagePack.h) when the
+ * encoding byte says so; a frame may have an empty payload. The server answers
+ * each request in the encoding it arrived in, so clients opt in per message.
+ * Servers that support MessagePack list it in the "encodings" of the ping result;
+ * older servers do not, and a client must keep to JSON with them.
+ *
+ * MCP_FRAME_FLAG_SHARED_PAYLOAD marks a frame whose payload is a descriptor of
+ * bytes in the connection's shared memory region (see MCPSharedMemory.h). It is
+ * only sent on a connection that opened one with open_shared_memory.
+ */
+#define MCP_FRAME_MAGIC_0 'M'
+#define MCP_FRAME_MAGIC_1 'C'
+#define MCP_FRAME_MAGIC_2 'P'
+#define MCP_FRAME_MAGIC_3 'F'
+#define MCP_FRAME_VERSION 1
+#define MCP_FRAME_HEADER_SIZE 16
+
+// The payload is in shared memory; the frame carries its descriptor
+#define MCP_FRAME_FLAG_SHARED_PAYLOAD 0x0001
+
+// Largest message a client may send before the connection is dropped
+#define MCP_MAX_MESSAGE_SIZE (256 * 1024 * 1024)
+
+enum class EMCPFrameEncoding : uint8
+{
+    Json = 0,
+    MessagePack = 1
+};
+
+/**
+ * Result produced by a command handler: the JSON result object plus an
+ * optional binary attachment that is delivered as the frame payload.
+ */
+struct FMCPCommandResult
+{
+    TSharedPtr<FJsonObject> Json;
+    TArray<uint8> Attachment;
+
+    FMCPCommandResult() = default;
+
+    explicit FMCPCommandResult(const TSharedPtr<FJsonObject>& InJson)
+        : Json(InJson)
+    {
+    }
+};
+
+/**
+ * FPlatformTime::Cycles64() timestamps of one request as it moves through the
+ * server; zero where a stage did not happen (see MCPServerStats.h). Cycles are
+ * the clock of the Insights CPU timers, so trace events use them unconverted.
+ */
+struct FMCPRequestTiming
+{
+    /** Message taken off the connection */
+    uint64 ReceiveCycle = 0;
+    /** Queued for the game thread */
+    uint64 DispatchCycle = 0;
+    /** Handler started and finished (async handlers finish when their future completes) */
+    uint64 StartCycle = 0;
+    uint64 EndCycle = 0;
+    /** Envelope built and encoded to bytes */
+    uint64 SerializeEndCycle = 0;
+    /** Last byte handed to the socket */
+    uint64 SendEndCycle = 0;
+
+    /** Seconds from one stamp to a later one; zero if either stage did not happen */
+    static double Seconds(uint64 FromCycle, uint64 ToCycle)
+    {
+        return (FromCycle != 0 && ToCycle >= FromCycle) ? FPlatformTime::ToSeconds64(ToCycle - FromCycle) : 0.0;
+    }
+};
+
+/**
+ * Serialized response ready to be written to a client
+ */
+struct FMCPResponse
+{
+    /** JSON envelope ({"status": ..., "result": ...}) */
+    FString Body;
+
+    /** The envelope as MessagePack, instead of Body, for MessagePack requests */
+    TArray<uint8> PackedBody;
+
+    EMCPFrameEncoding Encoding = EMCPFrameEncoding::Json;
+
+    /** Binary payload; when non-empty the response is sent as a frame */
+    TArray<uint8> Attachment;
+
+    /** True if the envelope reports an error */
+    bool bError = false;
+
+    /** Server-assigned id of the request, as used in logs and Insights traces */
+    uint64 RequestId = 0;
+
+    FMCPRequestTiming Timing;
+};
+
+/**
+ * A complete message taken off a client connection
+ */
+struct FMCPIncomingMessage
+{
+    /** The whole message, or the frame header: UTF-8 JSON or MessagePack, see Encoding */
+    TArray<uint8> Json;
+
+    /** Frame payload; empty for plain JSON messages */
+    TArray<uint8> Attachment;
+
+    EMCPFrameEncoding Encoding = EMCPFrameEncoding::Json;
+
+    /** MCP_FRAME_FLAG_* of a frame */
+    uint16 Flags = 0;
+};
+
+/**
+ * How far brace matching got through a JSON message that has not fully arrived.
+ * Kept by the reader between reads so each read scans only the new bytes.
+ */
+struct FMCPJsonScanState
+{
+    /** Bytes of the message already scanned, counted from its opening brace */
+    int32 Scanned = 0;
+    int32 Depth = 0;
+    bool bInString = false;
+    bool bEscaped = false;
+
+    void Reset()
+    {
+        *this = FMCPJsonScanState();
+    }
+};
+
+enum class EMCPReadResult : uint8
+{
+    /** More bytes are needed */
+    Incomplete,
+    /** A message was removed from the buffer */
+    Message,
+    /** The buffer does not start with a valid message; the connection should be closed */
+    Malformed
+};
+
+/**
+ * Helpers for building and recognising wire frames
+ */
+class UNREALMCP_API FMCPWireProtocol
+{
+public:
+    /** Returns true if the buffer starts with the frame magic */
+    static bool IsFrame(const uint8* Data, int32 Num);
+
+    /** Add "Name": RawJson to the envelope of a response; RawJson must be serialized JSON */
+    static void AppendField(FMCPResponse& Response, const TCHAR* Name, const FString& RawJson);
+
+    /**
+     * Add {"timing": {"queue_ms", "execute_ms"}} to the envelope of a response, for
+     * clients that set "timing": true in their request (benchmarks)
+     */
+    static void AppendTiming(FMCPResponse& Response);
+
+    /**
+     * Echo the "id" a client put next to "type" into the envelope of its response.
+     * Clients that keep several requests in flight on one connection use it to
+     * match responses; the value is copied as is, so strings and numbers both work.
+     */
+    static void AppendClientId(FMCPResponse& Response, const TSharedPtr<FJsonValue>& Id);
+
+    /** Decode the envelope of a request in either encoding */
+    static bool ParseMessage(const FMCPIncomingMessage& Message, TSharedPtr<FJsonObject>& OutObject, FString& OutError);
+
+    /** The envelope of a response as JSON text, for logs */
+    static FString DescribeResponse(const FMCPResponse& Response);
+
+    /**
+     * Encode a response into the bytes to send: plain JSON, or a frame if it has an
+     * attachment or is MessagePack. With a SharedDescriptor the frame carries it,
+     * flagged, in place of the attachment.
+     */
+    static void EncodeResponse(const FMCPResponse& Response, TArray<uint8>& OutBytes, const TArray<uint8>* SharedDescriptor = nullptr);
+
+    /**
+     * Take the next complete message from a receive buffer, starting at InOutOffset,
+     * and advance the offset past it. JSON messages are delimited by matching braces,
+     * so several messages may arrive in one read and whitespace or newlines between
+     * them are ignored. The buffer is not modified; the caller drops the consumed
+     * bytes once it has taken every complete message.
+     *
+     * InOutScan carries brace matching across calls while a JSON message is
+     * incomplete. It is relative to the start of that message, so it stays valid
+     * when the consumed bytes before it are dropped; it is reset after each message.
+     */
+    static EMCPReadResult ReadMessage(const TArray<uint8>& Buffer, int32& InOutOffset, FMCPJsonScanState& InOutScan, FMCPIncomingMessage& OutMessage,
+        FString& OutError);
+
+    /** Build a frame from an already encoded header and a payload */
+    static void EncodeFrame(const TArray<uint8>& Header, const uint8* Payload, int32 PayloadSize, EMCPFrameEncoding Encoding, TArray<uint8>& OutBytes,
+        uint16 Flags = 0);
+};
@@ -14,15 +14,23 @@
 #include "Commands/UnrealMCPProjectCommands.h"
 #include "Commands/UnrealMCPUMGCommands.h"
 #include "Commands/UnrealMCPBlueprintIntrospection.h"
+#include "MCPWireProtocol.h"
+#include "MCPEditBatch.h"
+#include "MCPServerStats.h"
+#include "MCPRequestJournal.h"
+#include "MCPChangeFeed.h"
+#include "Containers/Ticker.h"
 #include "UnrealMCPBridge.generated.h"
 
 class FMCPServerRunnable;
+class FMCPClientConnection;
+class FMCPFakeWorld;
 
 /**
  * Editor subsystem for MCP Bridge
  * Handles communication between external tools and the Unreal Editor
- * through a TCP socket connection. Commands are received as JSON and
- * routed to appropriate command handlers.
+ * through a TCP socket connection, and optionally a Unix domain socket.
+ * Commands are received as JSON and routed to appropriate command handlers.
  */
 UCLASS()
 class UNREALMCP_API UUnrealMCPBridge : public UEditorSubsystem
@@ -44,17 +52,75 @@ public:
 
 	// Command execution
 	FString ExecuteCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+	FMCPResponse ExecuteCommandWithAttachment(const FString& CommandType, const TSharedPtr<FJsonObject>& Params,
+		const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe>& Connection = nullptr,
+		TArray<uint8> RequestAttachment = TArray<uint8>(), uint64 RequestId = 0,
+		EMCPFrameEncoding Encoding = EMCPFrameEncoding::Json);
+
+	// Per-command request counters and latency histograms. Thread safe.
+	FMCPServerStats& GetStats() { return Stats; }
+
+	// Record requests and responses to a binary journal (see MCPRequestJournal.h).
+	// Starting a journal closes the previous one.
+	bool StartJournal(const FString& Path, FString& OutError);
+	void StopJournal();
+
+	// Journal being recorded, or null. Thread safe.
+	TSharedPtr<FMCPRequestJournal, ESPMode::ThreadSafe> GetJournal() const;
+
+	// Level and asset revision counters clients validate their caches against
+	// (see MCPChangeFeed.h); null before Initialize. Reading revisions is thread safe.
+	const FMCPChangeFeed* GetChangeFeed() const { return ChangeFeed.Get(); }
+
+	// Serve actor commands from a fake world instead of the editor (headless host only)
+	void SetFakeWorld(const TSharedPtr<FMCPFakeWorld>& InFakeWorld);
 
 private:
+	// Route a command to its handler. Must be called on the game thread.
+	TSharedPtr<FJsonObject> DispatchCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+
+	// Wrap a handler result in the {"status", "result"/"error"} envelope, serialized in Encoding
+	static FMCPResponse BuildResponse(FMCPCommandResult&& Result, EMCPFrameEncoding Encoding);
+
+	// True for commands that complete off the game thread
+	bool IsAsyncCommand(const FString& CommandType) const;
+
+	// Edit batches and transactions (see MCPEditBatch.h)
+	TSharedPtr<FJsonObject> HandleBatch(const TSharedPtr<FJsonObject>& Params);
+	TSharedPtr<FJsonObject> HandleBeginTransaction(const TSharedPtr<FJsonObject>& Params);
+	TSharedPtr<FJsonObject> HandleEndTransaction(bool bCommit);
+
+	// get_server_stats; safe to call from any thread
+	TSharedPtr<FJsonObject> HandleGetServerStats(const TSharedPtr<FJsonObject>& Params);
+
+	// get_revisions (any thread) and subscribe_revisions (game thread)
+	TSharedPtr<FJsonObject> HandleGetRevisions();
+	TSharedPtr<FJsonObject> HandleSubscribeRevisions(const TSharedPtr<FJsonObject>& Params);
+
+	// open_shared_memory; runs on the calling connection's thread
+	TSharedPtr<FJsonObject> HandleOpenSharedMemory(const TSharedPtr<FJsonObject>& Params,
+		const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe>& Connection);
+
+	// start_recording / stop_recording: the request journal, for replay
+	TSharedPtr<FJsonObject> HandleStartRecording(const TSharedPtr<FJsonObject>& Params);
+	TSharedPtr<FJsonObject> HandleStopRecording();
+
+	// Roll back an open transaction whose client has disconnected
+	bool TickOpenTransaction(float DeltaTime);
+
 	// Server state
 	bool bIsRunning;
 	TSharedPtr<FSocket> ListenerSocket;
 	TSharedPtr<FSocket> ConnectionSocket;
 	FRunnableThread* ServerThread;
 
+	// Listens next to ListenerSocket when UnixSocketPath is set (see MCPUnixSocket.h)
+	TSharedPtr<FSocket> UnixListenerSocket;
+
 	// Server configuration
 	FIPv4Address ServerAddress;
 	uint16 Port;
+	FString UnixSocketPath;
 
 	// Command handler instances
 	TSharedPtr<FUnrealMCPEditorCommands> EditorCommands;
@@ -63,4 +129,21 @@ private:
 	TSharedPtr<FUnrealMCPProjectCommands> ProjectCommands;
 	TSharedPtr<FUnrealMCPUMGCommands> UMGCommands;
 	TSharedPtr<FUnrealMCPBlueprintIntrospection> BlueprintIntrospection;
+
+	// When set, replaces the command handlers above (see MCPFakeWorld.h)
+	TSharedPtr<FMCPFakeWorld> FakeWorld;
+
+	FMCPServerStats Stats;
+
+	TUniquePtr<FMCPChangeFeed> ChangeFeed;
+
+	// Guards Journal, which connection threads read for every request
+	mutable FCriticalSection JournalLock;
+	TSharedPtr<FMCPRequestJournal, ESPMode::ThreadSafe> Journal;
+
+	// Transaction opened with begin_transaction, spanning several requests
+	TUniquePtr<FMCPEditBatch> OpenTransaction;
+	TWeakPtr<FMCPClientConnection, ESPMode::ThreadSafe> TransactionOwner;
+	bool bTransactionHasOwner;
+	FTSTicker::FDelegateHandle TransactionTickerHandle;
 }; 
\ No newline at end of file
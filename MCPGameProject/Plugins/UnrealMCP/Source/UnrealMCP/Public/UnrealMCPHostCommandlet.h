@@ -0,0 +1,32 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "UnrealMCPHostCommandlet.generated.h"
+
+/**
+ * Runs the MCP bridge without the editor UI, for benchmarks and CI on headless machines:
+ *
+ *   UnrealEditor-Cmd <Project>.uproject -run=UnrealMCPHost -nullrhi -unattended [options]
+ *
+ * Options:
+ *   -Map=/Game/Maps/Test   Load this map before serving commands
+ *   -FakeWorld             Serve actor commands from an in-process FMCPFakeWorld instead of the editor world
+ *   -FakeActors=N          Pre-populate the fake world with N actors
+ *   -Duration=S            Exit after S seconds (default: run until Ctrl+C)
+ *   -MCPPort=P             Listen on port P instead of 55557 (read by UUnrealMCPBridge)
+ *
+ * The commandlet pumps the game thread itself, so commands are scheduled exactly as
+ * in the editor: received on connection threads, executed on the game thread.
+ */
+UCLASS()
+class UNREALMCP_API UUnrealMCPHostCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UUnrealMCPHostCommandlet();
+
+	// UCommandlet implementation
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,123 @@
+"""
+MessagePack headers for the Unreal MCP wire protocol.
+
+A frame whose encoding byte is ENCODING_MSGPACK carries its envelope as
+MessagePack instead of JSON (see MCPWireProtocol.h and MCPMessagePack.h). The
+bridge answers in the encoding of the request, and lists "msgpack" in the
+"encodings" of its ping result when it supports it.
+
+Values map one to one onto JSON. Three extension types carry the structures
+commands return most often:
+
+    type  name         data                                   decodes to
+    1     float array  N little-endian float64                [x, y, ...]
+    2     guid         16 bytes                               32 uppercase hex digits
+    3     records      array [[keys], [values], [values]...]  [{key: value, ...}, ...]
+
+The encoder applies them under the same rules as the bridge: float arrays for
+lists of two or more numbers with at least one non-integral float, guids for
+strings of exactly 32 uppercase hex digits, and records for lists of two or more
+dicts with the same keys in the same order.
+
+Needs the msgpack package; AVAILABLE is False without it, and clients stay on JSON.
+"""
+
+import json
+import struct
+import sys
+from typing import Any, Dict
+
+try:
+    import msgpack
+    AVAILABLE = True
+except ImportError:
+    msgpack = None
+    AVAILABLE = False
+
+# Header encodings of a frame (EMCPFrameEncoding)
+ENCODING_JSON = 0
+ENCODING_MSGPACK = 1
+
+EXT_FLOAT_ARRAY = 1
+EXT_GUID = 2
+EXT_RECORDS = 3
+
+_HEX_UPPER = frozenset("0123456789ABCDEF")
+_LITTLE_ENDIAN = sys.byteorder == "little"
+
+
+def _is_guid(value: str) -> bool:
+    return len(value) == 32 and _HEX_UPPER.issuperset(value)
+
+
+def _is_float_array(values: list) -> bool:
+    has_fraction = False
+    for value in values:
+        if isinstance(value, float):
+            has_fraction = has_fraction or not value.is_integer()
+        elif not isinstance(value, int) or isinstance(value, bool):
+            return False
+    return has_fraction
+
+
+def _is_records(values: list) -> bool:
+    first = values[0]
+    if not isinstance(first, dict) or not first:
+        return False
+    keys = list(first)
+    return all(isinstance(value, dict) and list(value) == keys for value in values[1:])
+
+
+def _prepare(value: Any) -> Any:
+    """Replace the values that have an extension type with msgpack.ExtType."""
+    if isinstance(value, dict):
+        return {key: _prepare(item) for key, item in value.items()}
+    if isinstance(value, (list, tuple)):
+        if len(value) >= 2:
+            if _is_float_array(value):
+                return msgpack.ExtType(EXT_FLOAT_ARRAY, struct.pack(f"<{len(value)}d", *value))
+            if _is_records(value):
+                keys = list(value[0])
+                rows = [[_prepare(item[key]) for key in keys] for item in value]
+                return msgpack.ExtType(EXT_RECORDS, msgpack.packb([keys] + rows, use_bin_type=True))
+        return [_prepare(item) for item in value]
+    if isinstance(value, str) and _is_guid(value):
+        return msgpack.ExtType(EXT_GUID, bytes.fromhex(value))
+    return value
+
+
+def _ext_hook(code: int, data: bytes) -> Any:
+    if code == EXT_FLOAT_ARRAY:
+        if _LITTLE_ENDIAN:
+            return memoryview(data).cast("d").tolist()
+        return list(struct.unpack(f"<{len(data) // 8}d", data))
+    if code == EXT_GUID:
+        return data.hex().upper()
+    if code == EXT_RECORDS:
+        table = unpack(data)
+        keys = table[0]
+        return [dict(zip(keys, row)) for row in table[1:]]
+    return msgpack.ExtType(code, data)
+
+
+def pack(value: Dict[str, Any]) -> bytes:
+    """Encode an envelope as MessagePack."""
+    return msgpack.packb(_prepare(value), use_bin_type=True)
+
+
+def unpack(data: bytes) -> Any:
+    """Decode MessagePack, expanding the extension types."""
+    return msgpack.unpackb(data, ext_hook=_ext_hook, raw=False, strict_map_key=False)
+
+
+def decode_header(header: bytes) -> Dict[str, Any]:
+    """Decode an envelope in either encoding.
+
+    A JSON envelope starts with '{', which MessagePack never uses for a map, so
+    the encoding can be told from the first byte.
+    """
+    if header[:1] == b"{":
+        return json.loads(header.decode("utf-8"))
+    if not AVAILABLE:
+        raise ValueError("Received a MessagePack message but the msgpack package is not installed")
+    return unpack(header)
@@ -0,0 +1,624 @@
+#!/usr/bin/env python
+"""
+Latency and throughput benchmark for the Unreal MCP bridge.
+
+Drives the bridge over its TCP protocol with configurable workloads, concurrency
+levels and payload sizes, and writes the results as JSON. Two result files can
+be compared to catch regressions.
+
+Workloads:
+- ping: bare round trips, the floor for any command
+- echo: echo with a binary attachment of each --payload-sizes size (framing cost)
+- echo_json: echo with a JSON string of each size (parsing/serialization cost)
+- spawn_transform: each worker spawns actors, moves them in bursts, then deletes them
+- blueprint_build: the graph built by node/test_create_bird_blueprint_with_input_and_camera.py,
+  one new Blueprint per iteration (assets are left behind; use a scratch project)
+- blueprint_read: get_blueprint_data on --blueprint at full detail; the editor caches
+  results per Blueprint revision, so this measures the cached read path
+- actor_list: get_actors_in_level, a large float-heavy result with a populated
+  level (or -FakeActors=N on the headless host)
+
+--encoding msgpack sends MessagePack headers instead of JSON (see msgpack_codec.py);
+the bridge answers in kind, so comparing two runs shows what JSON costs.
+
+--unix-socket PATH connects to the bridge's Unix domain socket instead of TCP
+(see Docs/HeadlessHost.md), to compare per-message latency with loopback TCP.
+
+--shared-memory-mb N gives each connection N MB shared memory rings, per
+direction, so echo payloads of 64 KB or more bypass the socket (see
+shared_memory_transport.py). Only for a bridge on this machine.
+
+Every request sets "timing": true, so the server reports how long it waited for the
+game thread (queue_ms) and how long the command took there (execute_ms) next to the
+client-side latency.
+
+With --server-stats, the server's own per-command histograms (get_server_stats) are
+reset before each case and stored with it, splitting server time into parse, queue,
+execute, serialize and send.
+
+Every workload but blueprint_build and blueprint_read also runs against the headless
+host's fake world (see Docs/HeadlessHost.md), which isolates the transport from engine
+work. The fake world has no blueprints, so those two are skipped there with a message.
+
+Usage:
+    python benchmark_bridge.py run --workloads ping,echo --concurrency 1,4,16 --output base.json
+    python benchmark_bridge.py compare base.json new.json --threshold 0.10
+"""
+
+import argparse
+import json
+import math
+import os
+import socket
+import sys
+import threading
+import time
+from collections import defaultdict
+from typing import Any, Dict, List, Optional, Tuple
+
+# Add the Python directory to the path so we can reuse the wire helpers
+sys.path.append(os.path.dirname(os.path.dirname(os.path.dirname(os.path.abspath(__file__)))))
+
+import msgpack_codec
+import shared_memory_transport
+from shared_memory_transport import FLAG_SHARED_PAYLOAD, SharedRing
+from viewport_stream import FRAME_MAGIC, FRAME_PREFIX, JsonScanState, split_message
+
+RESULT_VERSION = 1
+
+
+class BenchClient:
+    """One client connection that records the latency of every request it sends."""
+
+    def __init__(self, host: str, port: int, persistent: bool, timeout: float, encoding: str = "json",
+                 shared_memory_size: int = 0, unix_socket: Optional[str] = None):
+        self.host = host
+        self.port = port
+        self.persistent = persistent
+        self.timeout = timeout
+        self.encoding = msgpack_codec.ENCODING_MSGPACK if encoding == "msgpack" else msgpack_codec.ENCODING_JSON
+        self.shared_memory_size = shared_memory_size
+        self.unix_socket = unix_socket
+        self.ring: Optional[SharedRing] = None
+        self.sock: Optional[socket.socket] = None
+        self.buffer = bytearray()
+        self.scan = JsonScanState()
+        # command -> list of (latency_ms, queue_ms, execute_ms, ok)
+        self.samples: Dict[str, List[Tuple[float, Optional[float], Optional[float], bool]]] = defaultdict(list)
+
+    def _connect(self):
+        if self.unix_socket:
+            self.sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+            self.sock.settimeout(self.timeout)
+            self.sock.connect(self.unix_socket)
+        else:
+            self.sock = socket.create_connection((self.host, self.port), timeout=self.timeout)
+            self.sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        self.buffer.clear()
+        self.scan.reset()
+        if self.shared_memory_size > 0:
+            self._open_shared_memory()
+
+    def _open_shared_memory(self):
+        ring = SharedRing(self.shared_memory_size)
+        params = {"name": ring.name, "ring_size": ring.ring_size, "min_payload": ring.min_payload}
+        self.sock.sendall(json.dumps({"type": "open_shared_memory", "params": params}).encode("utf-8"))
+        header, _ = self._receive()
+        response = msgpack_codec.decode_header(header)
+        if response.get("status") != "success":
+            ring.close()
+            raise ConnectionError(f"open_shared_memory failed: {response.get('error')}")
+        self.ring = ring
+
+    def close(self):
+        if self.sock:
+            try:
+                self.sock.close()
+            except OSError:
+                pass
+        self.sock = None
+        if self.ring is not None:
+            self.ring.close()
+            self.ring = None
+
+    def _receive(self) -> Tuple[bytes, bytes]:
+        while True:
+            flags = shared_memory_transport.frame_flags(self.buffer)
+            message = split_message(self.buffer, self.scan)
+            if message is not None:
+                header, payload, consumed = message
+                del self.buffer[:consumed]
+                if flags & FLAG_SHARED_PAYLOAD:
+                    if self.ring is None:
+                        raise ValueError("Shared payload without shared memory")
+                    payload = self.ring.read(payload)
+                return header, payload
+            chunk = self.sock.recv(1 << 20)
+            if not chunk:
+                raise ConnectionError("Connection closed by the server")
+            self.buffer += chunk
+
+    def call(self, command: str, params: Optional[Dict[str, Any]] = None,
+             attachment: Optional[bytes] = None) -> Tuple[Optional[Dict[str, Any]], bytes]:
+        """Send one command and wait for its response. Returns (result, payload); result is None on error."""
+        request = {"type": command, "params": params or {}, "timing": True}
+
+        start = time.perf_counter()
+        try:
+            if not self.persistent or self.sock is None:
+                self.close()
+                self._connect()
+            # Copying into the ring is part of the cost being measured
+            flags = 0
+            if attachment and self.ring is not None:
+                descriptor = self.ring.write(attachment)
+                if descriptor is not None:
+                    attachment, flags = descriptor, FLAG_SHARED_PAYLOAD
+            if self.encoding == msgpack_codec.ENCODING_MSGPACK:
+                header = msgpack_codec.pack(request)
+                message = FRAME_PREFIX.pack(FRAME_MAGIC, 1, self.encoding, flags, len(header), len(attachment or b"")) + header + (attachment or b"")
+            elif attachment:
+                header = json.dumps(request).encode("utf-8")
+                message = FRAME_PREFIX.pack(FRAME_MAGIC, 1, 0, flags, len(header), len(attachment)) + header + attachment
+            else:
+                message = json.dumps(request).encode("utf-8")
+            self.sock.sendall(message)
+            response_bytes, payload = self._receive()
+            response = msgpack_codec.decode_header(response_bytes)
+        except (OSError, ValueError, ConnectionError):
+            self.samples[command].append(((time.perf_counter() - start) * 1000.0, None, None, False))
+            self.close()
+            return None, b""
+        finally:
+            if not self.persistent:
+                self.close()
+        latency_ms = (time.perf_counter() - start) * 1000.0
+
+        timing = response.get("timing", {})
+        ok = response.get("status") == "success"
+        self.samples[command].append((latency_ms, timing.get("queue_ms"), timing.get("execute_ms"), ok))
+        return (response.get("result") if ok else None), payload
+
+
+# Workloads: setup(client, worker) -> state, step(client, worker, iteration, state), teardown(client, worker, state)
+
+class Workload:
+    name = ""
+    uses_payload = False
+    # Every command the workload sends is served by the headless host's fake world
+    fake_world = True
+
+    def __init__(self, args: argparse.Namespace, payload_bytes: int):
+        self.args = args
+        self.payload_bytes = payload_bytes
+        self.run_id = int(time.time() * 1000) % 1000000
+
+    def setup(self, client: BenchClient, worker: int) -> Any:
+        return None
+
+    def step(self, client: BenchClient, worker: int, iteration: int, state: Any):
+        raise NotImplementedError
+
+    def teardown(self, client: BenchClient, worker: int, state: Any):
+        pass
+
+
+class PingWorkload(Workload):
+    name = "ping"
+
+    def step(self, client, worker, iteration, state):
+        client.call("ping")
+
+
+class EchoWorkload(Workload):
+    name = "echo"
+    uses_payload = True
+
+    def setup(self, client, worker):
+        return os.urandom(self.payload_bytes)
+
+    def step(self, client, worker, iteration, state):
+        client.call("echo", {"iteration": iteration}, attachment=state or None)
+
+
+class EchoJsonWorkload(Workload):
+    name = "echo_json"
+    uses_payload = True
+
+    def setup(self, client, worker):
+        return "x" * self.payload_bytes
+
+    def step(self, client, worker, iteration, state):
+        client.call("echo", {"iteration": iteration, "data": state})
+
+
+class SpawnTransformWorkload(Workload):
+    name = "spawn_transform"
+
+    def setup(self, client, worker):
+        names = []
+        for index in range(self.args.actors_per_worker):
+            name = f"Bench_{self.run_id}_{worker}_{index}"
+            result, _ = client.call("spawn_actor", {
+                "name": name,
+                "type": "StaticMeshActor",
+                "location": [index * 100.0, worker * 100.0, 0.0]
+            })
+            if result is not None:
+                names.append(name)
+        return names
+
+    def step(self, client, worker, iteration, state):
+        # One burst: move every actor of this worker once
+        for index, name in enumerate(state):
+            client.call("set_actor_transform", {
+                "name": name,
+                "location": [index * 100.0, worker * 100.0, (iteration % 10) * 10.0],
+                "rotation": [0.0, (iteration * 15) % 360, 0.0]
+            })
+
+    def teardown(self, client, worker, state):
+        for name in state:
+            client.call("delete_actor", {"name": name})
+
+
+class BlueprintBuildWorkload(Workload):
+    name = "blueprint_build"
+    fake_world = False
+
+    def setup(self, client, worker):
+        client.call("create_input_mapping", {"action_name": "Flap", "key": "SpaceBar", "input_type": "Action"})
+        return None
+
+    def step(self, client, worker, iteration, state):
+        blueprint = f"BenchBird_{self.run_id}_{worker}_{iteration}"
+        client.call("create_blueprint", {"name": blueprint, "parent_class": "Pawn"})
+        client.call("add_component_to_blueprint", {
+            "blueprint_name": blueprint,
+            "component_type": "StaticMeshComponent",
+            "component_name": "BirdMesh",
+            "scale": [0.5, 0.5, 0.5]
+        })
+        client.call("set_physics_properties", {
+            "blueprint_name": blueprint,
+            "component_name": "BirdMesh",
+            "simulate_physics": True,
+            "gravity_enabled": True,
+            "mass": 2.0,
+            "linear_damping": 0.5,
+            "angular_damping": 0.5
+        })
+        client.call("add_blueprint_variable", {
+            "blueprint_name": blueprint,
+            "variable_name": "FlapStrength",
+            "variable_type": "Float",
+            "default_value": 500.0,
+            "is_exposed": True
+        })
+        client.call("set_static_mesh_properties", {
+            "blueprint_name": blueprint,
+            "component_name": "BirdMesh",
+            "static_mesh": "/Engine/BasicShapes/Sphere.Sphere"
+        })
+        client.call("add_blueprint_event_node", {
+            "blueprint_name": blueprint,
+            "event_name": "ReceiveBeginPlay",
+            "node_position": [-400, 0]
+        })
+        input_node, _ = client.call("add_blueprint_input_action_node", {
+            "blueprint_name": blueprint,
+            "action_name": "Flap",
+            "node_position": [-400, 300]
+        })
+        mesh_node, _ = client.call("add_blueprint_get_self_component_reference", {
+            "blueprint_name": blueprint,
+            "component_name": "BirdMesh",
+            "node_position": [0, 300]
+        })
+        impulse_node, _ = client.call("add_blueprint_function_node", {
+            "blueprint_name": blueprint,
+            "function_name": "AddImpulse",
+            "target": "UPrimitiveComponent",
+            "params": {"Impulse": [0, 0, 1000]},
+            "node_position": [400, 300]
+        })
+        if input_node and impulse_node:
+            client.call("connect_blueprint_nodes", {
+                "blueprint_name": blueprint,
+                "source_node_id": input_node.get("node_id"),
+                "source_pin": "Pressed",
+                "target_node_id": impulse_node.get("node_id"),
+                "target_pin": "Execute"
+            })
+        if mesh_node and impulse_node:
+            client.call("connect_blueprint_nodes", {
+                "blueprint_name": blueprint,
+                "source_node_id": mesh_node.get("node_id"),
+                "source_pin": "BirdMesh",
+                "target_node_id": impulse_node.get("node_id"),
+                "target_pin": "self"
+            })
+        client.call("compile_blueprint", {"blueprint_name": blueprint})
+
+
+class BlueprintReadWorkload(Workload):
+    name = "blueprint_read"
+    fake_world = False
+
+    def step(self, client, worker, iteration, state):
+        client.call("get_blueprint_data", {"blueprint_name": self.args.blueprint, "detail": "full"})
+
+
+class ActorListWorkload(Workload):
+    name = "actor_list"
+
+    def step(self, client, worker, iteration, state):
+        client.call("get_actors_in_level")
+
+
+WORKLOADS: Dict[str, type] = {
+    workload.name: workload for workload in (
+        PingWorkload, EchoWorkload, EchoJsonWorkload, SpawnTransformWorkload,
+        BlueprintBuildWorkload, BlueprintReadWorkload, ActorListWorkload
+    )
+}
+
+# Default iterations per worker, scaled to how expensive each step is
+DEFAULT_ITERATIONS = {
+    "ping": 500,
+    "echo": 200,
+    "echo_json": 200,
+    "spawn_transform": 10,
+    "blueprint_build": 2,
+    "blueprint_read": 50,
+    "actor_list": 50,
+}
+
+
+def percentile(sorted_values: List[float], fraction: float) -> float:
+    """Nearest-rank percentile of an already sorted list."""
+    if not sorted_values:
+        return 0.0
+    rank = max(0, min(len(sorted_values) - 1, math.ceil(fraction * len(sorted_values)) - 1))
+    return sorted_values[rank]
+
+
+def summarize(values: List[float]) -> Dict[str, float]:
+    values = sorted(values)
+    if not values:
+        return {}
+    return {
+        "p50": round(percentile(values, 0.50), 3),
+        "p90": round(percentile(values, 0.90), 3),
+        "p99": round(percentile(values, 0.99), 3),
+        "max": round(values[-1], 3),
+        "mean": round(sum(values) / len(values), 3),
+    }
+
+
+def summarize_samples(samples: List[Tuple[float, Optional[float], Optional[float], bool]]) -> Dict[str, Any]:
+    latencies = [sample[0] for sample in samples if sample[3]]
+    queue = [sample[1] for sample in samples if sample[3] and sample[1] is not None]
+    execute = [sample[2] for sample in samples if sample[3] and sample[2] is not None]
+    return {
+        "requests": len(samples),
+        "errors": sum(1 for sample in samples if not sample[3]),
+        "latency_ms": summarize(latencies),
+        "queue_ms": summarize(queue),
+        "execute_ms": summarize(execute),
+        "game_thread_ms_total": round(sum(execute), 3),
+    }
+
+
+def run_case(args: argparse.Namespace, workload_name: str, concurrency: int, payload_bytes: int) -> Dict[str, Any]:
+    """Run one workload at one concurrency level and payload size."""
+    workload = WORKLOADS[workload_name](args, payload_bytes)
+    iterations = args.iterations or DEFAULT_ITERATIONS[workload_name]
+    clients = [BenchClient(args.host, args.port, not args.per_command_connections, args.timeout, args.encoding,
+                           args.shared_memory_mb * 1024 * 1024, args.unix_socket) for _ in range(concurrency)]
+    states: List[Any] = [None] * concurrency
+
+    for worker, client in enumerate(clients):
+        states[worker] = workload.setup(client, worker)
+        # Setup requests are not part of the measurement
+        client.samples.clear()
+
+    control = BenchClient(args.host, args.port, True, args.timeout) if args.server_stats else None
+    if control:
+        control.call("get_server_stats", {"commands": False, "reset": True})
+
+    barrier = threading.Barrier(concurrency + 1)
+    errors: List[str] = []
+
+    def worker_main(worker: int):
+        client = clients[worker]
+        barrier.wait()
+        try:
+            for iteration in range(iterations):
+                workload.step(client, worker, iteration, states[worker])
+        except Exception as e:
+            errors.append(f"worker {worker}: {e}")
+
+    threads = [threading.Thread(target=worker_main, args=(worker,), daemon=True) for worker in range(concurrency)]
+    for thread in threads:
+        thread.start()
+    barrier.wait()
+    start = time.perf_counter()
+    for thread in threads:
+        thread.join()
+    elapsed = time.perf_counter() - start
+
+    server_stats = None
+    if control:
+        server_stats, _ = control.call("get_server_stats", {"commands": True})
+        control.close()
+
+    all_samples = []
+    per_command: Dict[str, List] = defaultdict(list)
+    for client in clients:
+        for command, samples in client.samples.items():
+            per_command[command].extend(samples)
+            all_samples.extend(samples)
+
+    for worker, client in enumerate(clients):
+        client.samples.clear()
+        workload.teardown(client, worker, states[worker])
+        client.close()
+
+    case = {
+        "workload": workload_name,
+        "concurrency": concurrency,
+        "payload_bytes": payload_bytes if workload.uses_payload else 0,
+        "iterations_per_worker": iterations,
+        "elapsed_s": round(elapsed, 4),
+        "throughput_rps": round(len(all_samples) / elapsed, 2) if elapsed > 0 else 0.0,
+    }
+    case.update(summarize_samples(all_samples))
+    case["game_thread_utilization"] = round(case["game_thread_ms_total"] / (elapsed * 1000.0), 4) if elapsed > 0 else 0.0
+    case["commands"] = {command: summarize_samples(samples) for command, samples in sorted(per_command.items())}
+    if server_stats:
+        case["server_stats"] = server_stats
+    if errors:
+        case["worker_errors"] = errors
+    return case
+
+
+def case_key(case: Dict[str, Any]) -> Tuple[str, int, int]:
+    return case["workload"], case["concurrency"], case["payload_bytes"]
+
+
+def format_case(case: Dict[str, Any]) -> str:
+    latency = case.get("latency_ms", {})
+    execute = case.get("execute_ms", {})
+    return (f"{case['workload']:<16} c={case['concurrency']:<3} bytes={case['payload_bytes']:<8} "
+            f"rps={case['throughput_rps']:<9} p50={latency.get('p50', 0):<8} p99={latency.get('p99', 0):<8} "
+            f"gt_p50={execute.get('p50', 0):<8} errors={case['errors']}")
+
+
+def command_run(args: argparse.Namespace) -> int:
+    workloads = [name.strip() for name in args.workloads.split(",") if name.strip()]
+    unknown = [name for name in workloads if name not in WORKLOADS]
+    if unknown:
+        print(f"Unknown workloads: {', '.join(unknown)} (available: {', '.join(WORKLOADS)})")
+        return 2
+    concurrency_levels = [int(value) for value in args.concurrency.split(",")]
+    payload_sizes = [int(value) for value in args.payload_sizes.split(",")]
+
+    probe = BenchClient(args.host, args.port, True, args.timeout, unix_socket=args.unix_socket)
+    pong = probe.call("ping")[0]
+    probe.close()
+    if pong is None:
+        print(f"No MCP bridge answering on {args.host}:{args.port}")
+        return 2
+    if args.encoding == "msgpack" and (not msgpack_codec.AVAILABLE or "msgpack" not in pong.get("encodings", [])):
+        print("MessagePack needs the msgpack package and a bridge that lists it in its ping result")
+        return 2
+
+    if pong.get("fake_world"):
+        for workload_name in [name for name in workloads if not WORKLOADS[name].fake_world]:
+            print(f"Skipping {workload_name}: the bridge serves a fake world, which has no blueprints")
+        workloads = [name for name in workloads if WORKLOADS[name].fake_world]
+
+    cases = []
+    for workload_name in workloads:
+        sizes = payload_sizes if WORKLOADS[workload_name].uses_payload else [0]
+        for concurrency in concurrency_levels:
+            for payload_bytes in sizes:
+                case = run_case(args, workload_name, concurrency, payload_bytes)
+                print(format_case(case))
+                cases.append(case)
+
+    result = {
+        "version": RESULT_VERSION,
+        "label": args.label,
+        "timestamp": time.strftime("%Y-%m-%dT%H:%M:%SZ", time.gmtime()),
+        "host": args.host,
+        "port": args.port,
+        "connection_mode": "per_command" if args.per_command_connections else "persistent",
+        "encoding": args.encoding,
+        "shared_memory_mb": args.shared_memory_mb,
+        "transport": "unix" if args.unix_socket else "tcp",
+        "fake_world": bool(pong.get("fake_world")),
+        "cases": cases,
+    }
+    if args.output:
+        with open(args.output, "w") as output:
+            json.dump(result, output, indent=2)
+        print(f"Wrote {args.output}")
+    return 1 if any(case["errors"] for case in cases) and args.fail_on_errors else 0
+
+
+def command_compare(args: argparse.Namespace) -> int:
+    with open(args.baseline) as baseline_file:
+        baseline = json.load(baseline_file)
+    with open(args.current) as current_file:
+        current = json.load(current_file)
+
+    baseline_cases = {case_key(case): case for case in baseline.get("cases", [])}
+    regressions = 0
+    print(f"{'case':<40} {'p50 ms':>20} {'p99 ms':>20} {'rps':>22}")
+    for case in current.get("cases", []):
+        key = case_key(case)
+        base = baseline_cases.get(key)
+        name = f"{key[0]} c={key[1]} bytes={key[2]}"
+        if base is None:
+            print(f"{name:<40} (no baseline)")
+            continue
+
+        def change(new: float, old: float) -> float:
+            return (new - old) / old if old else 0.0
+
+        p50_change = change(case["latency_ms"].get("p50", 0), base["latency_ms"].get("p50", 0))
+        p99_change = change(case["latency_ms"].get("p99", 0), base["latency_ms"].get("p99", 0))
+        rps_change = change(case["throughput_rps"], base["throughput_rps"])
+        regressed = p50_change > args.threshold or p99_change > args.threshold or rps_change < -args.threshold
+        regressions += regressed
+        print(f"{name:<40} "
+              f"{base['latency_ms'].get('p50', 0):>8} -> {case['latency_ms'].get('p50', 0):<8} "
+              f"{base['latency_ms'].get('p99', 0):>8} -> {case['latency_ms'].get('p99', 0):<8} "
+              f"{base['throughput_rps']:>9} -> {case['throughput_rps']:<9}"
+              f"{'  REGRESSION' if regressed else ''}")
+
+    print(f"{regressions} regression(s) beyond {args.threshold:.0%}")
+    return 1 if regressions else 0
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Benchmark the Unreal MCP bridge")
+    subparsers = parser.add_subparsers(dest="command", required=True)
+
+    run = subparsers.add_parser("run", help="Run workloads and report latency and throughput")
+    run.add_argument("--host", default="127.0.0.1")
+    run.add_argument("--port", type=int, default=55557)
+    run.add_argument("--workloads", default="ping,echo,spawn_transform",
+                     help=f"Comma-separated, from: {', '.join(WORKLOADS)}")
+    run.add_argument("--concurrency", default="1,4,16", help="Comma-separated numbers of concurrent clients")
+    run.add_argument("--payload-sizes", default="0,1024,65536,1048576", help="Bytes, for the echo workloads")
+    run.add_argument("--iterations", type=int, default=0, help="Steps per worker (default depends on the workload)")
+    run.add_argument("--actors-per-worker", type=int, default=20, help="Actors each spawn_transform worker moves")
+    run.add_argument("--blueprint", default="BirdBP", help="Blueprint read by blueprint_read")
+    run.add_argument("--per-command-connections", action="store_true",
+                     help="Open a new connection for every request, like the MCP server does")
+    run.add_argument("--server-stats", action="store_true",
+                     help="Store the server's per-phase histograms (get_server_stats) with each case")
+    run.add_argument("--encoding", choices=["json", "msgpack"], default="json", help="Header encoding of requests and responses")
+    run.add_argument("--unix-socket", help="Connect to this Unix domain socket of the bridge instead of TCP")
+    run.add_argument("--shared-memory-mb", type=int, default=0,
+                     help="Shared memory ring size per connection and direction, in MB (0 keeps payloads on the socket)")
+    run.add_argument("--timeout", type=float, default=30.0)
+    run.add_argument("--label", default="", help="Free text stored in the result, e.g. a commit id")
+    run.add_argument("--output", help="Write results to this JSON file")
+    run.add_argument("--fail-on-errors", action="store_true", help="Exit with 1 if any request failed")
+
+    compare = subparsers.add_parser("compare", help="Compare two result files")
+    compare.add_argument("baseline")
+    compare.add_argument("current")
+    compare.add_argument("--threshold", type=float, default=0.10,
+                         help="Relative change in p50/p99 latency or throughput counted as a regression")
+
+    args = parser.parse_args()
+    return command_run(args) if args.command == "run" else command_compare(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,526 @@
+#!/usr/bin/env python
+"""
+Replay a request journal recorded by the Unreal MCP bridge.
+
+The bridge records every request and response, with timestamps, when it is
+started with -MCPJournal=<path>, after the start_recording command, or after
+UnrealMCP.Journal.Start in the editor console (see Docs/Profiling.md). This
+script plays such a journal back against a bridge, compares each response with
+the recorded one structurally, and reports how the server-side timings moved.
+A recorded agent session thus becomes a repeatable regression test and benchmark.
+
+Pacing:
+- fast (default): send each request as soon as the previous response arrives
+- original: keep the recorded gaps between requests (scaled by --speed)
+
+Requests are replayed in their recorded order on a single connection, so
+commands that depend on each other see the same state. --parallel instead
+replays each recorded connection on its own connection, concurrently.
+
+Clients:
+- socket (default): talks to the bridge directly over the wire protocol
+- python: goes through AsyncUnrealConnection in unreal_async_client.py, the
+  pooled client the MCP tools use, so the Python layer is part of what is measured
+
+Responses match when they have the same status and the same structure. Keys
+that differ between runs by design (timings, ids, handles) are skipped; see
+--ignore. With --structure-only only keys and value types are compared.
+
+Usage:
+    python replay_journal.py info session.mcpj
+    python replay_journal.py replay session.mcpj --pacing original --output replay.json
+    python replay_journal.py replay session.mcpj --fail-on-mismatch
+"""
+
+import argparse
+import asyncio
+import fnmatch
+import hashlib
+import json
+import math
+import os
+import socket
+import struct
+import sys
+import threading
+import time
+from collections import defaultdict
+from typing import Any, Dict, List, Optional, Tuple
+
+# Add the Python directory to the path so we can reuse the wire helpers
+sys.path.append(os.path.dirname(os.path.dirname(os.path.dirname(os.path.abspath(__file__)))))
+
+import msgpack_codec
+from viewport_stream import FRAME_MAGIC, FRAME_PREFIX, JsonScanState, split_message
+
+JOURNAL_MAGIC = b"MCPJ"
+JOURNAL_VERSION = 1
+# Must match MCPRequestJournal.h
+JOURNAL_FILE_HEADER = struct.Struct("<4sII")
+JOURNAL_RECORD_HEADER = struct.Struct("<BBHIQdIIff")
+RECORD_REQUEST = 1
+RECORD_RESPONSE = 2
+
+REPORT_VERSION = 1
+
+# Commands that control the recording itself, or only report on the server
+DEFAULT_SKIP = "start_recording,stop_recording,get_server_stats"
+
+# Keys whose values legitimately differ between two runs
+DEFAULT_IGNORE = "timing,*_ms,*_s,*_seconds,uptime*,request_id,handle,handles,*_id,*guid*,revision,timestamp,*path"
+
+
+class JournalEntry:
+    """One request with its recorded response (if the response was recorded)."""
+
+    def __init__(self, request_id: int, connection_id: int, time_s: float, json_bytes: bytes, attachment: bytes, encoding: int):
+        self.request_id = request_id
+        self.connection_id = connection_id
+        self.time_s = time_s
+        self.json_bytes = json_bytes
+        self.attachment = attachment
+        # Header encoding the client used; replayed requests keep it
+        self.encoding = encoding
+        self.command = ""
+        self.request: Dict[str, Any] = {}
+        try:
+            self.request = msgpack_codec.decode_header(json_bytes)
+            self.command = self.request.get("type") or self.request.get("command") or ""
+        except ValueError:
+            pass
+        self.response: Optional[Dict[str, Any]] = None
+        self.response_attachment = b""
+        self.response_time_s = 0.0
+        self.queue_ms = 0.0
+        self.execute_ms = 0.0
+
+    @property
+    def server_ms(self) -> float:
+        """Recorded time from receipt of the request to the last byte of the response."""
+        return (self.response_time_s - self.time_s) * 1000.0 if self.response is not None else 0.0
+
+
+def read_journal(path: str) -> Tuple[List[JournalEntry], Dict[str, int]]:
+    """Read a journal file. Returns the requests in recorded order, and counts of what was skipped."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if len(data) < JOURNAL_FILE_HEADER.size:
+        raise ValueError(f"{path} is too short to be a journal")
+    magic, version, _ = JOURNAL_FILE_HEADER.unpack_from(data, 0)
+    if magic != JOURNAL_MAGIC:
+        raise ValueError(f"{path} is not an MCP journal")
+    if version != JOURNAL_VERSION:
+        raise ValueError(f"{path} has journal version {version}, expected {JOURNAL_VERSION}")
+
+    entries: List[JournalEntry] = []
+    by_id: Dict[int, JournalEntry] = {}
+    counts = {"truncated_bytes": 0, "orphan_responses": 0, "unparsable_responses": 0}
+    offset = JOURNAL_FILE_HEADER.size
+    while offset < len(data):
+        if offset + JOURNAL_RECORD_HEADER.size > len(data):
+            counts["truncated_bytes"] = len(data) - offset
+            break
+        kind, encoding, _, connection_id, request_id, time_s, json_len, attachment_len, queue_ms, execute_ms = \
+            JOURNAL_RECORD_HEADER.unpack_from(data, offset)
+        start = offset + JOURNAL_RECORD_HEADER.size
+        end = start + json_len + attachment_len
+        if end > len(data):
+            # The editor stopped mid-write
+            counts["truncated_bytes"] = len(data) - offset
+            break
+        json_bytes = data[start:start + json_len]
+        attachment = data[start + json_len:end]
+        offset = end
+
+        if kind == RECORD_REQUEST:
+            entry = JournalEntry(request_id, connection_id, time_s, json_bytes, attachment, encoding)
+            entries.append(entry)
+            by_id[request_id] = entry
+        elif kind == RECORD_RESPONSE:
+            entry = by_id.get(request_id)
+            if entry is None:
+                counts["orphan_responses"] += 1
+                continue
+            try:
+                entry.response = msgpack_codec.decode_header(json_bytes)
+            except ValueError:
+                counts["unparsable_responses"] += 1
+                continue
+            entry.response_attachment = attachment
+            entry.response_time_s = time_s
+            entry.queue_ms = queue_ms
+            entry.execute_ms = execute_ms
+
+    # Requests are recorded as they arrive, so connections interleave in receive order
+    entries.sort(key=lambda e: (e.time_s, e.request_id))
+    return entries, counts
+
+
+# Clients: call(entry) -> (response envelope or None, attachment, client latency in ms)
+
+class SocketClient:
+    """Persistent connection speaking the bridge's wire protocol."""
+
+    def __init__(self, host: str, port: int, timeout: float):
+        self.host = host
+        self.port = port
+        self.timeout = timeout
+        self.sock: Optional[socket.socket] = None
+        self.buffer = bytearray()
+        self.scan = JsonScanState()
+
+    def close(self):
+        if self.sock:
+            try:
+                self.sock.close()
+            except OSError:
+                pass
+        self.sock = None
+
+    def call(self, entry: JournalEntry) -> Tuple[Optional[Dict[str, Any]], bytes, float]:
+        request = dict(entry.request)
+        # Ask for the server-side queue and execute times
+        request["timing"] = True
+        if entry.encoding == msgpack_codec.ENCODING_MSGPACK:
+            header = msgpack_codec.pack(request)
+            message = FRAME_PREFIX.pack(FRAME_MAGIC, 1, entry.encoding, 0, len(header), len(entry.attachment)) + header + entry.attachment
+        elif entry.attachment:
+            header = json.dumps(request).encode("utf-8")
+            message = FRAME_PREFIX.pack(FRAME_MAGIC, 1, 0, 0, len(header), len(entry.attachment)) + header + entry.attachment
+        else:
+            message = json.dumps(request).encode("utf-8")
+
+        start = time.perf_counter()
+        try:
+            if self.sock is None:
+                self.sock = socket.create_connection((self.host, self.port), timeout=self.timeout)
+                self.sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+                self.buffer.clear()
+                self.scan.reset()
+            self.sock.sendall(message)
+            while True:
+                split = split_message(self.buffer, self.scan)
+                if split is not None:
+                    response_bytes, payload, consumed = split
+                    del self.buffer[:consumed]
+                    break
+                chunk = self.sock.recv(65536)
+                if not chunk:
+                    raise ConnectionError("Connection closed by the bridge")
+                self.buffer += chunk
+            response = msgpack_codec.decode_header(response_bytes)
+        except (OSError, ValueError, ConnectionError):
+            self.close()
+            return None, b"", (time.perf_counter() - start) * 1000.0
+        return response, payload or b"", (time.perf_counter() - start) * 1000.0
+
+
+class PythonClient:
+    """Goes through AsyncUnrealConnection, the pooled client the MCP tools use."""
+
+    def __init__(self, host: str, port: int, timeout: float):
+        from unreal_async_client import AsyncUnrealConnection
+        self.timeout = timeout
+        # The replay threads are synchronous; run the client on a loop of its own
+        self.loop = asyncio.new_event_loop()
+        self.thread = threading.Thread(target=self.loop.run_forever, daemon=True)
+        self.thread.start()
+        # Every journaled call must reach the bridge, so no read cache
+        self.connection = AsyncUnrealConnection(host, port, pool_size=1, default_timeout=timeout, cache_size=0)
+
+    def close(self):
+        asyncio.run_coroutine_threadsafe(self.connection.close(), self.loop).result()
+        self.loop.call_soon_threadsafe(self.loop.stop)
+        self.thread.join()
+        self.loop.close()
+
+    def call(self, entry: JournalEntry) -> Tuple[Optional[Dict[str, Any]], bytes, float]:
+        start = time.perf_counter()
+        call = self.connection.send_command(entry.command, entry.request.get("params") or {}, entry.attachment or None, self.timeout)
+        response = asyncio.run_coroutine_threadsafe(call, self.loop).result()
+        latency_ms = (time.perf_counter() - start) * 1000.0
+        if response is None:
+            return None, b"", latency_ms
+        attachment = response.pop("_attachment", None) or b""
+        return response, attachment, latency_ms
+
+
+# Structural comparison
+
+def is_ignored(key: str, ignore: List[str]) -> bool:
+    return any(fnmatch.fnmatch(key, pattern) for pattern in ignore)
+
+
+def type_name(value: Any) -> str:
+    if isinstance(value, bool):
+        return "bool"
+    if isinstance(value, (int, float)):
+        return "number"
+    if value is None:
+        return "null"
+    return type(value).__name__
+
+
+def compare_values(recorded: Any, replayed: Any, path: str, ignore: List[str], structure_only: bool,
+                   float_tolerance: float, differences: List[Dict[str, Any]], limit: int = 20):
+    """Append the differences between two JSON values to differences, up to limit."""
+    if len(differences) >= limit:
+        return
+    if type_name(recorded) != type_name(replayed):
+        differences.append({"path": path or "$", "recorded": recorded, "replayed": replayed})
+        return
+    if isinstance(recorded, dict):
+        for key in sorted(set(recorded) | set(replayed)):
+            if is_ignored(key, ignore):
+                continue
+            child = f"{path}.{key}" if path else key
+            if key not in replayed or key not in recorded:
+                differences.append({"path": child, "recorded": recorded.get(key, "<missing>"),
+                                    "replayed": replayed.get(key, "<missing>")})
+            else:
+                compare_values(recorded[key], replayed[key], child, ignore, structure_only, float_tolerance, differences, limit)
+            if len(differences) >= limit:
+                return
+    elif isinstance(recorded, list):
+        if len(recorded) != len(replayed):
+            differences.append({"path": f"{path}[]", "recorded": f"{len(recorded)} items", "replayed": f"{len(replayed)} items"})
+            if structure_only:
+                return
+        for index, (a, b) in enumerate(zip(recorded, replayed)):
+            compare_values(a, b, f"{path}[{index}]", ignore, structure_only, float_tolerance, differences, limit)
+            if len(differences) >= limit:
+                return
+    elif structure_only:
+        return
+    elif isinstance(recorded, float) or isinstance(replayed, float):
+        if not math.isclose(recorded, replayed, rel_tol=float_tolerance, abs_tol=float_tolerance):
+            differences.append({"path": path or "$", "recorded": recorded, "replayed": replayed})
+    elif recorded != replayed:
+        differences.append({"path": path or "$", "recorded": recorded, "replayed": replayed})
+
+
+def compare_responses(entry: JournalEntry, response: Optional[Dict[str, Any]], attachment: bytes,
+                      args: argparse.Namespace, ignore: List[str]) -> List[Dict[str, Any]]:
+    if response is None:
+        return [{"path": "$", "recorded": entry.response.get("status"), "replayed": "<no response>"}]
+    differences: List[Dict[str, Any]] = []
+    recorded = {k: v for k, v in entry.response.items() if k != "timing"}
+    replayed = {k: v for k, v in response.items() if k != "timing"}
+    compare_values(recorded, replayed, "", ignore, args.structure_only, args.float_tolerance, differences)
+    if not args.structure_only and entry.response_attachment != attachment:
+        differences.append({
+            "path": "<attachment>",
+            "recorded": f"{len(entry.response_attachment)} bytes, sha1 {hashlib.sha1(entry.response_attachment).hexdigest()[:12]}",
+            "replayed": f"{len(attachment)} bytes, sha1 {hashlib.sha1(attachment).hexdigest()[:12]}",
+        })
+    return differences
+
+
+# Replay
+
+def percentile(sorted_values: List[float], fraction: float) -> float:
+    """Nearest-rank percentile of an already sorted list."""
+    if not sorted_values:
+        return 0.0
+    rank = max(1, math.ceil(fraction * len(sorted_values)))
+    return sorted_values[rank - 1]
+
+
+def summarize(values: List[float]) -> Dict[str, float]:
+    values = sorted(values)
+    return {
+        "p50_ms": round(percentile(values, 0.50), 3),
+        "p90_ms": round(percentile(values, 0.90), 3),
+        "p99_ms": round(percentile(values, 0.99), 3),
+        "mean_ms": round(sum(values) / len(values), 3) if values else 0.0,
+    }
+
+
+def change(new: float, old: float) -> Optional[float]:
+    return round((new - old) / old, 4) if old > 0 else None
+
+
+def replay_sequence(entries: List[JournalEntry], client, args: argparse.Namespace, ignore: List[str],
+                    start_wall: float, first_time: float, results: List[Dict[str, Any]], lock: threading.Lock):
+    """Replay entries in order on one client, appending one result per entry."""
+    for entry in entries:
+        if args.pacing == "original":
+            due = start_wall + (entry.time_s - first_time) / args.speed
+            delay = due - time.perf_counter()
+            if delay > 0:
+                time.sleep(delay)
+
+        response, attachment, latency_ms = client.call(entry)
+        timing = (response or {}).get("timing", {})
+        result = {
+            "request_id": entry.request_id,
+            "command": entry.command,
+            "latency_ms": round(latency_ms, 3),
+            "recorded_server_ms": round(entry.server_ms, 3),
+            "recorded_queue_ms": round(entry.queue_ms, 3),
+            "recorded_execute_ms": round(entry.execute_ms, 3),
+            "queue_ms": timing.get("queue_ms"),
+            "execute_ms": timing.get("execute_ms"),
+        }
+        if entry.response is not None:
+            differences = compare_responses(entry, response, attachment, args, ignore)
+            result["match"] = not differences
+            if differences:
+                result["differences"] = differences
+        with lock:
+            results.append(result)
+
+
+def command_info(args: argparse.Namespace) -> int:
+    entries, counts = read_journal(args.journal)
+    if not entries:
+        print("Journal holds no requests")
+        return 0
+    per_command: Dict[str, List[JournalEntry]] = defaultdict(list)
+    for entry in entries:
+        per_command[entry.command].append(entry)
+    duration = entries[-1].time_s - entries[0].time_s
+    connections = len({entry.connection_id for entry in entries})
+    print(f"{len(entries)} requests over {duration:.1f} s on {connections} connection(s)")
+    for key, value in counts.items():
+        if value:
+            print(f"  {key}: {value}")
+    print(f"{'command':32} {'count':>7} {'errors':>7} {'server p50':>11} {'exec p50':>9} {'exec p99':>9}")
+    for command, items in sorted(per_command.items(), key=lambda kv: -len(kv[1])):
+        answered = [e for e in items if e.response is not None]
+        errors = sum(1 for e in answered if e.response.get("status") == "error")
+        server = summarize([e.server_ms for e in answered])
+        execute = summarize([e.execute_ms for e in answered])
+        print(f"{command:32} {len(items):7d} {errors:7d} {server['p50_ms']:10.2f}ms {execute['p50_ms']:8.2f}ms {execute['p99_ms']:8.2f}ms")
+    return 0
+
+
+def command_replay(args: argparse.Namespace) -> int:
+    entries, counts = read_journal(args.journal)
+    skip = {name for name in args.skip.split(",") if name}
+    only = {name for name in args.commands.split(",") if name}
+    entries = [e for e in entries if e.command and e.command not in skip and (not only or e.command in only)]
+    if args.limit:
+        entries = entries[:args.limit]
+    if not entries:
+        print("Nothing to replay")
+        return 0
+    ignore = [pattern for pattern in args.ignore.split(",") if pattern]
+    client_class = PythonClient if args.client == "python" else SocketClient
+
+    if args.parallel:
+        groups: Dict[int, List[JournalEntry]] = defaultdict(list)
+        for entry in entries:
+            groups[entry.connection_id].append(entry)
+        sequences = list(groups.values())
+    else:
+        sequences = [entries]
+
+    clients = [client_class(args.host, args.port, args.timeout) for _ in sequences]
+    results: List[Dict[str, Any]] = []
+    lock = threading.Lock()
+    first_time = entries[0].time_s
+    start_wall = time.perf_counter()
+    threads = [threading.Thread(target=replay_sequence, args=(sequence, client, args, ignore, start_wall, first_time, results, lock),
+                                daemon=True) for sequence, client in zip(sequences, clients)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    elapsed = time.perf_counter() - start_wall
+    for client in clients:
+        client.close()
+    results.sort(key=lambda r: r["request_id"])
+
+    compared = [r for r in results if "match" in r]
+    mismatches = [r for r in compared if not r["match"]]
+    per_command: Dict[str, List[Dict[str, Any]]] = defaultdict(list)
+    for result in results:
+        per_command[result["command"]].append(result)
+
+    commands = {}
+    for command, items in sorted(per_command.items()):
+        recorded_execute = summarize([r["recorded_execute_ms"] for r in items])
+        replayed_execute = summarize([r["execute_ms"] for r in items if r["execute_ms"] is not None])
+        commands[command] = {
+            "count": len(items),
+            "mismatches": sum(1 for r in items if r.get("match") is False),
+            "recorded_server": summarize([r["recorded_server_ms"] for r in items]),
+            "replay_latency": summarize([r["latency_ms"] for r in items]),
+            "recorded_execute": recorded_execute,
+            "replay_execute": replayed_execute,
+            "execute_p50_change": change(replayed_execute["p50_ms"], recorded_execute["p50_ms"])
+            if any(r["execute_ms"] is not None for r in items) else None,
+        }
+
+    report = {
+        "version": REPORT_VERSION,
+        "journal": os.path.abspath(args.journal),
+        "target": f"{args.host}:{args.port}",
+        "client": args.client,
+        "pacing": args.pacing,
+        "speed": args.speed if args.pacing == "original" else None,
+        "parallel": args.parallel,
+        "requests": len(results),
+        "compared": len(compared),
+        "mismatches": len(mismatches),
+        "elapsed_s": round(elapsed, 3),
+        "recorded_span_s": round(entries[-1].time_s - first_time, 3),
+        "journal_issues": {k: v for k, v in counts.items() if v},
+        "commands": commands,
+        "mismatched_requests": mismatches[:args.max_reported],
+    }
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(report, f, indent=2)
+
+    print(f"Replayed {len(results)} requests in {elapsed:.2f} s "
+          f"(recorded span {report['recorded_span_s']:.2f} s): {len(compared) - len(mismatches)}/{len(compared)} responses match")
+    print(f"{'command':32} {'count':>6} {'diff':>5} {'rec exec p50':>13} {'exec p50':>9} {'change':>8} {'latency p50':>12}")
+    for command, data in commands.items():
+        delta = data["execute_p50_change"]
+        delta_text = f"{delta * 100:+.1f}%" if delta is not None else "n/a"
+        print(f"{command:32} {data['count']:6d} {data['mismatches']:5d} {data['recorded_execute']['p50_ms']:12.2f}ms "
+              f"{data['replay_execute']['p50_ms']:8.2f}ms {delta_text:>8} {data['replay_latency']['p50_ms']:11.2f}ms")
+    for result in mismatches[:args.max_reported]:
+        first = result["differences"][0]
+        print(f"  #{result['request_id']} {result['command']}: {first['path']} recorded {first['recorded']!r}, replayed {first['replayed']!r}")
+
+    return 1 if mismatches and args.fail_on_mismatch else 0
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="action", required=True)
+
+    info = sub.add_parser("info", help="Summarize a journal")
+    info.add_argument("journal")
+
+    replay = sub.add_parser("replay", help="Replay a journal against a bridge")
+    replay.add_argument("journal")
+    replay.add_argument("--host", default="127.0.0.1")
+    replay.add_argument("--port", type=int, default=55557)
+    replay.add_argument("--client", choices=["socket", "python"], default="socket",
+                        help="Send directly, or through the pooled AsyncUnrealConnection the MCP tools use")
+    replay.add_argument("--pacing", choices=["fast", "original"], default="fast")
+    replay.add_argument("--speed", type=float, default=1.0, help="Playback rate for --pacing original")
+    replay.add_argument("--parallel", action="store_true", help="Replay each recorded connection concurrently")
+    replay.add_argument("--commands", default="", help="Only replay these comma-separated commands")
+    replay.add_argument("--skip", default=DEFAULT_SKIP, help="Comma-separated commands not to replay")
+    replay.add_argument("--limit", type=int, default=0, help="Replay at most this many requests")
+    replay.add_argument("--ignore", default=DEFAULT_IGNORE, help="Comma-separated key patterns left out of the comparison")
+    replay.add_argument("--structure-only", action="store_true", help="Compare keys and value types, not values")
+    replay.add_argument("--float-tolerance", type=float, default=1e-3)
+    replay.add_argument("--timeout", type=float, default=60.0)
+    replay.add_argument("--max-reported", type=int, default=50, help="Mismatched requests listed in the report")
+    replay.add_argument("--output", help="Write the report to this JSON file")
+    replay.add_argument("--fail-on-mismatch", action="store_true", help="Exit with 1 if any response differs")
+
+    args = parser.parse_args()
+    if args.action == "info":
+        return command_info(args)
+    return command_replay(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,118 @@
+"""
+Shared memory payloads for Unreal MCP clients on the same machine.
+
+A client creates a named region with two rings, one per direction, and asks the
+bridge to map it with open_shared_memory on an existing connection. From then on
+a frame payload of at least min_payload bytes can be written to the ring and
+replaced on the socket by a 16-byte descriptor (uint64 position, uint64 length),
+with FLAG_SHARED_PAYLOAD set in the frame flags. The socket still carries every
+request and response, in order; only the bulk bytes move.
+
+Region layout (see MCPSharedMemory.h):
+
+    offset     size  field
+    0          4     magic "MCPS"
+    4          4     version
+    8          8     ring size, per direction
+    16         8     request ring tail (bridge writes)
+    24         8     response ring tail (client writes)
+    64         ring  request ring, client to bridge
+    64 + ring  ring  response ring, bridge to client
+
+Positions count bytes since the region was opened; a payload is stored at
+position % ring size and never wraps. When a payload does not fit, the writer
+sends it inline instead, so neither side ever waits for the other.
+"""
+
+import os
+import secrets
+import struct
+from multiprocessing import shared_memory
+from typing import Optional
+
+from viewport_stream import FRAME_MAGIC
+
+SHARED_MEMORY_MAGIC = 0x5350434D  # "MCPS"
+SHARED_MEMORY_VERSION = 1
+HEADER_SIZE = 64
+
+# Frame flag: the payload is a descriptor of bytes in the shared region
+FLAG_SHARED_PAYLOAD = 0x0001
+
+DESCRIPTOR = struct.Struct("<QQ")
+
+_HEADER = struct.Struct("<IIQ")
+_TAIL = struct.Struct("<Q")
+_REQUEST_TAIL_OFFSET = 16
+_RESPONSE_TAIL_OFFSET = 24
+
+# Hosts for which the bridge runs on this machine
+LOOPBACK_HOSTS = {"127.0.0.1", "localhost", "::1"}
+
+
+def frame_flags(buffer: bytearray) -> int:
+    """Flags of the frame at the start of the buffer; 0 for plain JSON."""
+    start = 0
+    while start < len(buffer) and buffer[start] in b" \t\r\n":
+        start += 1
+    if buffer[start:start + 4] != FRAME_MAGIC or len(buffer) < start + 8:
+        return 0
+    return buffer[start + 6] | (buffer[start + 7] << 8)
+
+
+class SharedRing:
+    """The client side of one connection's shared memory region."""
+
+    def __init__(self, ring_size: int, min_payload: int = 64 * 1024):
+        self.ring_size = ring_size
+        self.min_payload = min_payload
+        # The name only has to be unique on this machine
+        self.memory = shared_memory.SharedMemory(
+            name=f"mcp_{os.getpid()}_{secrets.token_hex(4)}", create=True, size=HEADER_SIZE + 2 * ring_size)
+        self._request_head = 0
+        self._response_base = HEADER_SIZE + ring_size
+        _HEADER.pack_into(self.memory.buf, 0, SHARED_MEMORY_MAGIC, SHARED_MEMORY_VERSION, ring_size)
+        _TAIL.pack_into(self.memory.buf, _REQUEST_TAIL_OFFSET, 0)
+        _TAIL.pack_into(self.memory.buf, _RESPONSE_TAIL_OFFSET, 0)
+
+    @property
+    def name(self) -> str:
+        return self.memory.name
+
+    def write(self, payload: bytes) -> Optional[bytes]:
+        """Copy a request payload into the ring and return its descriptor, or None to send it inline."""
+        length = len(payload)
+        if length < self.min_payload or length > self.ring_size:
+            return None
+        position = self._request_head
+        if position % self.ring_size + length > self.ring_size:
+            # Payloads never wrap; skip the rest of the ring
+            position += self.ring_size - position % self.ring_size
+        tail = _TAIL.unpack_from(self.memory.buf, _REQUEST_TAIL_OFFSET)[0]
+        if position + length - tail > self.ring_size:
+            return None
+        offset = HEADER_SIZE + position % self.ring_size
+        self.memory.buf[offset:offset + length] = payload
+        self._request_head = position + length
+        return DESCRIPTOR.pack(position, length)
+
+    def read(self, descriptor: bytes) -> bytes:
+        """Copy out the response payload a descriptor points to, and release its ring space."""
+        if len(descriptor) != DESCRIPTOR.size:
+            raise ValueError(f"Shared payload descriptor has {len(descriptor)} bytes")
+        position, length = DESCRIPTOR.unpack(descriptor)
+        offset = position % self.ring_size
+        if offset + length > self.ring_size:
+            raise ValueError(f"Shared payload descriptor out of range (position {position}, length {length})")
+        start = self._response_base + offset
+        payload = bytes(self.memory.buf[start:start + length])
+        _TAIL.pack_into(self.memory.buf, _RESPONSE_TAIL_OFFSET, position + length)
+        return payload
+
+    def close(self):
+        """Unmap and remove the region; the bridge keeps its own mapping until the connection closes."""
+        self.memory.close()
+        try:
+            self.memory.unlink()
+        except FileNotFoundError:
+            pass
@@ -5,34 +5,190 @@ This module provides tools for extracting complete Blueprint data including
 metadata, components, variables, functions, and event graphs.
 """
 
+import array
+import json
 import logging
-from typing import Dict, Any
+import struct
+import sys
+from typing import Dict, Any, List, Optional
 from mcp.server.fastmcp import FastMCP, Context
 
 # Get logger
 logger = logging.getLogger("UnrealMCP")
 
+# MCPG binary graph export (see MCPGraphBinaryExport.h for the layout)
+MCPG_VERSION = 1
+MCPG_NO_STRING = 0xFFFFFFFF
+MCPG_NODE_CATEGORIES = ["other", "event", "function_call", "variable_get", "variable_set", "custom_event"]
+# JSON field carrying the member name, by node category
+MCPG_MEMBER_FIELDS = {1: "event_name", 2: "function_name", 3: "variable_name", 4: "variable_name", 5: "event_name"}
+MCPG_PIN_OUTPUT = 1
+MCPG_PIN_REFERENCE = 2
+MCPG_PIN_CONST = 4
+
+def decode_graph_binary(data: bytes) -> Dict[str, Any]:
+    """
+    Decode an MCPG graph export into graphs of nodes, pins and connections.
+    
+    Columns are read with one array copy each; strings are resolved from the
+    string table, absent strings become None.
+    """
+    view = memoryview(data)
+    magic, version, _reserved, string_count, graph_count, node_count, pin_count, edge_count = \
+        struct.unpack_from("<4sHHIIIII", view, 0)
+    if magic != b"MCPG":
+        raise ValueError("Not an MCPG graph export")
+    if version != MCPG_VERSION:
+        raise ValueError(f"Unsupported MCPG version {version}")
+    offset = 28
+    
+    strings = []
+    for _ in range(string_count):
+        (length,) = struct.unpack_from("<I", view, offset)
+        offset += 4
+        strings.append(bytes(view[offset:offset + length]).decode("utf-8"))
+        offset += length
+    
+    def column(typecode: str, count: int) -> array.array:
+        nonlocal offset
+        values = array.array(typecode)
+        values.frombytes(view[offset:offset + count * values.itemsize])
+        if sys.byteorder == "big":
+            values.byteswap()
+        offset += count * values.itemsize
+        return values
+    
+    def string(index: int) -> Optional[str]:
+        return None if index == MCPG_NO_STRING else strings[index]
+    
+    def guids(count: int) -> List[str]:
+        parts = column("I", count * 4)
+        return ["%08X%08X%08X%08X" % tuple(parts[i * 4:i * 4 + 4]) for i in range(count)]
+    
+    graph_rows = column("I", graph_count * 6)
+    
+    node_guids = guids(node_count)
+    node_classes = column("I", node_count)
+    node_titles = column("I", node_count)
+    node_members = column("I", node_count)
+    node_pos_x = column("i", node_count)
+    node_pos_y = column("i", node_count)
+    node_first_pins = column("I", node_count)
+    node_pin_counts = column("I", node_count)
+    node_categories = column("B", node_count)
+    
+    pin_guids = guids(pin_count)
+    pin_nodes = column("I", pin_count)
+    pin_names = column("I", pin_count)
+    pin_categories = column("I", pin_count)
+    pin_sub_categories = column("I", pin_count)
+    pin_objects = column("I", pin_count)
+    pin_defaults = column("I", pin_count)
+    pin_flags = column("B", pin_count)
+    
+    edge_from = column("I", edge_count)
+    edge_to = column("I", edge_count)
+    
+    def pin_dict(p: int) -> Dict[str, Any]:
+        flags = pin_flags[p]
+        pin = {
+            "id": pin_guids[p],
+            "name": strings[pin_names[p]],
+            "type": strings[pin_categories[p]],
+            "direction": "output" if flags & MCPG_PIN_OUTPUT else "input",
+        }
+        if pin_sub_categories[p] != MCPG_NO_STRING:
+            pin["sub_type"] = strings[pin_sub_categories[p]]
+        if pin_objects[p] != MCPG_NO_STRING:
+            pin["object_type"] = strings[pin_objects[p]]
+        if pin_defaults[p] != MCPG_NO_STRING:
+            pin["default_value"] = strings[pin_defaults[p]]
+        pin["is_reference"] = bool(flags & MCPG_PIN_REFERENCE)
+        pin["is_const"] = bool(flags & MCPG_PIN_CONST)
+        return pin
+    
+    graphs = []
+    for g in range(graph_count):
+        name, graph_type, first_node, graph_node_count, first_edge, graph_edge_count = graph_rows[g * 6:g * 6 + 6]
+        nodes = []
+        for n in range(first_node, first_node + graph_node_count):
+            category = node_categories[n]
+            first_pin = node_first_pins[n]
+            node = {
+                "id": node_guids[n],
+                "type": strings[node_classes[n]],
+                "title": strings[node_titles[n]],
+                "pos_x": node_pos_x[n],
+                "pos_y": node_pos_y[n],
+                "node_category": MCPG_NODE_CATEGORIES[category] if category < len(MCPG_NODE_CATEGORIES) else "other",
+            }
+            member = string(node_members[n])
+            if member is not None and category in MCPG_MEMBER_FIELDS:
+                node[MCPG_MEMBER_FIELDS[category]] = member
+            node["pins"] = [pin_dict(p) for p in range(first_pin, first_pin + node_pin_counts[n])]
+            nodes.append(node)
+        connections = []
+        for e in range(first_edge, first_edge + graph_edge_count):
+            from_pin, to_pin = edge_from[e], edge_to[e]
+            connections.append({
+                "from_node": node_guids[pin_nodes[from_pin]],
+                "from_pin": pin_guids[from_pin],
+                "from_pin_name": strings[pin_names[from_pin]],
+                "to_node": node_guids[pin_nodes[to_pin]],
+                "to_pin": pin_guids[to_pin],
+                "to_pin_name": strings[pin_names[to_pin]],
+            })
+        graphs.append({
+            "name": strings[name],
+            "type": strings[graph_type],
+            "nodes": nodes,
+            "connections": connections,
+            "node_count": len(nodes),
+            "connection_count": len(connections),
+        })
+    
+    return {"graphs": graphs}
+
 def register_blueprint_introspection_tools(mcp: FastMCP):
     """Register Blueprint introspection tools with the MCP server."""
     
     @mcp.tool()
-    def get_blueprint_data(
+    async def get_blueprint_data(
         ctx: Context,
-        blueprint_name: str
+        blueprint_name: str,
+        sections: Optional[List[str]] = None,
+        detail: str = "full",
+        node_offset: int = 0,
+        node_limit: int = 0
     ) -> Dict[str, Any]:
         """
         Get complete Blueprint data including metadata, components, and variables.
         
         This tool retrieves comprehensive information about a Blueprint asset,
         including its basic information, component hierarchy, and variable definitions.
+        For large Blueprints, request only the sections you need and a lower
+        graph detail level to keep the response small.
         
         Args:
             blueprint_name: Name of the Blueprint to inspect (e.g., "BP_MyActor")
                            Can be just the name or the full path
+            sections: Sections to return (default: all). Any of "info", "components",
+                      "variables", "functions", "event_graphs", "custom_events",
+                      "macros", "interfaces", or "graphs:<GraphName>" for a single
+                      graph (returned under "graphs")
+            detail: Graph detail level: "full" (default), "pins" (no pin default
+                    values), "nodes" (no pins, connections kept) or "summary"
+                    (node and connection counts only)
+            node_offset: Index of the first node returned per graph
+            node_limit: Maximum nodes returned per graph (0 = no limit). Paged
+                        graphs include total_nodes, node_offset, returned_nodes
+                        and has_more
             
         Returns:
             Dict containing:
             - success (bool): Whether the operation succeeded
+            - revision (int): Change counter of the Blueprint; results are cached
+              in the editor until it changes
             - blueprint_info (dict): Basic Blueprint metadata
               - name (str): Blueprint name
               - path (str): Full asset path
@@ -64,13 +220,22 @@ def register_blueprint_introspection_tools(mcp: FastMCP):
             ...     print(f"Parent: {info['parent_class']}")
             ...     print(f"Components: {len(result['components'])}")
             ...     print(f"Variables: {len(result['variables'])}")
+            
+            >>> # Page through one large graph without pin data
+            >>> result = get_blueprint_data(blueprint_name="BP_TestActor",
+            ...     sections=["graphs:EventGraph"], detail="nodes", node_limit=200)
         """
         from unreal_mcp_server import get_unreal_connection
         
         try:
             params = {
-                "blueprint_name": blueprint_name
+                "blueprint_name": blueprint_name,
+                "detail": detail,
+                "node_offset": node_offset,
+                "node_limit": node_limit
             }
+            if sections:
+                params["sections"] = sections
             
             unreal = get_unreal_connection()
             if not unreal:
@@ -78,7 +243,7 @@ def register_blueprint_introspection_tools(mcp: FastMCP):
                 return {"success": False, "error": "Failed to connect to Unreal Engine"}
             
             logger.info(f"Getting Blueprint data for '{blueprint_name}'")
-            response = unreal.send_command("get_blueprint_data", params)
+            response = await unreal.send_command("get_blueprint_data", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
@@ -91,3 +256,270 @@ def register_blueprint_introspection_tools(mcp: FastMCP):
             error_msg = f"Error getting Blueprint data: {e}"
             logger.error(error_msg)
             return {"success": False, "error": error_msg}
+    
+    @mcp.tool()
+    async def get_blueprint_delta(
+        ctx: Context,
+        blueprint_name: str,
+        since_revision: int = 0
+    ) -> Dict[str, Any]:
+        """
+        Get the graph changes made to a Blueprint since an earlier revision.
+        
+        Use the "revision" returned by get_blueprint_data (or a previous delta)
+        to fetch only the nodes and connections that changed, instead of
+        re-reading the whole Blueprint after every edit.
+        
+        Args:
+            blueprint_name: Name of the Blueprint to inspect (e.g., "BP_MyActor")
+            since_revision: Revision the caller last saw; 0 returns every graph
+                            with all nodes and connections as added
+            
+        Returns:
+            Dict containing:
+            - success (bool): Whether the operation succeeded
+            - revision (int): Current revision; pass it as since_revision next time
+            - full_resync_required (bool): since_revision is no longer in the
+              editor's revision log; call get_blueprint_data again. The log
+              only starts with the first delta query for a Blueprint, so start
+              with since_revision=0 or expect one resync
+            - structure_changed (bool): Variables, components or class settings
+              may have changed; re-fetch those sections with get_blueprint_data
+            - graphs (list): Changed graphs, each with name, type, is_new_graph,
+              added_nodes, modified_nodes (full node data), removed_nodes (ids),
+              added_connections and removed_connections
+            - removed_graphs (list): Names of graphs that no longer exist
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            params = {
+                "blueprint_name": blueprint_name,
+                "since_revision": since_revision
+            }
+            
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "error": "Failed to connect to Unreal Engine"}
+            
+            logger.info(f"Getting Blueprint delta for '{blueprint_name}' since revision {since_revision}")
+            response = await unreal.send_command("get_blueprint_delta", params)
+            
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "error": "No response from Unreal Engine"}
+            
+            return response
+            
+        except Exception as e:
+            error_msg = f"Error getting Blueprint delta: {e}"
+            logger.error(error_msg)
+            return {"success": False, "error": error_msg}
+    
+    @mcp.tool()
+    async def export_graph_binary(
+        ctx: Context,
+        blueprint_name: str,
+        graphs: Optional[List[str]] = None
+    ) -> Dict[str, Any]:
+        """
+        Export Blueprint graphs in the compact MCPG binary format and decode them.
+        
+        The editor sends nodes, pins and connections as a binary attachment with
+        a shared string table, which is much smaller and faster to produce than
+        the JSON graph data for large graphs. The decoded result has the same
+        nodes/pins/connections shape as get_blueprint_data with detail="full".
+        
+        Args:
+            blueprint_name: Name of the Blueprint
+            graphs: Graph names to export (default: every graph)
+            
+        Returns:
+            Dict containing export counters (size_bytes, node_count, ...) and graphs
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "error": "Failed to connect to Unreal Engine"}
+            
+            params = {"blueprint_name": blueprint_name}
+            if graphs:
+                params["graphs"] = graphs
+            
+            response = await unreal.send_command("export_graph_binary", params)
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "error": "No response from Unreal Engine"}
+            
+            data = response.pop("_attachment", None)
+            if response.get("status") == "error":
+                return response
+            if not data:
+                return {"success": False, "error": "Graph export arrived without an attachment"}
+            
+            result = response.get("result", {})
+            result.update(decode_graph_binary(data))
+            return result
+            
+        except Exception as e:
+            error_msg = f"Error exporting Blueprint graphs: {e}"
+            logger.error(error_msg)
+            return {"success": False, "error": error_msg}
+    
+    @mcp.tool()
+    async def scan_blueprints(
+        ctx: Context,
+        path: str = "/Game",
+        recursive: bool = True,
+        parent_class: str = "",
+        tag: str = "",
+        tag_value: str = "",
+        max_blueprints: int = 0,
+        sections: Optional[List[str]] = None,
+        detail: str = "summary"
+    ) -> Dict[str, Any]:
+        """
+        Start a project-wide Blueprint scan without freezing the editor.
+        
+        Matching Blueprints are found through the asset registry, loaded
+        asynchronously and extracted a few at a time per editor tick. Collect
+        the results with get_scan_results.
+        
+        Args:
+            path: Content path to search (e.g., "/Game/Characters")
+            recursive: Include sub-folders
+            parent_class: Only Blueprints whose parent or native parent class
+                          has this name (e.g., "Actor", "BP_EnemyBase")
+            tag: Only assets with this asset registry tag
+            tag_value: Required value of the tag (empty = any value)
+            max_blueprints: Stop after this many Blueprints (0 = no limit)
+            sections: Sections per Blueprint, as in get_blueprint_data
+                      (default: all)
+            detail: Graph detail per Blueprint, as in get_blueprint_data;
+                    defaults to "summary" to keep large scans small
+            
+        Returns:
+            Dict with scan_id, total (matched Blueprints) and progress counters
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            params = {
+                "path": path,
+                "recursive": recursive,
+                "max_blueprints": max_blueprints,
+                "detail": detail
+            }
+            if parent_class:
+                params["parent_class"] = parent_class
+            if tag:
+                params["tag"] = tag
+                params["tag_value"] = tag_value
+            if sections:
+                params["sections"] = sections
+            
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "error": "Failed to connect to Unreal Engine"}
+            
+            logger.info(f"Starting Blueprint scan of '{path}'")
+            response = await unreal.send_command("scan_blueprints", params)
+            
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "error": "No response from Unreal Engine"}
+            
+            return response
+            
+        except Exception as e:
+            error_msg = f"Error starting Blueprint scan: {e}"
+            logger.error(error_msg)
+            return {"success": False, "error": error_msg}
+    
+    @mcp.tool()
+    async def get_scan_results(
+        ctx: Context,
+        scan_id: int,
+        max_results: int = 50
+    ) -> Dict[str, Any]:
+        """
+        Collect results of a Blueprint scan started with scan_blueprints.
+        
+        Each call returns the results produced since the previous call (in
+        completion order, each with its "index" in the scan). The editor pauses
+        extraction while too many results are waiting, so call this until
+        has_more is false.
+        
+        Args:
+            scan_id: ID returned by scan_blueprints
+            max_results: Maximum results to return (0 = all available)
+            
+        Returns:
+            Dict containing progress counters, has_more, and results: a list of
+            {index, name, asset_path, data} or {index, name, asset_path, error}
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "error": "Failed to connect to Unreal Engine"}
+            
+            response = await unreal.send_command("get_scan_results", {"scan_id": scan_id, "max_results": max_results})
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "error": "No response from Unreal Engine"}
+            
+            # Results arrive pre-serialized as newline-delimited JSON in the attachment
+            lines = response.pop("_attachment", None) or b""
+            if response.get("status") == "error":
+                return response
+            
+            result = response.get("result", {})
+            result["results"] = [json.loads(line) for line in lines.splitlines() if line.strip()]
+            return result
+            
+        except Exception as e:
+            error_msg = f"Error getting Blueprint scan results: {e}"
+            logger.error(error_msg)
+            return {"success": False, "error": error_msg}
+    
+    @mcp.tool()
+    async def cancel_scan(
+        ctx: Context,
+        scan_id: int
+    ) -> Dict[str, Any]:
+        """
+        Stop a Blueprint scan and discard results that were not collected.
+        
+        Args:
+            scan_id: ID returned by scan_blueprints
+            
+        Returns:
+            Dict with the final progress counters of the scan
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "error": "Failed to connect to Unreal Engine"}
+            
+            response = await unreal.send_command("cancel_scan", {"scan_id": scan_id})
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "error": "No response from Unreal Engine"}
+            
+            return response
+            
+        except Exception as e:
+            error_msg = f"Error cancelling Blueprint scan: {e}"
+            logger.error(error_msg)
+            return {"success": False, "error": error_msg}
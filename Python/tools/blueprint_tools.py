@@ -15,7 +15,7 @@ def register_blueprint_tools(mcp: FastMCP):
     """Register Blueprint tools with the MCP server."""
     
     @mcp.tool()
-    def create_blueprint(
+    async def create_blueprint(
         ctx: Context,
         name: str,
         parent_class: str
@@ -30,7 +30,7 @@ def register_blueprint_tools(mcp: FastMCP):
                 logger.error("Failed to connect to Unreal Engine")
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
                 
-            response = unreal.send_command("create_blueprint", {
+            response = await unreal.send_command("create_blueprint", {
                 "name": name,
                 "parent_class": parent_class
             })
@@ -48,7 +48,7 @@ def register_blueprint_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
     
     @mcp.tool()
-    def add_component_to_blueprint(
+    async def add_component_to_blueprint(
         ctx: Context,
         blueprint_name: str,
         component_type: str,
@@ -105,7 +105,7 @@ def register_blueprint_tools(mcp: FastMCP):
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
                 
             logger.info(f"Adding component to blueprint with params: {params}")
-            response = unreal.send_command("add_component_to_blueprint", params)
+            response = await unreal.send_command("add_component_to_blueprint", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
@@ -120,7 +120,7 @@ def register_blueprint_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
     
     @mcp.tool()
-    def set_static_mesh_properties(
+    async def set_static_mesh_properties(
         ctx: Context,
         blueprint_name: str,
         component_name: str,
@@ -152,7 +152,7 @@ def register_blueprint_tools(mcp: FastMCP):
             }
             
             logger.info(f"Setting static mesh properties with params: {params}")
-            response = unreal.send_command("set_static_mesh_properties", params)
+            response = await unreal.send_command("set_static_mesh_properties", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
@@ -167,7 +167,7 @@ def register_blueprint_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
     
     @mcp.tool()
-    def set_component_property(
+    async def set_component_property(
         ctx: Context,
         blueprint_name: str,
         component_name: str,
@@ -191,7 +191,7 @@ def register_blueprint_tools(mcp: FastMCP):
             }
             
             logger.info(f"Setting component property with params: {params}")
-            response = unreal.send_command("set_component_property", params)
+            response = await unreal.send_command("set_component_property", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
@@ -206,7 +206,7 @@ def register_blueprint_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
     
     @mcp.tool()
-    def set_physics_properties(
+    async def set_physics_properties(
         ctx: Context,
         blueprint_name: str,
         component_name: str,
@@ -236,7 +236,7 @@ def register_blueprint_tools(mcp: FastMCP):
             }
             
             logger.info(f"Setting physics properties with params: {params}")
-            response = unreal.send_command("set_physics_properties", params)
+            response = await unreal.send_command("set_physics_properties", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
@@ -251,7 +251,7 @@ def register_blueprint_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
     
     @mcp.tool()
-    def compile_blueprint(
+    async def compile_blueprint(
         ctx: Context,
         blueprint_name: str
     ) -> Dict[str, Any]:
@@ -269,7 +269,7 @@ def register_blueprint_tools(mcp: FastMCP):
             }
             
             logger.info(f"Compiling blueprint: {blueprint_name}")
-            response = unreal.send_command("compile_blueprint", params)
+            response = await unreal.send_command("compile_blueprint", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
@@ -284,7 +284,7 @@ def register_blueprint_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
 
     @mcp.tool()
-    def set_blueprint_property(
+    async def set_blueprint_property(
         ctx: Context,
         blueprint_name: str,
         property_name: str,
@@ -316,7 +316,7 @@ def register_blueprint_tools(mcp: FastMCP):
             }
             
             logger.info(f"Setting blueprint property with params: {params}")
-            response = unreal.send_command("set_blueprint_property", params)
+            response = await unreal.send_command("set_blueprint_property", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
@@ -331,7 +331,7 @@ def register_blueprint_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
 
     # @mcp.tool() commented out, just use set_component_property instead
-    def set_pawn_properties(
+    async def set_pawn_properties(
         ctx: Context,
         blueprint_name: str,
         auto_possess_player: str = "",
@@ -394,7 +394,7 @@ def register_blueprint_tools(mcp: FastMCP):
                 }
                 
                 logger.info(f"Setting pawn property {prop_name} to {prop_value}")
-                response = unreal.send_command("set_blueprint_property", params)
+                response = await unreal.send_command("set_blueprint_property", params)
                 
                 if not response:
                     logger.error(f"No response from Unreal Engine for property {prop_name}")
@@ -4,18 +4,38 @@ Editor Tools for Unreal MCP.
 This module provides tools for controlling the Unreal Editor viewport and other editor functionality.
 """
 
+import asyncio
 import logging
-from typing import Dict, List, Any, Optional
-from mcp.server.fastmcp import FastMCP, Context
+import sys
+from array import array
+from typing import Dict, List, Any, Optional, Tuple, Union
+from mcp.server.fastmcp import FastMCP, Context, Image
 
 # Get logger
 logger = logging.getLogger("UnrealMCP")
 
+# Packed transform layouts by floats per transform
+TRANSFORM_LAYOUTS = {3: "location", 6: "location_rotation", 9: "full"}
+
+def pack_transforms(transforms: List[List[float]]) -> Tuple[str, bytes]:
+    """Pack equally sized transforms into a little-endian float32 buffer; returns (layout, bytes)."""
+    stride = len(transforms[0]) if transforms else 0
+    if stride not in TRANSFORM_LAYOUTS or any(len(t) != stride for t in transforms):
+        raise ValueError("every transform must have the same length: 3, 6 or 9 floats")
+    packed = array("f", (float(v) for t in transforms for v in t))
+    if sys.byteorder != "little":
+        packed.byteswap()
+    return TRANSFORM_LAYOUTS[stride], packed.tobytes()
+
+def actor_ref(name: str = "", handle: int = 0) -> Dict[str, Any]:
+    """Params addressing an actor: its handle when known (no server-side lookup), else its name."""
+    return {"handle": handle} if handle else {"name": name}
+
 def register_editor_tools(mcp: FastMCP):
     """Register editor tools with the MCP server."""
     
     @mcp.tool()
-    def get_actors_in_level(ctx: Context, max_actors: int = 100) -> List[Dict[str, Any]]:
+    async def get_actors_in_level(ctx: Context, max_actors: int = 100) -> List[Dict[str, Any]]:
         """Get a list of actors in the current level.
         
         Args:
@@ -33,7 +53,7 @@ def register_editor_tools(mcp: FastMCP):
                 return []
                 
             # Send max_actors parameter to the engine
-            response = unreal.send_command("get_actors_in_level", {
+            response = await unreal.send_command("get_actors_in_level", {
                 "max_actors": max_actors
             })
             
@@ -62,7 +82,7 @@ def register_editor_tools(mcp: FastMCP):
             return []
 
     @mcp.tool()
-    def find_actors_by_name(ctx: Context, pattern: str) -> List[Dict[str, Any]]:
+    async def find_actors_by_name(ctx: Context, pattern: str) -> List[Dict[str, Any]]:
         """Find actors in the level by name pattern (case-sensitive substring match).
         
         Searches through all actors in the current level and returns those whose names
@@ -105,7 +125,7 @@ def register_editor_tools(mcp: FastMCP):
                 logger.warning("Failed to connect to Unreal Engine")
                 return []
                 
-            response = unreal.send_command("find_actors_by_name", {
+            response = await unreal.send_command("find_actors_by_name", {
                 "pattern": pattern
             })
             
@@ -120,8 +140,170 @@ def register_editor_tools(mcp: FastMCP):
             logger.error(f"Error finding actors: {e}")
             return []
     
+    async def run_spatial_query(command: str, params: Dict[str, Any]) -> Dict[str, Any]:
+        """Send a query command (spatial, snapshot) and return its result, or an error dict."""
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            
+            response = await unreal.send_command(command, params)
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "message": "No response from Unreal Engine"}
+            
+            return response
+            
+        except Exception as e:
+            error_msg = f"Error running {command}: {e}"
+            logger.error(error_msg)
+            return {"success": False, "message": error_msg}
+    
+    @mcp.tool()
+    async def find_actors_in_radius(
+        ctx: Context,
+        center: List[float],
+        radius: float,
+        actor_class: str = "",
+        max_results: int = 1000
+    ) -> Dict[str, Any]:
+        """Find actors whose bounds intersect a sphere, nearest first.
+        
+        Served from a spatial index kept by the editor, so it stays fast on very
+        large levels without listing every actor.
+        
+        Args:
+            center: [X, Y, Z] world position
+            radius: Sphere radius in centimeters
+            actor_class: Only actors of this class or a subclass (e.g. "StaticMeshActor")
+            max_results: Return at most this many actors, the nearest ones
+                         ("truncated" is then true)
+            
+        Returns:
+            Dict with actors ({name, handle, class, location, distance} each), count,
+            truncated and query_us
+        """
+        params = {"center": center, "radius": radius, "max_results": max_results}
+        if actor_class:
+            params["class"] = actor_class
+        return await run_spatial_query("find_actors_in_radius", params)
+    
+    @mcp.tool()
+    async def find_actors_in_box(
+        ctx: Context,
+        min: List[float],
+        max: List[float],
+        actor_class: str = "",
+        max_results: int = 1000
+    ) -> Dict[str, Any]:
+        """Find actors whose bounds intersect an axis-aligned box.
+        
+        Args:
+            min: [X, Y, Z] box corner
+            max: [X, Y, Z] opposite box corner
+            actor_class: Only actors of this class or a subclass
+            max_results: Stop after this many actors ("truncated" is then true)
+            
+        Returns:
+            Dict with actors ({name, handle, class, location, distance to the box
+            center} each), count, truncated and query_us
+        """
+        params = {"min": min, "max": max, "max_results": max_results}
+        if actor_class:
+            params["class"] = actor_class
+        return await run_spatial_query("find_actors_in_box", params)
+    
+    @mcp.tool()
+    async def find_nearest_actors(
+        ctx: Context,
+        point: List[float],
+        count: int = 10,
+        max_distance: float = 0.0,
+        actor_class: str = "",
+        exclude: str = ""
+    ) -> Dict[str, Any]:
+        """Find the actors closest to a point, nearest first.
+        
+        Args:
+            point: [X, Y, Z] world position
+            count: Number of actors to return
+            max_distance: Ignore actors farther than this (0 for no limit)
+            actor_class: Only actors of this class or a subclass
+            exclude: Name of an actor to leave out, e.g. the one at the point
+            
+        Returns:
+            Dict with actors ({name, handle, class, location, distance} each),
+            count and query_us
+        """
+        params = {"point": point, "count": count}
+        if max_distance > 0:
+            params["max_distance"] = max_distance
+        if actor_class:
+            params["class"] = actor_class
+        if exclude:
+            params["exclude"] = exclude
+        return await run_spatial_query("find_nearest_actors", params)
+    
+    @mcp.tool()
+    async def snapshot_level(
+        ctx: Context,
+        properties: List[str] = [],
+        include_components: bool = True
+    ) -> Dict[str, Any]:
+        """Record the current state of every actor in the level for a later diff_level.
+        
+        Each actor is stored as its handle, name, class, transform and a hash of its
+        properties, so snapshots stay small even on very large levels. The editor keeps
+        the 16 most recent snapshots (within 128 MB); older ones are evicted.
+        
+        Args:
+            properties: Only hash these actor properties (e.g. ["bHidden", "Tags"]);
+                empty hashes every editable property
+            include_components: Also hash component properties (only when properties is empty)
+            
+        Returns:
+            Dict with snapshot_id, actor_count, bytes, capture_ms, hash_ms and evicted ids
+        """
+        params = {"include_components": include_components}
+        if properties:
+            params["properties"] = properties
+        return await run_spatial_query("snapshot_level", params)
+    
+    @mcp.tool()
+    async def diff_level(
+        ctx: Context,
+        from_snapshot: int,
+        to_snapshot: int = 0,
+        transform_tolerance: float = 0.01,
+        max_results: int = 1000
+    ) -> Dict[str, Any]:
+        """List the actors added, removed or changed between two level snapshots.
+        
+        Args:
+            from_snapshot: snapshot_id of the earlier snapshot
+            to_snapshot: snapshot_id of the later snapshot; 0 compares against the level as it is now
+            transform_tolerance: Ignore location/rotation/scale differences below this
+            max_results: Cap on each of the added, removed and changed lists
+            
+        Returns:
+            Dict with added, removed ({handle, name, class} each) and changed (also
+            changes: "transform"/"properties"/"name", with before/after transforms
+            when moved), their counts, truncated and elapsed_ms
+        """
+        params = {
+            "from": from_snapshot,
+            "transform_tolerance": transform_tolerance,
+            "max_results": max_results
+        }
+        if to_snapshot > 0:
+            params["to"] = to_snapshot
+        return await run_spatial_query("diff_level", params)
+    
     @mcp.tool()
-    def spawn_actor(
+    async def spawn_actor(
         ctx: Context,
         name: str,
         type: str,
@@ -166,7 +348,7 @@ def register_editor_tools(mcp: FastMCP):
                 params[param_name] = [float(val) for val in param_value]
             
             logger.info(f"Creating actor '{name}' of type '{type}' with params: {params}")
-            response = unreal.send_command("spawn_actor", params)
+            response = await unreal.send_command("spawn_actor", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
@@ -189,8 +371,81 @@ def register_editor_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
     
     @mcp.tool()
-    def delete_actor(ctx: Context, name: str) -> Dict[str, Any]:
-        """Delete an actor by name."""
+    async def spawn_actors_bulk(
+        ctx: Context,
+        name_prefix: str,
+        transforms: List[List[float]],
+        type: str = "StaticMeshActor",
+        static_mesh: str = "",
+        instanced: bool = False,
+        hierarchical: bool = True,
+        return_names: bool = False
+    ) -> Dict[str, Any]:
+        """Spawn many actors, or one instanced static mesh actor, in a single request.
+        
+        Transforms are sent as a packed float32 buffer, the spawn is one undo entry
+        and the viewports are refreshed once at the end.
+        
+        Args:
+            ctx: The MCP context
+            name_prefix: Base name; actors are named name_prefix_0, name_prefix_1, ...
+                (the instance actor is named name_prefix)
+            transforms: One entry per actor, all the same length: [x, y, z],
+                [x, y, z, pitch, yaw, roll] or [x, y, z, pitch, yaw, roll, sx, sy, sz]
+            type: Actor type, as for spawn_actor (ignored when instanced)
+            static_mesh: Mesh asset path, e.g. "/Engine/BasicShapes/Cube.Cube"
+            instanced: Spawn one actor with an instanced static mesh component holding
+                every transform instead of one actor per transform (requires static_mesh)
+            hierarchical: Use a hierarchical instanced component (HISM) when instanced
+            return_names: Include every spawned actor name in the result
+            
+        Returns:
+            Dict with count, mode, elapsed_ms and either spawned/failed/first_name/last_name
+            or the instance actor and instance_count
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            layout, packed = pack_transforms(transforms)
+            
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            
+            params = {
+                "name_prefix": name_prefix,
+                "type": type,
+                "layout": layout,
+                "instanced": instanced,
+                "hierarchical": hierarchical,
+                "return_names": return_names
+            }
+            if static_mesh:
+                params["static_mesh"] = static_mesh
+            
+            logger.info(f"Spawning {len(transforms)} actors with prefix '{name_prefix}'")
+            response = await unreal.send_command("spawn_actors_bulk", params, attachment=packed)
+            
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "message": "No response from Unreal Engine"}
+            
+            if response.get("status") == "error":
+                error_message = response.get("error", "Unknown error")
+                logger.error(f"Error spawning actors: {error_message}")
+                return {"success": False, "message": error_message}
+            
+            return response
+            
+        except Exception as e:
+            error_msg = f"Error spawning actors: {e}"
+            logger.error(error_msg)
+            return {"success": False, "message": error_msg}
+    
+    @mcp.tool()
+    async def delete_actor(ctx: Context, name: str = "", handle: int = 0) -> Dict[str, Any]:
+        """Delete an actor by name or handle."""
         from unreal_mcp_server import get_unreal_connection
         
         try:
@@ -199,9 +454,7 @@ def register_editor_tools(mcp: FastMCP):
                 logger.error("Failed to connect to Unreal Engine")
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
                 
-            response = unreal.send_command("delete_actor", {
-                "name": name
-            })
+            response = await unreal.send_command("delete_actor", actor_ref(name, handle))
             return response or {}
             
         except Exception as e:
@@ -209,14 +462,15 @@ def register_editor_tools(mcp: FastMCP):
             return {}
     
     @mcp.tool()
-    def set_actor_transform(
+    async def set_actor_transform(
         ctx: Context,
-        name: str,
+        name: str = "",
         location: List[float]  = None,
         rotation: List[float]  = None,
-        scale: List[float] = None
+        scale: List[float] = None,
+        handle: int = 0
     ) -> Dict[str, Any]:
-        """Set the transform of an actor."""
+        """Set the transform of an actor, by name or handle."""
         from unreal_mcp_server import get_unreal_connection
         
         try:
@@ -225,7 +479,7 @@ def register_editor_tools(mcp: FastMCP):
                 logger.error("Failed to connect to Unreal Engine")
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
                 
-            params = {"name": name}
+            params = actor_ref(name, handle)
             if location is not None:
                 params["location"] = location
             if rotation is not None:
@@ -233,7 +487,7 @@ def register_editor_tools(mcp: FastMCP):
             if scale is not None:
                 params["scale"] = scale
                 
-            response = unreal.send_command("set_actor_transform", params)
+            response = await unreal.send_command("set_actor_transform", params)
             return response or {}
             
         except Exception as e:
@@ -241,8 +495,63 @@ def register_editor_tools(mcp: FastMCP):
             return {}
     
     @mcp.tool()
-    def get_actor_properties(ctx: Context, name: str) -> Dict[str, Any]:
-        """Get all properties of an actor."""
+    async def set_transforms_bulk(
+        ctx: Context,
+        transforms: List[List[float]],
+        names: List[str] = None,
+        handles: List[int] = None,
+        transactional: bool = True
+    ) -> Dict[str, Any]:
+        """Set the transforms of many actors in a single request.
+        
+        Args:
+            ctx: The MCP context
+            transforms: One entry per actor, all the same length: [x, y, z],
+                [x, y, z, pitch, yaw, roll] or [x, y, z, pitch, yaw, roll, sx, sy, sz].
+                Parts that are left out keep their current value.
+            names: Actor names, one per transform
+            handles: Actor handles, one per transform; used instead of names and
+                skips the name lookup
+            transactional: Record the move as one undo entry; turn off for
+                frequent updates such as animation
+            
+        Returns:
+            Dict with count, updated, failed, failures ({index, error} per
+            actor that could not be moved) and elapsed_ms
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            actors = {"handles": handles} if handles else {"names": names or []}
+            if len(next(iter(actors.values()))) != len(transforms):
+                return {"success": False, "message": "names/handles and transforms must have the same length"}
+            layout, packed = pack_transforms(transforms)
+            
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            
+            response = await unreal.send_command("set_transforms_bulk", {
+                **actors,
+                "layout": layout,
+                "transactional": transactional
+            }, attachment=packed)
+            
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "message": "No response from Unreal Engine"}
+            
+            return response
+            
+        except Exception as e:
+            error_msg = f"Error setting transforms: {e}"
+            logger.error(error_msg)
+            return {"success": False, "message": error_msg}
+    
+    @mcp.tool()
+    async def get_actor_properties(ctx: Context, name: str = "", handle: int = 0) -> Dict[str, Any]:
+        """Get all properties of an actor, by name or handle."""
         from unreal_mcp_server import get_unreal_connection
         
         try:
@@ -251,9 +560,7 @@ def register_editor_tools(mcp: FastMCP):
                 logger.error("Failed to connect to Unreal Engine")
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
                 
-            response = unreal.send_command("get_actor_properties", {
-                "name": name
-            })
+            response = await unreal.send_command("get_actor_properties", actor_ref(name, handle))
             return response or {}
             
         except Exception as e:
@@ -261,33 +568,40 @@ def register_editor_tools(mcp: FastMCP):
             return {}
 
     @mcp.tool()
-    def set_actor_property(
+    async def set_actor_property(
         ctx: Context,
-        name: str,
-        property_name: str,
-        property_value,
+        name: str = "",
+        property_name: str = "",
+        property_value = None,
+        handle: int = 0
     ) -> Dict[str, Any]:
         """
-        Set a property on an actor.
+        Set a property on an actor, by name or handle.
         
         Args:
-            name: Name of the actor
+            name: Name of the actor (not needed when handle is given)
             property_name: Name of the property to set
             property_value: Value to set the property to
+            handle: Actor handle returned by spawn/find/list commands
             
         Returns:
             Dict containing response from Unreal with operation status
         """
         from unreal_mcp_server import get_unreal_connection
         
+        if not name and not handle:
+            return {"success": False, "message": "Either name or handle is required"}
+        if not property_name:
+            return {"success": False, "message": "property_name is required"}
+        
         try:
             unreal = get_unreal_connection()
             if not unreal:
                 logger.error("Failed to connect to Unreal Engine")
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
                 
-            response = unreal.send_command("set_actor_property", {
-                "name": name,
+            response = await unreal.send_command("set_actor_property", {
+                **actor_ref(name, handle),
                 "property_name": property_name,
                 "property_value": property_value
             })
@@ -305,7 +619,7 @@ def register_editor_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
 
     # @mcp.tool() commented out because it's buggy
-    def focus_viewport(
+    async def focus_viewport(
         ctx: Context,
         target: str = None,
         location: List[float] = None,
@@ -344,7 +658,7 @@ def register_editor_tools(mcp: FastMCP):
             if orientation:
                 params["orientation"] = orientation
                 
-            response = unreal.send_command("focus_viewport", params)
+            response = await unreal.send_command("focus_viewport", params)
             return response or {}
             
         except Exception as e:
@@ -352,7 +666,158 @@ def register_editor_tools(mcp: FastMCP):
             return {"status": "error", "message": str(e)}
 
     @mcp.tool()
-    def spawn_blueprint_actor(
+    async def take_screenshot(
+        ctx: Context,
+        filepath: str = None,
+        format: str = "png",
+        quality: int = 85,
+        max_width: int = 1280,
+        max_height: int = 720
+    ) -> Union[Image, Dict[str, Any]]:
+        """Capture the active editor viewport.
+        
+        The capture uses a non-blocking GPU readback and encodes on a worker thread,
+        so it does not stall the editor. Without a filepath the image is returned
+        inline; with a filepath it is written to disk and only the path is returned.
+        
+        Args:
+            filepath: Optional file to write instead of returning the image inline
+            format: "png" or "jpeg"
+            quality: JPEG quality (1-100), ignored for PNG
+            max_width: Downscale so the image is at most this wide (0 = native)
+            max_height: Downscale so the image is at most this tall (0 = native)
+            
+        Returns:
+            The image, or a dict with the written filepath and image size
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            
+            params = {
+                "format": format,
+                "quality": quality,
+                "max_width": max_width,
+                "max_height": max_height,
+                # Raw bytes in a binary frame avoid the base64 overhead on the wire
+                "delivery": "file" if filepath else "binary"
+            }
+            if filepath:
+                params["filepath"] = filepath
+            
+            response = await unreal.send_command("take_screenshot", params)
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "message": "No response from Unreal Engine"}
+            
+            image_bytes = response.pop("_attachment", None)
+            if response.get("status") == "error" or image_bytes is None:
+                return response
+            
+            result = response.get("result", {})
+            logger.info(f"Screenshot captured: {result.get('width')}x{result.get('height')} {result.get('format')}, {len(image_bytes)} bytes")
+            return Image(data=image_bytes, format=result.get("format", format))
+            
+        except Exception as e:
+            error_msg = f"Error taking screenshot: {e}"
+            logger.error(error_msg)
+            return {"success": False, "message": error_msg}
+
+    # Only one viewport stream per MCP server; it owns its own persistent connection
+    viewport_stream = {"stream": None}
+
+    @mcp.tool()
+    async def start_viewport_stream(
+        ctx: Context,
+        fps: float = 10.0,
+        max_width: int = 1280,
+        max_height: int = 720,
+        tile_size: int = 64
+    ) -> Dict[str, Any]:
+        """Start a live viewport stream for cheap repeated visual checks.
+        
+        The editor captures at the requested rate and pushes only the tiles that
+        changed since the previous frame. Use get_viewport_stream_frame to look at
+        the latest frame instead of calling take_screenshot repeatedly.
+        
+        Args:
+            fps: Target capture rate (0.5-60)
+            max_width: Downscale frames to at most this width
+            max_height: Downscale frames to at most this height
+            tile_size: Edge length of the change-detection tiles in pixels (16-256)
+            
+        Returns:
+            Dict with the stream id and effective settings
+        """
+        from unreal_mcp_server import UNREAL_HOST, UNREAL_PORT
+        from viewport_stream import ViewportStream
+        
+        try:
+            if viewport_stream["stream"] is not None:
+                await asyncio.to_thread(viewport_stream["stream"].stop)
+                viewport_stream["stream"] = None
+            
+            # The stream client blocks on its own socket; keep it off the event loop
+            stream = ViewportStream(UNREAL_HOST, UNREAL_PORT)
+            response = await asyncio.to_thread(stream.start, fps=fps, max_width=max_width, max_height=max_height, tile_size=tile_size)
+            if response.get("status") != "success":
+                return response
+            
+            viewport_stream["stream"] = stream
+            return response.get("result", {})
+            
+        except Exception as e:
+            error_msg = f"Error starting viewport stream: {e}"
+            logger.error(error_msg)
+            return {"success": False, "message": error_msg}
+
+    @mcp.tool()
+    async def get_viewport_stream_frame(ctx: Context, wait_seconds: float = 2.0) -> Union[Image, Dict[str, Any]]:
+        """Return the latest frame of the running viewport stream.
+        
+        Args:
+            wait_seconds: How long to wait for the first frame if none has arrived yet
+            
+        Returns:
+            The current composited frame as a PNG image
+        """
+        stream = viewport_stream["stream"]
+        if stream is None:
+            return {"success": False, "message": "No viewport stream is running; call start_viewport_stream first"}
+        
+        await asyncio.to_thread(stream.wait_for_frame, 0, timeout=wait_seconds)
+        frame = stream.latest_frame()
+        if frame is None:
+            reason = stream.stopped_reason or "No frame received yet"
+            return {"success": False, "message": reason}
+        
+        png, info = frame
+        logger.info(f"Viewport stream frame {info.get('frame')}: {info.get('changed_tiles')}/{info.get('total_tiles')} tiles, {info.get('payload_bytes')} bytes")
+        return Image(data=png, format="png")
+
+    @mcp.tool()
+    async def stop_viewport_stream(ctx: Context) -> Dict[str, Any]:
+        """Stop the running viewport stream.
+        
+        Returns:
+            Stream statistics (frames and bytes sent, skipped and unchanged frames)
+        """
+        stream = viewport_stream["stream"]
+        if stream is None:
+            return {"success": False, "message": "No viewport stream is running"}
+        
+        viewport_stream["stream"] = None
+        response = await asyncio.to_thread(stream.stop)
+        if response.get("status") == "success":
+            return response.get("result", {})
+        return response
+
+    @mcp.tool()
+    async def spawn_blueprint_actor(
         ctx: Context,
         blueprint_name: str,
         actor_name: str,
@@ -397,7 +862,7 @@ def register_editor_tools(mcp: FastMCP):
                 params[param_name] = [float(val) for val in param_value]
             
             logger.info(f"Spawning blueprint actor with params: {params}")
-            response = unreal.send_command("spawn_blueprint_actor", params)
+            response = await unreal.send_command("spawn_blueprint_actor", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
@@ -412,7 +877,7 @@ def register_editor_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
 
     @mcp.tool()
-    def get_console_output(
+    async def get_console_output(
         ctx: Context, 
         max_lines: int = 500,
         severity: str = "All",
@@ -436,9 +901,10 @@ def register_editor_tools(mcp: FastMCP):
                      - "Warning": Returns warnings and errors
                      
             category: Filter by log category (default: "" for all categories).
-                     Common categories: "LogTemp", "LogBlueprint", "LogPython", "LogActor"
+                     Common categories: "LogUnrealMCP", "LogTemp", "LogBlueprint", "LogPython", "LogActor"
                      Examples:
                      - "": All categories
+                     - "LogUnrealMCP": Messages from the MCP plugin itself
                      - "LogTemp": Only messages logged via UE_LOG(LogTemp, ...)
                      - "LogBlueprint": Only Blueprint-related messages
         
@@ -467,8 +933,8 @@ def register_editor_tools(mcp: FastMCP):
             # Get only Blueprint-related warnings and errors
             >>> get_console_output(category="LogBlueprint", severity="Warning")
             
-            # Get recent LogTemp messages for debugging
-            >>> get_console_output(max_lines=100, category="LogTemp")
+            # Get recent messages from the MCP plugin for debugging
+            >>> get_console_output(max_lines=100, category="LogUnrealMCP")
         
         Note:
             This tool captures log messages from the editor's output log.
@@ -495,7 +961,7 @@ def register_editor_tools(mcp: FastMCP):
             }
             
             logger.info(f"Getting console output with params: {params}")
-            response = unreal.send_command("get_console_output", params)
+            response = await unreal.send_command("get_console_output", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
@@ -525,7 +991,7 @@ def register_editor_tools(mcp: FastMCP):
             }
 
     @mcp.tool()
-    def get_opened_assets(ctx: Context) -> Dict[str, Any]:
+    async def get_opened_assets(ctx: Context) -> Dict[str, Any]:
         """
         Get currently opened assets in the Unreal Editor.
         
@@ -560,7 +1026,7 @@ def register_editor_tools(mcp: FastMCP):
                 return {"success": False, "error": "Failed to connect to Unreal Engine", "assets": [], "count": 0}
             
             logger.info("Getting opened assets from editor")
-            response = unreal.send_command("get_opened_assets", {})
+            response = await unreal.send_command("get_opened_assets", {})
             
             if not response:
                 logger.error("No response from Unreal Engine")
@@ -574,5 +1040,243 @@ def register_editor_tools(mcp: FastMCP):
             logger.error(error_msg)
             return {"success": False, "error": error_msg, "assets": [], "count": 0}
 
+    @mcp.tool()
+    async def batch(
+        ctx: Context,
+        commands: List[Dict[str, Any]],
+        transaction: bool = True,
+        stop_on_error: bool = True,
+        description: str = "MCP batch"
+    ) -> Dict[str, Any]:
+        """
+        Run several commands in one request, as a single undoable editor transaction.
+        
+        Blueprint refreshes and compiles requested by the commands are deferred
+        and done once per blueprint when the batch commits, so bulk edits are
+        much faster than sending the commands one by one.
+        
+        Args:
+            commands: List of {"type": command_name, "params": {...}}
+            transaction: Group the edits into one undo entry (all or nothing with stop_on_error)
+            stop_on_error: Stop at the first failing command; with a transaction,
+                every edit made by the batch is rolled back and the error still
+                carries failed_index and the results up to the failed command
+            description: Undo history label
+            
+        Returns:
+            Dict with executed, failed, results (one {type, status, result|error}
+            per command), blueprints_refreshed, blueprints_compiled
+            and blueprints_saved
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "error": "Failed to connect to Unreal Engine"}
+            
+            response = await unreal.send_command("batch", {
+                "commands": commands,
+                "transaction": transaction,
+                "stop_on_error": stop_on_error,
+                "description": description
+            })
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "error": "No response from Unreal Engine"}
+            
+            return response
+            
+        except Exception as e:
+            error_msg = f"Error running batch: {e}"
+            logger.error(error_msg)
+            return {"success": False, "error": error_msg}
+    
+    @mcp.tool()
+    async def begin_transaction(ctx: Context, description: str = "MCP transaction") -> Dict[str, Any]:
+        """
+        Open an editor transaction that spans the following commands.
+        
+        Every edit until commit_transaction or rollback_transaction becomes one
+        undo entry, and blueprint refreshes and compiles are deferred until
+        commit. Only one transaction can be open at a time.
+        
+        Args:
+            description: Undo history label
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "error": "Failed to connect to Unreal Engine"}
+            
+            response = await unreal.send_command("begin_transaction", {"description": description})
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "error": "No response from Unreal Engine"}
+            
+            return response
+            
+        except Exception as e:
+            error_msg = f"Error beginning transaction: {e}"
+            logger.error(error_msg)
+            return {"success": False, "error": error_msg}
+    
+    @mcp.tool()
+    async def commit_transaction(ctx: Context) -> Dict[str, Any]:
+        """
+        Close the open transaction, keeping its edits, and run the deferred refreshes and compiles.
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "error": "Failed to connect to Unreal Engine"}
+            
+            response = await unreal.send_command("commit_transaction", {})
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "error": "No response from Unreal Engine"}
+            
+            return response
+            
+        except Exception as e:
+            error_msg = f"Error committing transaction: {e}"
+            logger.error(error_msg)
+            return {"success": False, "error": error_msg}
+    
+    @mcp.tool()
+    async def rollback_transaction(ctx: Context) -> Dict[str, Any]:
+        """
+        Close the open transaction and undo every edit made in it.
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "error": "Failed to connect to Unreal Engine"}
+            
+            response = await unreal.send_command("rollback_transaction", {})
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "error": "No response from Unreal Engine"}
+            
+            return response
+            
+        except Exception as e:
+            error_msg = f"Error rolling back transaction: {e}"
+            logger.error(error_msg)
+            return {"success": False, "error": error_msg}
+
+    @mcp.tool()
+    async def get_server_stats(ctx: Context, commands: bool = True, reset: bool = False) -> Dict[str, Any]:
+        """
+        Get request counters and latency percentiles from the MCP server.
+        
+        Answered without waiting for the game thread, so it also works while
+        the editor is busy.
+        
+        Args:
+            commands: Include a breakdown per command type
+            reset: Clear the statistics after reading them
+            
+        Returns:
+            Dict with uptime_s, requests_per_s, totals and (optionally) commands.
+            Each entry has requests, errors, bytes_in, bytes_out and latency
+            percentiles for the parse, queue, execute, serialize, send and total phases.
+            "client" describes this server's connection pool: open connections,
+            calls in flight, and request, error, timeout and connect counters.
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "error": "Failed to connect to Unreal Engine"}
+            
+            response = await unreal.send_command("get_server_stats", {"commands": commands, "reset": reset})
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "error": "No response from Unreal Engine"}
+            
+            response["client"] = unreal.stats()
+            return response
+            
+        except Exception as e:
+            error_msg = f"Error getting server stats: {e}"
+            logger.error(error_msg)
+            return {"success": False, "error": error_msg}
+
+    @mcp.tool()
+    async def start_recording(ctx: Context, path: str = "") -> Dict[str, Any]:
+        """
+        Record every request and response the MCP server handles to a journal file.
+        
+        The journal can be replayed later with scripts/benchmarks/replay_journal.py
+        to turn a session into a repeatable regression test or benchmark.
+        
+        Args:
+            path: Journal file on the editor machine (default: Saved/MCP/Journal-<time>.mcpj)
+            
+        Returns:
+            Dict with the journal path and record counts
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "error": "Failed to connect to Unreal Engine"}
+            
+            params = {"path": path} if path else {}
+            response = await unreal.send_command("start_recording", params)
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "error": "No response from Unreal Engine"}
+            
+            return response
+            
+        except Exception as e:
+            error_msg = f"Error starting recording: {e}"
+            logger.error(error_msg)
+            return {"success": False, "error": error_msg}
+    
+    @mcp.tool()
+    async def stop_recording(ctx: Context) -> Dict[str, Any]:
+        """
+        Stop recording the request journal and close the file.
+        
+        Returns:
+            Dict with the journal path, records written and records dropped
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "error": "Failed to connect to Unreal Engine"}
+            
+            response = await unreal.send_command("stop_recording", {})
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "error": "No response from Unreal Engine"}
+            
+            return response
+            
+        except Exception as e:
+            error_msg = f"Error stopping recording: {e}"
+            logger.error(error_msg)
+            return {"success": False, "error": error_msg}
+
     logger.info("Editor tools registered successfully")
 
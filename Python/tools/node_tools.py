@@ -15,7 +15,7 @@ def register_blueprint_node_tools(mcp: FastMCP):
     """Register Blueprint node manipulation tools with the MCP server."""
     
     @mcp.tool()
-    def add_blueprint_event_node(
+    async def add_blueprint_event_node(
         ctx: Context,
         blueprint_name: str,
         event_name: str,
@@ -54,7 +54,7 @@ def register_blueprint_node_tools(mcp: FastMCP):
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
             
             logger.info(f"Adding event node '{event_name}' to blueprint '{blueprint_name}'")
-            response = unreal.send_command("add_blueprint_event_node", params)
+            response = await unreal.send_command("add_blueprint_event_node", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
@@ -69,7 +69,7 @@ def register_blueprint_node_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
     
     @mcp.tool()
-    def add_blueprint_input_action_node(
+    async def add_blueprint_input_action_node(
         ctx: Context,
         blueprint_name: str,
         action_name: str,
@@ -105,7 +105,7 @@ def register_blueprint_node_tools(mcp: FastMCP):
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
             
             logger.info(f"Adding input action node for '{action_name}' to blueprint '{blueprint_name}'")
-            response = unreal.send_command("add_blueprint_input_action_node", params)
+            response = await unreal.send_command("add_blueprint_input_action_node", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
@@ -120,7 +120,7 @@ def register_blueprint_node_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
     
     @mcp.tool()
-    def add_blueprint_function_node(
+    async def add_blueprint_function_node(
         ctx: Context,
         blueprint_name: str,
         target: str,
@@ -164,7 +164,7 @@ def register_blueprint_node_tools(mcp: FastMCP):
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
             
             logger.info(f"Adding function node '{function_name}' to blueprint '{blueprint_name}'")
-            response = unreal.send_command("add_blueprint_function_node", command_params)
+            response = await unreal.send_command("add_blueprint_function_node", command_params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
@@ -179,7 +179,7 @@ def register_blueprint_node_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
             
     @mcp.tool()
-    def connect_blueprint_nodes(
+    async def connect_blueprint_nodes(
         ctx: Context,
         blueprint_name: str,
         source_node_id: str,
@@ -217,7 +217,7 @@ def register_blueprint_node_tools(mcp: FastMCP):
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
             
             logger.info(f"Connecting nodes in blueprint '{blueprint_name}'")
-            response = unreal.send_command("connect_blueprint_nodes", params)
+            response = await unreal.send_command("connect_blueprint_nodes", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
@@ -232,7 +232,7 @@ def register_blueprint_node_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
     
     @mcp.tool()
-    def add_blueprint_variable(
+    async def add_blueprint_variable(
         ctx: Context,
         blueprint_name: str,
         variable_name: str,
@@ -267,7 +267,7 @@ def register_blueprint_node_tools(mcp: FastMCP):
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
             
             logger.info(f"Adding variable '{variable_name}' to blueprint '{blueprint_name}'")
-            response = unreal.send_command("add_blueprint_variable", params)
+            response = await unreal.send_command("add_blueprint_variable", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
@@ -282,7 +282,7 @@ def register_blueprint_node_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
     
     @mcp.tool()
-    def add_blueprint_get_self_component_reference(
+    async def add_blueprint_get_self_component_reference(
         ctx: Context,
         blueprint_name: str,
         component_name: str,
@@ -319,7 +319,7 @@ def register_blueprint_node_tools(mcp: FastMCP):
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
             
             logger.info(f"Adding self component reference node for '{component_name}' to blueprint '{blueprint_name}'")
-            response = unreal.send_command("add_blueprint_get_self_component_reference", params)
+            response = await unreal.send_command("add_blueprint_get_self_component_reference", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
@@ -334,7 +334,7 @@ def register_blueprint_node_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
     
     @mcp.tool()
-    def add_blueprint_self_reference(
+    async def add_blueprint_self_reference(
         ctx: Context,
         blueprint_name: str,
         node_position = None
@@ -366,7 +366,7 @@ def register_blueprint_node_tools(mcp: FastMCP):
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
             
             logger.info(f"Adding self reference node to blueprint '{blueprint_name}'")
-            response = unreal.send_command("add_blueprint_self_reference", params)
+            response = await unreal.send_command("add_blueprint_self_reference", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
@@ -381,7 +381,7 @@ def register_blueprint_node_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
     
     @mcp.tool()
-    def find_blueprint_nodes(
+    async def find_blueprint_nodes(
         ctx: Context,
         blueprint_name: str,
         node_type = None,
@@ -413,7 +413,7 @@ def register_blueprint_node_tools(mcp: FastMCP):
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
             
             logger.info(f"Finding nodes in blueprint '{blueprint_name}'")
-            response = unreal.send_command("find_blueprint_nodes", params)
+            response = await unreal.send_command("find_blueprint_nodes", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
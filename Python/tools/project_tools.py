@@ -5,7 +5,7 @@ This module provides tools for managing project-wide settings and configuration.
 """
 
 import logging
-from typing import Dict, Any
+from typing import Dict, Any, List, Optional
 from mcp.server.fastmcp import FastMCP, Context
 
 # Get logger
@@ -15,7 +15,7 @@ def register_project_tools(mcp: FastMCP):
     """Register project tools with the MCP server."""
     
     @mcp.tool()
-    def create_input_mapping(
+    async def create_input_mapping(
         ctx: Context,
         action_name: str,
         key: str,
@@ -47,7 +47,7 @@ def register_project_tools(mcp: FastMCP):
             }
             
             logger.info(f"Creating input mapping '{action_name}' with key '{key}'")
-            response = unreal.send_command("create_input_mapping", params)
+            response = await unreal.send_command("create_input_mapping", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
@@ -61,4 +61,71 @@ def register_project_tools(mcp: FastMCP):
             logger.error(error_msg)
             return {"success": False, "message": error_msg}
     
+    @mcp.tool()
+    async def find_assets(
+        ctx: Context,
+        asset_class: Optional[List[str]] = None,
+        paths: Optional[List[str]] = None,
+        recursive: bool = True,
+        name_contains: str = "",
+        tags: Optional[Dict[str, Optional[str]]] = None,
+        include_tags: Optional[List[str]] = None,
+        offset: int = 0,
+        limit: int = 100
+    ) -> Dict[str, Any]:
+        """
+        Search project assets through the asset registry without loading them.
+        
+        Results are sorted by package path, so offset/limit pages are stable
+        between calls while the project does not change.
+        
+        Args:
+            asset_class: Asset classes to match, short ("StaticMesh", "Blueprint")
+                or full ("/Script/Engine.StaticMesh"); subclasses are included
+            paths: Package paths to search (default: every mounted path)
+            recursive: Include sub-folders of the paths
+            name_contains: Case-insensitive substring the asset name must contain
+            tags: Asset registry tags to match, {"Tag": "Value"}; a None or empty
+                value only requires the tag to exist
+            include_tags: Tag values to return with each asset ("*" for all)
+            offset: Index of the first asset to return
+            limit: Maximum assets to return (at most 5000)
+            
+        Returns:
+            Dict containing total, has_more, and assets: a list of
+            {name, path, package, class, class_path[, tags]}
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            
+            params = {"recursive": recursive, "offset": offset, "limit": limit}
+            if asset_class:
+                params["class"] = asset_class
+            if paths:
+                params["paths"] = paths
+            if name_contains:
+                params["name_contains"] = name_contains
+            if tags:
+                params["tags"] = tags
+            if include_tags:
+                params["include_tags"] = include_tags
+            
+            response = await unreal.send_command("find_assets", params)
+            
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "message": "No response from Unreal Engine"}
+            
+            return response
+            
+        except Exception as e:
+            error_msg = f"Error finding assets: {e}"
+            logger.error(error_msg)
+            return {"success": False, "message": error_msg}
+    
     logger.info("Project tools registered successfully") 
\ No newline at end of file
@@ -15,7 +15,7 @@ def register_umg_tools(mcp: FastMCP):
     """Register UMG tools with the MCP server."""
 
     @mcp.tool()
-    def create_umg_widget_blueprint(
+    async def create_umg_widget_blueprint(
         ctx: Context,
         widget_name: str,
         parent_class: str = "UserWidget",
@@ -47,7 +47,7 @@ def register_umg_tools(mcp: FastMCP):
             }
             
             logger.info(f"Creating UMG Widget Blueprint with params: {params}")
-            response = unreal.send_command("create_umg_widget_blueprint", params)
+            response = await unreal.send_command("create_umg_widget_blueprint", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
@@ -62,7 +62,7 @@ def register_umg_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
 
     @mcp.tool()
-    def add_text_block_to_widget(
+    async def add_text_block_to_widget(
         ctx: Context,
         widget_name: str,
         text_block_name: str,
@@ -106,7 +106,7 @@ def register_umg_tools(mcp: FastMCP):
             }
             
             logger.info(f"Adding Text Block to widget with params: {params}")
-            response = unreal.send_command("add_text_block_to_widget", params)
+            response = await unreal.send_command("add_text_block_to_widget", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
@@ -121,7 +121,7 @@ def register_umg_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
 
     @mcp.tool()
-    def add_button_to_widget(
+    async def add_button_to_widget(
         ctx: Context,
         widget_name: str,
         button_name: str,
@@ -168,7 +168,7 @@ def register_umg_tools(mcp: FastMCP):
             }
             
             logger.info(f"Adding Button to widget with params: {params}")
-            response = unreal.send_command("add_button_to_widget", params)
+            response = await unreal.send_command("add_button_to_widget", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
@@ -183,7 +183,7 @@ def register_umg_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
 
     @mcp.tool()
-    def bind_widget_event(
+    async def bind_widget_event(
         ctx: Context,
         widget_name: str,
         widget_component_name: str,
@@ -222,7 +222,7 @@ def register_umg_tools(mcp: FastMCP):
             }
             
             logger.info(f"Binding widget event with params: {params}")
-            response = unreal.send_command("bind_widget_event", params)
+            response = await unreal.send_command("bind_widget_event", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
@@ -237,7 +237,7 @@ def register_umg_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
 
     @mcp.tool()
-    def add_widget_to_viewport(
+    async def add_widget_to_viewport(
         ctx: Context,
         widget_name: str,
         z_order: int = 0
@@ -266,7 +266,7 @@ def register_umg_tools(mcp: FastMCP):
             }
             
             logger.info(f"Adding widget to viewport with params: {params}")
-            response = unreal.send_command("add_widget_to_viewport", params)
+            response = await unreal.send_command("add_widget_to_viewport", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
@@ -281,7 +281,7 @@ def register_umg_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
 
     @mcp.tool()
-    def set_text_block_binding(
+    async def set_text_block_binding(
         ctx: Context,
         widget_name: str,
         text_block_name: str,
@@ -316,7 +316,7 @@ def register_umg_tools(mcp: FastMCP):
             }
             
             logger.info(f"Setting text block binding with params: {params}")
-            response = unreal.send_command("set_text_block_binding", params)
+            response = await unreal.send_command("set_text_block_binding", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
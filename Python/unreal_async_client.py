@@ -0,0 +1,687 @@
+"""
+Asyncio client for the Unreal MCP bridge.
+
+Keeps a small pool of persistent connections to the editor, so concurrent tool
+calls go out side by side instead of queuing behind one blocking socket. Every
+request carries an "id" that the bridge echoes in its response; a reader task per
+connection hands each response to the call waiting for that id. A response that
+arrives after its call timed out is dropped rather than given to the next request.
+
+The bridge answers the requests of one connection in order, and commands that
+touch the editor still run one at a time on the game thread. What runs in
+parallel is everything around them: parsing and serializing on the connection
+threads, the network, and commands answered off the game thread such as
+get_server_stats. A request only waits behind another one on the same
+connection when every connection in the pool is busy.
+
+Calls are never retried: a command that was sent may already have run, so when a
+connection drops its in-flight calls fail and the next call reconnects.
+
+Results of read-only commands (CACHEABLE_COMMANDS) are cached, keyed by command
+and params. The bridge keeps a level and an asset revision counter (see
+MCPChangeFeed.h); each cached result is tagged with the revisions it was read at
+and served again only while they are still current. The client subscribes to
+revision pushes on one pooled connection; until that subscription is live, a
+cached result is validated with get_revisions, which the bridge answers without
+waiting for the game thread. Any command not known to be read-only drops the
+whole cache, so the agent's own edits are always visible to its next read.
+Edits made in the editor reach the cache with the next push, one editor tick later.
+
+With the msgpack package installed, each connection asks the bridge on open
+(with a JSON ping) whether it accepts MessagePack headers, and if so sends its
+requests that way; the bridge answers in kind. This saves JSON formatting and
+parsing on both sides, most of all for float-heavy results such as transforms
+(see msgpack_codec.py). Older bridges, and encoding="json", keep to JSON.
+
+When unix_socket names the path the bridge listens on (see MCPUnixSocket.h),
+connections use that Unix domain socket instead of TCP, which avoids the TCP
+stack on every message. A missing or dead socket file falls back to TCP.
+
+When the bridge runs on this machine and shared_memory_size is set, each
+connection also creates a shared memory region and has the bridge map it with
+open_shared_memory. Attachments and response payloads of 64 KB or more then
+travel through the region, and only a descriptor goes over the socket (see
+shared_memory_transport.py). A connection whose region cannot be opened, for
+example on an older bridge, keeps sending everything over the socket.
+"""
+
+import asyncio
+import copy
+import itertools
+import json
+import logging
+import os
+import random
+import socket
+from collections import OrderedDict
+from typing import Any, Callable, Dict, List, Optional, Tuple
+
+import msgpack_codec
+import shared_memory_transport
+from shared_memory_transport import FLAG_SHARED_PAYLOAD, SharedRing
+from viewport_stream import FRAME_MAGIC, FRAME_PREFIX, JsonScanState, split_message
+
+logger = logging.getLogger("UnrealMCP")
+
+# Commands that routinely take longer than the default timeout
+COMMAND_TIMEOUTS = {
+    "take_screenshot": 60.0,
+    "compile_blueprint": 120.0,
+    "batch": 120.0,
+    "commit_transaction": 120.0,
+}
+
+# Read-only commands whose results are cached, and the revisions they depend on.
+# Actor results also depend on assets: compiling a blueprint reinstances its actors.
+CACHEABLE_COMMANDS = {
+    "get_actors_in_level": ("level", "assets"),
+    "find_actors_by_name": ("level", "assets"),
+    "get_actor_properties": ("level", "assets"),
+    "find_actors_in_radius": ("level", "assets"),
+    "find_actors_in_box": ("level", "assets"),
+    "find_nearest_actors": ("level", "assets"),
+    "get_blueprint_data": ("assets",),
+    "export_graph_binary": ("assets",),
+    "find_assets": ("assets",),
+}
+
+# Commands that edit nothing a cached result depends on. Every other command,
+# including ones added later, drops the cache.
+NON_MUTATING_COMMANDS = {
+    "ping", "echo", "get_server_stats", "get_revisions", "subscribe_revisions", "open_shared_memory",
+    "start_recording", "stop_recording", "get_console_output", "get_opened_assets",
+    "focus_viewport", "take_screenshot", "start_viewport_stream", "stop_viewport_stream",
+    "ack_viewport_frame", "snapshot_level", "diff_level", "get_blueprint_delta",
+    "scan_blueprints", "get_scan_results", "cancel_scan",
+}
+
+
+def encode_request(
+    command: str,
+    params: Optional[Dict[str, Any]],
+    attachment: Optional[bytes],
+    request_id: Optional[int] = None,
+    revisions: bool = False,
+    encoding: int = msgpack_codec.ENCODING_JSON,
+    flags: int = 0
+) -> bytes:
+    """Encode a request as plain JSON, or as a frame when it carries an attachment or is MessagePack.
+
+    With FLAG_SHARED_PAYLOAD in flags, attachment is the descriptor of a shared memory payload.
+    """
+    command_obj: Dict[str, Any] = {"type": command, "params": params or {}}
+    if request_id is not None:
+        command_obj["id"] = request_id
+    if revisions:
+        command_obj["revisions"] = True
+    if encoding == msgpack_codec.ENCODING_MSGPACK:
+        header = msgpack_codec.pack(command_obj)
+        return FRAME_PREFIX.pack(FRAME_MAGIC, 1, encoding, flags, len(header), len(attachment or b"")) + header + (attachment or b"")
+    header = json.dumps(command_obj).encode("utf-8")
+    if attachment:
+        return FRAME_PREFIX.pack(FRAME_MAGIC, 1, 0, flags, len(header), len(attachment)) + header + attachment
+    return header
+
+
+def normalize_response(response: Dict[str, Any], attachment: Optional[bytes]) -> Dict[str, Any]:
+    """Attach the binary payload and bring both error formats to {"status": "error", "error": ...}."""
+    # Binary payloads (e.g. screenshots) are handed back next to the JSON result
+    if attachment is not None:
+        response["_attachment"] = attachment
+
+    # Check for both error formats: {"status": "error", ...} and {"success": false, ...}
+    if response.get("status") == "error":
+        error_message = response.get("error") or response.get("message", "Unknown Unreal error")
+        logger.error(f"Unreal error (status=error): {error_message}")
+        # We want to preserve the original error structure but ensure error is accessible
+        if "error" not in response:
+            response["error"] = error_message
+    elif response.get("success") is False:
+        # This format uses {"success": false, "error": "message"} or {"success": false, "message": "message"}
+        error_message = response.get("error") or response.get("message", "Unknown Unreal error")
+        logger.error(f"Unreal error (success=false): {error_message}")
+        # Convert to the standard format expected by higher layers
+        response = {
+            "status": "error",
+            "error": error_message
+        }
+    return response
+
+
+class ReadCache:
+    """Results of read-only commands, valid while the revisions they were read at are current."""
+
+    def __init__(self, max_entries: int = 256):
+        self.max_entries = max_entries
+        # Latest known {"epoch", "level", "assets"} of the bridge
+        self.revisions: Optional[Dict[str, Any]] = None
+        # Bumped by every command that may edit; results read across a bump are not stored
+        self.generation = 0
+        self._entries: "OrderedDict[str, Tuple[int, Dict[str, Any], Dict[str, Any], Optional[bytes]]]" = OrderedDict()
+        self.counters = {"hits": 0, "misses": 0, "validations": 0, "invalidations": 0}
+
+    @staticmethod
+    def key(command: str, params: Optional[Dict[str, Any]]) -> str:
+        return command + json.dumps(params or {}, sort_keys=True, separators=(",", ":"))
+
+    def __contains__(self, key: str) -> bool:
+        return key in self._entries
+
+    def __len__(self) -> int:
+        return len(self._entries)
+
+    def observe(self, revisions: Dict[str, Any]):
+        """Merge revisions from a response or a push; counters only move forward."""
+        if self.revisions is None or self.revisions.get("epoch") != revisions.get("epoch"):
+            # First contact, or the editor restarted and its counters with it
+            self._entries.clear()
+            self.revisions = dict(revisions)
+            return
+        for name in ("level", "assets"):
+            self.revisions[name] = max(self.revisions.get(name, 0), revisions.get(name, 0))
+
+    def lookup(self, key: str, depends_on: Tuple[str, ...]) -> Optional[Tuple[Dict[str, Any], Optional[bytes]]]:
+        entry = self._entries.get(key)
+        if entry is not None:
+            generation, revisions, response, payload = entry
+            if generation == self.generation and self._is_current(revisions, depends_on):
+                self._entries.move_to_end(key)
+                self.counters["hits"] += 1
+                return copy.deepcopy(response), payload
+            del self._entries[key]
+        return None
+
+    def store(self, key: str, generation: int, revisions: Dict[str, Any], response: Dict[str, Any], payload: Optional[bytes]):
+        if generation != self.generation or self.revisions is None or revisions.get("epoch") != self.revisions.get("epoch"):
+            return
+        self._entries[key] = (generation, revisions, copy.deepcopy(response), payload)
+        self._entries.move_to_end(key)
+        while len(self._entries) > self.max_entries:
+            self._entries.popitem(last=False)
+
+    def invalidate(self):
+        self.generation += 1
+        if self._entries:
+            self.counters["invalidations"] += 1
+            self._entries.clear()
+
+    def _is_current(self, revisions: Dict[str, Any], depends_on: Tuple[str, ...]) -> bool:
+        current = self.revisions
+        return (current is not None and revisions.get("epoch") == current.get("epoch")
+                and all(revisions.get(name) == current.get(name) for name in depends_on))
+
+
+class _PooledConnection:
+    """One persistent connection and the requests in flight on it."""
+
+    def __init__(self, index: int, on_push: Callable[[Dict[str, Any]], None]):
+        self.index = index
+        self.on_push = on_push
+        # Revision pushes for the read cache arrive on this connection
+        self.subscribed = False
+        # Header encoding of requests, negotiated when the connection opens
+        self.encoding = msgpack_codec.ENCODING_JSON
+        # Shared memory region for large payloads, opened after the encoding
+        self.ring: Optional[SharedRing] = None
+        # "unix" or "tcp", set when the connection opens
+        self.transport = "tcp"
+        self.reader: Optional[asyncio.StreamReader] = None
+        self.writer: Optional[asyncio.StreamWriter] = None
+        self.read_task: Optional[asyncio.Task] = None
+        self.opening: Optional[asyncio.Task] = None
+        # Calls that timed out stay here until their response arrives, so a
+        # connection stuck behind a slow command is not picked as idle
+        self.pending: Dict[int, asyncio.Future] = {}
+
+    @property
+    def is_open(self) -> bool:
+        return self.writer is not None and not self.writer.is_closing()
+
+    async def open(self, host: str, port: int, timeout: float, unix_socket: Optional[str] = None):
+        self.transport = "tcp"
+        if unix_socket and hasattr(socket, "AF_UNIX") and os.path.exists(unix_socket):
+            try:
+                self.reader, self.writer = await asyncio.wait_for(asyncio.open_unix_connection(unix_socket), timeout)
+                self.transport = "unix"
+            except (OSError, asyncio.TimeoutError) as e:
+                # Left behind by an editor that exited, or not ours to open
+                logger.info(f"Pooled connection {self.index}: Unix socket {unix_socket} unavailable, using TCP: {e}")
+        if self.transport == "tcp":
+            self.reader, self.writer = await asyncio.wait_for(asyncio.open_connection(host, port), timeout)
+            sock = self.writer.get_extra_info("socket")
+            if sock is not None:
+                sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+                sock.setsockopt(socket.SOL_SOCKET, socket.SO_KEEPALIVE, 1)
+        self.read_task = asyncio.create_task(self._read_loop(self.reader))
+
+    def encode(
+        self,
+        request_id: int,
+        command: str,
+        params: Optional[Dict[str, Any]],
+        attachment: Optional[bytes],
+        revisions: bool = False
+    ) -> bytes:
+        """Encode a request in this connection's encoding, with a large attachment in shared memory.
+
+        Sending must follow without an await in between: the bridge reads shared
+        payloads in the order their frames arrive.
+        """
+        if attachment and self.ring is not None:
+            descriptor = self.ring.write(attachment)
+            if descriptor is not None:
+                return encode_request(command, params, descriptor, request_id, revisions, self.encoding, FLAG_SHARED_PAYLOAD)
+        return encode_request(command, params, attachment, request_id, revisions, self.encoding)
+
+    async def send(self, request_id: int, data: bytes) -> "asyncio.Future[Tuple[Dict[str, Any], bytes]]":
+        future = asyncio.get_running_loop().create_future()
+        self.pending[request_id] = future
+        try:
+            self.writer.write(data)
+            await self.writer.drain()
+        except Exception:
+            self.pending.pop(request_id, None)
+            raise
+        return future
+
+    def close(self, error: Optional[Exception] = None):
+        self.subscribed = False
+        self.encoding = msgpack_codec.ENCODING_JSON
+        if self.writer is not None:
+            self.writer.close()
+        if self.ring is not None:
+            self.ring.close()
+            self.ring = None
+        self.reader = None
+        self.writer = None
+        if self.read_task is not None and self.read_task is not asyncio.current_task():
+            self.read_task.cancel()
+        self.read_task = None
+        pending, self.pending = self.pending, {}
+        for future in pending.values():
+            if not future.done():
+                future.set_exception(error or ConnectionError("Connection to Unreal closed"))
+
+    async def _read_loop(self, reader: asyncio.StreamReader):
+        buffer = bytearray()
+        scan = JsonScanState()
+        error: Exception = ConnectionError("Connection closed by Unreal")
+        try:
+            while True:
+                chunk = await reader.read(65536)
+                if not chunk:
+                    break
+                buffer += chunk
+                while True:
+                    flags = shared_memory_transport.frame_flags(buffer)
+                    message = split_message(buffer, scan)
+                    if message is None:
+                        break
+                    json_bytes, payload, consumed = message
+                    del buffer[:consumed]
+                    if flags & FLAG_SHARED_PAYLOAD:
+                        # Even late responses release their ring space, in order
+                        if self.ring is None:
+                            raise ValueError("shared payload on a connection without shared memory")
+                        payload = self.ring.read(payload)
+                    self._dispatch(json_bytes, payload)
+        except asyncio.CancelledError:
+            return
+        except OSError as e:
+            error = ConnectionError(f"Connection to Unreal lost: {e}")
+        except ValueError as e:
+            error = ConnectionError(f"Invalid message from Unreal: {e}")
+        logger.warning(f"Pooled connection {self.index}: {error}")
+        self.close(error)
+
+    def _dispatch(self, json_bytes: bytes, payload: bytes):
+        try:
+            response = msgpack_codec.decode_header(json_bytes)
+        except ValueError as e:
+            logger.error(f"Pooled connection {self.index}: undecodable response ({len(json_bytes)} bytes): {e}")
+            return
+
+        request_id = response.pop("id", None)
+        if request_id is None:
+            if "status" not in response:
+                self.on_push(response)
+                return
+            # An error to a request the bridge could not read the id of. Responses are
+            # not ordered, so it can only be attributed when one request is waiting.
+            if not self.pending:
+                logger.warning(f"Pooled connection {self.index}: untagged response with nothing pending: {response}")
+                return
+            if len(self.pending) > 1:
+                error = response.get("error", "unknown error")
+                logger.error(f"Pooled connection {self.index}: untagged error with {len(self.pending)} requests pending: {error}")
+                pending, self.pending = self.pending, {}
+                for future in pending.values():
+                    if not future.done():
+                        future.set_exception(RuntimeError(
+                            f"Unreal rejected one of {len(pending)} requests in flight on this connection: {error}"))
+                return
+            request_id = next(iter(self.pending))
+
+        future = self.pending.pop(request_id, None)
+        if future is None or future.done():
+            logger.warning(f"Pooled connection {self.index}: dropping late response to request #{request_id}")
+            return
+        future.set_result((response, payload))
+
+
+class AsyncUnrealConnection:
+    """Pooled asyncio connection to an Unreal Engine instance.
+
+    Connections are opened on demand, up to pool_size. At most max_in_flight
+    calls wait for a response at any time; further calls wait for a slot, and
+    that wait counts against their timeout. While the editor cannot be reached,
+    connection attempts back off exponentially (with jitter, up to max_backoff)
+    and calls fail once connect_timeout has passed without a connection.
+
+    cache_size bounds the read cache (see the module docstring); 0 disables it.
+    encoding is "auto" (MessagePack where the bridge and the msgpack package
+    allow it) or "json". unix_socket is the path of the bridge's Unix domain
+    socket, tried before TCP for every connection. shared_memory_size is the
+    size in bytes of each connection's shared memory rings, per direction; 0, or
+    a bridge on another host, keeps all payloads on the socket.
+    """
+
+    def __init__(
+        self,
+        host: str,
+        port: int,
+        pool_size: int = 4,
+        max_in_flight: Optional[int] = None,
+        default_timeout: float = 30.0,
+        connect_timeout: float = 5.0,
+        max_backoff: float = 5.0,
+        cache_size: int = 256,
+        encoding: str = "auto",
+        shared_memory_size: int = 0,
+        unix_socket: Optional[str] = None
+    ):
+        self.host = host
+        self.port = port
+        self.max_in_flight = max(1, max_in_flight or pool_size)
+        self.default_timeout = default_timeout
+        self.connect_timeout = connect_timeout
+        self.max_backoff = max_backoff
+        self._connections: List[_PooledConnection] = [_PooledConnection(index, self._on_push) for index in range(max(1, pool_size))]
+        self._ids = itertools.count(1)
+        # Created on first use so they belong to the loop the calls run on
+        self._slots: Optional[asyncio.Semaphore] = None
+        self._failures = 0
+        self._retry_at = 0.0
+        self._last_error: Optional[Exception] = None
+        self._counters = {"requests": 0, "errors": 0, "timeouts": 0, "connects": 0, "connect_failures": 0}
+        self.cache: Optional[ReadCache] = ReadCache(cache_size) if cache_size > 0 else None
+        self._subscribing: Optional[asyncio.Task] = None
+        # Cleared when the bridge does not know subscribe_revisions
+        self._can_subscribe = True
+        self.use_msgpack = encoding == "auto" and msgpack_codec.AVAILABLE
+        self.shared_memory_size = shared_memory_size
+        self.unix_socket = unix_socket
+
+    async def connect(self) -> bool:
+        """Open the first pooled connection, so the first command does not pay for it."""
+        loop = asyncio.get_running_loop()
+        try:
+            await self._acquire(loop.time() + self.connect_timeout)
+            return True
+        except (OSError, asyncio.TimeoutError) as e:
+            logger.warning(f"Could not connect to Unreal Engine: {e}")
+            return False
+
+    async def close(self):
+        """Close every pooled connection; calls still in flight fail."""
+        if self._subscribing is not None:
+            self._subscribing.cancel()
+        for connection in self._connections:
+            if connection.opening is not None:
+                connection.opening.cancel()
+            connection.close()
+
+    def stats(self) -> Dict[str, Any]:
+        """Pool size, open connections, calls in flight, request and cache counters."""
+        stats = {
+            "pool_size": len(self._connections),
+            "open_connections": sum(1 for c in self._connections if c.is_open),
+            "in_flight": sum(len(c.pending) for c in self._connections),
+            "msgpack_connections": sum(1 for c in self._connections if c.is_open and c.encoding == msgpack_codec.ENCODING_MSGPACK),
+            "shared_memory_connections": sum(1 for c in self._connections if c.is_open and c.ring is not None),
+            "unix_connections": sum(1 for c in self._connections if c.is_open and c.transport == "unix"),
+            **self._counters,
+        }
+        if self.cache is not None:
+            stats["cache"] = {
+                "entries": len(self.cache),
+                "subscribed": self._is_subscribed(),
+                "revisions": self.cache.revisions,
+                **self.cache.counters,
+            }
+        return stats
+
+    async def send_command(
+        self,
+        command: str,
+        params: Dict[str, Any] = None,
+        attachment: Optional[bytes] = None,
+        timeout: Optional[float] = None
+    ) -> Optional[Dict[str, Any]]:
+        """Send a command to Unreal Engine and wait for its response.
+
+        A binary attachment (e.g. packed float buffers) is sent as the payload of
+        a frame. The timeout covers waiting for a free slot, connecting and the
+        command itself; it defaults to COMMAND_TIMEOUTS or default_timeout.
+        """
+        if timeout is None:
+            timeout = COMMAND_TIMEOUTS.get(command, self.default_timeout)
+        if self._slots is None:
+            self._slots = asyncio.Semaphore(self.max_in_flight)
+
+        cache = self.cache
+        depends_on = CACHEABLE_COMMANDS.get(command) if cache is not None and not attachment else None
+        mutating = cache is not None and depends_on is None and command not in NON_MUTATING_COMMANDS
+        if depends_on:
+            key = ReadCache.key(command, params)
+            if key in cache and (self._is_subscribed() or await self._validate_revisions()):
+                hit = cache.lookup(key, depends_on)
+                if hit is not None:
+                    logger.info(f"Serving {command} from the read cache")
+                    return normalize_response(*hit)
+            cache.counters["misses"] += 1
+            generation = cache.generation
+            self._ensure_subscribed()
+        elif mutating:
+            cache.invalidate()
+
+        request_id = next(self._ids)
+        self._counters["requests"] += 1
+        try:
+            response, payload = await asyncio.wait_for(
+                self._call(request_id, command, params, attachment, timeout, bool(depends_on)), timeout)
+        except asyncio.TimeoutError:
+            self._counters["timeouts"] += 1
+            logger.error(f"Command #{request_id} {command} timed out after {timeout:.1f}s")
+            return {"status": "error", "error": f"Timed out after {timeout:.1f}s waiting for {command}"}
+        except Exception as e:
+            self._counters["errors"] += 1
+            logger.error(f"Error sending command #{request_id} {command}: {e}")
+            return {"status": "error", "error": str(e)}
+        finally:
+            # Reads that overlapped an edit may have seen either side of it
+            if mutating:
+                cache.invalidate()
+
+        logger.info(f"Response #{request_id} from Unreal: {response}")
+        revisions = response.pop("revisions", None)
+        if cache is not None and revisions:
+            cache.observe(revisions)
+            if depends_on and response.get("status") == "success":
+                cache.store(key, generation, revisions, response, payload if payload else None)
+        return normalize_response(response, payload if payload else None)
+
+    async def _call(
+        self,
+        request_id: int,
+        command: str,
+        params: Optional[Dict[str, Any]],
+        attachment: Optional[bytes],
+        timeout: float,
+        revisions: bool = False
+    ) -> Tuple[Dict[str, Any], bytes]:
+        async with self._slots:
+            connection = await self._acquire(asyncio.get_running_loop().time() + min(timeout, self.connect_timeout))
+            data = connection.encode(request_id, command, params, attachment, revisions)
+            logger.info(f"Sending command #{request_id} on connection {connection.index}: {command}")
+            future = await connection.send(request_id, data)
+            return await future
+
+    def _on_push(self, message: Dict[str, Any]):
+        if message.get("event") == "revisions" and self.cache is not None:
+            self.cache.observe(message)
+        else:
+            # Other pushes (stream frames, notifications) belong to other clients
+            logger.debug(f"Ignoring unsolicited message {message.get('event')}")
+
+    def _is_subscribed(self) -> bool:
+        return any(c.subscribed and c.is_open for c in self._connections)
+
+    def _ensure_subscribed(self):
+        """Subscribe to revision pushes in the background, once per connection loss."""
+        if self._can_subscribe and self._subscribing is None and not self._is_subscribed():
+            self._subscribing = asyncio.ensure_future(self._subscribe())
+
+    async def _subscribe(self):
+        try:
+            loop = asyncio.get_running_loop()
+            connection = await self._acquire(loop.time() + self.connect_timeout)
+            request_id = next(self._ids)
+            future = await connection.send(request_id, connection.encode(request_id, "subscribe_revisions", {}, None))
+            response, _ = await asyncio.wait_for(future, self.default_timeout)
+            if response.get("status") != "success":
+                # An older bridge; cached results are validated per read instead
+                self._can_subscribe = False
+                logger.info(f"Revision pushes unavailable: {response.get('error')}")
+                return
+            connection.subscribed = True
+            self.cache.observe(response.get("result", {}))
+            logger.info(f"Pooled connection {connection.index} subscribed to revision pushes")
+        except Exception as e:
+            logger.warning(f"Could not subscribe to revision pushes: {e}")
+        finally:
+            self._subscribing = None
+
+    async def _validate_revisions(self) -> bool:
+        """Fetch the current revisions; False if the bridge could not be asked."""
+        self.cache.counters["validations"] += 1
+        request_id = next(self._ids)
+        try:
+            response, _ = await asyncio.wait_for(self._call(request_id, "get_revisions", {}, None, self.default_timeout), self.default_timeout)
+        except Exception as e:
+            logger.warning(f"Could not validate the read cache: {e}")
+            return False
+        if response.get("status") != "success":
+            return False
+        self.cache.observe(response.get("result", {}))
+        return True
+
+    async def _acquire(self, connect_deadline: float) -> _PooledConnection:
+        """Pick an idle connection, open a new one, or share the least busy one."""
+        while True:
+            open_connections = [c for c in self._connections if c.is_open]
+            for connection in open_connections:
+                if not connection.pending:
+                    return connection
+
+            closed = [c for c in self._connections if not c.is_open and c.opening is None]
+            if closed:
+                connection = closed[0]
+                connection.opening = asyncio.ensure_future(self._open(connection, connect_deadline))
+                try:
+                    await connection.opening
+                finally:
+                    connection.opening = None
+                return connection
+
+            if open_connections:
+                return min(open_connections, key=lambda c: len(c.pending))
+
+            # Every slot is still connecting; wait for one of them and look again
+            opening = [c.opening for c in self._connections if c.opening is not None]
+            remaining = connect_deadline - asyncio.get_running_loop().time()
+            if remaining <= 0:
+                raise ConnectionError(f"Could not connect to Unreal at {self.host}:{self.port}: {self._last_error}")
+            await asyncio.wait(opening, timeout=remaining, return_when=asyncio.FIRST_COMPLETED)
+
+    async def _open(self, connection: _PooledConnection, deadline: float):
+        loop = asyncio.get_running_loop()
+        while True:
+            # The backoff is shared, so callers arriving while the editor is down
+            # wait for the next attempt instead of each hammering the port
+            delay = max(0.0, self._retry_at - loop.time())
+            if loop.time() + delay >= deadline:
+                raise ConnectionError(f"Could not connect to Unreal at {self.host}:{self.port}: {self._last_error}")
+            if delay > 0:
+                await asyncio.sleep(delay)
+
+            try:
+                await connection.open(self.host, self.port, max(0.01, deadline - loop.time()), self.unix_socket)
+            except (OSError, asyncio.TimeoutError) as e:
+                self._failures += 1
+                self._counters["connect_failures"] += 1
+                self._last_error = e if str(e) else TimeoutError("connect timed out")
+                backoff = min(self.max_backoff, 0.1 * 2 ** (self._failures - 1))
+                self._retry_at = loop.time() + backoff * random.uniform(0.5, 1.0)
+                logger.warning(f"Failed to connect to Unreal (attempt {self._failures}): {self._last_error}")
+                continue
+
+            self._failures = 0
+            self._retry_at = 0.0
+            self._counters["connects"] += 1
+            logger.info(f"Pooled connection {connection.index} connected to Unreal at "
+                        f"{self.unix_socket if connection.transport == 'unix' else f'{self.host}:{self.port}'}")
+            if self.use_msgpack:
+                await self._negotiate(connection, deadline)
+            # A Unix socket connection is always to this machine
+            if self.shared_memory_size > 0 and (connection.transport == "unix" or self.host in shared_memory_transport.LOOPBACK_HOSTS):
+                await self._open_shared_memory(connection, deadline)
+            return
+
+    async def _negotiate(self, connection: _PooledConnection, deadline: float):
+        """Switch a new connection to MessagePack if the bridge lists it in its ping result."""
+        request_id = next(self._ids)
+        try:
+            future = await connection.send(request_id, encode_request("ping", {}, None, request_id))
+            response, _ = await asyncio.wait_for(future, max(0.01, deadline - asyncio.get_running_loop().time()))
+        except (OSError, ConnectionError, asyncio.TimeoutError) as e:
+            # The connection stays usable with JSON; a dead one fails the next send
+            logger.warning(f"Pooled connection {connection.index}: encoding negotiation failed: {e}")
+            return
+        if "msgpack" in response.get("result", {}).get("encodings", []):
+            connection.encoding = msgpack_codec.ENCODING_MSGPACK
+            logger.info(f"Pooled connection {connection.index} uses MessagePack")
+
+    async def _open_shared_memory(self, connection: _PooledConnection, deadline: float):
+        """Create a shared memory region for a new connection and have the bridge map it."""
+        try:
+            ring = SharedRing(self.shared_memory_size)
+        except (OSError, ValueError) as e:
+            logger.warning(f"Pooled connection {connection.index}: could not create shared memory: {e}")
+            return
+        request_id = next(self._ids)
+        params = {"name": ring.name, "ring_size": ring.ring_size, "min_payload": ring.min_payload}
+        try:
+            future = await connection.send(request_id, connection.encode(request_id, "open_shared_memory", params, None))
+            response, _ = await asyncio.wait_for(future, max(0.01, deadline - asyncio.get_running_loop().time()))
+        except (OSError, ConnectionError, asyncio.TimeoutError) as e:
+            logger.warning(f"Pooled connection {connection.index}: could not open shared memory: {e}")
+            ring.close()
+            return
+        if response.get("status") != "success" or not connection.is_open:
+            # An older bridge, or one on another machine behind a forwarded port
+            logger.info(f"Pooled connection {connection.index} stays on the socket: {response.get('error')}")
+            ring.close()
+            return
+        connection.ring = ring
+        logger.info(f"Pooled connection {connection.index} uses shared memory {ring.name}")
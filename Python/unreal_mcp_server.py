@@ -6,11 +6,13 @@ A simple MCP server for interacting with Unreal Engine.
 
 import logging
 import socket
+import struct
 import sys
 import json
 from contextlib import asynccontextmanager
-from typing import AsyncIterator, Dict, Any, Optional
+from typing import AsyncIterator, Dict, Any, Optional, Tuple
 from mcp.server.fastmcp import FastMCP
+from unreal_async_client import AsyncUnrealConnection, encode_request, normalize_response
 
 # Configure logging with more detailed format
 logging.basicConfig(
@@ -26,9 +28,40 @@ logger = logging.getLogger("UnrealMCP")
 # Configuration
 UNREAL_HOST = "127.0.0.1"
 UNREAL_PORT = 55557
+# Persistent connections the tools share, and the default per-call timeout in seconds
+UNREAL_POOL_SIZE = 4
+UNREAL_TIMEOUT = 30.0
+# Read-only results kept by the client (see unreal_async_client.py); 0 disables the cache
+UNREAL_CACHE_SIZE = 256
+# Shared memory rings for large payloads, in MB per connection and direction; only
+# used when the editor runs on this machine. 0 keeps every payload on the socket
+UNREAL_SHARED_MEMORY_MB = 16
+# Unix domain socket of the bridge ([UnrealMCP] UnixSocketPath or -MCPUnixSocket= in
+# the editor); used instead of TCP while it exists. None always uses TCP
+UNREAL_UNIX_SOCKET = "/tmp/unreal_mcp.sock"
+
+# Binary frame layout (see MCPWireProtocol.h): magic, version, encoding, flags,
+# header length, payload length, followed by the JSON header and raw payload.
+FRAME_MAGIC = b"MCPF"
+FRAME_PREFIX = struct.Struct("<4sBBHII")
+
+def parse_frame(data: bytes) -> Optional[Tuple[bytes, bytes]]:
+    """Split a complete frame into (header, payload), or return None if more bytes are needed."""
+    if len(data) < FRAME_PREFIX.size:
+        return None
+    _, _, _, _, header_len, payload_len = FRAME_PREFIX.unpack_from(data)
+    end = FRAME_PREFIX.size + header_len + payload_len
+    if len(data) < end:
+        return None
+    header_end = FRAME_PREFIX.size + header_len
+    return data[FRAME_PREFIX.size:header_end], data[header_end:end]
 
 class UnrealConnection:
-    """Connection to an Unreal Engine instance."""
+    """Blocking connection to an Unreal Engine instance, one socket per command.
+    
+    The MCP tools use the pooled AsyncUnrealConnection (get_unreal_connection);
+    this class is kept for scripts that talk to the editor synchronously.
+    """
     
     def __init__(self):
         """Initialize the connection."""
@@ -78,8 +111,11 @@ class UnrealConnection:
         self.socket = None
         self.connected = False
 
-    def receive_full_response(self, sock, buffer_size=4096) -> bytes:
-        """Receive a complete response from Unreal, handling chunked data."""
+    def receive_full_response(self, sock, buffer_size=4096) -> Tuple[bytes, Optional[bytes]]:
+        """Receive a complete response from Unreal, handling chunked data.
+
+        Returns the JSON bytes and, for framed responses, the binary payload.
+        """
         chunks = []
         sock.settimeout(5)  # 5 second timeout
         try:
@@ -93,13 +129,23 @@ class UnrealConnection:
                 
                 # Process the data received so far
                 data = b''.join(chunks)
+                
+                # Framed response: wait until the declared lengths have arrived
+                if data.startswith(FRAME_MAGIC):
+                    frame = parse_frame(data)
+                    if frame is None:
+                        buffer_size = max(buffer_size, 65536)
+                        continue
+                    logger.info(f"Received complete framed response ({len(data)} bytes)")
+                    return frame
+                
                 decoded_data = data.decode('utf-8')
                 
                 # Try to parse as JSON to check if complete
                 try:
                     json.loads(decoded_data)
                     logger.info(f"Received complete response ({len(data)} bytes)")
-                    return data
+                    return data, None
                 except json.JSONDecodeError:
                     # Not complete JSON yet, continue reading
                     logger.debug(f"Received partial response, waiting for more data...")
@@ -115,7 +161,7 @@ class UnrealConnection:
                 try:
                     json.loads(data.decode('utf-8'))
                     logger.info(f"Using partial response after timeout ({len(data)} bytes)")
-                    return data
+                    return data, None
                 except:
                     pass
             raise Exception("Timeout receiving Unreal response")
@@ -123,8 +169,11 @@ class UnrealConnection:
             logger.error(f"Error during receive: {str(e)}")
             raise
     
-    def send_command(self, command: str, params: Dict[str, Any] = None) -> Optional[Dict[str, Any]]:
-        """Send a command to Unreal Engine and get the response."""
+    def send_command(self, command: str, params: Dict[str, Any] = None, attachment: Optional[bytes] = None) -> Optional[Dict[str, Any]]:
+        """Send a command to Unreal Engine and get the response.
+        
+        A binary attachment (e.g. packed float buffers) is sent as the payload of a frame.
+        """
         # Always reconnect for each command, since Unreal closes the connection after each command
         # This is different from Unity which keeps connections alive
         if self.socket:
@@ -140,40 +189,19 @@ class UnrealConnection:
             return None
         
         try:
-            # Match Unity's command format exactly
-            command_obj = {
-                "type": command,  # Use "type" instead of "command"
-                "params": params or {}  # Use Unity's params or {} pattern
-            }
-            
-            # Send without newline, exactly like Unity
-            command_json = json.dumps(command_obj)
-            logger.info(f"Sending command: {command_json}")
-            self.socket.sendall(command_json.encode('utf-8'))
+            # Match Unity's command format exactly: {"type": ..., "params": ...}, no newline
+            command_bytes = encode_request(command, params, attachment)
+            logger.info(f"Sending command: {command}")
+            self.socket.sendall(command_bytes)
             
             # Read response using improved handler
-            response_data = self.receive_full_response(self.socket)
+            response_data, attachment = self.receive_full_response(self.socket)
             response = json.loads(response_data.decode('utf-8'))
             
             # Log complete response for debugging
             logger.info(f"Complete response from Unreal: {response}")
             
-            # Check for both error formats: {"status": "error", ...} and {"success": false, ...}
-            if response.get("status") == "error":
-                error_message = response.get("error") or response.get("message", "Unknown Unreal error")
-                logger.error(f"Unreal error (status=error): {error_message}")
-                # We want to preserve the original error structure but ensure error is accessible
-                if "error" not in response:
-                    response["error"] = error_message
-            elif response.get("success") is False:
-                # This format uses {"success": false, "error": "message"} or {"success": false, "message": "message"}
-                error_message = response.get("error") or response.get("message", "Unknown Unreal error")
-                logger.error(f"Unreal error (success=false): {error_message}")
-                # Convert to the standard format expected by higher layers
-                response = {
-                    "status": "error",
-                    "error": error_message
-                }
+            response = normalize_response(response, attachment)
             
             # Always close the connection after command is complete
             # since Unreal will close it on its side anyway
@@ -201,39 +229,26 @@ class UnrealConnection:
             }
 
 # Global connection state
-_unreal_connection: UnrealConnection = None
+_unreal_connection: Optional[AsyncUnrealConnection] = None
 
-def get_unreal_connection() -> Optional[UnrealConnection]:
-    """Get the connection to Unreal Engine."""
+def get_unreal_connection() -> Optional[AsyncUnrealConnection]:
+    """Get the pooled connection to Unreal Engine shared by all tools.
+    
+    Connections are opened, and reopened after a drop, by the pool itself when a
+    command is sent, so this only creates the pool on first use.
+    """
     global _unreal_connection
-    try:
-        if _unreal_connection is None:
-            _unreal_connection = UnrealConnection()
-            if not _unreal_connection.connect():
-                logger.warning("Could not connect to Unreal Engine")
-                _unreal_connection = None
-        else:
-            # Verify connection is still valid with a ping-like test
-            try:
-                # Simple test by sending an empty buffer to check if socket is still connected
-                _unreal_connection.socket.sendall(b'\x00')
-                logger.debug("Connection verified with ping test")
-            except Exception as e:
-                logger.warning(f"Existing connection failed: {e}")
-                _unreal_connection.disconnect()
-                _unreal_connection = None
-                # Try to reconnect
-                _unreal_connection = UnrealConnection()
-                if not _unreal_connection.connect():
-                    logger.warning("Could not reconnect to Unreal Engine")
-                    _unreal_connection = None
-                else:
-                    logger.info("Successfully reconnected to Unreal Engine")
-        
-        return _unreal_connection
-    except Exception as e:
-        logger.error(f"Error getting Unreal connection: {e}")
-        return None
+    if _unreal_connection is None:
+        _unreal_connection = AsyncUnrealConnection(
+            UNREAL_HOST,
+            UNREAL_PORT,
+            pool_size=UNREAL_POOL_SIZE,
+            default_timeout=UNREAL_TIMEOUT,
+            cache_size=UNREAL_CACHE_SIZE,
+            shared_memory_size=UNREAL_SHARED_MEMORY_MB * 1024 * 1024,
+            unix_socket=UNREAL_UNIX_SOCKET
+        )
+    return _unreal_connection
 
 @asynccontextmanager
 async def server_lifespan(server: FastMCP) -> AsyncIterator[Dict[str, Any]]:
@@ -241,20 +256,18 @@ async def server_lifespan(server: FastMCP) -> AsyncIterator[Dict[str, Any]]:
     global _unreal_connection
     logger.info("UnrealMCP server starting up")
     try:
-        _unreal_connection = get_unreal_connection()
-        if _unreal_connection:
+        if await get_unreal_connection().connect():
             logger.info("Connected to Unreal Engine on startup")
         else:
             logger.warning("Could not connect to Unreal Engine on startup")
     except Exception as e:
         logger.error(f"Error connecting to Unreal Engine on startup: {e}")
-        _unreal_connection = None
     
     try:
         yield {}
     finally:
         if _unreal_connection:
-            _unreal_connection.disconnect()
+            await _unreal_connection.close()
             _unreal_connection = None
         logger.info("Unreal MCP server shut down")
 
@@ -304,15 +317,29 @@ def info():
     ## Editor Tools
     ### Viewport and Screenshots
     - `focus_viewport(target, location, distance, orientation)` - Focus viewport
-    - `take_screenshot(filename, show_ui, resolution)` - Capture screenshots
+    - `take_screenshot(filepath, format, quality, max_width, max_height)` - Capture screenshots (inline image or file)
+    - `start_viewport_stream(fps, max_width, max_height, tile_size)` - Stream changed viewport tiles over a persistent connection
+    - `get_viewport_stream_frame()` - Latest composited stream frame; cheaper than repeated screenshots
+    - `stop_viewport_stream()` - Stop the stream and return its statistics
 
     ### Actor Management
     - `get_actors_in_level()` - List all actors in current level
     - `find_actors_by_name(pattern)` - Find actors by name pattern
+    - `find_actors_in_radius(center, radius)` / `find_actors_in_box(min, max)` / `find_nearest_actors(point, count)` - Spatial queries served from an editor-side index; use instead of listing every actor and filtering
+    - `snapshot_level()` / `diff_level(from_snapshot, to_snapshot)` - Record the level and list actors added, removed or changed since
     - `spawn_actor(name, type, location=[0,0,0], rotation=[0,0,0], scale=[1,1,1])` - Create actors
+    - `spawn_actors_bulk(name_prefix, transforms, static_mesh, instanced=False)` - Spawn many actors, or one instanced mesh actor, in one request
     - `delete_actor(name)` - Remove actors
     - `set_actor_transform(name, location, rotation, scale)` - Modify actor transform
+    - `set_transforms_bulk(transforms, names|handles)` - Move many actors in one request
     - `get_actor_properties(name)` - Get actor properties
+    - Actor results carry a stable `handle`; pass `handle` instead of `name` to skip the name lookup on repeated edits
+    
+    ### Batches and Transactions
+    - `batch(commands, transaction=True, stop_on_error=True)` - Run many commands as one undo entry; blueprint refreshes and compiles happen once at the end
+    - `begin_transaction(description)` / `commit_transaction()` / `rollback_transaction()` - Group edits across several calls
+    - `get_server_stats(commands, reset)` - Per-command request counts and latency percentiles; answers even while the editor is busy
+    - `start_recording(path)` / `stop_recording()` - Record requests and responses to a journal for replay
     
     ## Blueprint Management
     - `create_blueprint(name, parent_class)` - Create new Blueprint classes
@@ -336,6 +363,7 @@ def info():
     
     ## Project Tools
     - `create_input_mapping(action_name, key, input_type)` - Create input mappings
+    - `find_assets(asset_class, paths, name_contains, tags, include_tags, offset, limit)` - Search assets via the asset registry without loading them
     
     ## Best Practices
     
@@ -0,0 +1,319 @@
+"""
+Viewport stream client for Unreal MCP.
+
+Keeps a persistent connection to the editor, starts a viewport stream and
+composites the pushed tile updates into a full frame. Frames are acknowledged
+as they are applied; the editor stops capturing when too many frames are
+unacknowledged, so a slow consumer lowers the frame rate instead of queuing.
+
+Wire format of a pushed frame (see MCPViewportStream.h): an MCPF frame whose
+JSON header has "event": "viewport_frame" and a "tiles" list of
+[x, y, width, height, offset, length]. Each tile is zlib-compressed BGRA rows
+stored at payload[offset:offset + length].
+"""
+
+import json
+import logging
+import re
+import socket
+import struct
+import threading
+import time
+import zlib
+from collections import deque
+from queue import Queue, Empty
+from typing import Any, Deque, Dict, Optional, Tuple
+
+logger = logging.getLogger("UnrealMCP")
+
+FRAME_MAGIC = b"MCPF"
+FRAME_PREFIX = struct.Struct("<4sBBHII")
+PNG_SIGNATURE = b"\x89PNG\r\n\x1a\n"
+
+
+class JsonScanState:
+    """Brace matching progress through a JSON message that has not fully arrived.
+
+    Pass the same instance to split_message for every read of a connection, so
+    each read scans only the new bytes instead of the whole message again.
+    """
+
+    __slots__ = ("scanned", "depth", "in_string", "escaped")
+
+    def __init__(self):
+        self.reset()
+
+    def reset(self):
+        self.scanned = 0  # bytes of the message scanned, from its opening brace
+        self.depth = 0
+        self.in_string = False
+        self.escaped = False
+
+
+# The bytes brace matching has to stop at, outside and inside strings
+_JSON_STRUCTURE = re.compile(rb'[{}"]')
+_JSON_STRING_END = re.compile(rb'["\\]')
+
+
+def split_message(buffer: bytearray, scan: Optional[JsonScanState] = None) -> Optional[Tuple[bytes, bytes, int]]:
+    """Find the next complete message at the start of the buffer.
+
+    Returns (json_bytes, payload, consumed) or None if more data is needed.
+    Leading whitespace is skipped; plain JSON messages have an empty payload.
+    The caller must drop the consumed bytes before the next call when it keeps
+    a scan state, since the state is relative to the message start.
+    """
+    start = 0
+    while start < len(buffer) and buffer[start] in b" \t\r\n":
+        start += 1
+    if start == len(buffer):
+        return None
+
+    if buffer[start:start + 4] == FRAME_MAGIC:
+        if len(buffer) - start < FRAME_PREFIX.size:
+            return None
+        _, _, _, _, header_len, payload_len = FRAME_PREFIX.unpack_from(buffer, start)
+        header_start = start + FRAME_PREFIX.size
+        payload_start = header_start + header_len
+        end = payload_start + payload_len
+        if len(buffer) < end:
+            return None
+        return bytes(buffer[header_start:payload_start]), bytes(buffer[payload_start:end]), end
+
+    # Brace matching that ignores braces inside strings, resumed where the last read stopped
+    if scan is None:
+        scan = JsonScanState()
+    index = start + scan.scanned
+    length = len(buffer)
+    while index < length:
+        if scan.in_string:
+            if scan.escaped:
+                scan.escaped = False
+                index += 1
+                continue
+            match = _JSON_STRING_END.search(buffer, index)
+            if match is None:
+                break
+            index = match.start() + 1
+            if buffer[match.start()] == 0x5C:  # backslash
+                scan.escaped = True
+            else:
+                scan.in_string = False
+            continue
+        match = _JSON_STRUCTURE.search(buffer, index)
+        if match is None:
+            break
+        index = match.start() + 1
+        byte = buffer[match.start()]
+        if byte == 0x22:  # quote
+            scan.in_string = True
+        elif byte == 0x7B:  # {
+            scan.depth += 1
+        else:
+            scan.depth -= 1
+            if scan.depth == 0:
+                scan.reset()
+                return bytes(buffer[start:index]), b"", index
+    scan.scanned = length - start
+    return None
+
+
+def encode_png(bgra: bytes, width: int, height: int) -> bytes:
+    """Encode BGRA pixels as an RGBA PNG using only the standard library."""
+    rgba = bytearray(bgra)
+    rgba[0::4] = bgra[2::4]
+    rgba[2::4] = bgra[0::4]
+
+    stride = width * 4
+    scanlines = b"".join(b"\x00" + bytes(rgba[y * stride:(y + 1) * stride]) for y in range(height))
+
+    def chunk(tag: bytes, data: bytes) -> bytes:
+        return struct.pack(">I", len(data)) + tag + data + struct.pack(">I", zlib.crc32(tag + data) & 0xFFFFFFFF)
+
+    header = struct.pack(">IIBBBBB", width, height, 8, 6, 0, 0, 0)
+    return PNG_SIGNATURE + chunk(b"IHDR", header) + chunk(b"IDAT", zlib.compress(scanlines, 6)) + chunk(b"IEND", b"")
+
+
+class ViewportStream:
+    """A persistent connection that receives and composites viewport frames."""
+
+    def __init__(self, host: str, port: int):
+        self.host = host
+        self.port = port
+        self.socket: Optional[socket.socket] = None
+        self.stream_id: Optional[int] = None
+
+        self._send_lock = threading.Lock()
+        self._pending: Deque[Optional[Queue]] = deque()
+        self._reader: Optional[threading.Thread] = None
+        self._running = False
+
+        # Composited frame, guarded by _frame_lock
+        self._frame_lock = threading.Lock()
+        self._canvas: Optional[bytearray] = None
+        self._width = 0
+        self._height = 0
+        self._frame_index = 0
+        self._frame_info: Dict[str, Any] = {}
+        self._frame_event = threading.Event()
+        self.stopped_reason: Optional[str] = None
+
+    @property
+    def active(self) -> bool:
+        return self._running and self.stopped_reason is None
+
+    def start(self, **params) -> Dict[str, Any]:
+        """Connect and start streaming. Params are passed to start_viewport_stream."""
+        self.socket = socket.create_connection((self.host, self.port), timeout=5)
+        self.socket.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        self.socket.settimeout(None)
+        self._running = True
+        self._reader = threading.Thread(target=self._read_loop, name="UnrealViewportStream", daemon=True)
+        self._reader.start()
+
+        response = self._call("start_viewport_stream", params)
+        if response.get("status") != "success":
+            self.close()
+            return response
+        self.stream_id = response["result"]["stream_id"]
+        logger.info(f"Viewport stream {self.stream_id} started: {response['result']}")
+        return response
+
+    def stop(self) -> Dict[str, Any]:
+        """Stop the stream and close the connection, returning the server's stream stats."""
+        response: Dict[str, Any] = {"status": "error", "error": "Stream is not running"}
+        if self._running and self.stream_id is not None:
+            try:
+                response = self._call("stop_viewport_stream", {"stream_id": self.stream_id})
+            except Exception as e:
+                response = {"status": "error", "error": str(e)}
+        self.close()
+        return response
+
+    def close(self):
+        self._running = False
+        if self.socket:
+            try:
+                self.socket.shutdown(socket.SHUT_RDWR)
+            except OSError:
+                pass
+            self.socket.close()
+            self.socket = None
+        # Release anyone still waiting on a response
+        while self._pending:
+            waiter = self._pending.popleft()
+            if waiter is not None:
+                waiter.put({"status": "error", "error": "Connection closed"})
+
+    def wait_for_frame(self, after_frame: int = 0, timeout: float = 5.0) -> bool:
+        """Block until a frame newer than after_frame has been composited."""
+        deadline = time.monotonic() + timeout
+        while time.monotonic() < deadline:
+            with self._frame_lock:
+                if self._frame_index > after_frame:
+                    return True
+                self._frame_event.clear()
+            self._frame_event.wait(max(0.0, deadline - time.monotonic()))
+        with self._frame_lock:
+            return self._frame_index > after_frame
+
+    def latest_frame(self) -> Optional[Tuple[bytes, Dict[str, Any]]]:
+        """Return the current composited frame as a PNG plus its frame info."""
+        with self._frame_lock:
+            if self._canvas is None:
+                return None
+            pixels = bytes(self._canvas)
+            width, height = self._width, self._height
+            info = dict(self._frame_info)
+        return encode_png(pixels, width, height), info
+
+    def request_keyframe(self):
+        self._send("ack_viewport_frame", {"stream_id": self.stream_id, "frame": self._frame_index, "keyframe": True})
+
+    def _call(self, command: str, params: Dict[str, Any], timeout: float = 10.0) -> Dict[str, Any]:
+        waiter: Queue = Queue(maxsize=1)
+        self._send(command, params, waiter)
+        try:
+            return waiter.get(timeout=timeout)
+        except Empty:
+            return {"status": "error", "error": f"Timeout waiting for {command}"}
+
+    def _send(self, command: str, params: Dict[str, Any], waiter: Optional[Queue] = None):
+        """Send a command; its response is routed to waiter (or discarded) in order."""
+        data = json.dumps({"type": command, "params": params}).encode("utf-8")
+        with self._send_lock:
+            if not self.socket:
+                raise ConnectionError("Viewport stream is not connected")
+            self._pending.append(waiter)
+            self.socket.sendall(data)
+
+    def _read_loop(self):
+        buffer = bytearray()
+        scan = JsonScanState()
+        try:
+            while self._running:
+                chunk = self.socket.recv(262144)
+                if not chunk:
+                    break
+                buffer += chunk
+                while True:
+                    message = split_message(buffer, scan)
+                    if message is None:
+                        break
+                    header, payload, consumed = message
+                    del buffer[:consumed]
+                    self._dispatch(json.loads(header.decode("utf-8")), payload)
+        except (OSError, ValueError) as e:
+            if self._running:
+                logger.warning(f"Viewport stream connection error: {e}")
+        finally:
+            if self._running:
+                self.stopped_reason = self.stopped_reason or "connection closed"
+            self._running = False
+            self._frame_event.set()
+
+    def _dispatch(self, message: Dict[str, Any], payload: bytes):
+        event = message.get("event")
+        if event == "viewport_frame":
+            self._apply_frame(message, payload)
+        elif event == "viewport_stream_stopped":
+            self.stopped_reason = message.get("reason", "stopped")
+            logger.info(f"Viewport stream {message.get('stream_id')} stopped: {self.stopped_reason}")
+            self._frame_event.set()
+        elif "status" in message:
+            waiter = self._pending.popleft() if self._pending else None
+            if waiter is not None:
+                waiter.put(message)
+            elif message.get("status") == "error":
+                logger.warning(f"Viewport stream command failed: {message.get('error')}")
+
+    def _apply_frame(self, header: Dict[str, Any], payload: bytes):
+        width, height = header["width"], header["height"]
+        needs_keyframe = False
+
+        with self._frame_lock:
+            if header.get("keyframe") or self._canvas is None or (width, height) != (self._width, self._height):
+                if not header.get("keyframe"):
+                    # Missed the keyframe for this size; ask for a full frame
+                    needs_keyframe = True
+                self._canvas = bytearray(width * height * 4)
+                self._width, self._height = width, height
+
+            canvas = self._canvas
+            for x, y, tile_width, tile_height, offset, length in header["tiles"]:
+                pixels = zlib.decompress(payload[offset:offset + length])
+                row_bytes = tile_width * 4
+                for row in range(tile_height):
+                    dest = ((y + row) * width + x) * 4
+                    canvas[dest:dest + row_bytes] = pixels[row * row_bytes:(row + 1) * row_bytes]
+
+            self._frame_index = header["frame"]
+            self._frame_info = {key: value for key, value in header.items() if key != "tiles"}
+            self._frame_info["payload_bytes"] = len(payload)
+            self._frame_event.set()
+
+        # Acknowledge so the editor keeps capturing
+        try:
+            self._send("ack_viewport_frame", {"stream_id": header["stream_id"], "frame": header["frame"], "keyframe": needs_keyframe})
+        except (OSError, ConnectionError) as e:
+            logger.warning(f"Failed to acknowledge viewport frame: {e}")